@@ -0,0 +1,8 @@
+-- schema for pggate_bench.sh
+DROP TABLE IF EXISTS bench_kv;
+CREATE TABLE bench_kv (
+    id      bigint PRIMARY KEY,
+    grp     integer NOT NULL,
+    payload varchar(100)
+);
+CREATE INDEX bench_kv_grp ON bench_kv (grp);
@@ -0,0 +1,2 @@
+-- run with pgbench -C so that every transaction is a new backend loading its catalog caches from K2
+SELECT 1;
@@ -0,0 +1,2 @@
+\set grp random(0, 999)
+SELECT count(*) FROM bench_kv WHERE grp = :grp;
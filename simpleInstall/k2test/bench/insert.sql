@@ -0,0 +1,2 @@
+\set id random(:rows + 1, 4000000000000000000)
+INSERT INTO bench_kv VALUES (:id, :id % 1000, 'payload-' || :id);
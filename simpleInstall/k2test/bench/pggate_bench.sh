@@ -0,0 +1,71 @@
+#!/bin/bash
+# Micro-benchmark of the pggate layer. Run it against a database started with ../../inproc_run.sh so that
+# the numbers measure pggate and the K2 access methods rather than the network and the SKV cluster.
+# For each workload prints pgbench tps, the per-operation K2 latencies from pg_stat_k2_ops and the
+# backend memory usage.
+#
+# usage: pggate_bench.sh [-d dbname] [-p port] [-c clients] [-t seconds] [-r rows] [workload...]
+#   workloads: insert pk_select index_scan seq_scan catalog_load (default: all of them)
+
+DB=postgres
+PORT=5432
+CLIENTS=1
+DURATION=30
+ROWS=100000
+while getopts "d:p:c:t:r:" opt; do
+    case ${opt} in
+        d) DB=${OPTARG} ;;
+        p) PORT=${OPTARG} ;;
+        c) CLIENTS=${OPTARG} ;;
+        t) DURATION=${OPTARG} ;;
+        r) ROWS=${OPTARG} ;;
+        *) echo "usage: $0 [-d dbname] [-p port] [-c clients] [-t seconds] [-r rows] [workload...]"; exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+WORKLOADS=${@:-insert pk_select index_scan seq_scan catalog_load}
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )"
+GSQL="gsql -d ${DB} -p ${PORT} -v ON_ERROR_STOP=1"
+
+run_sql() {
+    ${GSQL} -c "$1"
+}
+
+k2_ops() {
+    ${GSQL} -A -t -F ' ' -c "SELECT op, calls, errors, total_us, bytes, records FROM pg_stat_k2_ops;"
+}
+
+# pg_stat_k2_ops is cumulative since server start, so report the difference over the run
+report() {
+    echo "---- $1: K2 operations"
+    k2_ops > /tmp/pggate_bench_after.$$
+    awk 'NR == FNR { calls[$1] = $2; errors[$1] = $3; us[$1] = $4; bytes[$1] = $5; recs[$1] = $6; next }
+         $2 - calls[$1] > 0 {
+             n = $2 - calls[$1]
+             printf "%-20s calls=%d errors=%d avg_us=%.1f bytes=%d records=%d\n", $1, n, $3 - errors[$1], ($4 - us[$1]) / n, $5 - bytes[$1], $6 - recs[$1]
+         }' /tmp/pggate_bench_before.$$ /tmp/pggate_bench_after.$$
+    rm -f /tmp/pggate_bench_before.$$ /tmp/pggate_bench_after.$$
+    echo "---- $1: memory"
+    run_sql "SELECT memorytype, memorymbytes FROM gs_total_memory_detail WHERE memorytype IN ('dynamic_used_memory', 'dynamic_used_shrctx', 'process_used_memory');"
+}
+
+echo "==== setup: ${ROWS} rows"
+${GSQL} -f ${SCRIPT_DIR}/bench_ddl.sql || exit 1
+run_sql "INSERT INTO bench_kv SELECT g, g % 1000, 'payload-' || g FROM generate_series(1, ${ROWS}) g;" || exit 1
+
+for w in ${WORKLOADS}; do
+    if [ ! -f ${SCRIPT_DIR}/${w}.sql ]; then
+        echo "unknown workload ${w}"
+        exit 1
+    fi
+    EXTRA=""
+    if [ "${w}" == "catalog_load" ]; then
+        EXTRA="-C"
+    fi
+    echo "==== ${w}"
+    k2_ops > /tmp/pggate_bench_before.$$
+    pgbench -n ${EXTRA} -p ${PORT} -c ${CLIENTS} -j ${CLIENTS} -T ${DURATION} -D rows=${ROWS} \
+        -f ${SCRIPT_DIR}/${w}.sql ${DB} | grep -E "tps|latency|number of transactions actually processed"
+    report ${w}
+done
@@ -0,0 +1 @@
+SELECT count(*) FROM bench_kv WHERE payload LIKE 'payload-1%';
@@ -4454,6 +4454,15 @@ CREATE VIEW dbe_perf.global_pagewriter_status AS
         SELECT node_name,pgwr_actual_flush_total_num,pgwr_last_flush_num,remain_dirty_page_num,queue_head_page_rec_lsn,queue_rec_lsn,current_xlog_insert_lsn,ckpt_redo_point
         FROM pg_catalog.local_pagewriter_stat();
 
+CREATE VIEW dbe_perf.global_k2_ops AS
+        SELECT pg_catalog.pgxc_node_str()::text AS node_name,op,calls,errors,total_us,p50_us,p99_us,p999_us,max_us,bytes,records
+        FROM pg_catalog.pg_stat_get_k2_ops();
+
+CREATE VIEW dbe_perf.global_k2_schemas AS
+        SELECT pg_catalog.pgxc_node_str()::text AS node_name,collection,schema,datid,relid,reads,writes,query_pages,errors,
+               records_read,records_written,bytes_read,bytes_written,since
+        FROM pg_catalog.pg_stat_get_k2_schemas();
+
 CREATE VIEW dbe_perf.global_record_reset_time AS
   SELECT * FROM dbe_perf.get_global_record_reset_time();
 
@@ -1827,6 +1827,12 @@ CREATE VIEW pg_stat_bgwriter AS
         pg_stat_get_buf_alloc() AS buffers_alloc,
         pg_stat_get_bgwriter_stat_reset_time() AS stats_reset;
 
+CREATE VIEW pg_stat_k2_ops AS
+    SELECT * FROM pg_stat_get_k2_ops();
+
+CREATE VIEW pg_stat_k2_schemas AS
+    SELECT * FROM pg_stat_get_k2_schemas();
+
 CREATE VIEW pg_user_mappings AS
     SELECT
         U.oid       AS umid,
@@ -13796,6 +13796,15 @@ createdb_opt_item:
 				{
 					$$ = makeDefElem("connectionlimit", (Node *)makeInteger($4));
 				}
+			/* storage options such as k2_partitioning, checked by createdb() */
+			| IDENT opt_equal Sconst
+				{
+					$$ = makeDefElem($1, (Node *)makeString($3));
+				}
+			| IDENT opt_equal SignedIconst
+				{
+					$$ = makeDefElem($1, (Node *)makeInteger($3));
+				}
 			| OWNER opt_equal name
 				{
 					$$ = makeDefElem("owner", (Node *)makeString($3));
@@ -218,6 +218,7 @@ extern Datum pg_stat_reset_single_function_counters(PG_FUNCTION_ARGS);
 extern Datum pv_os_run_info(PG_FUNCTION_ARGS);
 extern Datum pv_session_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_session_memory_detail(PG_FUNCTION_ARGS);
+extern Datum mot_session_jit_detail(PG_FUNCTION_ARGS);
 extern Datum pg_shared_memory_detail(PG_FUNCTION_ARGS);
 extern Datum pg_buffercache_pages(PG_FUNCTION_ARGS);
 extern Datum pv_session_time(PG_FUNCTION_ARGS);
@@ -8351,6 +8352,30 @@ Datum mot_session_memory_detail(PG_FUNCTION_ARGS)
 #endif
 }
 
+/*
+ * Description: Number of MOT jitted queries executed by the current session, in total and from stored procedures.
+ */
+Datum mot_session_jit_detail(PG_FUNCTION_ARGS)
+{
+#ifndef ENABLE_MOT
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("This function is not supported in cluster mode.")));
+    PG_RETURN_NULL();
+#else
+    TupleDesc tupdesc = CreateTemplateTupleDesc(2, false);
+    TupleDescInitEntry(tupdesc, (AttrNumber)1, "exec_count", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)2, "exec_spi_count", INT8OID, -1, 0);
+    tupdesc = BlessTupleDesc(tupdesc);
+
+    Datum values[2];
+    bool nulls[2] = {false};
+    values[0] = Int64GetDatum((int64)u_sess->mot_cxt.jit_exec_count);
+    values[1] = Int64GetDatum((int64)u_sess->mot_cxt.jit_exec_spi_count);
+
+    HeapTuple tuple = heap_form_tuple(tupdesc, values, nulls);
+    PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+#endif
+}
+
 /*
  * Description: Produce a view to show all global memory usage on node
  */
@@ -144,6 +144,30 @@ typedef struct RI_QueryKey {
     int16 keypair[RI_MAX_NUMKEYS][2];
 } RI_QueryKey;
 
+/* ----------
+ * K2PgPendingFKCheck
+ *
+ *	A check of a reference to the primary key of a K2PG table, deferred until
+ *	the after trigger events being fired are done (see K2PgFlushForeignKeyChecks)
+ * ----------
+ */
+typedef struct K2PgPendingFKCheck {
+    RI_QueryKey qkey;
+    NameData conname;
+    Oid db_oid;
+    Oid pk_relid;
+    Oid fk_relid;
+    int nest_level;     /* subtransaction that queued the check */
+    HeapTuple new_row;  /* copy of the referencing row, for the violation report */
+    char* tuple_id;
+    int64_t tuple_id_size;
+} K2PgPendingFKCheck;
+
+static THR_LOCAL MemoryContext k2pg_fk_check_cxt = NULL;
+static THR_LOCAL K2PgPendingFKCheck* k2pg_fk_checks = NULL;
+static THR_LOCAL int k2pg_fk_num_checks = 0;
+static THR_LOCAL int k2pg_fk_batch_size = -1;
+
 /* ----------
  * RI_QueryHashEntry
  * ----------
@@ -198,6 +222,8 @@ static bool ri_Check_Pk_Match(Relation pk_rel, Relation fk_rel, HeapTuple old_ro
 
 static void BuildPgTupleId(Relation pk_rel, Relation fk_rel, Relation idx,
 					const RI_ConstraintInfo *riinfo, HeapTuple tup, void **data, int64_t *bytes);
+static bool K2PgDeferForeignKeyCheck(Relation pk_rel, Relation fk_rel, const RI_ConstraintInfo *riinfo,
+					const RI_QueryKey *qkey, HeapTuple new_row, const char *tuple_id, int64_t tuple_id_size);
 
 static void ri_InitHashTables(void);
 static SPIPlanPtr ri_FetchPreparedPlan(RI_QueryKey* key);
@@ -462,6 +488,13 @@ static Datum RI_FKey_check(PG_FUNCTION_ARGS)
 			heap_close(pk_rel, RowShareLock);
 			return PointerGetDatum(NULL);
 		}
+
+		if (tuple_id != NULL && ref_table_id == RelationGetRelid(pk_rel) &&
+			K2PgDeferForeignKeyCheck(pk_rel, fk_rel, &riinfo, &qkey, new_row, tuple_id, tuple_id_size))
+		{
+			heap_close(pk_rel, RowShareLock);
+			return PointerGetDatum(NULL);
+		}
 	}
 
     if (SPI_connect() != SPI_OK_CONNECT) {
@@ -2914,6 +2947,141 @@ BuildPgTupleId(Relation pk_rel, Relation fk_rel, Relation idx_rel,
     *bytes = VARSIZE((Datum)tuple_id);
 }
 
+/*
+ * Queue the check of a reference to the primary key of a K2PG table instead of
+ * looking the parent row up right away. Returns false if the check must be done
+ * now, i.e. batching is disabled or the FK columns are not of the same types as
+ * the referenced ones, so that the tuple id may not match the stored key.
+ */
+static bool
+K2PgDeferForeignKeyCheck(Relation pk_rel, Relation fk_rel, const RI_ConstraintInfo *riinfo,
+						const RI_QueryKey *qkey, HeapTuple new_row, const char *tuple_id, int64_t tuple_id_size)
+{
+	if (k2pg_fk_batch_size < 0)
+		k2pg_fk_batch_size = PgGate_GetForeignKeyCheckBatchSize();
+	if (k2pg_fk_batch_size == 0)
+		return false;
+
+	for (int i = 0; i < riinfo->nkeys; i++)
+	{
+		if (RIAttType(pk_rel, riinfo->pk_attnums[i]) != RIAttType(fk_rel, riinfo->fk_attnums[i]))
+			return false;
+	}
+
+	if (k2pg_fk_check_cxt == NULL)
+	{
+		k2pg_fk_check_cxt = AllocSetContextCreate(u_sess->top_transaction_mem_cxt,
+			"K2PgForeignKeyChecks",
+			ALLOCSET_DEFAULT_MINSIZE,
+			ALLOCSET_DEFAULT_INITSIZE,
+			ALLOCSET_DEFAULT_MAXSIZE);
+		k2pg_fk_checks = (K2PgPendingFKCheck *) MemoryContextAlloc(k2pg_fk_check_cxt,
+			sizeof(K2PgPendingFKCheck) * k2pg_fk_batch_size);
+		k2pg_fk_num_checks = 0;
+	}
+
+	MemoryContext oldcxt = MemoryContextSwitchTo(k2pg_fk_check_cxt);
+	K2PgPendingFKCheck *check = &k2pg_fk_checks[k2pg_fk_num_checks];
+	check->qkey = *qkey;
+	check->conname = riinfo->conname;
+	check->db_oid = K2PgGetDatabaseOid(pk_rel);
+	check->pk_relid = RelationGetRelid(pk_rel);
+	check->fk_relid = RelationGetRelid(fk_rel);
+	check->nest_level = GetCurrentTransactionNestLevel();
+	check->new_row = heap_copytuple(new_row);
+	check->tuple_id = (char *) palloc(tuple_id_size);
+	errno_t rc = memcpy_s(check->tuple_id, tuple_id_size, tuple_id, tuple_id_size);
+	securec_check(rc, "\0", "\0");
+	check->tuple_id_size = tuple_id_size;
+	MemoryContextSwitchTo(oldcxt);
+
+	if (++k2pg_fk_num_checks >= k2pg_fk_batch_size)
+		K2PgFlushForeignKeyChecks();
+
+	return true;
+}
+
+/*
+ * Verify the queued K2PG foreign key checks, reading each distinct referenced
+ * key once per table, and report the first violation.
+ */
+void
+K2PgFlushForeignKeyChecks(void)
+{
+	int num_checks = k2pg_fk_num_checks;
+	K2PgPendingFKCheck *checks = k2pg_fk_checks;
+
+	if (num_checks == 0)
+		return;
+
+	bool *done = (bool *) palloc0(sizeof(bool) * num_checks);
+	for (int i = 0; i < num_checks; i++)
+	{
+		if (done[i])
+			continue;
+
+		std::vector<std::string> tuple_ids;
+		std::vector<int> members;
+		for (int j = i; j < num_checks; j++)
+		{
+			if (!done[j] && checks[j].pk_relid == checks[i].pk_relid)
+			{
+				tuple_ids.emplace_back(checks[j].tuple_id, checks[j].tuple_id_size);
+				members.push_back(j);
+				done[j] = true;
+			}
+		}
+
+		std::vector<bool> exists;
+		HandleK2PgStatus(PgGate_CheckForeignKeyReferences(checks[i].db_oid, checks[i].pk_relid, tuple_ids, exists));
+		for (size_t k = 0; k < members.size(); k++)
+		{
+			if (exists[k])
+				continue;
+
+			K2PgPendingFKCheck *check = &checks[members[k]];
+			Relation pk_rel = heap_open(check->pk_relid, NoLock);
+			Relation fk_rel = heap_open(check->fk_relid, NoLock);
+			ri_ReportViolation(&check->qkey, NameStr(check->conname), pk_rel, fk_rel, check->new_row, NULL, false);
+		}
+	}
+	pfree(done);
+
+	MemoryContextReset(k2pg_fk_check_cxt);
+	k2pg_fk_checks = (K2PgPendingFKCheck *) MemoryContextAlloc(k2pg_fk_check_cxt,
+		sizeof(K2PgPendingFKCheck) * k2pg_fk_batch_size);
+	k2pg_fk_num_checks = 0;
+}
+
+/*
+ * Forget the queued K2PG foreign key checks of the aborted (sub)transaction, or
+ * all of them at the end of the top level transaction.
+ */
+void
+K2PgResetForeignKeyChecks(bool isTopLevel)
+{
+	if (k2pg_fk_check_cxt == NULL)
+		return;
+
+	if (isTopLevel)
+	{
+		MemoryContextDelete(k2pg_fk_check_cxt);
+		k2pg_fk_check_cxt = NULL;
+		k2pg_fk_checks = NULL;
+		k2pg_fk_num_checks = 0;
+		return;
+	}
+
+	int my_level = GetCurrentTransactionNestLevel();
+	int kept = 0;
+	for (int i = 0; i < k2pg_fk_num_checks; i++)
+	{
+		if (k2pg_fk_checks[i].nest_level < my_level)
+			k2pg_fk_checks[kept++] = k2pg_fk_checks[i];
+	}
+	k2pg_fk_num_checks = kept;
+}
+
 /*
  * Extract fields from a tuple into Datum/nulls arrays
  */
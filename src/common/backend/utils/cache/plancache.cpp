@@ -79,7 +79,9 @@
 #include "commands/sqladvisor.h"
 
 #ifdef ENABLE_MOT
+#include "foreign/foreign.h"
 #include "storage/mot/jit_exec.h"
+#include "storage/mot/mot_fdw.h"
 #endif
 
 #ifdef PGXC
@@ -116,6 +118,10 @@ static void GPCCheckStreamPlan(CachedPlanSource *plansource, List* plist);
 static bool check_stream_plan(Plan* plan);
 #endif
 static bool is_upsert_query_with_update_param(Node* raw_parse_tree);
+#ifdef ENABLE_MOT
+static bool HasMOTParallelScan(PlannedStmt* plannedstmt);
+static bool IsMOTParallelScanRestricted(CachedPlanSource* plansource);
+#endif
 static void GPCFillPlanCache(CachedPlanSource* plansource, bool isBuildingCustomPlan);
 
 bool IsStreamSupport()
@@ -293,6 +299,7 @@ CachedPlanSource* CreateCachedPlan(Node* raw_parse_tree, const char* query_strin
 #ifdef ENABLE_MOT
     plansource->storageEngineType = SE_TYPE_UNSPECIFIED;
     plansource->mot_jit_context = NULL;
+    plansource->mot_jit_tried = false;
 #endif
 
     if (enable_pbe_gpc) {
@@ -375,6 +382,7 @@ CachedPlanSource* CreateOneShotCachedPlan(Node* raw_parse_tree, const char* quer
 #ifdef ENABLE_MOT
     plansource->storageEngineType = SE_TYPE_UNSPECIFIED;
     plansource->mot_jit_context = NULL;
+    plansource->mot_jit_tried = false;
 #endif
 
 #ifdef PGXC
@@ -977,6 +985,7 @@ List* RevalidateCachedQuery(CachedPlanSource* plansource, bool has_lp)
         JitExec::DestroyJitContext(plansource->mot_jit_context);
         plansource->mot_jit_context = NULL;
     }
+    plansource->mot_jit_tried = false;
 #endif
 
     /*
@@ -995,6 +1004,52 @@ List* RevalidateCachedQuery(CachedPlanSource* plansource, bool has_lp)
     return tlist;
 }
 
+#ifdef ENABLE_MOT
+/*
+ * HasMOTParallelScan: does the plan run in SMP workers and read MOT tables?
+ *
+ * Such a plan may split an MOT scan among the workers, which is only correct
+ * while MOTIsParallelScanAllowed() holds, so it is kept out of the global
+ * plan cache where ChooseCustomPlan can't replace it.
+ */
+static bool HasMOTParallelScan(PlannedStmt* plannedstmt)
+{
+    ListCell* lc = NULL;
+
+    if (plannedstmt->num_streams <= 0)
+        return false;
+
+    foreach (lc, plannedstmt->rtable) {
+        RangeTblEntry* rte = (RangeTblEntry*)lfirst(lc);
+
+        if (rte->rtekind == RTE_RELATION && rte->relkind == RELKIND_FOREIGN_TABLE && isMOTFromTblOid(rte->relid))
+            return true;
+    }
+    return false;
+}
+
+/*
+ * IsMOTParallelScanRestricted: must this execution of the plansource be planned serially?
+ *
+ * SMP workers can't see the changes made so far by the transaction nor share
+ * its repeatable read snapshot. A generic plan built now would be serial for
+ * good, so a custom plan is used instead, which the planner keeps serial.
+ */
+static bool IsMOTParallelScanRestricted(CachedPlanSource* plansource)
+{
+    ListCell* lc = NULL;
+
+    if (!IsStreamSupport())
+        return false;
+
+    foreach (lc, plansource->relationOids) {
+        if (isMOTFromTblOid(lfirst_oid(lc)))
+            return !MOTIsParallelScanAllowed();
+    }
+    return false;
+}
+#endif
+
 /*
  * CheckCachedPlan: see if the CachedPlanSource's generic plan is valid.
  *
@@ -1281,6 +1336,9 @@ static CachedPlan* BuildCachedPlan(CachedPlanSource* plansource, List* qlist, Pa
      */
     plan->planRoleId = GetUserId();
     plan->dependsOnRole = plansource->dependsOnRole;
+#ifdef ENABLE_MOT
+    plan->mot_parallel_scan = false;
+#endif
 
     foreach (lc, plist) {
         PlannedStmt* plannedstmt = (PlannedStmt*)lfirst(lc);
@@ -1293,6 +1351,11 @@ static CachedPlan* BuildCachedPlan(CachedPlanSource* plansource, List* qlist, Pa
 
         if (plannedstmt->dependsOnRole)
             plan->dependsOnRole = true;
+
+#ifdef ENABLE_MOT
+        if (HasMOTParallelScan(plannedstmt))
+            plan->mot_parallel_scan = true;
+#endif
     }
 
     if (is_transient) {
@@ -1321,6 +1384,10 @@ static CachedPlan* BuildCachedPlan(CachedPlanSource* plansource, List* qlist, Pa
     if (ENABLE_GPC) {
 #ifdef ENABLE_MULTIPLE_NODES
         GPCCheckStreamPlan(plansource, plist);
+#endif
+#ifdef ENABLE_MOT
+        if (plan->mot_parallel_scan && plansource->gpc.status.IsSharePlan())
+            plansource->gpc.status.SetKind(GPC_UNSHARED);
 #endif
         GPCFillPlanCache(plansource, isBuildingCustomPlan);
     }
@@ -1484,6 +1551,7 @@ static void ReportReasonForPlanChoose(PlanChooseReason reason)
          "CPlan, reason: Upsert with update query can't choose gplan.",
 #ifdef ENABLE_MOT
          "GPlan, reason: Don't choose custom plan if using pbe optimization and MOT engine.",
+         "CPlan, reason: MOT tables can't be scanned in parallel in this transaction.",
 #endif
          "CPlan, reason: For PBE, such as col=$1+$2, generate cplan.",
          "CPlan, reason: One-shot plans will always be considered custom.",
@@ -1523,6 +1591,14 @@ static bool ChooseCustomPlan(CachedPlanSource* plansource, ParamListInfo boundPa
         return false;
     }
 
+#ifdef ENABLE_MOT
+    /* Keep the parallel generic plan for later transactions, plan this execution serially */
+    if (IsMOTParallelScanRestricted(plansource)) {
+        ReportReasonForPlanChoose(MOT_PARALLEL_SCAN_RESTRICTED);
+        return true;
+    }
+#endif
+
     /* upsert with update query can't choose gplan */
     if (is_upsert_query_with_update_param(plansource->raw_parse_tree)) {
         ReportReasonForPlanChoose(UPSERT_UPDATE_QUERY);
@@ -2155,6 +2231,7 @@ CachedPlanSource* CopyCachedPlan(CachedPlanSource* plansource, bool is_share)
 #ifdef ENABLE_MOT
     newsource->storageEngineType = SE_TYPE_UNSPECIFIED;
     newsource->mot_jit_context = NULL;
+    newsource->mot_jit_tried = false;
 #endif
 
 #ifdef PGXC
@@ -5180,6 +5180,14 @@ retry:
 	{
 		K2PgPreloadCatalogCaches();
 	}
+	else if (IsK2PgEnabled())
+	{
+		/*
+		 * Otherwise load the most used catalog caches from the local snapshot,
+		 * or build it if it is missing or stale.
+		 */
+		K2PgLoadCatalogCacheSnapshot(true /* build */);
+	}
 }
 
 /*
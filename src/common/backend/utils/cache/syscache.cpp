@@ -100,6 +100,8 @@
 #include "utils/rel_gs.h"
 #include "utils/syscache.h"
 #include "catalog/pg_user_status.h"
+#include "access/k2/k2pg_aux.h"
+#include "storage/fd.h"
 
 /* ---------------------------------------------------------------------------
 
@@ -1182,33 +1184,25 @@ void K2PgSetSysCacheTuple(Relation rel, HeapTuple tup)
 }
 
 /*
- * In K2PG mode preload the given cache with data from master.
+ * In K2PG mode load the given cache with all the tuples of its catalog.
  * If no index cache is associated with the given cache (most of the time), its id should be -1.
  */
-void
-K2PgPreloadCatalogCache(int cache_id, int idx_cache_id)
+static void
+K2PgFillCatalogCache(int cache_id, int idx_cache_id, TupleDesc tupdesc, List *tuples)
 {
-
 	CatCache* cache         = u_sess->syscache_cxt.SysCache[cache_id];
 	CatCache* idx_cache     = idx_cache_id != -1 ? u_sess->syscache_cxt.SysCache[idx_cache_id] : NULL;
 	List*     current_list  = NIL;
 	List*     list_of_lists = NIL;
 	HeapTuple ntp;
-	Relation  relation      = heap_open(cache->cc_reloid, AccessShareLock);
-	TupleDesc tupdesc       = RelationGetDescr(relation);
+	ListCell* tlc;
 
-	SysScanDesc scandesc = systable_beginscan(relation,
-	                                          cache->cc_indexoid,
-	                                          false /* indexOK */,
-	                                          NULL /* snapshot */,
-	                                          0  /* nkeys */,
-	                                          NULL /* key */);
-
-	while (HeapTupleIsValid(ntp = systable_getnext(scandesc)))
+	foreach (tlc, tuples)
 	{
-		SetCatCacheTuple(cache, ntp, RelationGetDescr(relation));
+		ntp = (HeapTuple) lfirst(tlc);
+		SetCatCacheTuple(cache, ntp, tupdesc);
 		if (idx_cache)
-			SetCatCacheTuple(idx_cache, ntp, RelationGetDescr(relation));
+			SetCatCacheTuple(idx_cache, ntp, tupdesc);
 
 		/*
 		 * Special handling for the common case of looking up
@@ -1321,10 +1315,6 @@ K2PgPreloadCatalogCache(int cache_id, int idx_cache_id)
 		list_of_lists = lappend(list_of_lists, current_list);
 	}
 
-	systable_endscan(scandesc);
-
-	heap_close(relation, AccessShareLock);
-
 	/* Load up the lists computed above - if any - into the catalog cache. */
 	ListCell *lc;
 	foreach (lc, list_of_lists)
@@ -1342,6 +1332,47 @@ K2PgPreloadCatalogCache(int cache_id, int idx_cache_id)
 	list_free_deep(list_of_lists);
 }
 
+/*
+ * Scan the whole catalog of the given cache in SKV and load it into the cache.
+ * Returns the scanned tuples.
+ */
+static List *
+K2PgScanCatalogCache(int cache_id, int idx_cache_id)
+{
+	CatCache* cache    = u_sess->syscache_cxt.SysCache[cache_id];
+	List*     tuples   = NIL;
+	HeapTuple ntp;
+	Relation  relation = heap_open(cache->cc_reloid, AccessShareLock);
+
+	SysScanDesc scandesc = systable_beginscan(relation,
+	                                          cache->cc_indexoid,
+	                                          false /* indexOK */,
+	                                          NULL /* snapshot */,
+	                                          0  /* nkeys */,
+	                                          NULL /* key */);
+
+	while (HeapTupleIsValid(ntp = systable_getnext(scandesc)))
+		tuples = lappend(tuples, heap_copytuple(ntp));
+
+	systable_endscan(scandesc);
+
+	K2PgFillCatalogCache(cache_id, idx_cache_id, RelationGetDescr(relation), tuples);
+
+	heap_close(relation, AccessShareLock);
+
+	return tuples;
+}
+
+/*
+ * In K2PG mode preload the given cache with data from master.
+ * If no index cache is associated with the given cache (most of the time), its id should be -1.
+ */
+void
+K2PgPreloadCatalogCache(int cache_id, int idx_cache_id)
+{
+	list_free_deep(K2PgScanCatalogCache(cache_id, idx_cache_id));
+}
+
 /*
  * In K2PG mode load up the caches with data from some essential tables
  * that are looked up often during regular usage.
@@ -1400,3 +1431,251 @@ K2PgPreloadCatalogCaches(void)
 	for (cacheId = 0; cacheId < SysCacheSize; cacheId++)
 		K2PgPreloadCatalogCacheIfEssential(cacheId);
 }
+
+/*
+ * K2PG catalog cache snapshot.
+ *
+ * The catalogs live in SKV, so every catcache miss of a new backend is a
+ * remote scan. The first backend that starts after a catalog change scans the
+ * catalogs of the caches below once and saves their tuples in a per-database
+ * file, together with the catalog version they were read at. Later backends
+ * load the caches from that file while the version is still current, and fall
+ * back to SKV for the entries of all other caches as usual.
+ */
+#define K2PG_CATCACHE_SNAPSHOT_FILENAME "pg_k2_catcache.init"
+#define K2PG_CATCACHE_SNAPSHOT_MAGIC 0x4b3201 /* version ID value */
+
+/* caches saved in the snapshot and their index cache, -1 if none */
+static const int K2PgSnapshotCaches[][2] = {
+	{RELOID, RELNAMENSP},
+	{TYPEOID, TYPENAMENSP},
+	{ATTNAME, ATTNUM},
+	{PROCOID, PROCNAMEARGSNSP},
+	{OPEROID, OPERNAMENSP},
+	{CASTSOURCETARGET, -1},
+};
+
+#define K2PG_NUM_SNAPSHOT_CACHES ((int) lengthof(K2PgSnapshotCaches))
+
+static void
+K2PgCatalogCacheSnapshotFileName(char *filename, size_t size, bool temp)
+{
+	errno_t rc;
+
+	if (temp)
+		rc = snprintf_s(filename, size, size - 1, "%u_%s.%lu", u_sess->proc_cxt.MyDatabaseId,
+		                K2PG_CATCACHE_SNAPSHOT_FILENAME, t_thrd.proc_cxt.MyProcPid);
+	else
+		rc = snprintf_s(filename, size, size - 1, "%u_%s", u_sess->proc_cxt.MyDatabaseId,
+		                K2PG_CATCACHE_SNAPSHOT_FILENAME);
+	securec_check_ss(rc, "\0", "\0");
+}
+
+/*
+ * Read the tuples of the snapshot caches from the snapshot file. Returns false,
+ * and removes the file if it is stale or broken, unless the file was written at
+ * the given catalog version.
+ */
+static bool
+K2PgReadCatalogCacheSnapshot(uint64_t version, List **tuples)
+{
+	char     filename[MAXPGPATH];
+	int      magic;
+	uint64_t stored_version;
+	int      num_caches;
+
+	K2PgCatalogCacheSnapshotFileName(filename, sizeof(filename), false);
+	FILE *fp = AllocateFile(filename, PG_BINARY_R);
+	if (fp == NULL)
+		return false;
+
+	if (fread(&magic, 1, sizeof(magic), fp) != sizeof(magic) || magic != K2PG_CATCACHE_SNAPSHOT_MAGIC)
+		goto read_failed;
+	if (fread(&stored_version, 1, sizeof(stored_version), fp) != sizeof(stored_version) ||
+		stored_version != version)
+		goto read_failed;
+	if (fread(&num_caches, 1, sizeof(num_caches), fp) != sizeof(num_caches) ||
+		num_caches != K2PG_NUM_SNAPSHOT_CACHES)
+		goto read_failed;
+
+	for (int i = 0; i < num_caches; i++)
+	{
+		int cache_id;
+		int num_tuples;
+
+		if (fread(&cache_id, 1, sizeof(cache_id), fp) != sizeof(cache_id) ||
+			cache_id != K2PgSnapshotCaches[i][0])
+			goto read_failed;
+		if (fread(&num_tuples, 1, sizeof(num_tuples), fp) != sizeof(num_tuples) || num_tuples < 0)
+			goto read_failed;
+
+		for (int j = 0; j < num_tuples; j++)
+		{
+			uint32 len;
+			uint32 ctid_len;
+			HeapTupleData hdr;
+
+			if (fread(&len, 1, sizeof(len), fp) != sizeof(len) ||
+				fread(&hdr.t_self, 1, sizeof(hdr.t_self), fp) != sizeof(hdr.t_self) ||
+				fread(&hdr.t_tableOid, 1, sizeof(hdr.t_tableOid), fp) != sizeof(hdr.t_tableOid) ||
+				fread(&ctid_len, 1, sizeof(ctid_len), fp) != sizeof(ctid_len))
+				goto read_failed;
+
+			HeapTuple tuple = (HeapTuple) palloc0(HEAPTUPLESIZE + len);
+			tuple->tupTableType = HEAP_TUPLE;
+			tuple->t_len = len;
+			tuple->t_self = hdr.t_self;
+			tuple->t_tableOid = hdr.t_tableOid;
+			tuple->t_data = (HeapTupleHeader) ((char *) tuple + HEAPTUPLESIZE);
+			if (fread(tuple->t_data, 1, len, fp) != len)
+				goto read_failed;
+
+			if (ctid_len > 0)
+			{
+				text *ctid = (text *) palloc(VARHDRSZ + ctid_len);
+				SET_VARSIZE(ctid, VARHDRSZ + ctid_len);
+				if (fread(VARDATA(ctid), 1, ctid_len, fp) != ctid_len)
+					goto read_failed;
+				tuple->t_k2pgctid = PointerGetDatum(ctid);
+			}
+
+			tuples[i] = lappend(tuples[i], tuple);
+		}
+	}
+
+	FreeFile(fp);
+	return true;
+
+read_failed:
+	FreeFile(fp);
+	if (unlink(filename) < 0 && errno != ENOENT)
+		ereport(LOG, (errmsg("could not remove cache file \"%s\": %m", filename)));
+	for (int i = 0; i < K2PG_NUM_SNAPSHOT_CACHES; i++)
+		tuples[i] = NIL;
+	return false;
+}
+
+/*
+ * Write the tuples of the snapshot caches, read at the given catalog version,
+ * to the snapshot file.
+ */
+static void
+K2PgWriteCatalogCacheSnapshot(uint64_t version, List **tuples)
+{
+	char tempfilename[MAXPGPATH];
+	char finalfilename[MAXPGPATH];
+	int  magic      = K2PG_CATCACHE_SNAPSHOT_MAGIC;
+	int  num_caches = K2PG_NUM_SNAPSHOT_CACHES;
+	bool ok;
+
+	K2PgCatalogCacheSnapshotFileName(tempfilename, sizeof(tempfilename), true);
+	K2PgCatalogCacheSnapshotFileName(finalfilename, sizeof(finalfilename), false);
+
+	unlink(tempfilename); /* in case it exists w/wrong permissions */
+	FILE *fp = AllocateFile(tempfilename, PG_BINARY_W);
+	if (fp == NULL)
+	{
+		ereport(WARNING,
+			(errcode_for_file_access(),
+				errmsg("could not create catalog cache snapshot file \"%s\": %m", tempfilename),
+				errdetail("Continuing anyway, but there's something wrong.")));
+		return;
+	}
+
+	ok = fwrite(&magic, 1, sizeof(magic), fp) == sizeof(magic) &&
+	     fwrite(&version, 1, sizeof(version), fp) == sizeof(version) &&
+	     fwrite(&num_caches, 1, sizeof(num_caches), fp) == sizeof(num_caches);
+
+	for (int i = 0; ok && i < num_caches; i++)
+	{
+		int       cache_id   = K2PgSnapshotCaches[i][0];
+		int       num_tuples = list_length(tuples[i]);
+		ListCell *lc;
+
+		ok = fwrite(&cache_id, 1, sizeof(cache_id), fp) == sizeof(cache_id) &&
+		     fwrite(&num_tuples, 1, sizeof(num_tuples), fp) == sizeof(num_tuples);
+
+		foreach (lc, tuples[i])
+		{
+			HeapTuple tuple    = (HeapTuple) lfirst(lc);
+			uint32    ctid_len = tuple->t_k2pgctid == 0 ? 0 : VARSIZE_ANY_EXHDR(DatumGetPointer(tuple->t_k2pgctid));
+
+			if (!ok)
+				break;
+			ok = fwrite(&tuple->t_len, 1, sizeof(tuple->t_len), fp) == sizeof(tuple->t_len) &&
+			     fwrite(&tuple->t_self, 1, sizeof(tuple->t_self), fp) == sizeof(tuple->t_self) &&
+			     fwrite(&tuple->t_tableOid, 1, sizeof(tuple->t_tableOid), fp) == sizeof(tuple->t_tableOid) &&
+			     fwrite(&ctid_len, 1, sizeof(ctid_len), fp) == sizeof(ctid_len) &&
+			     fwrite(tuple->t_data, 1, tuple->t_len, fp) == tuple->t_len &&
+			     (ctid_len == 0 ||
+			      fwrite(VARDATA_ANY(DatumGetPointer(tuple->t_k2pgctid)), 1, ctid_len, fp) == ctid_len);
+		}
+	}
+
+	if (FreeFile(fp) || !ok)
+	{
+		ereport(WARNING, (errmsg("could not write catalog cache snapshot file \"%s\"", tempfilename)));
+		unlink(tempfilename);
+		return;
+	}
+
+	/* Put the file in place atomically, a concurrent builder simply wins */
+	if (rename(tempfilename, finalfilename) < 0)
+	{
+		ereport(WARNING,
+			(errcode_for_file_access(),
+				errmsg("could not rename catalog cache snapshot file \"%s\" to \"%s\": %m",
+					tempfilename, finalfilename)));
+		unlink(tempfilename);
+	}
+}
+
+/*
+ * Load the snapshot caches from the catalog cache snapshot if it was written at
+ * the current catalog version. Otherwise, if build is true, preload them from
+ * SKV and write a new snapshot for the backends that start later.
+ */
+void
+K2PgLoadCatalogCacheSnapshot(bool build)
+{
+	uint64_t version = 0;
+	List    *tuples[K2PG_NUM_SNAPSHOT_CACHES];
+
+	if (!PgGate_UseCatalogCacheSnapshot())
+		return;
+
+	HandleK2PgStatus(PgGate_GetCatalogMasterVersion(&version));
+
+	MemoryContext snapshot_cxt = AllocSetContextCreate(CurrentMemoryContext,
+	                                                   "K2PgCatalogCacheSnapshot",
+	                                                   ALLOCSET_DEFAULT_MINSIZE,
+	                                                   ALLOCSET_DEFAULT_INITSIZE,
+	                                                   ALLOCSET_DEFAULT_MAXSIZE);
+	MemoryContext oldcxt = MemoryContextSwitchTo(snapshot_cxt);
+
+	for (int i = 0; i < K2PG_NUM_SNAPSHOT_CACHES; i++)
+		tuples[i] = NIL;
+
+	if (K2PgReadCatalogCacheSnapshot(version, tuples))
+	{
+		for (int i = 0; i < K2PG_NUM_SNAPSHOT_CACHES; i++)
+		{
+			CatCache *cache    = u_sess->syscache_cxt.SysCache[K2PgSnapshotCaches[i][0]];
+			Relation  relation = heap_open(cache->cc_reloid, AccessShareLock);
+
+			K2PgFillCatalogCache(K2PgSnapshotCaches[i][0], K2PgSnapshotCaches[i][1],
+			                     RelationGetDescr(relation), tuples[i]);
+			heap_close(relation, AccessShareLock);
+		}
+		elog(DEBUG1, "K2Pg loaded catalog cache snapshot of version %lu", version);
+	}
+	else if (build)
+	{
+		for (int i = 0; i < K2PG_NUM_SNAPSHOT_CACHES; i++)
+			tuples[i] = K2PgScanCatalogCache(K2PgSnapshotCaches[i][0], K2PgSnapshotCaches[i][1]);
+		K2PgWriteCatalogCacheSnapshot(version, tuples);
+	}
+
+	MemoryContextSwitchTo(oldcxt);
+	MemoryContextDelete(snapshot_cxt);
+}
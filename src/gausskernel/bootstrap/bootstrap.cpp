@@ -423,7 +423,8 @@ static void BootstrapModeMain(void)
         K2PgCreateDatabase(TemplateDbOid,
                           "template1",
                           InvalidOid,
-                          FirstBootstrapObjectId);
+                          FirstBootstrapObjectId,
+                          NULL);
 
         K2PgCommitTxn();
     }
@@ -29,6 +29,7 @@
 #include "access/tupdesc.h"
 #include "access/xlog.h"
 #include "bulkload/dist_fdw.h"
+#include "catalog/catalog.h"
 #include "catalog/heap.h"
 #include "catalog/pgxc_class.h"
 #include "bulkload/dist_fdw.h"
@@ -3154,7 +3155,7 @@ void CopyFromErrorCallback(void* arg)
                 cstate->cur_attname);
         } else {
             /* error is relevant to a particular line */
-            if (cstate->line_buf_converted || !cstate->need_transcoding) {
+            if (!cstate->line_buf_stale && (cstate->line_buf_converted || !cstate->need_transcoding)) {
                 char* lineval = NULL;
 
                 lineval = limit_printout_length(cstate->line_buf.data);
@@ -3167,7 +3168,8 @@ void CopyFromErrorCallback(void* arg)
                  * failure to do encoding conversion (ie, bad data).  We dare
                  * not try to convert it, and at present there's no way to
                  * regurgitate it without conversion.  So we have to punt and
-                 * just report the line number.
+                 * just report the line number. Same if line_buf holds a later
+                 * line than the failing one.
                  */
                 (void)errcontext("COPY %s, line %u", cstate->cur_relname, cstate->cur_lineno);
             }
@@ -3175,6 +3177,22 @@ void CopyFromErrorCallback(void* arg)
     }
 }
 
+/*
+ * A pipelined K2 write failed after COPY read further lines, point the error
+ * context at the line of the failing row.
+ */
+static void K2CopyBulkInsertErrorRow(void* arg, uint64 tag)
+{
+    CopyState cstate = (CopyState)arg;
+
+    if (cstate->cur_lineno != (uint32)tag) {
+        cstate->cur_lineno = (uint32)tag;
+        cstate->line_buf_stale = true;
+    }
+    cstate->cur_attname = NULL;
+    cstate->cur_attval = NULL;
+}
+
 void BulkloadErrorCallback(void* arg)
 {
     CopyState cstate = (CopyState)arg;
@@ -3791,6 +3809,7 @@ static uint64 CopyFrom(CopyState cstate)
 
     int2 bucketid = InvalidBktId;
     bool useHeapMultiInsert = false;
+    K2PgBulkInsertState* k2BulkState = NULL;
     bool isPartitionRel = false;
     bool resetPerTupCxt = false;
     Relation resultRelationDesc = NULL;
@@ -3943,6 +3962,16 @@ static uint64 CopyFrom(CopyState cstate)
         (resultRelInfo->ri_TrigDesc->trig_insert_before_row || resultRelInfo->ri_TrigDesc->trig_insert_instead_row)) ||
         cstate->volatile_defexprs) {
         useHeapMultiInsert = false;
+        /*
+         * K2 tables have no heap to buffer tuples for, but the same reasoning
+         * applies to pipelining their writes to the storage layer.
+         */
+        if (IsK2PgRelation(cstate->rel) && !IsCatalogRelation(cstate->rel) &&
+            !(resultRelInfo->ri_TrigDesc != NULL &&
+            (resultRelInfo->ri_TrigDesc->trig_insert_before_row || resultRelInfo->ri_TrigDesc->trig_insert_instead_row)) &&
+            !cstate->volatile_defexprs) {
+            k2BulkState = K2PgBeginBulkInsert(resultRelInfo, K2CopyBulkInsertErrorRow, cstate);
+        }
     } else {
         useHeapMultiInsert = true;
         mgr = initCopyFromManager(cstate->copycontext, resultRelationDesc);
@@ -4573,8 +4602,23 @@ static uint64 CopyFrom(CopyState cstate)
                 } else {
                     List* recheckIndexes = NIL;
                     /* OK, store the tuple and create index entries for it */
-					if (IsK2PgRelation(resultRelInfo->ri_RelationDesc)) {
-						K2PgExecuteInsert(cstate->rel, tupDesc, (HeapTuple)tuple);
+                    if (k2BulkState != NULL) {
+                        K2PgBulkInsertTuple(k2BulkState, slot, (HeapTuple)tuple, estate, cstate->cur_lineno);
+
+                        /* AFTER ROW INSERT Triggers, queued until the writes are flushed */
+                        ExecARInsertTriggers(estate, resultRelInfo, InvalidOid, InvalidBktId, (HeapTuple)tuple, NIL);
+                    } else if (IsK2PgRelation(resultRelInfo->ri_RelationDesc)) {
+                        K2PgExecuteInsert(cstate->rel, tupDesc, (HeapTuple)tuple);
+
+                        if (K2PgRelInfoHasSecondaryIndices(resultRelInfo))
+                            recheckIndexes = ExecInsertIndexTuples(slot,
+                                (ItemPointer)DatumGetPointer(((HeapTuple)tuple)->t_k2pgctid),
+                                estate, NULL, NULL, InvalidBktId, NULL, NULL);
+
+                        ExecARInsertTriggers(estate, resultRelInfo, InvalidOid, InvalidBktId, (HeapTuple)tuple,
+                            recheckIndexes);
+
+                        list_free(recheckIndexes);
                     } else {
                         Relation targetRel;
                         ItemPointer pTSelf = NULL;
@@ -4720,6 +4764,15 @@ static uint64 CopyFrom(CopyState cstate)
         }
     }
 
+    /*
+     * Wait for the K2 writes still in flight, AFTER triggers must see all rows.
+     * Still under the COPY error context, so that a failed write names its line.
+     */
+    if (k2BulkState != NULL) {
+        K2PgEndBulkInsert(k2BulkState);
+        k2BulkState = NULL;
+    }
+
     /* Done, clean up */
     t_thrd.log_cxt.error_context_stack = errcontext.previous;
 
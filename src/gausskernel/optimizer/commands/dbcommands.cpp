@@ -172,6 +172,10 @@ void createdb(const CreatedbStmt* stmt)
     DefElem* dctype = NULL;
     DefElem* dcompatibility = NULL;
     DefElem* dconnlimit = NULL;
+    DefElem* dk2partitioning = NULL;
+    DefElem* dk2rangeends = NULL;
+    DefElem* dk2minnodes = NULL;
+    K2PgCollectionOptions k2options;
     char* dbname = stmt->dbname;
     char* dbowner = NULL;
     const char* dbtemplate = NULL;
@@ -226,6 +230,18 @@ void createdb(const CreatedbStmt* stmt)
             if (dcompatibility != NULL)
                 ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("conflicting or redundant options")));
             dcompatibility = defel;
+        } else if (IsK2PgEnabled() && strcmp(defel->defname, "k2_partitioning") == 0) {
+            if (dk2partitioning != NULL)
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("conflicting or redundant options")));
+            dk2partitioning = defel;
+        } else if (IsK2PgEnabled() && strcmp(defel->defname, "k2_range_ends") == 0) {
+            if (dk2rangeends != NULL)
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("conflicting or redundant options")));
+            dk2rangeends = defel;
+        } else if (IsK2PgEnabled() && strcmp(defel->defname, "k2_min_nodes") == 0) {
+            if (dk2minnodes != NULL)
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("conflicting or redundant options")));
+            dk2minnodes = defel;
         } else if (strcmp(defel->defname, "location") == 0) {
             ereport(ERROR,
                 (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
@@ -280,6 +296,29 @@ void createdb(const CreatedbStmt* stmt)
                 ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("invalid connection limit: %d", dbconnlimit)));
     }
 
+    /* partitioning of the K2 collection of the database */
+    if (dk2partitioning != NULL) {
+        if (!IsA(dk2partitioning->arg, String) ||
+            (strcmp(strVal(dk2partitioning->arg), "hash") != 0 && strcmp(strVal(dk2partitioning->arg), "range") != 0))
+            ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("k2_partitioning must be \"hash\" or \"range\"")));
+        k2options.partitioning = strVal(dk2partitioning->arg);
+    }
+    if (dk2rangeends != NULL) {
+        if (!IsA(dk2rangeends->arg, String))
+            ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("k2_range_ends must be a string of comma separated keys")));
+        if (k2options.partitioning != NULL && strcmp(k2options.partitioning, "range") != 0)
+            ereport(ERROR,
+                (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("k2_range_ends requires k2_partitioning \"range\"")));
+        k2options.range_ends = strVal(dk2rangeends->arg);
+    }
+    if (dk2minnodes != NULL) {
+        if (!IsA(dk2minnodes->arg, Integer) || intVal(dk2minnodes->arg) < 1)
+            ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("k2_min_nodes must be a positive integer")));
+        k2options.min_nodes = intVal(dk2minnodes->arg);
+    }
+
     /* obtain OID of proposed owner */
     if (dbowner != NULL)
         datdba = get_role_oid(dbowner, false);
@@ -530,7 +569,7 @@ void createdb(const CreatedbStmt* stmt)
     new_record[Anum_pg_database_compatibility - 1] = DirectFunctionCall1(namein, CStringGetDatum(dbcompatibility));
 
 	if (IsK2PgEnabled())
-		K2PgCreateDatabase(dboid, dbname, src_dboid, InvalidOid);
+		K2PgCreateDatabase(dboid, dbname, src_dboid, InvalidOid, &k2options);
 
     /*
      * We deliberately set datacl to default (NULL), rather than copying it
@@ -16,6 +16,8 @@
 #include "knl/knl_variable.h"
 
 #include "access/tableam.h"
+#include "access/k2/k2catam.h"
+#include "access/k2/k2pg_aux.h"
 #include "access/xact.h"
 #include "catalog/indexing.h"
 #include "catalog/namespace.h"
@@ -166,6 +168,7 @@ static void show_tidbitmap_info(BitmapHeapScanState *planstate, ExplainState *es
 static void show_instrumentation_count(const char* qlabel, int which, const PlanState* planstate, ExplainState* es);
 static void show_removed_rows(int which, const PlanState* planstate, int idx, int smpIdx, int* removeRows);
 static void show_foreignscan_info(ForeignScanState* fsstate, ExplainState* es);
+static void show_k2_scan_info(PlanState* planstate, ExplainState* es);
 static void show_dfs_block_info(PlanState* planstate, ExplainState* es);
 static void show_detail_storage_info_text(Instrumentation* instr, StringInfo instr_info);
 static void show_detail_storage_info_json(Instrumentation* instr, StringInfo instr_info, ExplainState* es);
@@ -2383,6 +2386,7 @@ static void ExplainNode(
             show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
             if (plan->qual)
                 show_instrumentation_count("Rows Removed by Filter", 1, planstate, es);
+            show_k2_scan_info(planstate, es);
             break;
         case T_IndexOnlyScan:
             show_scan_qual(((IndexOnlyScan*)plan)->indexqual, "Index Cond", planstate, ancestors, es);
@@ -2394,6 +2398,7 @@ static void ExplainNode(
                 show_instrumentation_count("Rows Removed by Filter", 1, planstate, es);
             if (es->analyze)
                 ExplainPropertyLong("Heap Fetches", ((IndexOnlyScanState*)planstate)->ioss_HeapFetches, es);
+            show_k2_scan_info(planstate, es);
             break;
         case T_BitmapIndexScan:
             show_scan_qual(((BitmapIndexScan*)plan)->indexqualorig, "Index Cond", planstate, ancestors, es);
@@ -2532,6 +2537,8 @@ static void ExplainNode(
             if (plan->qual)
                 show_instrumentation_count("Rows Removed by Filter", 1, planstate, es);
             show_llvm_info(planstate, es);
+            if (IsA(plan, SeqScan))
+                show_k2_scan_info(planstate, es);
             break;
         case T_DfsScan: {
             show_scan_qual(plan->qual, "Filter", planstate, ancestors, es);
@@ -7233,6 +7240,61 @@ static void show_foreignscan_info(ForeignScanState* fsstate, ExplainState* es)
         fdwroutine->ExplainForeignScan(fsstate, es);
 }
 
+/*
+ * Show the remote work done by a scan of a K2 table or index.
+ */
+static void show_k2_scan_info(PlanState* planstate, ExplainState* es)
+{
+    if (!es->analyze || !IsK2PgEnabled())
+        return;
+
+    CamScanDesc camScan = NULL;
+    switch (nodeTag(planstate)) {
+        case T_SeqScanState: {
+            ScanState* ss = (ScanState*)planstate;
+            if (ss->ss_currentScanDesc != NULL && IsK2PgRelation(ss->ss_currentRelation))
+                camScan = ((HeapScanDesc)ss->ss_currentScanDesc)->k2scan;
+            break;
+        }
+        case T_IndexScanState: {
+            IndexScanState* iss = (IndexScanState*)planstate;
+            if (iss->iss_ScanDesc != NULL && IsK2PgRelation(iss->iss_RelationDesc))
+                camScan = (CamScanDesc)iss->iss_ScanDesc->opaque;
+            break;
+        }
+        case T_IndexOnlyScanState: {
+            IndexOnlyScanState* ioss = (IndexOnlyScanState*)planstate;
+            if (ioss->ioss_ScanDesc != NULL && IsK2PgRelation(ioss->ioss_RelationDesc))
+                camScan = (CamScanDesc)ioss->ioss_ScanDesc->opaque;
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (camScan == NULL)
+        return;
+
+    K2PgScanStats stats;
+    camGetScanStats(camScan, &stats);
+    ExplainK2ScanStats(&stats, es);
+}
+
+/*
+ * Print the counters of a K2 scan, also used by the K2 FDW.
+ */
+void ExplainK2ScanStats(const K2PgScanStats* stats, ExplainState* es)
+{
+    ExplainPropertyLong("K2 Queries Created", (long)stats->create_queries, es);
+    ExplainPropertyLong("K2 Query Pages", (long)stats->query_pages, es);
+    ExplainPropertyLong("K2 Point Reads", (long)stats->point_reads, es);
+    ExplainPropertyLong("K2 Records Received", (long)stats->records_received, es);
+    ExplainPropertyLong("K2 Records Returned", (long)stats->records_returned, es);
+    ExplainPropertyLong("K2 Records Passed Quals", (long)stats->records_passed, es);
+    ExplainPropertyLong("K2 Bytes Received", (long)stats->bytes_received, es);
+    ExplainPropertyFloat("K2 Wait Time", stats->wait_usecs / 1000.0, 3, es);
+}
+
 /*
  * @Description: check whether Instrumentation object has
  *               bloomfilter info to display about storage.
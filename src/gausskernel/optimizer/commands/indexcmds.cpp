@@ -824,7 +824,15 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
 				 errhint(" ")));
 
     accessMethodForm = (Form_pg_am)GETSTRUCT(tuple);
-    if (stmt->unique &&
+
+    /* MOT builds its own hash index for USING hash, which handles unique and multicolumn keys */
+    bool motHashIndex = false;
+#ifdef ENABLE_MOT
+    motHashIndex = (accessMethodId == HASH_AM_OID && rel->rd_rel->relkind == RELKIND_FOREIGN_TABLE &&
+                    isMOTFromTblOid(RelationGetRelid(rel)));
+#endif
+
+    if (stmt->unique && !motHashIndex &&
 #ifndef ENABLE_MULTIPLE_NODES
     !accessMethodForm->amcanunique)
 #else
@@ -834,7 +842,7 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support unique indexes", accessMethodName)));
 
-    if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol)
+    if (numberOfAttributes > 1 && !motHashIndex && !accessMethodForm->amcanmulticol)
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support multicolumn indexes", accessMethodName)));
@@ -229,6 +229,14 @@ void ExecuteQuery(ExecuteStmt* stmt, IntoClause* intoClause, const char* querySt
 
     OpFusion::clearForCplan((OpFusion*)psrc->opFusionObj, psrc);
 
+    /*
+     * Same as exec_bind_message: DDL on the target relation invalidates the
+     * plan, revalidating it drops the fusion built for the old definition.
+     */
+    if (psrc->opFusionObj != NULL) {
+        (void)RevalidateCachedQuery(psrc);
+    }
+
     if (psrc->opFusionObj != NULL) {
         OpFusion *opFusionObj = (OpFusion *)(psrc->opFusionObj);
         if (opFusionObj->IsGlobal()) {
@@ -427,6 +427,7 @@ typedef OldToNewChunkIdMappingData* OldToNewChunkIdMapping;
         (kind) == RELKIND_COMPOSITE_TYPE || (kind) == RELKIND_STREAM || (kind) == RELKIND_CONTQUERY)
 
 static bool CStoreSupportATCmd(AlterTableType cmdtype);
+static void CheckRowIdStrategyOption(CreateStmt* stmt);
 static bool CStoreSupportConstraint(Constraint* cons);
 static List* MergeAttributes(
     List* schema, List* supers, char relpersistence, List** supOids, List** supconstr, int* supOidCount);
@@ -1757,6 +1758,28 @@ static void DetermineColumnCollationForMOTTable(Oid *collOid)
 }
 #endif
 
+/*
+ * rowid_strategy only applies to K2PG tables without primary key, reject it
+ * for heap tables and K2PG tables with primary key instead of ignoring it.
+ */
+static void CheckRowIdStrategyOption(CreateStmt* stmt)
+{
+    ListCell* cell = NULL;
+
+    if (!IsK2PgEnabled() || stmt->relation->relpersistence == RELPERSISTENCE_TEMP) {
+        ForbidToSetRowIdStrategyOption(stmt->options, "heap relation");
+        return;
+    }
+
+    /* K2PG keeps the primary key in the constraints, see transformCreateStmt() */
+    foreach (cell, stmt->constraints) {
+        if (((Constraint*)lfirst(cell))->contype == CONSTR_PRIMARY) {
+            ForbidToSetRowIdStrategyOption(stmt->options, "relation with primary key");
+            return;
+        }
+    }
+}
+
 /* ----------------------------------------------------------------
  *		DefineRelation
  *				Creates a new relation.
@@ -2232,6 +2255,7 @@ Oid DefineRelation(CreateStmt* stmt, char relkind, Oid ownerId, bool isCTAS)
             if (relkind == RELKIND_RELATION) {
                 /* only care heap relation. ignore foreign table and index relation */
                 ForbidToSetOptionsForRowTbl(stmt->options);
+                CheckRowIdStrategyOption(stmt);
             }
         }
         pfree_ext(std_opt);
@@ -4008,6 +4032,16 @@ void ExecuteTruncate(TruncateStmt* stmt)
             continue;
         }
 
+        if (IsK2PgRelation(rel)) {
+            /*
+             * K2 rows are keyed by the table oid rather than by the relfilenode,
+             * so delete them, and those of the indexes, in place.
+             */
+            K2PgTruncateTable(rel);
+            pgstat_count_truncate(rel);
+            continue;
+        }
+
 #ifdef ENABLE_MOT
         if (RelationIsForeignTable(rel) && isMOTFromTblOid(RelationGetRelid(rel))) {
             FdwRoutine* fdwroutine = GetFdwRoutineByRelId(RelationGetRelid(rel));
@@ -11944,6 +11978,14 @@ static void validateForeignKeyConstraint(char* conname, Relation rel, Relation p
     }
 
     tableam_scan_end(scan);
+
+    /*
+     * RI_FKey_check_ins may have queued the references to a K2PG table instead
+     * of checking them. No trigger event is fired here to flush the batch, so
+     * verify it now, otherwise violating rows would be accepted.
+     */
+    if (IsK2PgEnabled())
+        K2PgFlushForeignKeyChecks();
 }
 
 static void CreateFKCheckTrigger(
@@ -14364,6 +14406,11 @@ static void ATExecSetRelOptions(Relation rel, List* defList, AlterTableType oper
                 if (algo == NULL || *algo == '\0') {
                     ForbidToSetTdeOptionsForNonTdeTbl(defList);
                 }
+                if (!IsK2PgRelation(rel)) {
+                    ForbidToSetRowIdStrategyOption(defList, "heap relation");
+                } else if (OidIsValid(RelationGetPrimaryKeyIndex(rel))) {
+                    ForbidToSetRowIdStrategyOption(defList, "relation with primary key");
+                }
             }
 
             /* validate the values of ttl and period for partition manager */
@@ -3973,6 +3973,10 @@ static bool afterTriggerInvokeEvents(AfterTriggerEventList* events, CommandId fi
         }
     }
 
+    /* Verify the references to K2PG tables queued by the RI triggers fired above */
+    if (IsK2PgEnabled())
+        K2PgFlushForeignKeyChecks();
+
     /* Release working resources */
     MemoryContextDelete(per_tuple_context);
 
@@ -4268,6 +4272,9 @@ void AfterTriggerFireDeferred(void)
  */
 void AfterTriggerEndXact(bool isCommit)
 {
+    if (IsK2PgEnabled())
+        K2PgResetForeignKeyChecks(true);
+
     /*
      * Forget everything we know about AFTER triggers.
      *
@@ -4387,6 +4394,10 @@ void AfterTriggerEndSubXact(bool isCommit)
     if (u_sess->tri_cxt.afterTriggers == NULL)
         return;
 
+    /* Forget the K2PG foreign key checks queued by the aborted subtransaction */
+    if (!isCommit && IsK2PgEnabled())
+        K2PgResetForeignKeyChecks(false);
+
     /*
      * Pop the prior state if needed.
      */
@@ -3804,9 +3804,14 @@ ForeignPath* create_foreignscan_path(PlannerInfo* root, RelOptInfo* rel, Cost st
          *				   foreign scan: obs table
          *			  It is comfortable to add smp foreign scan for this scenario.
          * HDFS Server: we don't add smp feature for this kind of server. No reason.
+         * MOT Server: the MOT FDW decides by itself whether a scan can be split, so take its dop
+         *			  for CMD_SELECT.
          * Others:	  Keep constant with the original logic.
          */
-        if (T_OBS_SERVER == serverType) {
+        if (isMOTFromTblOid(tblId)) {
+            if (CMD_SELECT == root->parse->commandType)
+                pathnode->path.dop = dop;
+        } else if (T_OBS_SERVER == serverType) {
             if ((CMD_SELECT == root->parse->commandType || CMD_INSERT == root->parse->commandType) &&
                 LOCATOR_TYPE_RROBIN == source->locator_type)
                 pathnode->path.dop = u_sess->opt_cxt.query_dop;
@@ -11610,6 +11610,8 @@ static void K2PgRefreshCache()
 	ResetCatalogCaches();
 	CallSystemCacheCallbacks();
 	K2PgPreloadRelCache();
+	/* Reuse the catalog cache snapshot if a new backend already wrote one */
+	K2PgLoadCatalogCacheSnapshot(false /* build */);
 
 	/* Also invalidate the pggate cache. */
 	PgGate_InvalidateCache();
@@ -1252,6 +1252,8 @@ static void knl_u_mot_init(knl_u_mot_context* mot_cxt)
     mot_cxt->jit_tvm_do_while_stack = NULL;
     mot_cxt->jit_context = NULL;
     mot_cxt->jit_txn = NULL;
+    mot_cxt->jit_exec_count = 0;
+    mot_cxt->jit_exec_spi_count = 0;
 }
 #endif
 
@@ -47,6 +47,7 @@
 #include "access/transam.h"
 #include "access/xact.h"
 #include "access/ustore/knl_uheap.h"
+#include "access/k2/k2pg_aux.h"
 #include "catalog/pg_statistic.h"
 #include "catalog/pg_statistic_ext.h"
 #include "catalog/namespace.h"
@@ -246,6 +247,14 @@ void standard_ExecutorStart(QueryDesc *queryDesc, int eflags)
         ExecCheckXactReadOnly(queryDesc->plannedstmt);
     }
 
+    /*
+     * Let K2 reject writes of a read-only transaction as well. Transactions that
+     * do not write, read-only or not, are ended without waiting on K2.
+     */
+    if (IsK2PgEnabled()) {
+        HandleK2PgStatus(PgGate_SetTransactionReadOnly(u_sess->attr.attr_common.XactReadOnly));
+    }
+
     /* reset the sequent number of memory context */
     t_thrd.utils_cxt.mctx_sequent_count = 0;
 
@@ -599,6 +599,18 @@ static Oid ExecUpsert(ModifyTableState* state, TupleTableSlot* slot, TupleTableS
     }
 
 
+	if (state->k2pg_upsert != NULL)
+	{
+		/* a single conditional write instead of checking the unique indexes first */
+		if (K2PgUpsertTuple(state->k2pg_upsert, slot, (HeapTuple)tuple, estate, canSetTag))
+			return HeapTupleGetOid((HeapTuple)tuple);
+
+		*returning = NULL;
+		InstrCountFiltered2(&state->ps, 1);
+		*updated = true;
+		return InvalidOid;
+	}
+
     vlock:
     specConflict = false;
     bool isgpi = false;
@@ -1224,7 +1236,9 @@ TupleTableSlot* ExecDelete(ItemPointer tupleid, Oid deletePartitionOid, int2 buc
 	}
     else if (IsK2PgRelation(result_relation_desc))
 	{
-		bool row_found = K2PgExecuteDelete(result_relation_desc, planSlot, estate, node);
+		bool row_found = node->k2pg_bulk_modify != NULL ?
+			K2PgBulkDeleteTuple(node->k2pg_bulk_modify, planSlot) :
+			K2PgExecuteDelete(result_relation_desc, planSlot, estate, node);
 		if (!row_found)
 		{
 			/*
@@ -1711,6 +1725,14 @@ TupleTableSlot* ExecUpdate(ItemPointer tupleid,
         /* FDW might have changed tuple */
         tuple = tableam_tslot_get_tuple_from_slot(result_relation_desc, slot);
     } else if (IsK2PgRelation(result_relation_desc)) {
+        /*
+         * Compute stored generated columns
+         */
+        if (result_relation_desc->rd_att->constr && result_relation_desc->rd_att->constr->has_generated_stored) {
+            ExecComputeStoredGenerated(result_rel_info, estate, slot, tuple, CMD_UPDATE);
+            tuple = slot->tts_tuple;
+        }
+
 		/*
 		 * Check the constraints of the tuple.
 		 */
@@ -1725,7 +1747,9 @@ TupleTableSlot* ExecUpdate(ItemPointer tupleid,
 		RangeTblEntry *rte = rt_fetch(result_rel_info->ri_RangeTableIndex,
 									  estate->es_range_table);
 
-		bool row_found = K2PgExecuteUpdate(result_relation_desc, planSlot, (HeapTuple)tuple, estate, node, rte->updatedCols);
+		bool row_found = node->k2pg_bulk_modify != NULL ?
+			K2PgBulkUpdateTuple(node->k2pg_bulk_modify, planSlot, (HeapTuple)tuple, rte->updatedCols) :
+			K2PgExecuteUpdate(result_relation_desc, planSlot, (HeapTuple)tuple, estate, node, rte->updatedCols);
 
 		if (!row_found)
 		{
@@ -3051,6 +3075,12 @@ TupleTableSlot* ExecModifyTable(ModifyTableState* node)
 
     list_free_ext(partition_list);
 
+    /* Wait for the pipelined K2 writes so that their errors are raised by this statement */
+    if (node->k2pg_bulk_modify != NULL) {
+        K2PgEndBulkModify(node->k2pg_bulk_modify);
+        node->k2pg_bulk_modify = NULL;
+    }
+
     /*
      * We're done, but fire AFTER STATEMENT triggers before exiting.
      */
@@ -3142,6 +3172,7 @@ ModifyTableState* ExecInitModifyTable(ModifyTable* node, EState* estate, int efl
     mt_state->mt_nplans = nplans;
     mt_state->limitExprContext = NULL;
 	mt_state->k2pg_mt_is_single_row_update_or_delete = K2PgIsSingleRowUpdateOrDelete(node);
+	mt_state->k2pg_bulk_modify = (eflags & EXEC_FLAG_EXPLAIN_ONLY) ? NULL : K2PgBeginBulkModify(mt_state, estate);
 
     upsertState = (UpsertState*)palloc0(sizeof(UpsertState));
     upsertState->us_action = node->upsertAction;
@@ -3378,6 +3409,7 @@ ModifyTableState* ExecInitModifyTable(ModifyTable* node, EState* estate, int efl
         ExecBuildProjectionInfo((List*)setexpr, econtext,
             upsertState->us_updateproj, result_rel_info->ri_RelationDesc->rd_att);
     }
+	mt_state->k2pg_upsert = (eflags & EXEC_FLAG_EXPLAIN_ONLY) ? NULL : K2PgBeginUpsert(mt_state, estate);
 
     /*
      * If we have any secondary relations in an UPDATE or DELETE, they need to
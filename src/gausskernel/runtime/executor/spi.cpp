@@ -45,6 +45,11 @@
 #include "utils/typcache.h"
 #include "utils/elog.h"
 #include "commands/sqladvisor.h"
+#ifdef ENABLE_MOT
+#include "nodes/nodeFuncs.h"
+#include "parser/analyze.h"
+#include "storage/mot/jit_exec.h"
+#endif
 
 THR_LOCAL uint32 SPI_processed = 0;
 THR_LOCAL SPITupleTable *SPI_tuptable = NULL;
@@ -73,6 +78,9 @@ void _SPI_error_callback(void *arg);
 static void _SPI_cursor_operation(Portal portal, FetchDirection direction, long count, DestReceiver *dest);
 
 static SPIPlanPtr _SPI_make_plan_non_temp(SPIPlanPtr plan);
+#ifdef ENABLE_MOT
+static void _SPI_try_mot_jit_codegen(CachedPlanSource *plansource);
+#endif
 static SPIPlanPtr _SPI_save_plan(SPIPlanPtr plan);
 
 static int _SPI_begin_call(bool execmem);
@@ -2333,6 +2341,13 @@ static int _SPI_execute_plan(SPIPlanPtr plan, ParamListInfo paramLI, Snapshot sn
          */
         cplan = GetCachedPlan(plansource, paramLI, plan->saved);
 
+#ifdef ENABLE_MOT
+        /* after GetCachedPlan, so that a revalidated query is compiled rather than the stale one */
+        if (plan->saved && !ENABLE_CN_GPC) {
+            _SPI_try_mot_jit_codegen(plansource);
+        }
+#endif
+
         /* use shared plan here, add refcount */
         if (cplan->isShared())
             (void)pg_atomic_fetch_add_u32((volatile uint32*)&cplan->global_refcount, 1);
@@ -2431,8 +2446,26 @@ static int _SPI_execute_plan(SPIPlanPtr plan, ParamListInfo paramLI, Snapshot sn
                     snap = InvalidSnapshot;
                 }
 
+#ifdef ENABLE_MOT
+                JitExec::JitContext *mot_jit_context = plansource->mot_jit_context;
+                if (mot_jit_context != NULL) {
+                    /* a previous execution limited by tcount may have left a range scan open */
+                    JitExec::JitResetScan(mot_jit_context);
+                }
+                if (mot_jit_context != NULL && paramLI != NULL && paramLI->paramFetch != NULL) {
+                    /* jitted code reads the parameter values directly, so fetch the lazily evaluated ones now */
+                    for (int i = 0; i < paramLI->numParams; i++) {
+                        if (!OidIsValid(paramLI->params[i].ptype)) {
+                            (*paramLI->paramFetch)(paramLI, i + 1);
+                        }
+                    }
+                }
+                qdesc = CreateQueryDesc((PlannedStmt *)stmt, plansource->query_string, snap, crosscheck_snapshot, dest,
+                    paramLI, 0, mot_jit_context);
+#else
                 qdesc = CreateQueryDesc((PlannedStmt *)stmt, plansource->query_string, snap, crosscheck_snapshot, dest,
                     paramLI, 0);
+#endif
                 res = _SPI_pquery(qdesc, fire_triggers, canSetTag ? tcount : 0, from_lock);
                 FreeQueryDesc(qdesc);
             } else {
@@ -3031,6 +3064,80 @@ static SPIPlanPtr _SPI_make_plan_non_temp(SPIPlanPtr plan)
     return newplan;
 }
 
+#ifdef ENABLE_MOT
+static bool _SPI_mot_jit_param_walker(Node *node, StringInfo key)
+{
+    if (node == NULL) {
+        return false;
+    }
+    if (IsA(node, Param)) {
+        Param *param = (Param *)node;
+        appendStringInfo(key, " $%d:%u", param->paramid, param->paramtype);
+        return false;
+    }
+    if (IsA(node, Query)) {
+        return query_tree_walker((Query *)node, (bool (*)())_SPI_mot_jit_param_walker, (void *)key, 0);
+    }
+    return expression_tree_walker(node, (bool (*)())_SPI_mot_jit_param_walker, (void *)key);
+}
+
+/*
+ * Per-statement JIT for SPI plans: generate MOT jitted code for a saved plan of a
+ * single MOT query, as is done for prepared statements, so that such a statement of a
+ * stored procedure skips the executor. Unsupported statements simply keep running
+ * through the executor. The procedure itself (control flow, variables, exception
+ * blocks) is still interpreted by PL/pgSQL; whole-procedure codegen is separate work.
+ *
+ * The JIT source cache is keyed by query text, but the same text in different
+ * procedures may bind different procedure variables, so the key is qualified with
+ * the parameters referenced by the query.
+ */
+static void _SPI_try_mot_jit_codegen(CachedPlanSource *plansource)
+{
+    if (IS_PGXC_COORDINATOR || !JitExec::IsMotCodegenEnabled() || plansource->mot_jit_context != NULL ||
+        plansource->mot_jit_tried) {
+        return;
+    }
+
+    /* remember the outcome, failures included, until the plan source is invalidated */
+    plansource->mot_jit_tried = true;
+    if (list_length(plansource->query_list) != 1) {
+        return;
+    }
+
+    /* sub-queries are resolved by the text of the prepared statement, which is not available here */
+    Query *query = (Query *)linitial(plansource->query_list);
+    if (query->commandType == CMD_UTILITY || query->hasSubLinks) {
+        return;
+    }
+
+    StorageEngineType storageEngineType = SE_TYPE_UNSPECIFIED;
+    CheckTablesStorageEngine(query, &storageEngineType);
+    if (storageEngineType != SE_TYPE_MOT) {
+        return;
+    }
+
+    StringInfoData key;
+    initStringInfo(&key);
+    appendStringInfo(&key, "%s /* spi:", plansource->query_string);
+    (void)query_tree_walker(query, (bool (*)())_SPI_mot_jit_param_walker, (void *)&key, 0);
+    appendStringInfoString(&key, " */");
+
+    if (JitExec::IsMotCodegenPrintEnabled()) {
+        elog(LOG, "Attempting to generate MOT jitted code for SPI query: %s\n", key.data);
+    }
+
+    JitExec::JitPlan *jitPlan = JitExec::IsJittable(query, key.data);
+    if (jitPlan != NULL) {
+        plansource->mot_jit_context = JitExec::JitCodegenQuery(query, key.data, jitPlan);
+        if ((plansource->mot_jit_context == NULL) && JitExec::IsMotCodegenPrintEnabled()) {
+            elog(LOG, "Failed to generate jitted MOT function for SPI query %s\n", key.data);
+        }
+    }
+    pfree(key.data);
+}
+#endif
+
 void CopySPI_Plan(SPIPlanPtr newplan, SPIPlanPtr plan, MemoryContext plancxt)
 {
     newplan->magic = _SPI_PLAN_MAGIC;
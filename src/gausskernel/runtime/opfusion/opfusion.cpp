@@ -40,6 +40,7 @@
 #include "opfusion/opfusion_agg.h"
 #include "opfusion/opfusion_delete.h"
 #include "opfusion/opfusion_insert.h"
+#include "opfusion/opfusion_k2.h"
 #include "opfusion/opfusion_select.h"
 #include "opfusion/opfusion_selectforupdate.h"
 #include "opfusion/opfusion_sort.h"
@@ -245,6 +246,12 @@ FusionType OpFusion::getFusionType(CachedPlan *plan, ParamListInfo params, List
             return NOBYPASS_NO_SIMPLE_PLAN;
         }
 
+        /* single row statements on K2 tables go through the K2 point fusions, others fall through */
+        result = getK2FusionType(planned_stmt, params);
+        if (result != NONE_FUSION) {
+            return result;
+        }
+
         if (((PlannedStmt *)st)->commandType == CMD_SELECT) {
             result = getSelectFusionType(plist, params);
         } else if (planned_stmt->commandType == CMD_INSERT) {
@@ -587,6 +594,12 @@ void *OpFusion::FusionFactory(FusionType ftype, MemoryContext context, CachedPla
             opfusionObj = New(objCxt)MotJitModifyFusion(context, psrc, plantree_list, params);
             break;
 #endif
+        case K2_POINT_SELECT_FUSION:
+            opfusionObj = New(objCxt)K2PointSelectFusion(context, psrc, plantree_list, params);
+            break;
+        case K2_POINT_MODIFY_FUSION:
+            opfusionObj = New(objCxt)K2PointModifyFusion(context, psrc, plantree_list, params);
+            break;
         case AGG_INDEX_FUSION:
             opfusionObj = New(objCxt)AggFusion(context, psrc, plantree_list, params);
             break;
@@ -0,0 +1,586 @@
+/*
+ * Copyright (c) 2022 Futurewei Cloud
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * opfusion_k2.cpp
+ *        Definition of K2 primary key point select and modify operators for bypass executor.
+ *
+ * A statement qualifies when it touches exactly one row of a K2 table addressed by an equality
+ * on every primary key column. The key and assigned values are evaluated from the bound
+ * parameters and sent as a single SKV read or write through a pggate point op, which caches
+ * the SKV schema and field layout of the table for the life of the prepared statement.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/runtime/opfusion/opfusion_k2.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#include "opfusion/opfusion_k2.h"
+
+#include "access/genam.h"
+#include "access/skey.h"
+#include "access/k2/k2_table_ops.h"
+#include "access/k2/k2pg_aux.h"
+#include "catalog/catalog.h"
+#include "nodes/nodeFuncs.h"
+#include "optimizer/var.h"
+#include "parser/parse_coerce.h"
+#include "parser/parsetree.h"
+#include "storage/lmgr.h"
+#include "utils/lsyscache.h"
+
+/* the fields of IndexScan and IndexOnlyScan used by the K2 point fusions */
+static bool GetK2IndexScanInfo(Plan* plan, Scan** scan, Oid* indexid, List** indexqual, List** indexorderby)
+{
+    if (IsA(plan, IndexScan)) {
+        IndexScan* node = (IndexScan*)plan;
+        *scan = &node->scan;
+        *indexid = node->indexid;
+        *indexqual = node->indexqual;
+        *indexorderby = node->indexorderby;
+    } else if (IsA(plan, IndexOnlyScan)) {
+        IndexOnlyScan* node = (IndexOnlyScan*)plan;
+        *scan = &node->scan;
+        *indexid = node->indexid;
+        *indexqual = node->indexqual;
+        *indexorderby = node->indexorderby;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static inline Expr* StripRelabelType(Expr* expr)
+{
+    while (IsA(expr, RelabelType)) {
+        expr = ((RelabelType*)expr)->arg;
+    }
+    return expr;
+}
+
+static bool CheckK2PointRelation(Relation rel, PlannedStmt* plannedStmt)
+{
+    if (!IsK2PgRelation(rel) || IsSystemRelation(rel) || rel->rd_rel->relkind != RELKIND_RELATION ||
+        rel->rd_rel->relhasrules || rel->rd_rel->relhastriggers || rel->rd_rel->relhasoids ||
+        rel->rd_rel->relhassubclass || RELATION_IS_PARTITIONED(rel) || plannedStmt->hasReturning) {
+        return false;
+    }
+
+    /* secondary indexes must be maintained by the executor, and tables without primary key use a generated rowid */
+    return OidIsValid(RelationGetPrimaryKeyIndex(rel)) && !K2PgRelHasSecondaryIndices(rel);
+}
+
+/*
+ * Check that the plan is a scan of the primary key index of rel with one equality per key column,
+ * each compared to a Const or an external Param of the column type, and nothing else to evaluate.
+ */
+static bool CheckK2PrimaryKeyScan(Plan* plan, Relation rel)
+{
+    Scan* scan = NULL;
+    Oid indexid = InvalidOid;
+    List* indexqual = NIL;
+    List* indexorderby = NIL;
+    if (!GetK2IndexScanInfo(plan, &scan, &indexid, &indexqual, &indexorderby)) {
+        return false;
+    }
+    if (indexid != RelationGetPrimaryKeyIndex(rel) || indexorderby != NIL || plan->qual != NIL ||
+        scan->isPartTbl || plan->lefttree != NULL || plan->righttree != NULL) {
+        return false;
+    }
+
+    Relation index = index_open(indexid, AccessShareLock);
+    int nkeys = IndexRelationGetNumberOfKeyAttributes(index);
+    Bitmapset* covered = NULL;
+    bool result = (list_length(indexqual) == nkeys);
+    ListCell* lc = NULL;
+    foreach (lc, indexqual) {
+        if (!result) {
+            break;
+        }
+        result = false;
+
+        OpExpr* opexpr = (OpExpr*)lfirst(lc);
+        if (!IsA(opexpr, OpExpr) || list_length(opexpr->args) != 2) {
+            break;
+        }
+        Expr* leftop = StripRelabelType((Expr*)linitial(opexpr->args));
+        Expr* rightop = (Expr*)lsecond(opexpr->args);
+        if (!IsA(leftop, Var) || ((Var*)leftop)->varno != INDEX_VAR) {
+            break;
+        }
+        AttrNumber indexcol = ((Var*)leftop)->varattno;
+        if (indexcol < 1 || indexcol > nkeys || bms_is_member(indexcol, covered)) {
+            break;
+        }
+
+        int strategy = 0;
+        Oid lefttype = InvalidOid;
+        Oid righttype = InvalidOid;
+        get_op_opfamily_properties(opexpr->opno, index->rd_opfamily[indexcol - 1], false,
+                                   &strategy, &lefttype, &righttype);
+        if (strategy != BTEqualStrategyNumber || lefttype != righttype) {
+            break;
+        }
+
+        /* the value is sent as is, so it must already be of the column type */
+        AttrNumber attnum = index->rd_index->indkey.values[indexcol - 1];
+        if (attnum <= 0 ||
+            !IsBinaryCoercible(exprType((Node*)rightop), TupleDescAttr(RelationGetDescr(rel), attnum - 1)->atttypid)) {
+            break;
+        }
+        Expr* arg = StripRelabelType(rightop);
+        if (!IsA(arg, Const) && !(IsA(arg, Param) && ((Param*)arg)->paramkind == PARAM_EXTERN)) {
+            break;
+        }
+
+        covered = bms_add_member(covered, indexcol);
+        result = true;
+    }
+    bms_free(covered);
+    index_close(index, AccessShareLock);
+
+    return result;
+}
+
+static bool CheckK2SelectTargetlist(List* targetlist)
+{
+    ListCell* lc = NULL;
+    foreach (lc, targetlist) {
+        TargetEntry* res = (TargetEntry*)lfirst(lc);
+        if (res->resjunk) {
+            continue;
+        }
+        Var* var = (Var*)res->expr;
+        if (!IsA(var, Var)) {
+            return false;
+        }
+        AttrNumber attnum = (var->varno == INDEX_VAR) ? var->varoattno : var->varattno;
+        if (attnum <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* an UPDATE target entry that assigns a column its current value */
+static inline bool IsK2UnchangedColumn(TargetEntry* res)
+{
+    return IsA(res->expr, Var) && ((Var*)res->expr)->varattno == res->resno;
+}
+
+/* assigned values must not depend on the current row, which is never read, and keys cannot change */
+static bool CheckK2UpdateTargetlist(List* targetlist, Relation rel)
+{
+    FusionType ftype = K2_POINT_MODIFY_FUSION;
+    checkTargetlist(targetlist, &ftype);
+    if (ftype != K2_POINT_MODIFY_FUSION) {
+        return false;
+    }
+
+    AttrNumber minattr = FirstLowInvalidHeapAttributeNumber + 1;
+    Bitmapset* pkey = GetK2PgTablePrimaryKey(rel);
+    bool result = true;
+    ListCell* lc = NULL;
+    foreach (lc, targetlist) {
+        TargetEntry* res = (TargetEntry*)lfirst(lc);
+        if (res->resjunk || IsK2UnchangedColumn(res)) {
+            continue;
+        }
+        if (contain_var_clause((Node*)res->expr) || bms_is_member(res->resno - minattr, pkey)) {
+            result = false;
+            break;
+        }
+    }
+    bms_free(pkey);
+
+    return result;
+}
+
+static bool CheckK2InsertTargetlist(List* targetlist)
+{
+    FusionType ftype = K2_POINT_MODIFY_FUSION;
+    checkTargetlist(targetlist, &ftype);
+    return ftype == K2_POINT_MODIFY_FUSION && !contain_var_clause((Node*)targetlist);
+}
+
+static bool CheckK2PointPlan(PlannedStmt* plannedStmt, Relation rel)
+{
+    Plan* top_plan = plannedStmt->planTree;
+    if (plannedStmt->commandType == CMD_SELECT) {
+        return CheckK2SelectTargetlist(top_plan->targetlist) && CheckK2PrimaryKeyScan(top_plan, rel);
+    }
+
+    ModifyTable* node = (ModifyTable*)top_plan;
+    Plan* subplan = (Plan*)linitial(node->plans);
+    TupleConstr* constr = RelationGetDescr(rel)->constr;
+    bool hasComputedChecks = (constr != NULL && (constr->num_check > 0 || constr->has_generated_stored));
+    switch (node->operation) {
+        case CMD_DELETE:
+            return CheckK2PrimaryKeyScan(subplan, rel);
+        case CMD_UPDATE:
+            return !hasComputedChecks && CheckK2PrimaryKeyScan(subplan, rel) &&
+                   CheckK2UpdateTargetlist(subplan->targetlist, rel);
+        case CMD_INSERT:
+            return !hasComputedChecks && IsA(subplan, BaseResult) && subplan->lefttree == NULL &&
+                   subplan->initPlan == NIL && ((BaseResult*)subplan)->resconstantqual == NULL &&
+                   CheckK2InsertTargetlist(subplan->targetlist);
+        default:
+            return false;
+    }
+}
+
+FusionType getK2FusionType(PlannedStmt* plannedStmt, ParamListInfo params)
+{
+    if (!IsK2PgEnabled() || plannedStmt->rowMarks != NIL) {
+        return NONE_FUSION;
+    }
+
+    FusionType ftype = NONE_FUSION;
+    Oid relid = InvalidOid;
+    Plan* top_plan = plannedStmt->planTree;
+    switch (plannedStmt->commandType) {
+        case CMD_SELECT: {
+            if (!IsA(top_plan, IndexScan) && !IsA(top_plan, IndexOnlyScan)) {
+                return NONE_FUSION;
+            }
+            relid = getrelid(((Scan*)top_plan)->scanrelid, plannedStmt->rtable);
+            ftype = K2_POINT_SELECT_FUSION;
+            break;
+        }
+        case CMD_INSERT:
+        case CMD_UPDATE:
+        case CMD_DELETE: {
+            if (!IsA(top_plan, ModifyTable) || list_length(plannedStmt->resultRelations) != 1) {
+                return NONE_FUSION;
+            }
+            ModifyTable* node = (ModifyTable*)top_plan;
+            if (list_length(node->plans) != 1 || node->operation != plannedStmt->commandType ||
+                node->upsertAction != UPSERT_NONE) {
+                return NONE_FUSION;
+            }
+            relid = getrelid(linitial_int(plannedStmt->resultRelations), plannedStmt->rtable);
+            ftype = K2_POINT_MODIFY_FUSION;
+            break;
+        }
+        default:
+            return NONE_FUSION;
+    }
+
+    Relation rel = heap_open(relid, AccessShareLock);
+    bool supported = CheckK2PointRelation(rel, plannedStmt) && CheckK2PointPlan(plannedStmt, rel);
+    heap_close(rel, AccessShareLock);
+
+    return supported ? ftype : NONE_FUSION;
+}
+
+K2PointFusion::K2PointFusion(MemoryContext context, CachedPlanSource* psrc, List* plantree_list)
+    : OpFusion(context, psrc, plantree_list)
+{
+    m_c_global = NULL;
+    m_c_local.m_op = NULL;
+}
+
+void K2PointFusion::InitBoundColumn(K2BoundColumn* column, TupleDesc desc, AttrNumber attnum, Expr* expr)
+{
+    Form_pg_attribute attr = TupleDescAttr(desc, attnum - 1);
+    column->attnum = attnum;
+    column->atttypid = attr->atttypid;
+    column->attlen = attr->attlen;
+    column->attbyval = attr->attbyval;
+    column->attnotnull = attr->attnotnull;
+    column->attname = attr->attname;
+    column->expr = expr;
+}
+
+void K2PointFusion::InitK2Globals(Relation rel, K2PgPointOpType opType)
+{
+    m_c_global = (K2PointFusionGlobalVariable*)palloc0(sizeof(K2PointFusionGlobalVariable));
+    m_c_global->m_opType = opType;
+    m_c_global->m_dboid = K2PgGetDatabaseOid(rel);
+    m_global->m_natts = RelationGetNumberOfAttributes(rel);
+    m_global->m_paramNum = 0;
+}
+
+/* fill the primary key columns from the equality quals of the index scan */
+void K2PointFusion::InitK2Keys(Plan* plan, Relation rel)
+{
+    Scan* scan = NULL;
+    Oid indexid = InvalidOid;
+    List* indexqual = NIL;
+    List* indexorderby = NIL;
+    (void)GetK2IndexScanInfo(plan, &scan, &indexid, &indexqual, &indexorderby);
+
+    Relation index = index_open(indexid, AccessShareLock);
+    m_c_global->m_keyNum = list_length(indexqual);
+    m_c_global->m_keys = (K2BoundColumn*)palloc0(m_c_global->m_keyNum * sizeof(K2BoundColumn));
+    int i = 0;
+    ListCell* lc = NULL;
+    foreach (lc, indexqual) {
+        OpExpr* opexpr = (OpExpr*)lfirst(lc);
+        Var* var = (Var*)StripRelabelType((Expr*)linitial(opexpr->args));
+        AttrNumber attnum = index->rd_index->indkey.values[var->varattno - 1];
+        InitBoundColumn(&m_c_global->m_keys[i++], RelationGetDescr(rel), attnum, (Expr*)lsecond(opexpr->args));
+    }
+    index_close(index, AccessShareLock);
+}
+
+/*
+ * Evaluate the column expressions into K2 attributes. Returns false if a key is null, which
+ * matches no row.
+ */
+bool K2PointFusion::BindColumns(const K2BoundColumn* columns, int num, bool isKey,
+                                std::vector<K2PgAttributeDef>& attrs)
+{
+    for (int i = 0; i < num; i++) {
+        const K2BoundColumn* column = &columns[i];
+        bool isnull = false;
+        Datum value = 0;
+        if (IsA(column->expr, FuncExpr)) {
+            value = CalFuncNodeVal(((FuncExpr*)column->expr)->funcid, ((FuncExpr*)column->expr)->args,
+                                   &isnull, NULL, NULL);
+        } else if (IsA(column->expr, OpExpr)) {
+            value = CalFuncNodeVal(((OpExpr*)column->expr)->opfuncid, ((OpExpr*)column->expr)->args,
+                                   &isnull, NULL, NULL);
+        } else {
+            value = EvalSimpleArg((Node*)column->expr, &isnull, NULL, NULL);
+        }
+
+        if (isnull) {
+            if (isKey) {
+                return false;
+            }
+            if (column->attnotnull) {
+                ereport(ERROR,
+                        (errcode(ERRCODE_NOT_NULL_VIOLATION),
+                         errmsg("null value in column \"%s\" violates not-null constraint",
+                                NameStr(column->attname))));
+            }
+        }
+
+        K2PgAttributeDef attr;
+        attr.attr_num = column->attnum;
+        attr.value.type_id = column->atttypid;
+        attr.value.attr_size = column->attlen;
+        attr.value.attr_byvalue = column->attbyval;
+        attr.value.datum = isnull ? 0 : value;
+        attr.value.is_null = isnull;
+        attrs.push_back(attr);
+    }
+    return true;
+}
+
+K2PgPointOp* K2PointFusion::GetPointOp()
+{
+    if (m_c_local.m_op == NULL) {
+        /* the op caches the K2 schema, keep it with the other per session state of this statement */
+        MemoryContext old_context = MemoryContextSwitchTo(m_local.m_localContext);
+        HandleK2PgStatus(PgGate_NewPointOp(m_c_global->m_dboid, m_global->m_reloid, m_c_global->m_opType,
+                                           &m_c_local.m_op));
+        MemoryContextSwitchTo(old_context);
+    }
+    return m_c_local.m_op;
+}
+
+K2PointSelectFusion::K2PointSelectFusion(
+    MemoryContext context, CachedPlanSource* psrc, List* plantree_list, ParamListInfo params)
+    : K2PointFusion(context, psrc, plantree_list)
+{
+    MemoryContext old_context = NULL;
+    if (!IsGlobal()) {
+        old_context = MemoryContextSwitchTo(m_global->m_context);
+        InitGlobals();
+        MemoryContextSwitchTo(old_context);
+    } else {
+        m_c_global = ((K2PointSelectFusion*)(psrc->opFusionObj))->m_c_global;
+    }
+    old_context = MemoryContextSwitchTo(m_local.m_localContext);
+    InitLocals(params);
+    MemoryContextSwitchTo(old_context);
+}
+
+void K2PointSelectFusion::InitGlobals()
+{
+    Plan* plan = m_global->m_planstmt->planTree;
+    m_global->m_reloid = getrelid(((Scan*)plan)->scanrelid, m_global->m_planstmt->rtable);
+    m_global->m_tupDesc = ExecCleanTypeFromTL(plan->targetlist, false);
+    m_global->m_attrno = (int16*)palloc(m_global->m_tupDesc->natts * sizeof(int16));
+    int i = 0;
+    ListCell* lc = NULL;
+    foreach (lc, plan->targetlist) {
+        TargetEntry* res = (TargetEntry*)lfirst(lc);
+        if (res->resjunk) {
+            continue;
+        }
+        Var* var = (Var*)res->expr;
+        m_global->m_attrno[i++] = (var->varno == INDEX_VAR) ? var->varoattno : var->varattno;
+    }
+
+    Relation rel = heap_open(m_global->m_reloid, AccessShareLock);
+    InitK2Globals(rel, K2PG_POINT_READ);
+    InitK2Keys(plan, rel);
+    heap_close(rel, AccessShareLock);
+}
+
+void K2PointSelectFusion::InitLocals(ParamListInfo params)
+{
+    initParams(params);
+    m_local.m_receiver = NULL;
+    m_local.m_isInsideRec = true;
+    m_local.m_reslot = MakeSingleTupleTableSlot(m_global->m_tupDesc);
+    m_local.m_values = (Datum*)palloc0(m_global->m_natts * sizeof(Datum));
+    m_local.m_isnull = (bool*)palloc0(m_global->m_natts * sizeof(bool));
+}
+
+bool K2PointSelectFusion::execute(long max_rows, char* completionTag)
+{
+    MemoryContext old_context = MemoryContextSwitchTo(m_local.m_tmpContext);
+    /* the op caches the table layout, hold off concurrent DDL as a regular scan would */
+    LockRelationOid(m_global->m_reloid, AccessShareLock);
+    setReceiver();
+
+    unsigned long nprocessed = 0;
+    std::vector<K2PgAttributeDef> keys;
+    if (max_rows != 0 && BindColumns(m_c_global->m_keys, m_c_global->m_keyNum, true, keys)) {
+        bool has_data = false;
+        HandleK2PgStatus(PgGate_ExecPointRead(GetPointOp(), keys, m_global->m_natts, (uint64_t*)m_local.m_values,
+                                              m_local.m_isnull, &has_data));
+        if (has_data) {
+            TupleTableSlot* slot = m_local.m_reslot;
+            for (int i = 0; i < m_global->m_tupDesc->natts; i++) {
+                slot->tts_values[i] = m_local.m_values[m_global->m_attrno[i] - 1];
+                slot->tts_isnull[i] = m_local.m_isnull[m_global->m_attrno[i] - 1];
+            }
+            (void)ExecStoreVirtualTuple(slot);
+            (*m_local.m_receiver->receiveSlot)(slot, m_local.m_receiver);
+            (void)ExecClearTuple(slot);
+            nprocessed++;
+        }
+    }
+
+    if (m_local.m_isInsideRec) {
+        (*m_local.m_receiver->rDestroy)(m_local.m_receiver);
+    }
+
+    m_local.m_position = 0;
+    m_local.m_isCompleted = true;
+
+    errno_t errorno = snprintf_s(completionTag, COMPLETION_TAG_BUFSIZE, COMPLETION_TAG_BUFSIZE - 1,
+                                 "SELECT %lu", nprocessed);
+    securec_check_ss(errorno, "\0", "\0");
+    MemoryContextSwitchTo(old_context);
+
+    return true;
+}
+
+K2PointModifyFusion::K2PointModifyFusion(
+    MemoryContext context, CachedPlanSource* psrc, List* plantree_list, ParamListInfo params)
+    : K2PointFusion(context, psrc, plantree_list)
+{
+    MemoryContext old_context = NULL;
+    if (!IsGlobal()) {
+        old_context = MemoryContextSwitchTo(m_global->m_context);
+        InitGlobals();
+        MemoryContextSwitchTo(old_context);
+    } else {
+        m_c_global = ((K2PointModifyFusion*)(psrc->opFusionObj))->m_c_global;
+    }
+    old_context = MemoryContextSwitchTo(m_local.m_localContext);
+    InitLocals(params);
+    MemoryContextSwitchTo(old_context);
+}
+
+void K2PointModifyFusion::InitGlobals()
+{
+    m_global->m_reloid = getrelid(linitial_int(m_global->m_planstmt->resultRelations), m_global->m_planstmt->rtable);
+    ModifyTable* node = (ModifyTable*)m_global->m_planstmt->planTree;
+    Plan* subplan = (Plan*)linitial(node->plans);
+
+    Relation rel = heap_open(m_global->m_reloid, AccessShareLock);
+    TupleDesc desc = RelationGetDescr(rel);
+    switch (node->operation) {
+        case CMD_INSERT:
+            InitK2Globals(rel, K2PG_POINT_INSERT);
+            break;
+        case CMD_UPDATE:
+            InitK2Globals(rel, K2PG_POINT_UPDATE);
+            InitK2Keys(subplan, rel);
+            break;
+        default:
+            InitK2Globals(rel, K2PG_POINT_DELETE);
+            InitK2Keys(subplan, rel);
+            break;
+    }
+
+    /* insert sends every column, update only the assigned ones */
+    m_c_global->m_valueNum = 0;
+    if (node->operation != CMD_DELETE) {
+        m_c_global->m_values = (K2BoundColumn*)palloc0(list_length(subplan->targetlist) * sizeof(K2BoundColumn));
+        ListCell* lc = NULL;
+        foreach (lc, subplan->targetlist) {
+            TargetEntry* res = (TargetEntry*)lfirst(lc);
+            if (res->resjunk || res->resno > desc->natts || TupleDescAttr(desc, res->resno - 1)->attisdropped ||
+                (node->operation == CMD_UPDATE && IsK2UnchangedColumn(res))) {
+                continue;
+            }
+            InitBoundColumn(&m_c_global->m_values[m_c_global->m_valueNum++], desc, res->resno, res->expr);
+        }
+    }
+    heap_close(rel, AccessShareLock);
+}
+
+void K2PointModifyFusion::InitLocals(ParamListInfo params)
+{
+    initParams(params);
+    m_local.m_receiver = NULL;
+    m_local.m_isInsideRec = true;
+}
+
+bool K2PointModifyFusion::execute(long max_rows, char* completionTag)
+{
+    MemoryContext old_context = MemoryContextSwitchTo(m_local.m_tmpContext);
+    LockRelationOid(m_global->m_reloid, RowExclusiveLock);
+
+    unsigned long nprocessed = 0;
+    std::vector<K2PgAttributeDef> columns;
+    if (BindColumns(m_c_global->m_keys, m_c_global->m_keyNum, true, columns) &&
+        BindColumns(m_c_global->m_values, m_c_global->m_valueNum, false, columns)) {
+        int rows_affected = 0;
+        HandleK2PgStatusForRelation(PgGate_ExecPointWrite(GetPointOp(), columns, &rows_affected),
+                                    m_global->m_reloid);
+        nprocessed = rows_affected;
+    }
+
+    errno_t ret = EOK;
+    switch (m_c_global->m_opType) {
+        case K2PG_POINT_INSERT:
+            ret = snprintf_s(completionTag, COMPLETION_TAG_BUFSIZE, COMPLETION_TAG_BUFSIZE - 1,
+                "INSERT 0 %lu", nprocessed);
+            break;
+        case K2PG_POINT_UPDATE:
+            ret = snprintf_s(completionTag, COMPLETION_TAG_BUFSIZE, COMPLETION_TAG_BUFSIZE - 1,
+                "UPDATE %lu", nprocessed);
+            break;
+        default:
+            ret = snprintf_s(completionTag, COMPLETION_TAG_BUFSIZE, COMPLETION_TAG_BUFSIZE - 1,
+                "DELETE %lu", nprocessed);
+            break;
+    }
+    securec_check_ss(ret, "\0", "\0");
+
+    m_local.m_isCompleted = true;
+    MemoryContextSwitchTo(old_context);
+
+    return true;
+}
@@ -73,6 +73,14 @@ const char* getBypassReason(FusionType result)
         	return "Bypass executed through agg fusion";
         }
 
+        case K2_POINT_SELECT_FUSION: {
+            return "Bypass executed through k2 point select fusion";
+        }
+
+        case K2_POINT_MODIFY_FUSION: {
+            return "Bypass executed through k2 point modify fusion";
+        }
+
         case SORT_INDEX_FUSION: {
         	return "Bypass executed through sort fusion";
         }
@@ -72,6 +72,7 @@ static void ValidateStrOptTTLInterval(const char *val);
 static void ValidateStrOptGatherInterval(const char *val);
 static void ValidateStrOptSwInterval(const char *val);
 static void ValidateStrOptVersion(const char *val);
+static void ValidateStrOptRowIdStrategy(const char *val);
 static void ValidateStrOptSpcFileSystem(const char *val);
 static void ValidateStrOptSpcAddress(const char *val);
 static void ValidateStrOptSpcCfgPath(const char *val);
@@ -472,6 +473,13 @@ static relopt_string stringRelOpts[] = {
         ValidateStrOptEncryptAlgo,
         "",
     },
+    {
+        { "rowid_strategy", "random, time_ordered or sharded k2pgrowid of K2PG tables", RELOPT_KIND_HEAP },
+        6,
+        false,
+        ValidateStrOptRowIdStrategy,
+        ROWID_STRATEGY_RANDOM,
+    },
     {
         {"wait_clean_gpi", "Whether to wait for gpi cleanup", RELOPT_KIND_HEAP },
         1,
@@ -1747,12 +1755,28 @@ void ForbidToSetOptionsForColTbl(List *options)
         "enable_tde",
         "encrypt_algo",
         "dek_cipher",
-        "cmk_id"
+        "cmk_id",
+        "rowid_strategy"
     };
 
     ForbidUserToSetUnsupportedOptions(options, unsupported, lengthof(unsupported), "column relation");
 }
 
+/*
+ * @Description: check relation options for tables without a k2pgrowid column,
+ *               i.e. heap tables and K2PG tables with primary key
+ * @Param[IN] options: input user options
+ * @Param[IN] detail: which kind of relation, for the error detail
+ */
+void ForbidToSetRowIdStrategyOption(List *options, const char *detail)
+{
+    static const char *unsupported[] = {
+        "rowid_strategy"
+    };
+
+    ForbidUserToSetUnsupportedOptions(options, unsupported, lengthof(unsupported), detail);
+}
+
 /*
  * @Description: check relation options for non-tde table
  * @Param[IN] options: input user options
@@ -1933,6 +1957,7 @@ bytea *default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         { "dek_cipher", RELOPT_TYPE_STRING, offsetof(StdRdOptions, dek_cipher)},
         { "cmk_id", RELOPT_TYPE_STRING, offsetof(StdRdOptions, cmk_id)},
         { "encrypt_algo", RELOPT_TYPE_STRING, offsetof(StdRdOptions, encrypt_algo)},
+        { "rowid_strategy", RELOPT_TYPE_STRING, offsetof(StdRdOptions, rowid_strategy)},
         { "enable_tde", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, enable_tde)},
     };
 
@@ -2289,6 +2314,23 @@ static void ValidateStrOptVersion(const char *val)
                         errdetail("Valid string are \"0.11\", \"0.12\".")));
     }
 }
+/*
+ * Brief        : Check the rowid_strategy option Validity.
+ * Input        : val, the rowid_strategy option value.
+ * Output       : None.
+ * Return Value : None.
+ * Notes        : None.
+ */
+static void ValidateStrOptRowIdStrategy(const char *val)
+{
+    if (pg_strcasecmp(val, ROWID_STRATEGY_RANDOM) != 0 && pg_strcasecmp(val, ROWID_STRATEGY_TIME_ORDERED) != 0 &&
+        pg_strcasecmp(val, ROWID_STRATEGY_SHARDED) != 0) {
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                        errmsg("Invalid string for  \"ROWID_STRATEGY\" option"),
+                        errdetail("Valid string are \"random\", \"time_ordered\", \"sharded\".")));
+    }
+}
+
 /*
  * check parameter of append_mode . Allows "on", "off"
  * and "auto" values.
@@ -539,7 +539,8 @@ Tuple IndexFetchTuple(IndexScanDesc scan)
 	{
 		if (scan->xs_hitup != 0)
 			return scan->xs_hitup;
-		return CamFetchTuple(scan->heapRelation, scan->xs_ctup.t_k2pgctid);
+		CamScanDesc camScan = IsK2PgRelation(scan->indexRelation) ? (CamScanDesc)scan->opaque : NULL;
+		return CamFetchTuple(scan->heapRelation, scan->xs_ctup.t_k2pgctid, camScan ? &camScan->stats : NULL);
 	}
 
     bool all_dead = false;
@@ -50,14 +50,16 @@ Status SqlCatalogClient::CreateDatabase(const std::string& database_name,
                                  uint32_t database_oid,
                                  const std::string& source_database_id,
                                  const std::string& creator_role_name,
-                                 const std::optional<uint32_t>& next_pg_oid) {
+                                 const std::optional<uint32_t>& next_pg_oid,
+                                 const CollectionPartitioning& partitioning) {
     CreateDatabaseRequest request {
       .databaseName = database_name,
       .databaseId = database_id,
       .databaseOid = database_oid,
       .sourceDatabaseId = source_database_id,
       .creatorRoleName = creator_role_name,
-      .nextPgOid = next_pg_oid
+      .nextPgOid = next_pg_oid,
+      .partitioning = partitioning
     };
     auto result = catalog_manager_->CreateDatabase(request);
     return k2pg::K2StatusToK2PgStatus(std::move(std::get<0>(result)));
@@ -125,6 +127,10 @@ Status SqlCatalogClient::DeleteTable(const PgOid database_oid, const PgOid table
     return k2pg::K2StatusToK2PgStatus(std::move(std::get<0>(response)));
 }
 
+Status SqlCatalogClient::TruncateTable(const PgOid database_oid, const PgOid table_oid) {
+    return k2pg::K2StatusToK2PgStatus(catalog_manager_->TruncateTable(database_oid, table_oid));
+}
+
 Status SqlCatalogClient::DeleteIndexTable(const PgOid database_oid, const PgOid table_oid, PgOid *base_table_oid, bool wait) {
     auto [status, response] = catalog_manager_->DeleteIndex(database_oid, table_oid);
     if (!status.is2xxOK()) {
@@ -54,7 +54,8 @@ public:
                                 uint32_t database_oid,
                                 const std::string& source_database_id,
                                 const std::string& creator_role_name,
-                                const std::optional<uint32_t>& next_pg_oid = std::nullopt);
+                                const std::optional<uint32_t>& next_pg_oid = std::nullopt,
+                                const CollectionPartitioning& partitioning = CollectionPartitioning{});
 
     // Delete database with the given name.
     Status DeleteDatabase(const std::string& database_name,
@@ -88,6 +89,9 @@ public:
 
     Status DeleteIndexTable(const PgOid database_oid, const PgOid table_oid, PgOid *base_table_oid, bool wait = true);
 
+    // Delete all rows of the specified table, including those of its secondary indexes.
+    Status TruncateTable(const PgOid database_oid, const PgOid table_oid);
+
     Status OpenTable(const PgOid database_oid, const PgOid table_oid, std::shared_ptr<TableInfo>* table);
 
     std::shared_ptr<TableInfo> OpenTable(const PgOid database_oid, const PgOid table_oid);
@@ -35,6 +35,7 @@ SqlCatalogManager::~SqlCatalogManager() {
 sh::Status SqlCatalogManager::Start() {
     K2LOG_I(log::catalog, "Starting Catalog Manager...");
     K2ASSERT(log::catalog, !initted_.load(std::memory_order_acquire), "Already started");
+    LoadOidPrefetchConfig();
     // load cluster info
     auto [status, clusterInfo] = cluster_info_handler_.GetClusterInfo(cluster_id_);
     if (!status.is2xxOK()) {
@@ -299,9 +300,8 @@ sh::Response<std::shared_ptr<DatabaseInfo>>  SqlCatalogManager::CreateDatabase(c
 
     // step 2.1 create new SKVCollection
     //   Note: using unique immutable databaseId as SKV collection name
-    //   TODO: pass in other collection configurations/parameters later.
     K2LOG_D(log::catalog, "Creating SKV collection for database {}", request.databaseId);
-    auto [ccResult] = TXMgr.createCollection(request.databaseId, request.databaseName).get();
+    auto [ccResult] = TXMgr.createCollection(request.databaseId, request.databaseName, request.partitioning).get();
     if (!ccResult.is2xxOK()) {
         K2LOG_ECT(log::catalog, "Failed to create SKV collection {} due to {}", request.databaseId, ccResult);
         return std::make_tuple(ccResult, std::shared_ptr<DatabaseInfo>());
@@ -722,6 +722,26 @@ sh::Response<DeleteTableResponse> SqlCatalogManager::DeleteTable(const uint32_t
     return std::make_tuple(sh::Statuses::S200_OK, response);
 }
 
+sh::Status SqlCatalogManager::TruncateTable(const uint32_t databaseOid, uint32_t tableOid) {
+    K2LOG_D(log::catalog, "Truncating table {} in database {}", tableOid, databaseOid);
+    auto [status, table_info] = GetTableSchema(databaseOid, tableOid);
+    if (!status.is2xxOK()) {
+        return status;
+    }
+    if (table_info == nullptr || table_info->table_oid() != tableOid) {
+        return sh::Statuses::S404_Not_Found(fmt::format("Cannot find table {}", tableOid));
+    }
+
+    // the metadata and the SKV schemas are kept, only the records of the table and its indexes are deleted
+    std::string database_id = PgObjectId::GetDatabaseUuid(databaseOid);
+    if (auto status = table_info_handler_.DeleteTableData(database_id, table_info); !status.is2xxOK()) {
+        AbortTransaction();
+        return status;
+    }
+    CommitTransaction();
+    return sh::Statuses::S200_OK;
+}
+
 sh::Response<DeleteIndexResponse> SqlCatalogManager::DeleteIndex(const uint32_t databaseOid, uint32_t tableOid) {
     K2LOG_D(log::catalog, "Deleting index {} in ns {}", tableOid, databaseOid);
     DeleteIndexResponse response;
@@ -788,11 +808,13 @@ sh::Response<DeleteIndexResponse> SqlCatalogManager::DeleteIndex(const uint32_t
 
 sh::Response<ReservePgOidsResponse> SqlCatalogManager::ReservePgOid(const std::string& databaseId, uint32_t nextOid, uint32_t count) {
     ReservePgOidsResponse response;
+    Metric mt(K2Op::ReserveOids);
     K2LOG_D(log::catalog, "Reserving PgOid with nextOid: {}, count: {}, for ns: {}",
             nextOid, count, databaseId);
     auto [status, databaseInfo] = database_info_handler_.GetDatabase(databaseId);
     if (!status.is2xxOK()) {
         AbortTransaction();
+        mt.report(false);
         K2LOG_ECT(log::catalog, "Failed to get database {}", databaseId);
         return std::make_tuple(status, response);
     }
@@ -803,11 +825,14 @@ sh::Response<ReservePgOidsResponse> SqlCatalogManager::ReservePgOid(const std::s
     }
     if (begin_oid == std::numeric_limits<uint32_t>::max()) {
         AbortTransaction();
+        mt.report(false);
         K2LOG_WCT(log::catalog, "No more object identifier is available for Postgres database {}", databaseId);
         return std::make_tuple(sh::Statuses::S400_Bad_Request, response);
     }
 
-    uint32_t end_oid = begin_oid + count;
+    auto now = k2::Clock::now();
+    uint32_t block_size = NextOidPrefetchSize(databaseId, count, now);
+    uint32_t end_oid = begin_oid + block_size;
     if (end_oid < begin_oid) {
         end_oid = std::numeric_limits<uint32_t>::max(); // Handle wraparound.
     }
@@ -822,12 +847,16 @@ sh::Response<ReservePgOidsResponse> SqlCatalogManager::ReservePgOid(const std::s
     K2LOG_D(log::catalog, "Updating nextPgOid on SKV to {} for database {}", end_oid, databaseId);
     if (auto status = database_info_handler_.UpsertDatabase(databaseInfo); !status.is2xxOK()) {
         AbortTransaction();
+        mt.report(false);
         K2LOG_ECT(log::catalog, "Failed to update nextPgOid on SKV due to {}", status);
         return std::make_tuple(status, response);
     }
 
     CommitTransaction();
     K2LOG_D(log::catalog, "Reserved PgOid succeeded for database {}", databaseId);
+    UpdateOidPrefetchState(databaseId, block_size, now);
+    RecordOidReservation(end_oid - begin_oid);
+    mt.report(true, 0, end_oid - begin_oid);
         // update database caches after persisting to SKV successfully
     auto updated_ns = std::make_shared<DatabaseInfo>(databaseInfo);
     std::lock_guard<std::mutex> l(lock_);
@@ -836,6 +865,68 @@ sh::Response<ReservePgOidsResponse> SqlCatalogManager::ReservePgOid(const std::s
     return std::make_tuple(sh::Statuses::S200_OK, response);
 }
 
+void SqlCatalogManager::LoadOidPrefetchConfig() {
+    auto conf = TXMgr.getConfig().sub("catalog");
+    oid_prefetch_conf_.minSize = conf.get<uint32_t>("oid_prefetch_min", 256);
+    oid_prefetch_conf_.maxSize = std::max(oid_prefetch_conf_.minSize, conf.get<uint32_t>("oid_prefetch_max", 32768));
+    oid_prefetch_conf_.growInterval = conf.getDurationMillis("oid_prefetch_grow_interval_ms", 1s);
+    oid_prefetch_conf_.shrinkInterval = conf.getDurationMillis("oid_prefetch_shrink_interval_ms", 60s);
+    oid_prefetch_conf_.statsInterval = conf.getDurationMillis("oid_stats_interval_ms", 10s);
+}
+
+uint32_t SqlCatalogManager::NextOidPrefetchSize(const std::string& databaseId, uint32_t count, k2::TimePoint now) {
+    uint32_t minSize = std::max(count, oid_prefetch_conf_.minSize);
+    uint32_t maxSize = std::max(minSize, oid_prefetch_conf_.maxSize);
+
+    std::lock_guard<std::mutex> l(oid_lock_);
+    auto it = oid_prefetch_map_.find(databaseId);
+    if (it == oid_prefetch_map_.end() || it->second.blockSize == 0) {
+        return minSize;
+    }
+
+    // only compute the size here, the state is advanced once the reservation is persisted
+    const OidPrefetchState& state = it->second;
+    uint32_t blockSize = state.blockSize;
+    auto elapsed = now - state.lastReserve;
+    if (elapsed < oid_prefetch_conf_.growInterval) {
+        // the previous block was consumed quickly, e.g., bulk DDL, double the next one
+        blockSize = (uint32_t)std::min<uint64_t>((uint64_t)blockSize * 2, maxSize);
+    } else if (elapsed > oid_prefetch_conf_.shrinkInterval) {
+        blockSize = blockSize / 2;
+    }
+    blockSize = std::max(blockSize, minSize);
+    K2LOG_D(log::catalog, "Oid prefetch size for database {} is {}", databaseId, blockSize);
+    return blockSize;
+}
+
+void SqlCatalogManager::UpdateOidPrefetchState(const std::string& databaseId, uint32_t blockSize, k2::TimePoint now) {
+    std::lock_guard<std::mutex> l(oid_lock_);
+    OidPrefetchState& state = oid_prefetch_map_[databaseId];
+    state.blockSize = blockSize;
+    state.lastReserve = now;
+}
+
+void SqlCatalogManager::RecordOidReservation(uint32_t count) {
+    auto now = k2::Clock::now();
+    std::lock_guard<std::mutex> l(oid_lock_);
+    oid_stats_.reservations++;
+    oid_stats_.oidsReserved += count;
+    oid_window_reservations_++;
+    if (oid_window_start_ == k2::TimePoint{}) {
+        oid_window_start_ = now;
+        return;
+    }
+
+    auto elapsed = now - oid_window_start_;
+    if (elapsed >= oid_prefetch_conf_.statsInterval) {
+        oid_stats_.reservationsPerSec = oid_window_reservations_ * 1.0 / std::chrono::duration<double>(elapsed).count();
+        K2LOG_I(log::catalog, "Oid reservations: {} in the last {} ({:.2f}/s), total reservations: {}, total oids: {}",
+            oid_window_reservations_, elapsed, oid_stats_.reservationsPerSec, oid_stats_.reservations, oid_stats_.oidsReserved);
+        oid_window_reservations_ = 0;
+        oid_window_start_ = now;
+    }
+}
+
 // update table caches
 void SqlCatalogManager::UpdateTableCache(std::shared_ptr<TableInfo> table_info) {
     table_uuid_map_[table_info->table_uuid()] = table_info;
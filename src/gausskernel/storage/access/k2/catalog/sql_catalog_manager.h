@@ -99,6 +99,8 @@ struct CreateDatabaseRequest {
     std::string creatorRoleName;
     // next oid to assign. Ignored when sourceDatabaseId is given and the nextPgOid from source database will be used
     std::optional<uint32_t> nextPgOid;
+    // partitioning of the SKV collection of the database
+    CollectionPartitioning partitioning;
 };
 
 struct CreateTableRequest {
@@ -135,6 +137,17 @@ struct ReservePgOidsResponse {
     uint32_t endOid;
 };
 
+// Counters for the OID reservations served by ReservePgOid, logged every stats interval to verify that
+// bulk DDL does not turn into a stream of read-modify-writes on the database record
+struct OidReservationStats {
+    // number of reservations, i.e., read-modify-writes of the database record on SKV
+    uint64_t reservations = 0;
+    // total number of oids handed out
+    uint64_t oidsReserved = 0;
+    // reservation rate observed in the last completed stats window
+    double reservationsPerSec = 0;
+};
+
 struct DeleteTableResponse {
     std::string databaseId;
     std::string tableId;
@@ -186,6 +199,9 @@ public:
 
     sh::Response<DeleteTableResponse> DeleteTable(const uint32_t databaseOid, uint32_t tableOid);
 
+    // Delete all rows of a table and of its secondary indexes in the current transaction
+    sh::Status TruncateTable(const uint32_t databaseOid, uint32_t tableOid);
+
     sh::Response<DeleteIndexResponse> DeleteIndex(const uint32_t databaseOid, uint32_t tableOid);
 
     sh::Response<ReservePgOidsResponse> ReservePgOid(const std::string& databaseId, uint32_t nextOid, uint32_t count);
@@ -242,6 +258,19 @@ protected:
 
     void LoadDatabases();
 
+    // read the oid prefetch settings of the "catalog" config section, once on Start()
+    void LoadOidPrefetchConfig();
+
+    // Decide how many oids to reserve for a database. The block grows geometrically while
+    // reservations come in faster than oid_prefetch_grow_interval_ms and shrinks back once
+    // the database has been idle for oid_prefetch_shrink_interval_ms
+    uint32_t NextOidPrefetchSize(const std::string& databaseId, uint32_t count, k2::TimePoint now);
+
+    // advance the prefetch state of a database after its reservation was persisted on SKV
+    void UpdateOidPrefetchState(const std::string& databaseId, uint32_t blockSize, k2::TimePoint now);
+
+    void RecordOidReservation(uint32_t count);
+
     static inline const std::string primary_cluster_id = "PG_DEFAULT_CLUSTER";
     static inline const std::string skv_collection_name_primary_cluster =  "K2RESVD_COLLECTION_SQL_PRIMARY_CLUSTER";
     // cluster identifier
@@ -283,6 +312,35 @@ private:
 
     // index id to quickly search for the index information and base table id
     std::unordered_map<std::string, std::shared_ptr<IndexInfo>> index_uuid_map_;
+
+    // oid prefetch settings, see LoadOidPrefetchConfig()
+    struct OidPrefetchConfig {
+        uint32_t minSize = 256;
+        uint32_t maxSize = 32768;
+        k2::Duration growInterval = std::chrono::seconds(1);
+        k2::Duration shrinkInterval = std::chrono::seconds(60);
+        k2::Duration statsInterval = std::chrono::seconds(10);
+    };
+
+    OidPrefetchConfig oid_prefetch_conf_;
+
+    // adaptive oid prefetch state of a database
+    struct OidPrefetchState {
+        uint32_t blockSize = 0;
+        k2::TimePoint lastReserve;
+    };
+
+    // oid prefetch state by database id
+    std::unordered_map<std::string, OidPrefetchState> oid_prefetch_map_;
+
+    // protects oid_prefetch_map_ and the oid reservation counters
+    std::mutex oid_lock_;
+
+    OidReservationStats oid_stats_;
+
+    // reservations and start time of the current stats window
+    uint64_t oid_window_reservations_ = 0;
+    k2::TimePoint oid_window_start_;
 };
 
 } // namespace catalog
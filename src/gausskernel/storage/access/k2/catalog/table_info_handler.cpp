@@ -25,6 +25,8 @@ Copyright(c) 2022 Futurewei Cloud
 
 #include "table_info_handler.h"
 
+#include <algorithm>
+#include <deque>
 #include <stdexcept>
 
 #include "postgres.h"
@@ -567,8 +569,26 @@ sh::Status TableInfoHandler::DeleteTableMetadata(const std::string& collection_n
 // Delete the actual table records from SKV that are stored with the SKV schema name to be table_id as in table_info
 sh::Status TableInfoHandler::DeleteTableData(const std::string& collection_name, std::shared_ptr<TableInfo> table) {
     try {
-        // TODO: add a task to delete the actual data from SKV
+        if (table->is_shared()) {
+            // shared tables reside in the primary cluster and are never dropped or truncated per database
+            K2LOG_I(log::catalog, "Skip deleting data of shared table {} in {}", table->table_id(), collection_name);
+            return sh::Statuses::S200_OK;
+        }
+
+        auto status = DeleteSKVTableData(collection_name, table->table_id(), table->schema().version(), table->table_oid(), 0 /*index_oid*/);
+        if (!status.is2xxOK()) {
+            return status;
+        }
 
+        if (table->has_secondary_indexes()) {
+            for (const auto& secondary_index : table->secondary_indexes()) {
+                status = DeleteSKVTableData(collection_name, secondary_index.first, secondary_index.second.version(),
+                    table->table_oid(), secondary_index.second.table_oid());
+                if (!status.is2xxOK()) {
+                    return status;
+                }
+            }
+        }
     }
     catch (const std::exception& e) {
         return sh::Statuses::S500_Internal_Server_Error(e.what());
@@ -576,6 +596,77 @@ sh::Status TableInfoHandler::DeleteTableData(const std::string& collection_name,
     return sh::Statuses::S200_OK;
 }
 
+// SKV has neither a range delete nor a way to drop a schema, so the records are scanned and erased in the
+// current transaction, with up to catalog.delete_data_max_in_flight erases outstanding while the next page is fetched
+sh::Status TableInfoHandler::DeleteSKVTableData(
+            const std::string& collection_name,
+            const std::string& schema_name,
+            uint32_t schema_version,
+            PgOid table_oid,
+            PgOid index_oid) {
+    auto [schema_status, schema] = TXMgr.getSchema(collection_name, schema_name, schema_version).get();
+    if (schema_status.code == 404) {
+        // the SKV schema was never created, thus there is no data
+        return sh::Statuses::S200_OK;
+    }
+    if (!schema_status.is2xxOK()) {
+        K2LOG_ECT(log::catalog, "Failed to get SKV schema for table {} in {} with version {} due to {}",
+            schema_name, collection_name, schema_version, schema_status);
+        return schema_status;
+    }
+
+    auto startScanRecord = buildRangeRecord(collection_name, schema, table_oid, index_oid, std::nullopt);
+    auto endScanRecord = buildRangeRecord(collection_name, schema, table_oid, index_oid, std::nullopt);
+    auto [status, query] = TXMgr.createQuery(startScanRecord, endScanRecord).get();
+    if (!status.is2xxOK()) {
+        K2LOG_ECT(log::catalog, "Failed to create scan read for {} in {} due to {}", schema_name, collection_name, status.message);
+        return status;
+    }
+
+    uint32_t maxInFlight = std::max(1u, TXMgr.getConfig().sub("catalog").get<uint32_t>("delete_data_max_in_flight", 64));
+    std::deque<boost::future<sh::Response<>>> inFlight;
+    sh::Status firstError = sh::Statuses::S200_OK;
+    auto waitFront = [&inFlight, &firstError] () {
+        auto [erase_status] = inFlight.front().get();
+        inFlight.pop_front();
+        if (firstError.is2xxOK() && !erase_status.is2xxOK()) {
+            firstError = std::move(erase_status);
+        }
+    };
+
+    int count = 0;
+    bool done = false;
+    do {
+        auto [status, query_result] = TXMgr.query(query).get();
+        if (!status.is2xxOK()) {
+            K2LOG_ECT(log::catalog, "Failed to run scan read for table {} in {} due to {}",
+                schema_name, collection_name, status);
+            firstError = std::move(status);
+            break;
+        }
+
+        for (sh::dto::SKVRecord::Storage& storage : query_result.records) {
+            sh::dto::SKVRecord record(collection_name, schema, std::move(storage));
+            while (inFlight.size() >= maxInFlight) {
+                waitFront();
+            }
+            inFlight.push_back(TXMgr.write(record, /* erase */ true));
+            count++;
+        }
+        done = query_result.done;
+    } while (!done && firstError.is2xxOK());
+
+    while (!inFlight.empty()) {
+        waitFront();
+    }
+    if (!firstError.is2xxOK()) {
+        K2LOG_ECT(log::catalog, "Failed to delete data of {} in {} due to {}", schema_name, collection_name, firstError);
+        return firstError;
+    }
+    K2LOG_I(log::catalog, "Deleted {} records of {} in {}", count, schema_name, collection_name);
+    return sh::Statuses::S200_OK;
+}
+
 // Delete index_info from tablemeta and indexcolumnmeta tables
 sh::Status TableInfoHandler::DeleteIndexMetadata(const std::string& collection_name, const std::string& index_id) {
     try {
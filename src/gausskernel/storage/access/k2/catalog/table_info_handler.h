@@ -209,6 +209,14 @@ class TableInfoHandler {
             PgOid source_table_oid,
             PgOid source_index_oid);
 
+    // Erase all records of the table (index_oid 0) or index stored under the given SKV schema
+    sh::Status DeleteSKVTableData(
+            const std::string& collection_name,
+            const std::string& schema_name,
+            uint32_t schema_version,
+            PgOid table_oid,
+            PgOid index_oid);
+
     // A SKV Schema of perticular version is not mutable, thus, we only create a new specified version if that version doesn't exists yet
     sh::Status CreateTableSKVSchema(const std::string& collection_name, std::shared_ptr<TableInfo> table);
 
@@ -0,0 +1,831 @@
+/*
+MIT License
+
+Copyright(c) 2022 Futurewei Cloud
+
+    Permission is hereby granted,
+    free of charge, to any person obtaining a copy of this software and associated documentation files(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and / or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS",
+    WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER
+    LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "inproc_skv.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+namespace k2pg {
+namespace inproc {
+using namespace sh::dto::expression;
+
+// Key encoding ------------------------------------------------------------------------------------
+// Keys are encoded into byte strings which sort in the same order as the key fields:
+// <schema name> \0 { \0 (null) | \1 <order-preserving value> }...
+
+template <typename T>
+static void encodeKeyField(std::string& out, const std::optional<T>& value) {
+    if (!value.has_value()) {
+        out.push_back('\0');
+        return;
+    }
+    out.push_back('\1');
+    if constexpr (std::is_same_v<T, bool>) {
+        out.push_back(*value ? '\1' : '\0');
+    } else if constexpr (std::is_integral_v<T>) {
+        uint64_t u = (uint64_t)(int64_t)*value ^ (1ULL << 63);
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out.push_back((char)((u >> shift) & 0xff));
+        }
+    } else if constexpr (std::is_floating_point_v<T>) {
+        double d = *value;
+        uint64_t u;
+        std::memcpy(&u, &d, sizeof(u));
+        u = (u & (1ULL << 63)) ? ~u : (u | (1ULL << 63));
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out.push_back((char)((u >> shift) & 0xff));
+        }
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        // escape \0 so that a string sorts before its extensions
+        for (char c : *value) {
+            out.push_back(c);
+            if (c == '\0') {
+                out.push_back('\xff');
+            }
+        }
+        out.push_back('\0');
+        out.push_back('\1');
+    } else {
+        throw std::runtime_error("Unsupported key field type in in-process SKV");
+    }
+}
+
+// Encodes the key fields of the record. For range bounds the encoding stops at the first null field, so that
+// the bound is a prefix of the keys it matches.
+static std::string encodeKey(sh::dto::SKVRecord& record, bool isBound) {
+    std::shared_ptr<sh::dto::Schema> schema = record.schema;
+    std::string out = schema->name;
+    out.push_back('\0');
+
+    std::vector<uint32_t> keyFields = schema->partitionKeyFields;
+    keyFields.insert(keyFields.end(), schema->rangeKeyFields.begin(), schema->rangeKeyFields.end());
+    bool stop = false;
+    for (uint32_t idx : keyFields) {
+        record.seekField(idx);
+        record.visitNextField([&out, &stop, isBound] (const auto& field, auto&& value) {
+            if (isBound && !value.has_value()) {
+                stop = true;
+                return;
+            }
+            encodeKeyField(out, value);
+        });
+        if (stop) {
+            break;
+        }
+    }
+    return out;
+}
+
+// The smallest string greater than all strings with the given prefix, or empty if there is none
+static std::string prefixSuccessor(std::string prefix) {
+    while (!prefix.empty() && (unsigned char)prefix.back() == 0xff) {
+        prefix.pop_back();
+    }
+    if (!prefix.empty()) {
+        prefix.back() = (char)((unsigned char)prefix.back() + 1);
+    }
+    return prefix;
+}
+
+// Filter evaluation -------------------------------------------------------------------------------
+
+template <typename A, typename B>
+static std::optional<int> compareValues(const A& a, const B& b) {
+    if constexpr (std::is_arithmetic_v<A> && std::is_arithmetic_v<B>) {
+        if constexpr (std::is_floating_point_v<A> || std::is_floating_point_v<B>) {
+            double x = a, y = b;
+            return x < y ? -1 : (x > y ? 1 : 0);
+        } else {
+            int64_t x = a, y = b;
+            return x < y ? -1 : (x > y ? 1 : 0);
+        }
+    } else if constexpr (std::is_same_v<A, std::string> && std::is_same_v<B, std::string>) {
+        int c = a.compare(b);
+        return c < 0 ? -1 : (c > 0 ? 1 : 0);
+    } else {
+        return std::nullopt;
+    }
+}
+
+template <typename Func>
+static bool visitField(sh::dto::SKVRecord& record, const std::string& fieldName, Func&& visitor) {
+    const auto& fields = record.schema->fields;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].name == fieldName) {
+            record.seekField(i);
+            record.visitNextField(visitor);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Compares a field of the record with a literal, empty if the field is null or the types are not comparable
+static std::optional<int> compareField(sh::dto::SKVRecord& record, Value& ref, Value& literal) {
+    std::optional<int> result;
+    bool found = visitField(record, ref.fieldName, [&result, &literal] (const auto& field, auto&& value) {
+        if (!value.has_value()) {
+            return;
+        }
+        sh::dto::applyTyped(literal, [&result, &literal, &value] (const auto& afr) mutable {
+            typename std::remove_reference_t<decltype(afr)>::ValueT constant;
+            sh::MPackReader reader(literal.literal);
+            if (!reader.read(constant)) {
+                throw std::runtime_error("Unable to deserialize value literal");
+            }
+            result = compareValues(*value, constant);
+        });
+    });
+    if (!found) {
+        throw std::runtime_error("Unknown field in filter expression: " + ref.fieldName);
+    }
+    return result;
+}
+
+static bool isFieldNull(sh::dto::SKVRecord& record, Value& ref) {
+    bool isNull = true;
+    visitField(record, ref.fieldName, [&isNull] (const auto& field, auto&& value) {
+        isNull = !value.has_value();
+    });
+    return isNull;
+}
+
+// Evaluates the filter on the record. Supports the expressions pggate pushes down: comparisons of a field with
+// a literal, IS_NULL and AND/OR/NOT over sub-expressions. Throws on anything else
+static bool evaluate(Expression& expr, sh::dto::SKVRecord& record) {
+    switch (expr.op) {
+        case Operation::UNKNOWN:
+            return true;
+        case Operation::AND:
+            for (auto& child : expr.expressionChildren) {
+                if (!evaluate(child, record)) {
+                    return false;
+                }
+            }
+            return true;
+        case Operation::OR:
+            for (auto& child : expr.expressionChildren) {
+                if (evaluate(child, record)) {
+                    return true;
+                }
+            }
+            return false;
+        case Operation::NOT:
+            if (expr.expressionChildren.size() != 1) {
+                throw std::invalid_argument("NOT expects a single sub-expression");
+            }
+            return !evaluate(expr.expressionChildren[0], record);
+        case Operation::IS_NULL:
+            if (expr.valueChildren.size() != 1 || !expr.valueChildren[0].isReference()) {
+                throw std::invalid_argument("IS_NULL expects a single field reference");
+            }
+            return isFieldNull(record, expr.valueChildren[0]);
+        case Operation::EQ:
+        case Operation::GT:
+        case Operation::GTE:
+        case Operation::LT:
+        case Operation::LTE: {
+            if (expr.valueChildren.size() != 2) {
+                throw std::invalid_argument("Comparison expects two values");
+            }
+            // normalize to <field> op <literal>
+            bool swapped = !expr.valueChildren[0].isReference();
+            Value& ref = swapped ? expr.valueChildren[1] : expr.valueChildren[0];
+            Value& literal = swapped ? expr.valueChildren[0] : expr.valueChildren[1];
+            if (!ref.isReference() || literal.isReference()) {
+                throw std::invalid_argument("Comparison expects a field reference and a literal");
+            }
+            std::optional<int> cmp = compareField(record, ref, literal);
+            if (!cmp.has_value()) {
+                return false;
+            }
+            int c = swapped ? -*cmp : *cmp;
+            switch (expr.op) {
+                case Operation::EQ: return c == 0;
+                case Operation::GT: return c > 0;
+                case Operation::GTE: return c >= 0;
+                case Operation::LT: return c < 0;
+                default: return c <= 0;
+            }
+        }
+        default:
+            throw std::invalid_argument(fmt::format("Unsupported filter operation in in-process SKV: {}", expr.op));
+    }
+}
+
+// DelayQueue --------------------------------------------------------------------------------------
+
+DelayQueue::~DelayQueue() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cv.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void DelayQueue::schedule(k2::TimePoint due, std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_thread.joinable()) {
+            _thread = std::thread([this] { _run(); });
+        }
+        _queue.emplace(due, std::move(fn));
+    }
+    _cv.notify_one();
+}
+
+void DelayQueue::_run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stop) {
+        if (_queue.empty()) {
+            _cv.wait(lock);
+            continue;
+        }
+        auto first = _queue.begin();
+        if (first->first > k2::Clock::now()) {
+            _cv.wait_until(lock, first->first);
+            continue;
+        }
+        std::function<void()> fn = std::move(first->second);
+        _queue.erase(first);
+        lock.unlock();
+        fn();
+        lock.lock();
+    }
+}
+
+// InProcTxn ---------------------------------------------------------------------------------------
+
+// A write buffered in the txn until commit
+struct PendingWrite {
+    bool deleted;
+    sh::dto::SKVRecord::Storage storage;
+};
+
+// State of an open query
+struct Cursor {
+    std::string collectionName;
+    std::shared_ptr<sh::dto::Schema> schema;
+    // scan keys in [start, endLimit), endLimit empty means unbounded
+    std::string start;
+    std::string endLimit;
+    Expression filter;
+    int32_t remaining;  // -1 for no limit
+    bool reverse;
+    std::optional<std::string> last;
+    bool done{false};
+};
+
+class InProcTxn : public SKVTxn {
+public:
+    InProcTxn(std::shared_ptr<InProcSKV> skv, uint64_t id, uint64_t startTs) : _skv(std::move(skv)), _id(id), _startTs(startTs) {}
+
+    ~InProcTxn() {
+        if (!_ended) {
+            std::lock_guard<std::mutex> lock(_skv->_mutex);
+            _skv->_releaseTxn(_startTs);
+        }
+    }
+
+    boost::future<sh::Response<>>
+    endTxn(sh::dto::EndAction endAction) override {
+        std::lock_guard<std::mutex> lock(_skv->_mutex);
+        if (_ended) {
+            return _skv->_respond(sh::Statuses::S410_Gone("transaction already ended"));
+        }
+        _ended = true;
+        _skv->_releaseTxn(_startTs);
+        _queries.clear();
+        if (endAction != sh::dto::EndAction::Commit) {
+            _writes.clear();
+            return _skv->_respond(sh::Statuses::S200_OK);
+        }
+
+        // validate first so that the commit is all or nothing
+        for (auto& [collectionName, writes] : _writes) {
+            auto collIt = _skv->_collections.find(collectionName);
+            if (collIt == _skv->_collections.end()) {
+                _writes.clear();
+                return _skv->_respond(sh::Statuses::S404_Not_Found(fmt::format("collection {} not found", collectionName)));
+            }
+            for (auto& [key, write] : writes) {
+                if (_hasConflict(collIt->second, key)) {
+                    _writes.clear();
+                    return _skv->_respond(sh::Statuses::S409_Conflict("write-write conflict on commit"));
+                }
+            }
+        }
+
+        uint64_t commitTs = ++_skv->_clock;
+        for (auto& [collectionName, writes] : _writes) {
+            Collection& coll = _skv->_collections[collectionName];
+            for (auto& [key, write] : writes) {
+                std::vector<Version>& versions = coll.rows[key];
+                versions.push_back(Version{.ts = commitTs, .deleted = write.deleted, .storage = std::move(write.storage)});
+                _skv->_collectGarbage(versions);
+                if (versions.empty()) {
+                    coll.rows.erase(key);
+                }
+            }
+        }
+        _writes.clear();
+        return _skv->_respond(sh::Statuses::S200_OK);
+    }
+
+    boost::future<sh::Response<sh::dto::SKVRecord>>
+    read(sh::dto::SKVRecord record) override {
+        std::lock_guard<std::mutex> lock(_skv->_mutex);
+        Collection* coll = _findCollection(record.collectionName);
+        if (!coll) {
+            return _skv->_respond(sh::Statuses::S404_Not_Found("collection not found"), sh::dto::SKVRecord{});
+        }
+        std::string key = encodeKey(record, false);
+        sh::dto::SKVRecord::Storage* storage = _visible(record.collectionName, *coll, key);
+        if (!storage) {
+            return _skv->_respond(sh::Statuses::S404_Not_Found("record not found"), sh::dto::SKVRecord{});
+        }
+        std::shared_ptr<sh::dto::Schema> schema = _skv->_findSchema(*coll, record.schema->name, storage->schemaVersion);
+        return _skv->_respond(sh::Statuses::S200_OK, sh::dto::SKVRecord(record.collectionName, schema ? schema : record.schema, storage->share()));
+    }
+
+    boost::future<sh::Response<>>
+    write(sh::dto::SKVRecord& record, bool erase, sh::dto::ExistencePrecondition precondition) override {
+        std::lock_guard<std::mutex> lock(_skv->_mutex);
+        Collection* coll = _findCollection(record.collectionName);
+        if (!coll) {
+            return _skv->_respond(sh::Statuses::S404_Not_Found("collection not found"));
+        }
+        std::string key = encodeKey(record, false);
+        if (_hasConflict(*coll, key)) {
+            return _skv->_respond(sh::Statuses::S409_Conflict("write-write conflict"));
+        }
+        bool exists = _visible(record.collectionName, *coll, key) != nullptr;
+        if ((precondition == sh::dto::ExistencePrecondition::Exists && !exists) ||
+            (precondition == sh::dto::ExistencePrecondition::NotExists && exists)) {
+            return _skv->_respond(sh::Statuses::S412_Precondition_Failed("existence precondition failed"));
+        }
+        _writes[record.collectionName].insert_or_assign(key, PendingWrite{.deleted = erase, .storage = record.getStorage().share()});
+        return _skv->_respond(sh::Statuses::S200_OK);
+    }
+
+    boost::future<sh::Response<>>
+    partialUpdate(sh::dto::SKVRecord& record, std::vector<uint32_t> fieldsForPartialUpdate) override {
+        std::lock_guard<std::mutex> lock(_skv->_mutex);
+        Collection* coll = _findCollection(record.collectionName);
+        if (!coll) {
+            return _skv->_respond(sh::Statuses::S404_Not_Found("collection not found"));
+        }
+        std::string key = encodeKey(record, false);
+        if (_hasConflict(*coll, key)) {
+            return _skv->_respond(sh::Statuses::S409_Conflict("write-write conflict"));
+        }
+        sh::dto::SKVRecord::Storage* storage = _visible(record.collectionName, *coll, key);
+        if (!storage) {
+            return _skv->_respond(sh::Statuses::S412_Precondition_Failed("record not found for partial update"));
+        }
+        if (storage->schemaVersion != (uint32_t)record.schema->version) {
+            return _skv->_respond(sh::Statuses::S400_Bad_Request("partial update across schema versions is not supported"));
+        }
+
+        // take the key and the updated fields from the new record, everything else from the current one
+        std::unordered_set<uint32_t> fromNew(fieldsForPartialUpdate.begin(), fieldsForPartialUpdate.end());
+        fromNew.insert(record.schema->partitionKeyFields.begin(), record.schema->partitionKeyFields.end());
+        fromNew.insert(record.schema->rangeKeyFields.begin(), record.schema->rangeKeyFields.end());
+        sh::dto::SKVRecord current(record.collectionName, record.schema, storage->share());
+        sh::dto::SKVRecordBuilder builder(record.collectionName, record.schema);
+        try {
+            for (uint32_t i = 0; i < record.schema->fields.size(); ++i) {
+                sh::dto::SKVRecord& source = fromNew.count(i) ? record : current;
+                source.seekField(i);
+                source.visitNextField([&builder] (const auto& field, auto&& value) mutable {
+                    using T = typename std::remove_reference_t<decltype(value)>::value_type;
+                    if (!value.has_value()) {
+                        builder.serializeNull();
+                    } else {
+                        builder.serializeNext<T>(*value);
+                    }
+                });
+            }
+        } catch (const std::exception& err) {
+            return _skv->_respond(sh::Statuses::S400_Bad_Request(err.what()));
+        }
+        _writes[record.collectionName].insert_or_assign(key, PendingWrite{.deleted = false, .storage = builder.build().getStorage().share()});
+        return _skv->_respond(sh::Statuses::S200_OK);
+    }
+
+    boost::future<sh::Response<sh::dto::QueryResponse>>
+    query(std::shared_ptr<sh::dto::QueryRequest> query) override {
+        std::lock_guard<std::mutex> lock(_skv->_mutex);
+        auto it = _queries.find(query.get());
+        if (it == _queries.end()) {
+            return _skv->_respond(sh::Statuses::S404_Not_Found("query not found"), sh::dto::QueryResponse{});
+        }
+        Cursor& cursor = it->second;
+        Collection* coll = _findCollection(cursor.collectionName);
+        if (!coll) {
+            return _skv->_respond(sh::Statuses::S404_Not_Found("collection not found"), sh::dto::QueryResponse{});
+        }
+
+        sh::dto::QueryResponse response{};
+        try {
+            while (!cursor.done && response.records.size() < _skv->_pageSize) {
+                std::optional<std::string> key = _nextKey(cursor, *coll);
+                if (!key) {
+                    cursor.done = true;
+                    break;
+                }
+                cursor.last = key;
+                sh::dto::SKVRecord::Storage* storage = _visible(cursor.collectionName, *coll, *key);
+                if (!storage) {
+                    continue;
+                }
+                std::shared_ptr<sh::dto::Schema> schema = _skv->_findSchema(*coll, cursor.schema->name, storage->schemaVersion);
+                sh::dto::SKVRecord record(cursor.collectionName, schema ? schema : cursor.schema, storage->share());
+                if (!evaluate(cursor.filter, record)) {
+                    continue;
+                }
+                response.records.push_back(storage->share());
+                if (cursor.remaining > 0 && --cursor.remaining == 0) {
+                    cursor.done = true;
+                }
+            }
+        } catch (const std::exception& err) {
+            return _skv->_respond(sh::Statuses::S400_Bad_Request(err.what()), sh::dto::QueryResponse{});
+        }
+        response.done = cursor.done;
+        return _skv->_respond(sh::Statuses::S200_OK, std::move(response));
+    }
+
+    boost::future<sh::Response<std::shared_ptr<sh::dto::QueryRequest>>>
+    createQuery(sh::dto::SKVRecord& startKey, sh::dto::SKVRecord& endKey, sh::dto::expression::Expression&& filter,
+                std::vector<std::string>&& projection, int32_t recordLimit, bool reverseDirection,
+                bool includeVersionMismatch) override {
+        std::lock_guard<std::mutex> lock(_skv->_mutex);
+        if (!_findCollection(startKey.collectionName)) {
+            return _skv->_respond(sh::Statuses::S404_Not_Found("collection not found"), std::shared_ptr<sh::dto::QueryRequest>());
+        }
+        // projection is not applied, full records are returned and pggate reads the fields it needs
+        auto request = std::make_shared<sh::dto::QueryRequest>();
+        _queries.emplace(request.get(), Cursor{
+            .collectionName = startKey.collectionName,
+            .schema = startKey.schema,
+            .start = encodeKey(startKey, true),
+            .endLimit = prefixSuccessor(encodeKey(endKey, true)),
+            .filter = std::move(filter),
+            .remaining = recordLimit > 0 ? recordLimit : -1,
+            .reverse = reverseDirection,
+            .last = std::nullopt,
+            .done = recordLimit == 0
+        });
+        return _skv->_respond(sh::Statuses::S200_OK, std::move(request));
+    }
+
+    boost::future<sh::Response<>>
+    destroyQuery(std::shared_ptr<sh::dto::QueryRequest> query) override {
+        std::lock_guard<std::mutex> lock(_skv->_mutex);
+        _queries.erase(query.get());
+        return _skv->_respond(sh::Statuses::S200_OK);
+    }
+
+    std::string toString() const override {
+        return fmt::format("inproc-txn{{id={}, startTs={}}}", _id, _startTs);
+    }
+
+private:
+    // All private helpers must be called with _skv->_mutex held
+    Collection* _findCollection(const std::string& name) {
+        auto it = _skv->_collections.find(name);
+        return it == _skv->_collections.end() ? nullptr : &it->second;
+    }
+
+    // true if the key was committed by another txn after this txn started
+    bool _hasConflict(Collection& coll, const std::string& key) {
+        auto it = coll.rows.find(key);
+        return it != coll.rows.end() && !it->second.empty() && it->second.back().ts > _startTs;
+    }
+
+    // the version of the record visible to this txn, or null if the record does not exist for it
+    sh::dto::SKVRecord::Storage* _visible(const std::string& collectionName, Collection& coll, const std::string& key) {
+        auto wit = _writes.find(collectionName);
+        if (wit != _writes.end()) {
+            auto pit = wit->second.find(key);
+            if (pit != wit->second.end()) {
+                return pit->second.deleted ? nullptr : &pit->second.storage;
+            }
+        }
+        auto rit = coll.rows.find(key);
+        if (rit == coll.rows.end()) {
+            return nullptr;
+        }
+        for (auto vit = rit->second.rbegin(); vit != rit->second.rend(); ++vit) {
+            if (vit->ts <= _startTs) {
+                return vit->deleted ? nullptr : &vit->storage;
+            }
+        }
+        return nullptr;
+    }
+
+    // the next key of the cursor's range in scan order, from the committed rows and this txn's writes
+    std::optional<std::string> _nextKey(Cursor& cursor, Collection& coll) {
+        static const std::map<std::string, PendingWrite> noWrites;
+        auto wit = _writes.find(cursor.collectionName);
+        const std::map<std::string, PendingWrite>& writes = wit == _writes.end() ? noWrites : wit->second;
+
+        std::optional<std::string> next;
+        auto consider = [&cursor, &next] (const auto& map) {
+            if (!cursor.reverse) {
+                auto it = cursor.last ? map.upper_bound(*cursor.last) : map.lower_bound(cursor.start);
+                if (it != map.end() && (!next || it->first < *next)) {
+                    next = it->first;
+                }
+            } else {
+                auto it = cursor.last ? map.lower_bound(*cursor.last) :
+                          (cursor.endLimit.empty() ? map.end() : map.lower_bound(cursor.endLimit));
+                if (it != map.begin()) {
+                    --it;
+                    if (!next || it->first > *next) {
+                        next = it->first;
+                    }
+                }
+            }
+        };
+        consider(coll.rows);
+        consider(writes);
+
+        if (next && (*next < cursor.start || (!cursor.endLimit.empty() && *next >= cursor.endLimit))) {
+            return std::nullopt;
+        }
+        return next;
+    }
+
+    std::shared_ptr<InProcSKV> _skv;
+    uint64_t _id;
+    uint64_t _startTs;
+    bool _ended{false};
+    // collection name -> encoded key -> write
+    std::unordered_map<std::string, std::map<std::string, PendingWrite>> _writes;
+    std::unordered_map<const sh::dto::QueryRequest*, Cursor> _queries;
+};
+
+// InProcSKV ---------------------------------------------------------------------------------------
+
+static std::mutex instanceMutex;
+static std::shared_ptr<InProcSKV> theInstance;
+
+std::shared_ptr<InProcSKV> InProcSKV::instance(Config config) {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if (!theInstance) {
+        theInstance = std::make_shared<InProcSKV>(std::move(config));
+        if (!theInstance->_snapshotFile.empty()) {
+            theInstance->_loadSnapshot();
+            std::atexit([] () {
+                std::lock_guard<std::mutex> lock(instanceMutex);
+                if (theInstance) {
+                    theInstance->_saveSnapshot();
+                }
+            });
+        }
+    }
+    return theInstance;
+}
+
+InProcSKV::InProcSKV(Config config) {
+    _latency = std::chrono::microseconds(config.get<uint64_t>("latency_us", 0));
+    _pageSize = config.get<uint32_t>("query_page_size", 500);
+    _snapshotFile = config.get<std::string>("snapshot_file", "");
+    K2LOG_I(k2log::k2pg, "In-process SKV with latency {}, page size {}, snapshot file '{}'", _latency, _pageSize, _snapshotFile);
+}
+
+template <typename... T>
+boost::future<sh::Response<T...>> InProcSKV::_respond(sh::Status&& status, T&&... values) {
+    if (_latency == k2::Duration::zero()) {
+        return sh::MakeResponse<T...>(std::move(status), std::forward<T>(values)...);
+    }
+    auto promise = std::make_shared<boost::promise<sh::Response<T...>>>();
+    auto response = std::make_shared<sh::Response<T...>>(std::move(status), std::forward<T>(values)...);
+    auto fut = promise->get_future();
+    _delays.schedule(k2::Clock::now() + _latency, [promise, response] () {
+        promise->set_value(std::move(*response));
+    });
+    return fut;
+}
+
+std::shared_ptr<sh::dto::Schema> InProcSKV::_findSchema(Collection& coll, const std::string& schemaName, int64_t schemaVersion) {
+    auto it = coll.schemas.find(schemaName);
+    if (it == coll.schemas.end() || it->second.empty()) {
+        return nullptr;
+    }
+    if (schemaVersion == sh::dto::ANY_SCHEMA_VERSION) {
+        return it->second.rbegin()->second;
+    }
+    auto vit = it->second.find(schemaVersion);
+    return vit == it->second.end() ? nullptr : vit->second;
+}
+
+void InProcSKV::_releaseTxn(uint64_t startTs) {
+    auto it = _activeTxns.find(startTs);
+    if (it != _activeTxns.end()) {
+        _activeTxns.erase(it);
+    }
+}
+
+// Drops the versions no running or future txn can see
+void InProcSKV::_collectGarbage(std::vector<Version>& versions) {
+    uint64_t oldestVisible = _activeTxns.empty() ? _clock : *_activeTxns.begin();
+    // find the newest version visible at oldestVisible, everything before it is garbage
+    size_t keepFrom = 0;
+    for (size_t i = 0; i < versions.size(); ++i) {
+        if (versions[i].ts <= oldestVisible) {
+            keepFrom = i;
+        }
+    }
+    if (keepFrom > 0) {
+        versions.erase(versions.begin(), versions.begin() + keepFrom);
+    }
+    if (versions.size() == 1 && versions[0].deleted && versions[0].ts <= oldestVisible) {
+        versions.clear();
+    }
+}
+
+boost::future<sh::Response<std::unique_ptr<SKVTxn>>>
+InProcSKV::beginTxn(sh::dto::TxnOptions opts) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint64_t startTs = _clock;
+    _activeTxns.insert(startTs);
+    std::unique_ptr<SKVTxn> txn = std::make_unique<InProcTxn>(shared_from_this(), ++_nextTxnId, startTs);
+    return _respond(sh::Statuses::S200_OK, std::move(txn));
+}
+
+boost::future<sh::Response<>>
+InProcSKV::createSchema(const std::string& collectionName, const sh::dto::Schema& schema) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _collections.find(collectionName);
+    if (it == _collections.end()) {
+        return _respond(sh::Statuses::S404_Not_Found(fmt::format("collection {} not found", collectionName)));
+    }
+    auto& versions = it->second.schemas[schema.name];
+    if (versions.count(schema.version)) {
+        return _respond(sh::Statuses::S409_Conflict(fmt::format("schema {} version {} already exists", schema.name, schema.version)));
+    }
+    versions[schema.version] = std::make_shared<sh::dto::Schema>(schema);
+    return _respond(sh::Statuses::S200_OK);
+}
+
+boost::future<sh::Response<std::shared_ptr<sh::dto::Schema>>>
+InProcSKV::getSchema(const std::string& collectionName, const std::string& schemaName, int64_t schemaVersion) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _collections.find(collectionName);
+    if (it == _collections.end()) {
+        return _respond(sh::Statuses::S404_Not_Found(fmt::format("collection {} not found", collectionName)), std::shared_ptr<sh::dto::Schema>());
+    }
+    std::shared_ptr<sh::dto::Schema> schema = _findSchema(it->second, schemaName, schemaVersion);
+    if (!schema) {
+        return _respond(sh::Statuses::S404_Not_Found(fmt::format("schema {} not found", schemaName)), std::shared_ptr<sh::dto::Schema>());
+    }
+    return _respond(sh::Statuses::S200_OK, std::move(schema));
+}
+
+boost::future<sh::Response<>>
+InProcSKV::createCollection(sh::dto::CollectionMetadata metadata, std::vector<std::string> rangeEnds) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_collections.count(metadata.name)) {
+        return _respond(sh::Statuses::S403_Forbidden(fmt::format("collection {} already exists", metadata.name)));
+    }
+    std::string name = metadata.name;
+    _collections[name].metadata = std::move(metadata);
+    return _respond(sh::Statuses::S200_OK);
+}
+
+// Snapshot ----------------------------------------------------------------------------------------
+// Only the latest committed, non-deleted version of each record is saved
+
+void InProcSKV::_saveSnapshot() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    sh::MPackWriter writer;
+    writer.write((uint64_t)_collections.size());
+    for (auto& [name, coll] : _collections) {
+        writer.write(coll.metadata);
+        uint64_t numSchemas = 0;
+        for (auto& [schemaName, versions] : coll.schemas) {
+            numSchemas += versions.size();
+        }
+        writer.write(numSchemas);
+        for (auto& [schemaName, versions] : coll.schemas) {
+            for (auto& [version, schema] : versions) {
+                writer.write(*schema);
+            }
+        }
+        uint64_t numRows = 0;
+        for (auto& [key, versions] : coll.rows) {
+            numRows += (!versions.empty() && !versions.back().deleted) ? 1 : 0;
+        }
+        writer.write(numRows);
+        for (auto& [key, versions] : coll.rows) {
+            if (!versions.empty() && !versions.back().deleted) {
+                writer.write(key);
+                writer.write(versions.back().storage);
+            }
+        }
+    }
+
+    sh::Binary binary;
+    if (!writer.flush(binary)) {
+        K2LOG_E(k2log::k2pg, "Unable to serialize in-process SKV snapshot");
+        return;
+    }
+    std::string tmpFile = _snapshotFile + ".tmp";
+    {
+        std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+        out.write(binary.data(), binary.size());
+        if (!out) {
+            K2LOG_E(k2log::k2pg, "Unable to write in-process SKV snapshot to {}", tmpFile);
+            return;
+        }
+    }
+    if (std::rename(tmpFile.c_str(), _snapshotFile.c_str()) != 0) {
+        K2LOG_E(k2log::k2pg, "Unable to rename in-process SKV snapshot to {}", _snapshotFile);
+    }
+}
+
+void InProcSKV::_loadSnapshot() {
+    std::ifstream in(_snapshotFile, std::ios::binary);
+    if (!in) {
+        K2LOG_I(k2log::k2pg, "No in-process SKV snapshot at {}, starting empty", _snapshotFile);
+        return;
+    }
+    std::stringstream contents;
+    contents << in.rdbuf();
+    auto buf = std::make_shared<std::string>(contents.str());
+    sh::Binary binary(buf->data(), buf->size(), [buf] () {});
+    sh::MPackReader reader(binary);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    // everything loaded is committed at ts 1
+    _clock = 1;
+    uint64_t numCollections = 0;
+    bool ok = reader.read(numCollections);
+    for (uint64_t c = 0; ok && c < numCollections; ++c) {
+        sh::dto::CollectionMetadata metadata;
+        ok = reader.read(metadata);
+        if (!ok) break;
+        Collection& coll = _collections[metadata.name];
+        coll.metadata = std::move(metadata);
+
+        uint64_t numSchemas = 0;
+        ok = reader.read(numSchemas);
+        for (uint64_t s = 0; ok && s < numSchemas; ++s) {
+            auto schema = std::make_shared<sh::dto::Schema>();
+            ok = reader.read(*schema);
+            if (ok) {
+                coll.schemas[schema->name][schema->version] = schema;
+            }
+        }
+
+        uint64_t numRows = 0;
+        ok = ok && reader.read(numRows);
+        for (uint64_t r = 0; ok && r < numRows; ++r) {
+            std::string key;
+            sh::dto::SKVRecord::Storage storage;
+            ok = reader.read(key) && reader.read(storage);
+            if (ok) {
+                coll.rows[key].push_back(Version{.ts = _clock, .deleted = false, .storage = std::move(storage)});
+            }
+        }
+    }
+    if (!ok) {
+        K2LOG_E(k2log::k2pg, "Corrupt in-process SKV snapshot {}, starting empty", _snapshotFile);
+        _collections.clear();
+        return;
+    }
+    K2LOG_I(k2log::k2pg, "Loaded {} collections from in-process SKV snapshot {}", _collections.size(), _snapshotFile);
+}
+
+} // ns inproc
+} // ns k2pg
@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright(c) 2022 Futurewei Cloud
+
+    Permission is hereby granted,
+    free of charge, to any person obtaining a copy of this software and associated documentation files(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and / or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS",
+    WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER
+    LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
+#include "skv_backend.h"
+
+namespace k2pg {
+namespace inproc {
+
+// In-process stand-in for the K2 cluster and HTTP proxy, used for benchmarking the pggate path without a cluster.
+// Records are kept in an ordered map per collection with MVCC-lite semantics: txns read the committed state as of
+// their start plus their own writes, write-write conflicts with txns committed after the start are rejected with 409,
+// and writes become visible atomically at commit. Filters support the comparison/AND/OR/NOT expressions pggate pushes down.
+// Configured by the "client.inproc" section of the K2 config:
+//   "latency_us": injected latency added to every response (default 0)
+//   "query_page_size": max records returned per query page (default 500)
+//   "snapshot_file": if set, the committed state is loaded from this file on start and saved on process exit, so
+//                    that a cluster initialized by initdb can be reused by the server
+class InProcSKV;
+
+// A committed version of a record
+struct Version {
+    uint64_t ts;
+    bool deleted;
+    sh::dto::SKVRecord::Storage storage;
+};
+
+struct Collection {
+    sh::dto::CollectionMetadata metadata;
+    // schema name -> schema version -> schema
+    std::unordered_map<std::string, std::map<int64_t, std::shared_ptr<sh::dto::Schema>>> schemas;
+    // encoded key -> committed versions, oldest first
+    std::map<std::string, std::vector<Version>> rows;
+};
+
+// Delivers completions after an injected delay, from a single background thread
+class DelayQueue {
+public:
+    ~DelayQueue();
+    void schedule(k2::TimePoint due, std::function<void()> fn);
+
+private:
+    void _run();
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::multimap<k2::TimePoint, std::function<void()>> _queue;
+    std::thread _thread;
+    bool _stop{false};
+};
+
+class InProcTxn;
+
+class InProcSKV : public SKVBackend, public std::enable_shared_from_this<InProcSKV> {
+public:
+    // the store is shared by all threads of the process
+    static std::shared_ptr<InProcSKV> instance(Config config);
+
+    boost::future<sh::Response<std::unique_ptr<SKVTxn>>>
+        beginTxn(sh::dto::TxnOptions opts) override;
+    boost::future<sh::Response<>>
+        createSchema(const std::string& collectionName, const sh::dto::Schema& schema) override;
+    boost::future<sh::Response<std::shared_ptr<sh::dto::Schema>>>
+        getSchema(const std::string& collectionName, const std::string& schemaName, int64_t schemaVersion) override;
+    boost::future<sh::Response<>>
+        createCollection(sh::dto::CollectionMetadata metadata, std::vector<std::string> rangeEnds) override;
+
+    InProcSKV(Config config);
+
+private:
+    friend class InProcTxn;
+
+    template <typename... T>
+    boost::future<sh::Response<T...>> _respond(sh::Status&& status, T&&... values);
+
+    // must be called with _mutex held
+    std::shared_ptr<sh::dto::Schema> _findSchema(Collection& coll, const std::string& schemaName, int64_t schemaVersion);
+    void _releaseTxn(uint64_t startTs);
+    void _collectGarbage(std::vector<Version>& versions);
+
+    void _loadSnapshot();
+    void _saveSnapshot();
+
+    std::mutex _mutex;
+    std::unordered_map<std::string, Collection> _collections;
+    // timestamp of the last commit
+    uint64_t _clock{0};
+    // start timestamps of the running txns, used to trim old versions
+    std::multiset<uint64_t> _activeTxns;
+    uint64_t _nextTxnId{0};
+
+    k2::Duration _latency;
+    uint32_t _pageSize;
+    std::string _snapshotFile;
+    DelayQueue _delays;
+};
+
+} // ns inproc
+} // ns k2pg
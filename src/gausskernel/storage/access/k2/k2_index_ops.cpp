@@ -224,9 +224,11 @@ Datum k2inrescan(PG_FUNCTION_ARGS)
 	ScanKey orderbys = (ScanKey)PG_GETARG_POINTER(3);
 	int norderbys = (int)PG_GETARG_INT32(4);
 
+	K2PgScanStats prior_stats{};
 	if (scan->opaque)
 	{
-		/* For rescan, end the previous scan. */
+		/* For rescan, end the previous scan but keep its counters for EXPLAIN ANALYZE. */
+		camGetScanStats((CamScanDesc)scan->opaque, &prior_stats);
 		Datum args[1];
 		FunctionCallInfoData finfo;
 		finfo.arg = &args[0];
@@ -238,6 +240,7 @@ Datum k2inrescan(PG_FUNCTION_ARGS)
 	CamScanDesc camScan = camBeginScan(scan->heapRelation, scan->indexRelation, scan->xs_want_itup,
 																	 nscankeys, scankey);
 	camScan->index = scan->indexRelation;
+	camScan->stats = prior_stats;
 	scan->opaque = camScan;
 
 	PG_RETURN_VOID();
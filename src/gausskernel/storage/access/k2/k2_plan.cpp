@@ -26,10 +26,12 @@ Copyright(c) 2022 Futurewei Cloud
 #include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
 #include "nodes/makefuncs.h"
+#include "nodes/nodeFuncs.h"
 #include "nodes/nodes.h"
 #include "nodes/plannodes.h"
 #include "nodes/print.h"
 #include "nodes/relation.h"
+#include "optimizer/clauses.h"
 #include "utils/datum.h"
 #include "utils/rel.h"
 #include "utils/syscache.h"
@@ -475,6 +477,135 @@ bool K2PgIsSingleRowUpdateOrDelete(ModifyTable *modifyTable)
 	return true;
 }
 
+/*
+ * Returns true if the following are all true:
+ *  - is update or delete command without RETURNING.
+ *  - only one target table.
+ *  - source data is a K2 foreign scan of the target table itself, so every row
+ *    is produced once and by its k2pgctid.
+ *  - neither the scan quals nor the new column values contain subqueries, and
+ *    every SET expression is one that K2PgIsSupportedSingleRowModifyAssignExpr
+ *    accepts, i.e. it only reads the target column.
+ *
+ * Such a statement never reads the table again while its writes are being
+ * applied, so the writes do not have to complete one at a time.
+ */
+bool K2PgIsBulkUpdateOrDelete(ModifyTable *modifyTable)
+{
+	/* Support UPDATE and DELETE. */
+	if (modifyTable->operation != CMD_UPDATE &&
+		modifyTable->operation != CMD_DELETE)
+		return false;
+
+	if (list_length(modifyTable->resultRelations) != 1 ||
+		list_length(modifyTable->plans) != 1)
+		return false;
+
+	/* Rows must be returned one at a time with RETURNING */
+	if (modifyTable->returningLists != NIL)
+		return false;
+
+	if (modifyTable->plan.initPlan != NIL)
+		return false;
+
+	Plan *subplan = (Plan *) linitial(modifyTable->plans);
+	if (!IsA(subplan, ForeignScan) ||
+		((ForeignScan *) subplan)->scan.scanrelid != (Index) linitial_int(modifyTable->resultRelations))
+		return false;
+
+	if (subplan->initPlan != NIL || contain_subplans((Node *) subplan->qual))
+		return false;
+
+	if (modifyTable->operation == CMD_UPDATE)
+	{
+		ListCell *lc;
+		foreach(lc, subplan->targetlist)
+		{
+			TargetEntry *target = (TargetEntry *) lfirst(lc);
+			bool needs_pushdown = false;
+
+			if (target->resjunk)
+				continue;
+
+			if (!K2PgIsSupportedSingleRowModifyAssignExpr(target->expr,
+			                                             target->resno,
+			                                             &needs_pushdown))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Walker for K2PgIsNativeUpsert, true if the expression reads the existing row
+ * of the target table, i.e. anything other than EXCLUDED, or runs a subquery.
+ */
+static bool K2PgReadsExistingRowWalker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, Var))
+		return ((Var *) node)->varno != INNER_VAR;
+
+	if (IsA(node, SubPlan) || IsA(node, AlternativeSubPlan) || IsA(node, SubLink))
+		return true;
+
+	return expression_tree_walker(node, (bool (*)()) K2PgReadsExistingRowWalker, context);
+}
+
+/*
+ * Returns true if the following are all true:
+ *  - is an INSERT ... ON DUPLICATE KEY UPDATE or UPDATE NOTHING.
+ *  - only one target table and one data source.
+ *  - for UPDATE, there is no RETURNING and every SET expression only reads
+ *    the EXCLUDED row, so that the new values are known without reading the
+ *    existing row. Columns that are not assigned reference the existing row
+ *    with the same attribute number and are left as they are.
+ *
+ * The relation must also qualify, see K2PgBeginUpsert. Such an upsert is sent
+ * as a conditional write instead of checking the unique indexes first.
+ */
+bool K2PgIsNativeUpsert(ModifyTable *modifyTable)
+{
+	if (modifyTable->operation != CMD_INSERT ||
+		modifyTable->upsertAction == UPSERT_NONE)
+		return false;
+
+	if (list_length(modifyTable->resultRelations) != 1 ||
+		list_length(modifyTable->plans) != 1)
+		return false;
+
+	if (modifyTable->upsertAction == UPSERT_UPDATE)
+	{
+		ListCell *lc;
+
+		/* The updated row would have to be read back for RETURNING */
+		if (modifyTable->returningLists != NIL)
+			return false;
+
+		foreach(lc, modifyTable->updateTlist)
+		{
+			TargetEntry *target = (TargetEntry *) lfirst(lc);
+
+			if (target->resjunk)
+				continue;
+
+			/* Column that is not assigned */
+			if (IsA(target->expr, Var) &&
+				((Var *) target->expr)->varno != INNER_VAR &&
+				((Var *) target->expr)->varattno == target->resno)
+				continue;
+
+			if (K2PgReadsExistingRowWalker((Node *) target->expr, NULL))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /*
  * Returns true if provided Bitmapset of attribute numbers
  * matches the primary key attribute numbers of the relation.
@@ -0,0 +1,248 @@
+/*
+MIT License
+
+Copyright(c) 2022 Futurewei Cloud
+
+    Permission is hereby granted,
+    free of charge, to any person obtaining a copy of this software and associated documentation files(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and / or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS",
+    WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER
+    LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+// When we mix certain C++ standard lib code and pg code there seems to be a macro conflict that
+// will cause compiler errors in libintl.h. Including as the first thing fixes this.
+#include <libintl.h>
+#include "postgres.h"
+#include "funcapi.h"
+#include "catalog/pg_type.h"
+#include "utils/builtins.h"
+#include "utils/timestamp.h"
+
+#include "access/k2/k2_stat.h"
+#include "access/k2/op_metrics.h"
+#include "access/k2/pg_ids.h"
+
+#define K2_OPS_STAT_COLS 10
+#define K2_SCHEMAS_STAT_COLS 13
+
+/* one row of pg_stat_k2_ops */
+typedef struct K2OpStatRow {
+    const char* op;
+    int64 calls;
+    int64 errors;
+    int64 total_us;
+    int64 p50_us;
+    int64 p99_us;
+    int64 p999_us;
+    int64 max_us;
+    int64 bytes;
+    int64 records;
+} K2OpStatRow;
+
+/*
+ * Latency percentiles, bytes and records of the K2 operations issued by this node,
+ * aggregated over all threads
+ */
+Datum pg_stat_get_k2_ops(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* funcctx = NULL;
+    K2OpStatRow* entry = NULL;
+    MemoryContext oldcontext;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tupdesc;
+
+        funcctx = SRF_FIRSTCALL_INIT();
+        oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+        tupdesc = CreateTemplateTupleDesc(K2_OPS_STAT_COLS, false);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 1, "op", TEXTOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 2, "calls", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 3, "errors", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 4, "total_us", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 5, "p50_us", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 6, "p99_us", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 7, "p999_us", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 8, "max_us", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 9, "bytes", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 10, "records", INT8OID, -1, 0);
+        funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+        std::vector<k2pg::OpStatsSnapshot> stats = k2pg::GetK2OpStats();
+        K2OpStatRow* rows = (K2OpStatRow*)palloc0(sizeof(K2OpStatRow) * stats.size());
+        for (size_t i = 0; i < stats.size(); i++) {
+            const k2pg::OpStatsSnapshot& s = stats[i];
+            rows[i].op = k2pg::K2OpName(s.op);
+            rows[i].calls = (int64)s.calls;
+            rows[i].errors = (int64)s.errors;
+            rows[i].total_us = (int64)s.totalUsecs;
+            rows[i].p50_us = (int64)s.percentile(0.5);
+            rows[i].p99_us = (int64)s.percentile(0.99);
+            rows[i].p999_us = (int64)s.percentile(0.999);
+            rows[i].max_us = (int64)s.maxUsecs;
+            rows[i].bytes = (int64)s.bytes;
+            rows[i].records = (int64)s.records;
+        }
+        funcctx->user_fctx = (void*)rows;
+        funcctx->max_calls = stats.size();
+
+        (void)MemoryContextSwitchTo(oldcontext);
+    }
+
+    funcctx = SRF_PERCALL_SETUP();
+    entry = (K2OpStatRow*)funcctx->user_fctx;
+
+    if (funcctx->call_cntr < funcctx->max_calls) {
+        Datum values[K2_OPS_STAT_COLS];
+        bool nulls[K2_OPS_STAT_COLS] = {false};
+        HeapTuple tuple = NULL;
+
+        entry += funcctx->call_cntr;
+        values[0] = CStringGetTextDatum(entry->op);
+        values[1] = Int64GetDatum(entry->calls);
+        values[2] = Int64GetDatum(entry->errors);
+        values[3] = Int64GetDatum(entry->total_us);
+        values[4] = Int64GetDatum(entry->p50_us);
+        values[5] = Int64GetDatum(entry->p99_us);
+        values[6] = Int64GetDatum(entry->p999_us);
+        values[7] = Int64GetDatum(entry->max_us);
+        values[8] = Int64GetDatum(entry->bytes);
+        values[9] = Int64GetDatum(entry->records);
+
+        tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+    } else {
+        SRF_RETURN_DONE(funcctx);
+    }
+}
+
+/* one row of pg_stat_k2_schemas */
+typedef struct K2SchemaStatRow {
+    char* collection;
+    char* schema;
+    Oid datid;
+    Oid relid;
+    int64 reads;
+    int64 writes;
+    int64 query_pages;
+    int64 errors;
+    int64 records_read;
+    int64 records_written;
+    int64 bytes_read;
+    int64 bytes_written;
+    TimestampTz since;
+} K2SchemaStatRow;
+
+/*
+ * Requests, records and bytes this node sent to each SKV schema, that is to the key
+ * range of each table and index, since the schema was first accessed or the stats
+ * were reset. relid is null for schemas of the K2 catalog.
+ */
+Datum pg_stat_get_k2_schemas(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* funcctx = NULL;
+    K2SchemaStatRow* entry = NULL;
+    MemoryContext oldcontext;
+
+    if (SRF_IS_FIRSTCALL()) {
+        TupleDesc tupdesc;
+
+        funcctx = SRF_FIRSTCALL_INIT();
+        oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+        tupdesc = CreateTemplateTupleDesc(K2_SCHEMAS_STAT_COLS, false);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 1, "collection", TEXTOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 2, "schema", TEXTOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 3, "datid", OIDOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 4, "relid", OIDOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 5, "reads", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 6, "writes", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 7, "query_pages", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 8, "errors", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 9, "records_read", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 10, "records_written", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 11, "bytes_read", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 12, "bytes_written", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber) 13, "since", TIMESTAMPTZOID, -1, 0);
+        funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+        std::vector<k2pg::SchemaOpStatsSnapshot> stats = k2pg::GetSchemaOpStats();
+        K2SchemaStatRow* rows = (K2SchemaStatRow*)palloc0(sizeof(K2SchemaStatRow) * stats.size());
+        for (size_t i = 0; i < stats.size(); i++) {
+            const k2pg::SchemaOpStatsSnapshot& s = stats[i];
+            rows[i].collection = pstrdup(s.collection.c_str());
+            rows[i].schema = pstrdup(s.schema.c_str());
+            if (k2pg::PgObjectId::IsPgsqlId(s.schema)) {
+                rows[i].datid = k2pg::PgObjectId::GetDatabaseOidByTableUuid(s.schema);
+                rows[i].relid = k2pg::PgObjectId::GetTableOidByTableUuid(s.schema);
+            }
+            rows[i].reads = (int64)s.reads;
+            rows[i].writes = (int64)s.writes;
+            rows[i].query_pages = (int64)s.queryPages;
+            rows[i].errors = (int64)s.errors;
+            rows[i].records_read = (int64)s.recordsRead;
+            rows[i].records_written = (int64)s.recordsWritten;
+            rows[i].bytes_read = (int64)s.bytesRead;
+            rows[i].bytes_written = (int64)s.bytesWritten;
+            /* sinceUsecs counts from the Unix epoch */
+            rows[i].since = (TimestampTz)(s.sinceUsecs -
+                (int64)(POSTGRES_EPOCH_JDATE - UNIX_EPOCH_JDATE) * USECS_PER_DAY);
+        }
+        funcctx->user_fctx = (void*)rows;
+        funcctx->max_calls = stats.size();
+
+        (void)MemoryContextSwitchTo(oldcontext);
+    }
+
+    funcctx = SRF_PERCALL_SETUP();
+    entry = (K2SchemaStatRow*)funcctx->user_fctx;
+
+    if (funcctx->call_cntr < funcctx->max_calls) {
+        Datum values[K2_SCHEMAS_STAT_COLS];
+        bool nulls[K2_SCHEMAS_STAT_COLS] = {false};
+        HeapTuple tuple = NULL;
+
+        entry += funcctx->call_cntr;
+        values[0] = CStringGetTextDatum(entry->collection);
+        values[1] = CStringGetTextDatum(entry->schema);
+        values[2] = ObjectIdGetDatum(entry->datid);
+        nulls[2] = !OidIsValid(entry->datid);
+        values[3] = ObjectIdGetDatum(entry->relid);
+        nulls[3] = !OidIsValid(entry->relid);
+        values[4] = Int64GetDatum(entry->reads);
+        values[5] = Int64GetDatum(entry->writes);
+        values[6] = Int64GetDatum(entry->query_pages);
+        values[7] = Int64GetDatum(entry->errors);
+        values[8] = Int64GetDatum(entry->records_read);
+        values[9] = Int64GetDatum(entry->records_written);
+        values[10] = Int64GetDatum(entry->bytes_read);
+        values[11] = Int64GetDatum(entry->bytes_written);
+        values[12] = TimestampTzGetDatum(entry->since);
+
+        tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+    } else {
+        SRF_RETURN_DONE(funcctx);
+    }
+}
+
+/*
+ * Clear the K2 operation and schema statistics of this node
+ */
+Datum pg_stat_reset_k2_ops(PG_FUNCTION_ARGS)
+{
+    k2pg::ResetK2OpStats();
+    PG_RETURN_VOID();
+}
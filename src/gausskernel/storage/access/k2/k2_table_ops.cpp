@@ -41,9 +41,13 @@ Copyright(c) 2022 Futurewei Cloud
 #include "utils/inval.h"
 #include "utils/relcache.h"
 #include "utils/rel.h"
+#include "utils/rel_gs.h"
 #include "executor/tuptable.h"
 
 #include "utils/syscache.h"
+#include "catalog/index.h"
+#include "executor/executor.h"
+#include "parser/parsetree.h"
 #include "access/k2/k2_table_ops.h"
 #include "access/k2/k2_plan.h"
 #include "access/k2/pg_gate_api.h"
@@ -260,19 +264,38 @@ static bool IsSystemCatalogChange(Relation rel)
 }
 
 /*
- * Utility method to insert a tuple into the relation's backing K2PG table.
+ * Map the rowid_strategy reloption of a relation to the K2PG row id strategy.
+ * Only tables without primary key ('pkey' is empty) have a k2pgrowid column,
+ * the others always get K2PG_ROWID_RANDOM, i.e. nothing to generate here.
  */
-static Oid K2PgExecuteInsertInternal(Relation rel,
-                                    TupleDesc tupleDesc,
-                                     HeapTuple tuple)
+static K2PgRowIdStrategy GetRowIdStrategy(Relation rel, Bitmapset *pkey)
+{
+	if (!bms_is_empty(pkey))
+		return K2PG_ROWID_RANDOM;
+
+	const char *strategy = RelationGetRowIdStrategy(rel);
+
+	if (pg_strcasecmp(strategy, ROWID_STRATEGY_TIME_ORDERED) == 0)
+		return K2PG_ROWID_TIME_ORDERED;
+	if (pg_strcasecmp(strategy, ROWID_STRATEGY_SHARDED) == 0)
+		return K2PG_ROWID_SHARDED;
+	return K2PG_ROWID_RANDOM;
+}
+
+/*
+ * Utility method to collect the column values of a tuple for an insert into
+ * the relation's backing K2PG table.
+ */
+static void PrepareInsertColumns(Relation rel,
+                                 TupleDesc tupleDesc,
+                                 HeapTuple tuple,
+                                 Bitmapset *pkey,
+                                 K2PgRowIdStrategy strategy,
+                                 std::vector<K2PgAttributeDef>& columns)
 {
-	Oid            dboid    = K2PgGetDatabaseOid(rel);
-	Oid            relid    = RelationGetRelid(rel);
 	AttrNumber     minattr  = FirstLowInvalidHeapAttributeNumber + 1;
 	int            natts    = RelationGetNumberOfAttributes(rel);
-	Bitmapset      *pkey    = GetK2PgTablePrimaryKey(rel);
 	bool           is_null  = false;
-    std::vector<K2PgAttributeDef> columns;
 
 	/* Generate a new oid for this row if needed */
 	if (rel->rd_rel->relhasoids)
@@ -317,6 +340,40 @@ static Oid K2PgExecuteInsertInternal(Relation rel,
         columns.push_back(std::move(column));
 	}
 
+	/*
+	 * PgGate generates random row ids for tables without primary key, other
+	 * strategies come from the relation options, see GetRowIdStrategy().
+	 */
+	if (strategy != K2PG_ROWID_RANDOM)
+	{
+		Datum rowid = 0;
+		HandleK2PgStatus(PgGate_GenerateRowId(strategy, &rowid));
+		K2PgAttributeDef column {
+			.attr_num = K2PgRowIdAttributeNumber,
+			.value = {
+				.type_id = BYTEAOID,
+				.datum = rowid,
+				.is_null = false
+			}
+		};
+		columns.push_back(std::move(column));
+	}
+}
+
+/*
+ * Utility method to insert a tuple into the relation's backing K2PG table.
+ */
+static Oid K2PgExecuteInsertInternal(Relation rel,
+                                    TupleDesc tupleDesc,
+                                     HeapTuple tuple)
+{
+	Oid            dboid    = K2PgGetDatabaseOid(rel);
+	Oid            relid    = RelationGetRelid(rel);
+    std::vector<K2PgAttributeDef> columns;
+	Bitmapset     *pkey     = GetK2PgTablePrimaryKey(rel);
+
+	PrepareInsertColumns(rel, tupleDesc, tuple, pkey, GetRowIdStrategy(rel, pkey), columns);
+
 	/*
 	 * For system tables, mark tuple for invalidation from system caches
 	 * at next command boundary. Do this now so if there is an error with insert
@@ -492,6 +549,465 @@ void K2PgExecuteInsertIndex(Relation index,
 	HandleK2PgStatus(PgGate_ExecInsert(dboid, relid, upsert, false, columns, &k2pgtid));
 }
 
+/*
+ * Form the index row of a new tuple the same way as ExecInsertIndexTuples.
+ * Returns false if the index does not take the tuple, i.e. it is not ready
+ * for inserts yet or the tuple does not satisfy its predicate.
+ */
+static bool FormIndexValues(IndexInfo *indexInfo,
+                            TupleTableSlot *slot,
+                            EState *estate,
+                            Datum *values,
+                            bool *isnull)
+{
+	ExprContext *econtext = GetPerTupleExprContext(estate);
+	econtext->ecxt_scantuple = slot;
+
+	if (!indexInfo->ii_ReadyForInserts)
+		return false;
+
+	/* Check for partial index */
+	if (indexInfo->ii_Predicate != NIL)
+	{
+		List *predicate = indexInfo->ii_PredicateState;
+		if (predicate == NIL)
+		{
+			predicate = (List *) ExecPrepareExpr((Expr *) indexInfo->ii_Predicate, estate);
+			indexInfo->ii_PredicateState = predicate;
+		}
+
+		if (!ExecQual(predicate, econtext, false))
+			return false;
+	}
+
+	FormIndexDatum(indexInfo, slot, estate, values, isnull);
+	return true;
+}
+
+struct K2PgBulkInsertState
+{
+	ResultRelInfo  *resultRelInfo;
+	Bitmapset      *pkey;
+	K2PgRowIdStrategy rowidStrategy;
+	K2PgBulkInsert *table;
+	K2PgBulkInsert **indexes;	/* parallel to ri_IndexRelationDescs, NULL if not maintained here */
+	K2PgBulkInsertErrorRowHook errorRow;
+	void           *errorArg;
+};
+
+/*
+ * A write error may belong to an earlier row than the one being added, let
+ * the caller know which row failed before raising it. Index rows are upserted,
+ * so a unique violation can only come from the primary key of the table.
+ */
+static void HandleBulkInsertStatus(K2PgBulkInsertState *state, K2PgBulkInsert *handle, K2PgStatus status)
+{
+	if (status.IsOK())
+		return;
+
+	if (state->errorRow != NULL)
+		state->errorRow(state->errorArg, PgGate_BulkInsertFailedTag(handle));
+
+	HandleK2PgStatusForRelation(status, RelationGetRelid(state->resultRelInfo->ri_RelationDesc));
+}
+
+K2PgBulkInsertState *K2PgBeginBulkInsert(ResultRelInfo *resultRelInfo,
+                                         K2PgBulkInsertErrorRowHook errorRow,
+                                         void *errorArg)
+{
+	Relation rel = resultRelInfo->ri_RelationDesc;
+	Oid      dboid = K2PgGetDatabaseOid(rel);
+	K2PgBulkInsertState *state = (K2PgBulkInsertState *) palloc0(sizeof(K2PgBulkInsertState));
+
+	state->resultRelInfo = resultRelInfo;
+	state->pkey = GetK2PgTablePrimaryKey(rel);
+	state->rowidStrategy = GetRowIdStrategy(rel, state->pkey);
+	state->errorRow = errorRow;
+	state->errorArg = errorArg;
+	HandleK2PgStatus(PgGate_NewBulkInsert(dboid, RelationGetRelid(rel), false /* upsert */, &state->table));
+
+	if (resultRelInfo->ri_NumIndices > 0)
+	{
+		state->indexes = (K2PgBulkInsert **) palloc0(sizeof(K2PgBulkInsert *) * resultRelInfo->ri_NumIndices);
+		for (int i = 0; i < resultRelInfo->ri_NumIndices; i++)
+		{
+			Relation index = resultRelInfo->ri_IndexRelationDescs[i];
+
+			/* The primary key is the base table itself */
+			if (index == NULL || index->rd_index->indisprimary)
+				continue;
+
+			/* Same as K2PgExecuteInsertIndex, index rows are always upserted */
+			HandleK2PgStatus(PgGate_NewBulkInsert(dboid, RelationGetRelid(index), true /* upsert */,
+			                                      &state->indexes[i]));
+		}
+	}
+
+	return state;
+}
+
+void K2PgBulkInsertTuple(K2PgBulkInsertState *state,
+                         TupleTableSlot *slot,
+                         HeapTuple tuple,
+                         EState *estate,
+                         uint64 tag)
+{
+	ResultRelInfo *resultRelInfo = state->resultRelInfo;
+	Relation       rel = resultRelInfo->ri_RelationDesc;
+	std::vector<K2PgAttributeDef> columns;
+
+	PrepareInsertColumns(rel, slot->tts_tupleDescriptor, tuple, state->pkey, state->rowidStrategy, columns);
+
+	Datum k2pgtid = 0;
+	HandleBulkInsertStatus(state, state->table, PgGate_BulkInsertAdd(state->table, columns, tag, &k2pgtid));
+	tuple->t_k2pgctid = k2pgtid;
+
+	if (state->indexes == NULL)
+		return;
+
+	for (int i = 0; i < resultRelInfo->ri_NumIndices; i++)
+	{
+		Relation   index = resultRelInfo->ri_IndexRelationDescs[i];
+		IndexInfo *indexInfo = resultRelInfo->ri_IndexRelationInfo[i];
+		Datum      values[INDEX_MAX_KEYS];
+		bool       isnull[INDEX_MAX_KEYS];
+
+		if (state->indexes[i] == NULL ||
+			!FormIndexValues(indexInfo, slot, estate, values, isnull))
+			continue;
+
+		std::vector<K2PgAttributeDef> index_columns;
+		PrepareIndexWriteStmt(index, values, isnull,
+		                      RelationGetNumberOfAttributes(index),
+		                      k2pgtid, true /* k2pgctid_as_value */, index_columns);
+		HandleBulkInsertStatus(state, state->indexes[i],
+		                       PgGate_BulkInsertAdd(state->indexes[i], index_columns, tag, NULL));
+	}
+}
+
+void K2PgEndBulkInsert(K2PgBulkInsertState *state)
+{
+	HandleBulkInsertStatus(state, state->table, PgGate_BulkInsertFlush(state->table));
+
+	if (state->indexes != NULL)
+	{
+		for (int i = 0; i < state->resultRelInfo->ri_NumIndices; i++)
+		{
+			if (state->indexes[i] != NULL)
+				HandleBulkInsertStatus(state, state->indexes[i], PgGate_BulkInsertFlush(state->indexes[i]));
+		}
+		pfree(state->indexes);
+	}
+
+	pfree(state);
+}
+
+struct K2PgUpsertState
+{
+	ResultRelInfo  *resultRelInfo;
+	UpsertAction    action;
+	Bitmapset      *pkey;
+	K2PgRowIdStrategy rowidStrategy;
+	ExprContext    *econtext;
+	int             numAssigned;
+	AttrNumber     *assignedAttnums;	/* columns set by ON DUPLICATE KEY UPDATE */
+	ExprState     **assignedExprs;		/* their values, computed from the EXCLUDED row */
+};
+
+K2PgUpsertState *K2PgBeginUpsert(ModifyTableState *mtstate, EState *estate)
+{
+	ModifyTable   *plan = (ModifyTable *) mtstate->ps.plan;
+	ResultRelInfo *resultRelInfo = mtstate->resultRelInfo;
+	Relation       rel = resultRelInfo->ri_RelationDesc;
+	TupleDesc      tupleDesc = RelationGetDescr(rel);
+	bool           update = (plan->upsertAction == UPSERT_UPDATE);
+	Bitmapset     *indexed = NULL;
+
+	if (!IsK2PgRelation(rel) || !K2PgIsNativeUpsert(plan))
+		return NULL;
+
+	/* Catalog changes bump the catalog version per row */
+	if (IsSystemCatalogChange(rel))
+		return NULL;
+
+	for (int i = 0; i < resultRelInfo->ri_NumIndices; i++)
+	{
+		Relation   index = resultRelInfo->ri_IndexRelationDescs[i];
+		IndexInfo *indexInfo = resultRelInfo->ri_IndexRelationInfo[i];
+
+		/* The primary key is the base table itself */
+		if (index == NULL || index->rd_index->indisprimary)
+			continue;
+
+		if (indexInfo->ii_ExclusionOps != NULL ||
+			(indexInfo->ii_Unique && !index->rd_index->indimmediate))
+			return NULL;
+
+		if (!update)
+			continue;
+
+		/*
+		 * The row that owns a conflicting unique index entry is not known
+		 * without reading the index, and the old entry of an index on an
+		 * assigned column would have to be deleted.
+		 */
+		if (indexInfo->ii_Unique || indexInfo->ii_Expressions != NIL || indexInfo->ii_Predicate != NIL)
+			return NULL;
+
+		for (int k = 0; k < indexInfo->ii_NumIndexAttrs; k++)
+			indexed = bms_add_member(indexed, indexInfo->ii_KeyAttrNumbers[k]);
+	}
+
+	/* The new row version is not formed, so there is nothing to check or pass to triggers */
+	if (update &&
+		(K2PgRelHasOldRowTriggers(rel, CMD_UPDATE) ||
+		 (tupleDesc->constr != NULL &&
+		  (tupleDesc->constr->num_check > 0 || tupleDesc->constr->has_generated_stored))))
+	{
+		bms_free(indexed);
+		return NULL;
+	}
+
+	K2PgUpsertState *state = (K2PgUpsertState *) palloc0(sizeof(K2PgUpsertState));
+	state->resultRelInfo = resultRelInfo;
+	state->action = plan->upsertAction;
+	state->pkey = GetK2PgTablePrimaryKey(rel);
+	state->rowidStrategy = GetRowIdStrategy(rel, state->pkey);
+	state->econtext = mtstate->ps.ps_ExprContext;
+
+	if (update)
+	{
+		ListCell *lc;
+		int       ntargets = list_length(plan->updateTlist);
+
+		state->assignedAttnums = (AttrNumber *) palloc(sizeof(AttrNumber) * ntargets);
+		state->assignedExprs = (ExprState **) palloc(sizeof(ExprState *) * ntargets);
+
+		foreach(lc, plan->updateTlist)
+		{
+			TargetEntry *target = (TargetEntry *) lfirst(lc);
+			AttrNumber   attnum = target->resno;
+
+			if (target->resjunk || !IsRealK2PgColumn(rel, attnum))
+				continue;
+
+			/* Not assigned, see K2PgIsNativeUpsert */
+			if (IsA(target->expr, Var) &&
+				((Var *) target->expr)->varno != INNER_VAR &&
+				((Var *) target->expr)->varattno == attnum)
+				continue;
+
+			/* partialUpdate cannot move the row to another key */
+			if (bms_is_member(attnum - FirstLowInvalidHeapAttributeNumber - 1, state->pkey) ||
+				bms_is_member(attnum, indexed))
+			{
+				bms_free(indexed);
+				bms_free(state->pkey);
+				pfree(state->assignedAttnums);
+				pfree(state->assignedExprs);
+				pfree(state);
+				return NULL;
+			}
+
+			state->assignedAttnums[state->numAssigned] = attnum;
+			state->assignedExprs[state->numAssigned] = ExecInitExpr(target->expr, &mtstate->ps);
+			state->numAssigned++;
+		}
+	}
+
+	bms_free(indexed);
+	return state;
+}
+
+/*
+ * Insert the index rows of a tuple that was just inserted by K2PgUpsertTuple.
+ * Unique indexes go first and are written only if their key does not exist
+ * yet. On a conflict the unique entries written so far are deleted again and
+ * false is returned.
+ */
+static bool K2PgUpsertIndexTuples(K2PgUpsertState *state, TupleTableSlot *slot, EState *estate, Datum k2pgctid)
+{
+	ResultRelInfo *resultRelInfo = state->resultRelInfo;
+	int            numIndices = resultRelInfo->ri_NumIndices;
+	int            conflict = -1;
+
+	for (int i = 0; i < numIndices && conflict < 0; i++)
+	{
+		Relation   index = resultRelInfo->ri_IndexRelationDescs[i];
+		IndexInfo *indexInfo = resultRelInfo->ri_IndexRelationInfo[i];
+		Datum      values[INDEX_MAX_KEYS];
+		bool       isnull[INDEX_MAX_KEYS];
+		bool       exists = false;
+
+		if (index == NULL || index->rd_index->indisprimary || !indexInfo->ii_Unique ||
+			!FormIndexValues(indexInfo, slot, estate, values, isnull))
+			continue;
+
+		std::vector<K2PgAttributeDef> columns;
+		Datum index_tid = 0;
+		PrepareIndexWriteStmt(index, values, isnull,
+		                      RelationGetNumberOfAttributes(index),
+		                      k2pgctid, true /* k2pgctid_as_value */, columns);
+		HandleK2PgStatus(PgGate_ExecInsertIfNotExists(K2PgGetDatabaseOid(index), RelationGetRelid(index),
+		                                              columns, &index_tid, &exists));
+		if (exists)
+			conflict = i;
+	}
+
+	if (conflict >= 0)
+	{
+		for (int i = 0; i < conflict; i++)
+		{
+			Relation   index = resultRelInfo->ri_IndexRelationDescs[i];
+			IndexInfo *indexInfo = resultRelInfo->ri_IndexRelationInfo[i];
+			Datum      values[INDEX_MAX_KEYS];
+			bool       isnull[INDEX_MAX_KEYS];
+
+			if (index == NULL || index->rd_index->indisprimary || !indexInfo->ii_Unique ||
+				!FormIndexValues(indexInfo, slot, estate, values, isnull))
+				continue;
+
+			K2PgExecuteDeleteIndex(index, values, isnull, k2pgctid);
+		}
+		return false;
+	}
+
+	for (int i = 0; i < numIndices; i++)
+	{
+		Relation   index = resultRelInfo->ri_IndexRelationDescs[i];
+		IndexInfo *indexInfo = resultRelInfo->ri_IndexRelationInfo[i];
+		Datum      values[INDEX_MAX_KEYS];
+		bool       isnull[INDEX_MAX_KEYS];
+
+		if (index == NULL || index->rd_index->indisprimary || indexInfo->ii_Unique ||
+			!FormIndexValues(indexInfo, slot, estate, values, isnull))
+			continue;
+
+		K2PgExecuteInsertIndex(index, values, isnull, k2pgctid);
+	}
+
+	return true;
+}
+
+/*
+ * Apply the ON DUPLICATE KEY UPDATE assignments to the existing row with the
+ * given k2pgctid as a partial update.
+ */
+static void K2PgUpsertUpdateRow(K2PgUpsertState *state, TupleTableSlot *excluded, Datum k2pgctid)
+{
+	Relation     rel = state->resultRelInfo->ri_RelationDesc;
+	TupleDesc    tupleDesc = RelationGetDescr(rel);
+	ExprContext *econtext = state->econtext;
+	std::vector<K2PgAttributeDef> columns;
+
+	if (state->numAssigned == 0)
+		return;
+
+	K2PgAttributeDef k2id {
+		.attr_num = K2PgTupleIdAttributeNumber,
+		.value = {
+			.type_id = BYTEAOID,
+			.attr_size = -1,
+			.attr_byvalue = false,
+			.datum = k2pgctid,
+			.is_null = false
+		}
+	};
+	columns.push_back(std::move(k2id));
+
+	/* EXCLUDED references are INNER_VAR, the same as in ExecConflictUpdate */
+	ResetExprContext(econtext);
+	econtext->ecxt_scantuple = NULL;
+	econtext->ecxt_innertuple = excluded;
+	econtext->ecxt_outertuple = NULL;
+
+	for (int i = 0; i < state->numAssigned; i++)
+	{
+		AttrNumber attnum = state->assignedAttnums[i];
+		FormData_pg_attribute *att_desc = TupleDescAttr(tupleDesc, attnum - 1);
+		bool is_null = false;
+		Datum d = ExecEvalExpr(state->assignedExprs[i], econtext, &is_null, NULL);
+
+		if (is_null && att_desc->attnotnull)
+		{
+			ereport(ERROR,
+			        (errcode(ERRCODE_NOT_NULL_VIOLATION),
+			         errmsg("null value in column \"%s\" violates not-null constraint",
+			                NameStr(att_desc->attname))));
+		}
+
+		K2PgAttributeDef column {
+			.attr_num = attnum,
+			.value = {
+				.type_id = att_desc->atttypid,
+				.attr_size = att_desc->attlen,
+				.attr_byvalue = att_desc->attbyval,
+				.datum = d,
+				.is_null = is_null
+			}
+		};
+		columns.push_back(std::move(column));
+	}
+
+	HandleK2PgStatus(PgGate_ExecUpdate(K2PgGetDatabaseOid(rel), RelationGetRelid(rel),
+	                                   false /* increment catalog */, NULL /* rows affected */, columns));
+}
+
+bool K2PgUpsertTuple(K2PgUpsertState *state,
+                     TupleTableSlot *slot,
+                     HeapTuple tuple,
+                     EState *estate,
+                     bool canSetTag)
+{
+	Relation rel = state->resultRelInfo->ri_RelationDesc;
+	Oid      dboid = K2PgGetDatabaseOid(rel);
+	Oid      relid = RelationGetRelid(rel);
+	Datum    k2pgctid = 0;
+	bool     exists = false;
+	std::vector<K2PgAttributeDef> columns;
+
+	PrepareInsertColumns(rel, slot->tts_tupleDescriptor, tuple, state->pkey, state->rowidStrategy, columns);
+	HandleK2PgStatus(PgGate_ExecInsertIfNotExists(dboid, relid, columns, &k2pgctid, &exists));
+
+	if (!exists)
+	{
+		tuple->t_k2pgctid = k2pgctid;
+		if (K2PgUpsertIndexTuples(state, slot, estate, k2pgctid))
+			return true;
+
+		/*
+		 * A unique secondary index has the key already, which only DO NOTHING
+		 * allows, so take the new row back again.
+		 */
+		Assert(state->action == UPSERT_NOTHING);
+		std::vector<K2PgAttributeDef> key;
+		K2PgAttributeDef k2id {
+			.attr_num = K2PgTupleIdAttributeNumber,
+			.value = {
+				.type_id = BYTEAOID,
+				.attr_size = -1,
+				.attr_byvalue = false,
+				.datum = k2pgctid,
+				.is_null = false
+			}
+		};
+		key.push_back(std::move(k2id));
+		HandleK2PgStatus(PgGate_ExecDelete(dboid, relid, false /* increment catalog */, NULL /* rows affected */, key));
+		tuple->t_k2pgctid = 0;
+		return false;
+	}
+
+	/* The key exists, and the k2pgctid built from it is the one of the existing row */
+	if (state->action == UPSERT_UPDATE)
+	{
+		K2PgUpsertUpdateRow(state, slot, k2pgctid);
+		if (canSetTag)
+			(estate->es_processed)++;
+	}
+
+	return false;
+}
+
 bool K2PgExecuteDelete(Relation rel, TupleTableSlot *slot, EState *estate, ModifyTableState *mtstate)
 {
 	Oid            dboid          = K2PgGetDatabaseOid(rel);
@@ -560,6 +1076,193 @@ bool K2PgExecuteDelete(Relation rel, TupleTableSlot *slot, EState *estate, Modif
 	return !isSingleRow || rows_affected_count > 0;
 }
 
+struct K2PgBulkModifyState
+{
+	Relation        rel;
+	CmdType         operation;
+	K2PgBulkModify *handle;
+	uint64          rowsSent;
+};
+
+K2PgBulkModifyState *K2PgBeginBulkModify(ModifyTableState *mtstate, EState *estate)
+{
+	ModifyTable   *plan = (ModifyTable *) mtstate->ps.plan;
+	ResultRelInfo *resultRelInfo = mtstate->resultRelInfo;
+	Relation       rel = resultRelInfo->ri_RelationDesc;
+
+	if (!IsK2PgRelation(rel) || !K2PgIsBulkUpdateOrDelete(plan))
+		return NULL;
+
+	/*
+	 * Catalog changes bump the catalog version per row, and index entries and
+	 * row triggers are maintained by the executor one row at a time.
+	 */
+	if (IsSystemCatalogChange(rel) ||
+		K2PgRelHasSecondaryIndices(rel) ||
+		K2PgRelHasOldRowTriggers(rel, plan->operation))
+		return NULL;
+
+	/* A changed primary key moves the row, which partialUpdate cannot do */
+	if (plan->operation == CMD_UPDATE)
+	{
+		RangeTblEntry *rte = rt_fetch(resultRelInfo->ri_RangeTableIndex, estate->es_range_table);
+		Bitmapset     *pkey = GetK2PgTablePrimaryKey(rel);
+		bool           overlaps = bms_is_member(InvalidAttrNumber - FirstLowInvalidHeapAttributeNumber, rte->updatedCols);
+		int            member = -1;
+
+		/* pkey members are offset by FirstLowInvalidHeapAttributeNumber + 1 */
+		while (!overlaps && (member = bms_next_member(pkey, member)) >= 0)
+		{
+			AttrNumber attnum = member + FirstLowInvalidHeapAttributeNumber + 1;
+			overlaps = bms_is_member(attnum - FirstLowInvalidHeapAttributeNumber, rte->updatedCols);
+		}
+
+		bms_free(pkey);
+		if (overlaps)
+			return NULL;
+
+		/*
+		 * Only the updated columns are shipped, so a stored generated column,
+		 * which the executor recomputes and which is never in updatedCols,
+		 * would be left stale.
+		 */
+		TupleDesc tupdesc = RelationGetDescr(rel);
+		if (tupdesc->constr != NULL && tupdesc->constr->has_generated_stored)
+		{
+			for (int i = 0; i < tupdesc->natts; i++)
+			{
+				if (GetGeneratedCol(tupdesc, i) == ATTRIBUTE_GENERATED_STORED &&
+					!bms_is_member(i + 1 - FirstLowInvalidHeapAttributeNumber, rte->updatedCols))
+					return NULL;
+			}
+		}
+	}
+
+	K2PgBulkModifyState *state = (K2PgBulkModifyState *) palloc0(sizeof(K2PgBulkModifyState));
+	state->rel = rel;
+	state->operation = plan->operation;
+	HandleK2PgStatus(PgGate_NewBulkModify(K2PgGetDatabaseOid(rel), RelationGetRelid(rel), &state->handle));
+
+	return state;
+}
+
+static Datum K2PgBulkModifyTupleId(TupleTableSlot *slot, HeapTuple tuple)
+{
+	Datum k2pgctid = 0;
+
+	if (tuple != NULL && tuple->t_k2pgctid != 0)
+		k2pgctid = tuple->t_k2pgctid;
+	else
+		k2pgctid = K2PgGetPgTupleIdFromSlot(slot);
+
+	if (k2pgctid == 0)
+		k2pgctid = slot->tts_k2pgctid;
+
+	if (k2pgctid == 0)
+	{
+		ereport(ERROR,
+		        (errcode(ERRCODE_UNDEFINED_COLUMN), errmsg(
+					"Missing column k2pgctid in bulk modify request to K2PG database")));
+	}
+
+	return k2pgctid;
+}
+
+bool K2PgBulkDeleteTuple(K2PgBulkModifyState *state, TupleTableSlot *slot)
+{
+	Datum k2pgctid = K2PgBulkModifyTupleId(slot, NULL);
+	std::vector<K2PgAttributeDef> columns;
+
+	K2PgAttributeDef k2id {
+		.attr_num = K2PgTupleIdAttributeNumber,
+		.value = {
+			.type_id = BYTEAOID,
+			.attr_size = -1,
+			.attr_byvalue = false,
+			.datum = k2pgctid,
+			.is_null = false
+		}
+	};
+	columns.push_back(std::move(k2id));
+
+	/* Delete row from foreign key cache */
+	HandleK2PgStatus(PgGate_DeleteFromForeignKeyReferenceCache(RelationGetRelid(state->rel), k2pgctid));
+
+	HandleK2PgStatus(PgGate_BulkDeleteAdd(state->handle, columns));
+	state->rowsSent++;
+
+	/* The row was just returned by the scan in this transaction */
+	return true;
+}
+
+bool K2PgBulkUpdateTuple(K2PgBulkModifyState *state,
+                         TupleTableSlot *slot,
+                         HeapTuple tuple,
+                         Bitmapset *updatedCols)
+{
+	Relation  rel = state->rel;
+	TupleDesc tupleDesc = RelationGetDescr(rel);
+	Datum     k2pgctid = K2PgBulkModifyTupleId(slot, tuple);
+	std::vector<K2PgAttributeDef> columns;
+
+	K2PgAttributeDef k2id {
+		.attr_num = K2PgTupleIdAttributeNumber,
+		.value = {
+			.type_id = BYTEAOID,
+			.attr_size = -1,
+			.attr_byvalue = false,
+			.datum = k2pgctid,
+			.is_null = false
+		}
+	};
+	columns.push_back(std::move(k2id));
+
+	/* There are no row triggers, so only the SET columns can have changed */
+	for (int idx = 0; idx < tupleDesc->natts; idx++)
+	{
+		FormData_pg_attribute *att_desc = TupleDescAttr(tupleDesc, idx);
+		AttrNumber attnum = att_desc->attnum;
+
+		if (!IsRealK2PgColumn(rel, attnum))
+			continue;
+
+		if (!bms_is_member(attnum - FirstLowInvalidHeapAttributeNumber, updatedCols))
+			continue;
+
+		bool is_null = false;
+		Datum d = heap_getattr(tuple, attnum, tupleDesc, &is_null);
+		K2PgAttributeDef column {
+			.attr_num = attnum,
+			.value = {
+				.type_id = att_desc->atttypid,
+				.attr_size = att_desc->attlen,
+				.attr_byvalue = att_desc->attbyval,
+				.datum = d,
+				.is_null = is_null
+			}
+		};
+		columns.push_back(std::move(column));
+	}
+
+	HandleK2PgStatus(PgGate_BulkUpdateAdd(state->handle, columns));
+	state->rowsSent++;
+
+	return true;
+}
+
+void K2PgEndBulkModify(K2PgBulkModifyState *state)
+{
+	uint64_t rows_affected = 0;
+	HandleK2PgStatus(PgGate_BulkModifyFlush(state->handle, &rows_affected));
+
+	if (rows_affected != state->rowsSent)
+		elog(DEBUG1, "K2PG bulk %s of %s sent " UINT64_FORMAT " rows, " UINT64_FORMAT " were affected",
+		     state->operation == CMD_UPDATE ? "update" : "delete", RelationGetRelationName(state->rel),
+		     state->rowsSent, (uint64) rows_affected);
+
+	pfree(state);
+}
+
 void K2PgExecuteDeleteIndex(Relation index, Datum *values, const bool *isnull, Datum k2pgctid)
 {
   Assert(index->rd_rel->relkind == RELKIND_INDEX);
@@ -703,10 +1406,12 @@ bool K2PgExecuteUpdate(Relation rel,
 		 * Skip unmodified columns if possible.
 		 * Note: we only do this for the single-row case, as otherwise there
 		 * might be triggers that modify the heap tuple to set (other) columns
-		 * (e.g. using the SPI module functions).
+		 * (e.g. using the SPI module functions). Stored generated columns are
+		 * recomputed by the executor and are never in updatedCols.
 		 */
 		int bms_idx = attnum - FirstLowInvalidHeapAttributeNumber;
-		if (isSingleRow && !whole_row && !bms_is_member(bms_idx, updatedCols))
+		if (isSingleRow && !whole_row && !bms_is_member(bms_idx, updatedCols) &&
+			GetGeneratedCol(tupleDesc, idx) != ATTRIBUTE_GENERATED_STORED)
 			continue;
 
         bool is_null = false;
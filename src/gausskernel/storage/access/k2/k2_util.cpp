@@ -60,8 +60,12 @@ int K2CodeToPGCode(int k2code) {
 
 Status K2StatusToK2PgStatus(skv::http::Status&& status) {
     if(!status.is2xxOK()) {
+        int pg_code = K2CodeToPGCode(status.code);
+        if (IsReadOnlyTxnStatus(status)) {
+            pg_code = ERRCODE_READ_ONLY_SQL_TRANSACTION;
+        }
         K2PgStatus out_status{
-            .pg_code = K2CodeToPGCode(status.code),
+            .pg_code = pg_code,
             .k2_code = status.code,
             .msg = std::move(status.message),
             .detail = ""
@@ -92,12 +92,14 @@ K2FinishInitDB()
 /*  Database Functions. */
 
 void
-K2PgCreateDatabase(Oid dboid, const char *dbname, Oid src_dboid, Oid next_oid)
+K2PgCreateDatabase(Oid dboid, const char *dbname, Oid src_dboid, Oid next_oid,
+				   const K2PgCollectionOptions *options)
 {
 	HandleK2PgStatus(PgGate_ExecCreateDatabase(dbname,
 										  dboid,
 										  src_dboid,
-                                          next_oid));
+                                          next_oid,
+                                          options));
 }
 
 void
@@ -277,6 +279,14 @@ K2PgDropTable(Oid relationId)
                                           false /* if_exists */));
 }
 
+void
+K2PgTruncateTable(Relation rel)
+{
+	/* Delete the rows of the table and of its indexes, the relfilenodes are kept */
+	HandleK2PgStatus(PgGate_ExecTruncateTable(u_sess->proc_cxt.MyDatabaseId,
+	                                          RelationGetRelid(rel)));
+}
+
 void
 K2PgCreateIndex(const char *indexName,
 			   IndexInfo *indexInfo,
@@ -1027,6 +1027,21 @@ void camEndScan(CamScanDesc camScan)
 	pfree(camScan);
 }
 
+void camGetScanStats(CamScanDesc camScan, K2PgScanStats *stats)
+{
+	stats->create_queries += camScan->stats.create_queries;
+	stats->query_pages += camScan->stats.query_pages;
+	stats->records_received += camScan->stats.records_received;
+	stats->records_returned += camScan->stats.records_returned;
+	stats->records_passed += camScan->stats.records_passed;
+	stats->point_reads += camScan->stats.point_reads;
+	stats->bytes_received += camScan->stats.bytes_received;
+	stats->wait_usecs += camScan->stats.wait_usecs;
+
+	if (camScan->handle != NULL)
+		PgGate_AddScanStats(camScan->handle, stats);
+}
+
 static bool heaptuple_matches_key(HeapTuple tup,
 					  TupleDesc tupdesc,
 					  int nkeys,
@@ -1153,7 +1168,10 @@ HeapTuple cam_getnext_heaptuple(CamScanDesc camScan, bool is_forward_scan, bool
 	while (HeapTupleIsValid(tup = camFetchNextHeapTuple(camScan, is_forward_scan)))
 	{
 		if (heaptuple_matches_key(tup, camScan->target_desc, nkeys, key, sk_attno, recheck))
+		{
+			camScan->stats.records_passed++;
 			return tup;
+		}
 
 		heap_freetuple(tup);
 	}
@@ -1176,7 +1194,10 @@ IndexTuple cam_getnext_indextuple(CamScanDesc camScan, bool is_forward_scan, boo
 	while (PointerIsValid(tup = camFetchNextIndexTuple(camScan, index, is_forward_scan)))
 	{
 		if (indextuple_matches_key(tup, RelationGetDescr(index), nkeys, key, sk_attno, recheck))
+		{
+			camScan->stats.records_passed++;
 			return tup;
+		}
 
 		pfree(tup);
 	}
@@ -1495,7 +1516,7 @@ void camIndexCostEstimate(IndexPath *path, Selectivity *selectivity,
 	RelationClose(index);
 }
 
-HeapTuple CamFetchTuple(Relation relation, Datum k2pgctid)
+HeapTuple CamFetchTuple(Relation relation, Datum k2pgctid, K2PgScanStats *stats)
 {
 	K2PgScanHandle* k2pg_stmt;
 	TupleDesc      tupdesc = RelationGetDescr(relation);
@@ -1585,5 +1606,14 @@ HeapTuple CamFetchTuple(Relation relation, Datum k2pgctid)
 	pfree(values);
 	pfree(nulls);
 
+	/*
+	 * Charge the lookup to the index scan it was done for. The row is fetched by a
+	 * single-key query, so it is counted with the queries and pages, not the point reads.
+	 */
+	if (stats != NULL)
+	{
+		PgGate_AddScanStats(k2pg_stmt, stats);
+	}
+
 	return tuple;
 }
@@ -226,6 +226,20 @@ static void FetchUniqueConstraintName(Oid relation_id, char* dest, size_t max_si
 	RelationClose(rel);
 }
 
+void HandleK2PgStatusForRelation(const K2PgStatus& status, Oid relationId)
+{
+	if (status.pg_code == ERRCODE_UNIQUE_VIOLATION)
+	{
+		char constraint_name[NAMEDATALEN];
+
+		FetchUniqueConstraintName(relationId, constraint_name, sizeof(constraint_name));
+		ereport(ERROR,
+		        (errcode(ERRCODE_UNIQUE_VIOLATION),
+		         errmsg("duplicate key value violates unique constraint \"%s\"", constraint_name)));
+	}
+	HandleK2PgStatus(status);
+}
+
 void K2PgInitPostgresBackend(const char *program_name)
 {
 	if (K2PgIsEnabledInPostgresEnvVar() && !g_instance.k2_cxt.isK2ModelEnabled) {
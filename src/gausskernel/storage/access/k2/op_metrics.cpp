@@ -0,0 +1,334 @@
+/*
+MIT License
+
+Copyright(c) 2022 Futurewei Cloud
+
+    Permission is hereby granted,
+    free of charge, to any person obtaining a copy of this software and associated documentation files(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and / or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS",
+    WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER
+    LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "access/k2/op_metrics.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace k2pg {
+
+namespace {
+const char* const op_names[] = {
+    "read",
+    "write",
+    "partialUpdate",
+    "query",
+    "createQuery",
+    "destroyQuery",
+    "beginTxn",
+    "endTxn",
+    "txnTotal",
+    "getSchema",
+    "createSchema",
+    "createCollection",
+    "reserveOids",
+    "cachedRead",
+    "fkCheckBatch",
+    "fkLookupSaved"
+};
+static_assert(sizeof(op_names) / sizeof(op_names[0]) == static_cast<size_t>(K2Op::Count), "missing K2Op name");
+
+void addCounters(ThreadOpStats::OpCounters& to, const ThreadOpStats::OpCounters& from) {
+    to.calls.fetch_add(from.calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.errors.fetch_add(from.errors.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.totalUsecs.fetch_add(from.totalUsecs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.bytes.fetch_add(from.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.records.fetch_add(from.records.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    to.maxUsecs.store(std::max(to.maxUsecs.load(std::memory_order_relaxed), from.maxUsecs.load(std::memory_order_relaxed)),
+                      std::memory_order_relaxed);
+}
+
+void addCounters(OpStatsSnapshot& to, const ThreadOpStats::OpCounters& from) {
+    to.calls += from.calls.load(std::memory_order_relaxed);
+    to.errors += from.errors.load(std::memory_order_relaxed);
+    to.totalUsecs += from.totalUsecs.load(std::memory_order_relaxed);
+    to.bytes += from.bytes.load(std::memory_order_relaxed);
+    to.records += from.records.load(std::memory_order_relaxed);
+    to.maxUsecs = std::max(to.maxUsecs, from.maxUsecs.load(std::memory_order_relaxed));
+    for (int b = 0; b < LatencyHistogram::BUCKETS; ++b) {
+        to.buckets[b] += from.latency.count(b);
+    }
+}
+
+void clearCounters(ThreadOpStats::OpCounters& c) {
+    c.calls.store(0, std::memory_order_relaxed);
+    c.errors.store(0, std::memory_order_relaxed);
+    c.totalUsecs.store(0, std::memory_order_relaxed);
+    c.maxUsecs.store(0, std::memory_order_relaxed);
+    c.bytes.store(0, std::memory_order_relaxed);
+    c.records.store(0, std::memory_order_relaxed);
+    c.latency.clear();
+}
+
+// All live per-thread stats, plus the folded stats of the threads which have exited.
+// The registry lock is only taken when a thread starts or exits and by readers.
+class OpStatsRegistry {
+public:
+    void add(ThreadOpStats* stats) {
+        std::lock_guard<std::mutex> l(_lock);
+        _threads.push_back(stats);
+    }
+
+    void remove(ThreadOpStats* stats) {
+        std::lock_guard<std::mutex> l(_lock);
+        _threads.erase(std::remove(_threads.begin(), _threads.end(), stats), _threads.end());
+        for (int op = 0; op < static_cast<int>(K2Op::Count); ++op) {
+            addCounters(_retired.ops[op], stats->ops[op]);
+            _retired.ops[op].latency.add(stats->ops[op].latency);
+        }
+    }
+
+    std::vector<OpStatsSnapshot> snapshot() {
+        std::vector<OpStatsSnapshot> result(static_cast<size_t>(K2Op::Count));
+        for (int op = 0; op < static_cast<int>(K2Op::Count); ++op) {
+            result[op].op = static_cast<K2Op>(op);
+            result[op].buckets.resize(LatencyHistogram::BUCKETS, 0);
+        }
+
+        std::lock_guard<std::mutex> l(_lock);
+        for (int op = 0; op < static_cast<int>(K2Op::Count); ++op) {
+            addCounters(result[op], _retired.ops[op]);
+            for (ThreadOpStats* stats : _threads) {
+                addCounters(result[op], stats->ops[op]);
+            }
+        }
+        return result;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> l(_lock);
+        for (int op = 0; op < static_cast<int>(K2Op::Count); ++op) {
+            clearCounters(_retired.ops[op]);
+            for (ThreadOpStats* stats : _threads) {
+                clearCounters(stats->ops[op]);
+            }
+        }
+    }
+
+private:
+    std::mutex _lock;
+    std::vector<ThreadOpStats*> _threads;
+    ThreadOpStats _retired;
+};
+
+// never destroyed so that threads exiting during process shutdown can still unregister
+OpStatsRegistry& registry() {
+    static OpStatsRegistry* instance = new OpStatsRegistry();
+    return *instance;
+}
+
+struct ThreadOpStatsHolder {
+    ThreadOpStats stats;
+    ThreadOpStatsHolder() {
+        registry().add(&stats);
+    }
+    ~ThreadOpStatsHolder() {
+        registry().remove(&stats);
+    }
+};
+
+thread_local ThreadOpStatsHolder thread_op_stats;
+
+int64_t nowUsecs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Counters by collection and schema name. The lock is only taken on the first access of a thread to a
+// schema and by readers
+class SchemaOpStatsRegistry {
+public:
+    SchemaOpCounters* get(const std::string& collection, const std::string& schema) {
+        std::lock_guard<std::mutex> l(_lock);
+        std::unique_ptr<SchemaOpCounters>& counters = _schemas[std::make_pair(collection, schema)];
+        if (!counters) {
+            counters = std::make_unique<SchemaOpCounters>();
+            counters->sinceUsecs.store(nowUsecs(), std::memory_order_relaxed);
+        }
+        return counters.get();
+    }
+
+    std::vector<SchemaOpStatsSnapshot> snapshot() {
+        std::vector<SchemaOpStatsSnapshot> result;
+        std::lock_guard<std::mutex> l(_lock);
+        result.reserve(_schemas.size());
+        for (const auto& [key, c] : _schemas) {
+            SchemaOpStatsSnapshot s;
+            s.collection = key.first;
+            s.schema = key.second;
+            s.reads = c->reads.load(std::memory_order_relaxed);
+            s.writes = c->writes.load(std::memory_order_relaxed);
+            s.queryPages = c->queryPages.load(std::memory_order_relaxed);
+            s.errors = c->errors.load(std::memory_order_relaxed);
+            s.recordsRead = c->recordsRead.load(std::memory_order_relaxed);
+            s.recordsWritten = c->recordsWritten.load(std::memory_order_relaxed);
+            s.bytesRead = c->bytesRead.load(std::memory_order_relaxed);
+            s.bytesWritten = c->bytesWritten.load(std::memory_order_relaxed);
+            s.sinceUsecs = c->sinceUsecs.load(std::memory_order_relaxed);
+            result.push_back(std::move(s));
+        }
+        return result;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> l(_lock);
+        int64_t now = nowUsecs();
+        for (auto& [key, c] : _schemas) {
+            c->reads.store(0, std::memory_order_relaxed);
+            c->writes.store(0, std::memory_order_relaxed);
+            c->queryPages.store(0, std::memory_order_relaxed);
+            c->errors.store(0, std::memory_order_relaxed);
+            c->recordsRead.store(0, std::memory_order_relaxed);
+            c->recordsWritten.store(0, std::memory_order_relaxed);
+            c->bytesRead.store(0, std::memory_order_relaxed);
+            c->bytesWritten.store(0, std::memory_order_relaxed);
+            c->sinceUsecs.store(now, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::mutex _lock;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<SchemaOpCounters>> _schemas;
+};
+
+SchemaOpStatsRegistry& schemaRegistry() {
+    static SchemaOpStatsRegistry* instance = new SchemaOpStatsRegistry();
+    return *instance;
+}
+
+// collection and schema name separated by \0 -> counters
+thread_local std::unordered_map<std::string, SchemaOpCounters*> thread_schema_counters;
+} // anonymous ns
+
+const char* K2OpName(K2Op op) {
+    if (op >= K2Op::Count) {
+        return "unknown";
+    }
+    return op_names[static_cast<int>(op)];
+}
+
+int LatencyHistogram::bucketFor(uint64_t usecs) {
+    if (usecs < SUB_BUCKETS) {
+        return static_cast<int>(usecs);
+    }
+    int msb = 63 - __builtin_clzll(usecs);
+    if (msb >= MAX_VALUE_BITS) {
+        return BUCKETS - 1;
+    }
+    int shift = msb - SUB_BUCKET_BITS;
+    int sub = static_cast<int>((usecs >> shift) & (SUB_BUCKETS - 1));
+    return (shift + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketValue(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+    uint64_t lowest = (SUB_BUCKETS + sub) << shift;
+    return lowest + ((1ULL << shift) >> 1);
+}
+
+void LatencyHistogram::add(const LatencyHistogram& o) {
+    for (int b = 0; b < BUCKETS; ++b) {
+        _counts[b].fetch_add(o.count(b), std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::clear() {
+    for (int b = 0; b < BUCKETS; ++b) {
+        _counts[b].store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t OpStatsSnapshot::percentile(double quantile) const {
+    uint64_t total = 0;
+    for (uint64_t c : buckets) {
+        total += c;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // rank of the value at the quantile, 1-based
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(quantile * total + 0.5));
+    uint64_t seen = 0;
+    for (size_t b = 0; b < buckets.size(); ++b) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            return std::min(LatencyHistogram::bucketValue(static_cast<int>(b)), maxUsecs);
+        }
+    }
+    return maxUsecs;
+}
+
+void RecordK2Op(K2Op op, std::chrono::nanoseconds elapsed, bool ok, uint64_t bytes, uint64_t records) {
+    if (op >= K2Op::Count) {
+        return;
+    }
+    ThreadOpStats::OpCounters& c = thread_op_stats.stats.ops[static_cast<int>(op)];
+    uint64_t usecs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    c.latency.record(usecs);
+    c.calls.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) {
+        c.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    c.totalUsecs.fetch_add(usecs, std::memory_order_relaxed);
+    if (usecs > c.maxUsecs.load(std::memory_order_relaxed)) {
+        c.maxUsecs.store(usecs, std::memory_order_relaxed);
+    }
+    c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    c.records.fetch_add(records, std::memory_order_relaxed);
+}
+
+std::vector<OpStatsSnapshot> GetK2OpStats() {
+    return registry().snapshot();
+}
+
+void ResetK2OpStats() {
+    registry().reset();
+    schemaRegistry().reset();
+}
+
+SchemaOpCounters* GetSchemaOpCounters(const std::string& collection, const std::string& schema) {
+    std::string key;
+    key.reserve(collection.size() + schema.size() + 1);
+    key.append(collection).push_back('\0');
+    key.append(schema);
+    SchemaOpCounters*& counters = thread_schema_counters[key];
+    if (counters == nullptr) {
+        counters = schemaRegistry().get(collection, schema);
+    }
+    return counters;
+}
+
+std::vector<SchemaOpStatsSnapshot> GetSchemaOpStats() {
+    return schemaRegistry().snapshot();
+}
+
+} // ns
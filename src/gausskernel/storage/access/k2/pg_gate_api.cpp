@@ -26,7 +26,9 @@ Copyright(c) 2022 Futurewei Cloud
 #include <libintl.h>
 #include <unordered_map>
 #include <assert.h>
+#include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <memory>
 
 #include "access/k2/pg_session.h"
@@ -187,14 +189,38 @@ K2PgStatus PgGate_ConnectDatabase(const char *database_name) {
 K2PgStatus PgGate_ExecCreateDatabase(const char *database_name,
                                  K2PgOid database_oid,
                                  K2PgOid source_database_oid,
-                                 K2PgOid next_oid) {
+                                 K2PgOid next_oid,
+                                 const K2PgCollectionOptions *options) {
   elog(LOG, "PgGateAPI: PgGate_ExecCreateDatabase %s, %d, %d, %d",
          database_name, database_oid, source_database_oid, next_oid);
+  k2pg::CollectionPartitioning partitioning;
+  if (options != NULL) {
+    if (options->partitioning != NULL) {
+      partitioning.hashScheme = strcmp(options->partitioning, "range") == 0 ?
+          skv::http::dto::HashScheme::Range : skv::http::dto::HashScheme::HashCRC32C;
+    }
+    if (options->range_ends != NULL) {
+      // as in the config, an empty end key is the open end of the last partition
+      std::vector<std::string> rangeEnds;
+      std::string ends(options->range_ends);
+      size_t start = 0;
+      for (;;) {
+        size_t comma = ends.find(',', start);
+        rangeEnds.push_back(ends.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+        if (comma == std::string::npos) {
+          break;
+        }
+        start = comma + 1;
+      }
+      partitioning.rangeEnds = std::move(rangeEnds);
+    }
+    partitioning.minNodes = options->min_nodes > 0 ? options->min_nodes : 0;
+  }
   return pg_gate->GetCatalogClient()->CreateDatabase(database_name,
       k2pg::PgObjectId::GetDatabaseUuid(database_oid),
       database_oid,
       source_database_oid != k2pg::kPgInvalidOid ? k2pg::PgObjectId::GetDatabaseUuid(source_database_oid) : "",
-      "" /* creator_role_name */, next_oid);
+      "" /* creator_role_name */, next_oid, partitioning);
 }
 
 // Drop database.
@@ -238,6 +264,10 @@ K2PgStatus PgGate_GetCatalogMasterVersion(uint64_t *version) {
     return pg_gate->GetCatalogClient()->GetCatalogVersion(version);
 }
 
+bool PgGate_UseCatalogCacheSnapshot() {
+    return k2pg::TXMgr.getConfig().get<bool>("pggate.catalog_cache_snapshot", true);
+}
+
 void PgGate_InvalidateTableCache(
     const K2PgOid database_oid,
     const K2PgOid table_oid) {
@@ -390,6 +420,12 @@ K2PgStatus PgGate_ExecDropTable(K2PgOid database_oid,
   return status;
 }
 
+K2PgStatus PgGate_ExecTruncateTable(K2PgOid database_oid,
+                                    K2PgOid table_oid){
+  elog(LOG, "PgGateAPI: PgGate_ExecTruncateTable %d, %d", database_oid, table_oid);
+  return pg_gate->GetCatalogClient()->TruncateTable(database_oid, table_oid);
+}
+
 K2PgStatus PgGate_GetTableDesc(K2PgOid database_oid,
                             K2PgOid table_oid,
                             K2PgTableDesc *handle) {
@@ -497,32 +533,92 @@ K2PgStatus PgGate_ExecDropIndex(K2PgStatement handle){
 //--------------------------------------------------------------------------------------------------
 // DML statements (select, insert, update, delete, truncate)
 //--------------------------------------------------------------------------------------------------
+
+// Blocks on a K2 response for the given scan, charging the time spent waiting to its stats
+template <typename ResponseT>
+static ResponseT waitForScanResponse(K2PgScanHandle* handle, boost::future<ResponseT>& fut) {
+    auto start = k2::Clock::now();
+    ResponseT response = fut.get();
+    handle->stats.wait_usecs += std::chrono::duration_cast<std::chrono::microseconds>(k2::Clock::now() - start).count();
+    return response;
+}
+
+// The number of pages a scan may buffer ahead: its readahead depth, bounded by the memory the
+// pages take and by the pages the planner expects to remain
+static uint64_t scanReadaheadPages(const K2PgScanHandle* handle) {
+    uint64_t depth = handle->readaheadPages;
+    if (depth <= 1 || handle->lastPageRecords == 0) {
+        return depth;
+    }
+
+    if (handle->readaheadMaxBytes > 0 && handle->lastPageBytes > 0) {
+        depth = std::min(depth, std::max<uint64_t>(1, handle->readaheadMaxBytes / handle->lastPageBytes));
+    }
+    if (handle->estimatedRows > 0) {
+        double remaining = handle->estimatedRows - handle->stats.records_received;
+        uint64_t pages = remaining > 0 ? (uint64_t)std::ceil(remaining / handle->lastPageRecords) : 0;
+        depth = std::min(depth, std::max<uint64_t>(1, pages));
+    }
+    return depth;
+}
+
+// Requests the next query page unless one is in flight or enough records are buffered already
+static void requestQueryPage(K2PgScanHandle* handle) {
+    if (handle->queryInFlight || handle->queryDone) {
+        return;
+    }
+    if (handle->queryRecords.size() > scanReadaheadPages(handle) * handle->lastPageRecords) {
+        return;
+    }
+    handle->queryReq = k2pg::TXMgr.query(handle->query);
+    handle->queryInFlight = true;
+}
+
+// Saves the records of the in-flight query page, waiting for it if it did not arrive yet
+static K2PgStatus receiveQueryPage(K2PgScanHandle* handle) {
+    auto [status, resp] = waitForScanResponse(handle, handle->queryReq);
+    handle->queryInFlight = false;
+    if (!status.is2xxOK()) {
+        return k2pg::K2StatusToK2PgStatus(std::move(status));
+    }
+
+    handle->stats.query_pages++;
+    handle->stats.records_received += resp.records.size();
+    handle->lastPageRecords = resp.records.size();
+    handle->lastPageBytes = 0;
+    // Save the result records from the query
+    for (skv::http::dto::SKVRecord::Storage& storage : resp.records) {
+        handle->stats.bytes_received += storage.fieldData.size();
+        handle->lastPageBytes += storage.fieldData.size();
+        std::shared_ptr<skv::http::dto::Schema> schema = handle->secondarySchema ? handle->secondarySchema : handle->primarySchema;
+        skv::http::dto::SKVRecord record(handle->primaryTable->collection_name(), schema, std::move(storage));
+        handle->queryRecords.push_back(std::move(record));
+    }
+    handle->queryDone = resp.done;
+    return K2PgStatus::OK;
+}
+
 K2PgStatus PgGate_DmlFetch(K2PgScanHandle* handle, int32_t nattrs, uint64_t *values, bool *isnulls,
                         K2PgSysColumns *syscols, bool *has_data){
     elog(DEBUG5, "PgGateAPI: PgGate_DmlFetch handle: %p, nattrs: %d", handle, nattrs);
 
     *has_data = false;
 
-    // First check if we need to wait for more records from our top-level query
-    if (!handle->queryRecords.size() && handle->queryInFlight) {
-        auto [status, resp] = handle->queryReq.get();
-        handle->queryInFlight = false;
-        if (!status.is2xxOK()) {
-            return k2pg::K2StatusToK2PgStatus(std::move(status));
-        }
-
-        // Save the result records from the query
-        for (skv::http::dto::SKVRecord::Storage& storage : resp.records) {
-            std::shared_ptr<skv::http::dto::Schema> schema = handle->secondarySchema ? handle->secondarySchema : handle->primarySchema;
-            skv::http::dto::SKVRecord record(handle->primaryTable->collection_name(), schema, std::move(storage));
-            handle->queryRecords.push_back(std::move(record));
+    // Collect the page in flight of our top-level query as soon as it arrives, so that the next one
+    // is requested while the buffered records are returned. Wait for it if we ran out of records
+    if (handle->queryInFlight && handle->queryReq.is_ready()) {
+        K2PgStatus status = receiveQueryPage(handle);
+        if (!status.IsOK()) {
+            return status;
         }
-
-        // Prefetch the next page in the query
-        if (!resp.done) {
-            handle->queryReq = k2pg::TXMgr.query(handle->query);
-            handle->queryInFlight = true;
+    }
+    requestQueryPage(handle);
+    if (!handle->queryRecords.size() && handle->queryInFlight) {
+        K2PgStatus status = receiveQueryPage(handle);
+        if (!status.IsOK()) {
+            return status;
         }
+        requestQueryPage(handle);
     }
 
     // If we are doing a secondary index scan, try to keep a number of primary index read requests in flight
@@ -532,6 +628,7 @@ K2PgStatus PgGate_DmlFetch(K2PgScanHandle* handle, int32_t nattrs, uint64_t *val
                 skv::http::dto::SKVRecord readKey = makePrimaryKeyFromSecondary(handle->queryRecords.front(), handle->secondaryTable, handle->primarySchema);
                 handle->queryRecords.pop_front();
                 handle->readReqs.push_back(k2pg::TXMgr.read(std::move(readKey)));
+                handle->stats.point_reads++;
             }
             catch (const std::exception& err) {
                 K2PgStatus status {
@@ -555,11 +652,13 @@ K2PgStatus PgGate_DmlFetch(K2PgScanHandle* handle, int32_t nattrs, uint64_t *val
 
     // Get one record from the result set, either from the read requests (for secondary index scan) or from the query results (for primary scan)
     if (handle->secondarySchema) {
-        auto [status, resp] = handle->readReqs.front().get();
+        auto [status, resp] = waitForScanResponse(handle, handle->readReqs.front());
         handle->readReqs.pop_front();
         if (!status.is2xxOK()) {
             return k2pg::K2StatusToK2PgStatus(std::move(status));
         }
+        handle->stats.records_received++;
+        handle->stats.bytes_received += resp.getStorage().fieldData.size();
         resultRecord = std::move(resp);
     } else {
         resultRecord = std::move(handle->queryRecords.front());
@@ -570,25 +669,14 @@ K2PgStatus PgGate_DmlFetch(K2PgScanHandle* handle, int32_t nattrs, uint64_t *val
     K2PgStatus status = populateDatumsFromSKVRecord(resultRecord, handle->primaryTable, nattrs, values, isnulls, syscols);
     if (status.IsOK()) {
         *has_data = true;
+        handle->stats.records_returned++;
     }
 
     return status;
 }
 
-// This function returns the tuple id (k2pgctid) of a Postgres tuple.
-K2PgStatus PgGate_DmlBuildPgTupleId(Oid db_oid, Oid table_oid, const std::vector<K2PgAttributeDef>& attrs,
-                                    uint64_t *k2pgctid){
-    elog(DEBUG5, "PgGateAPI: PgGate_DmlBuildPgTupleId db: %d, table %d, attr size: %lu", db_oid, table_oid, attrs.size());
-
-    skv::http::dto::SKVRecord fullRecord;
-    std::shared_ptr<k2pg::PgTableDesc> pg_table = k2pg::pg_session->LoadTable(db_oid, table_oid);
-    K2PgStatus status = makeSKVRecordFromK2PgAttributes(db_oid, table_oid, attrs, fullRecord, pg_table);
-    if (status.pg_code != ERRCODE_SUCCESSFUL_COMPLETION) {
-        return status;
-    }
-    skv::http::dto::SKVRecord record = fullRecord.getSKVKeyRecord();
-
-
+// Serializes the key record into a tuple id (k2pgctid) datum allocated in the current memory context
+static K2PgStatus serializeTupleId(skv::http::dto::SKVRecord& record, uint64_t *k2pgctid) {
     // TODO can we remove some of the copies being done?
     skv::http::MPackWriter _writer;
     skv::http::Binary serializedStorage;
@@ -614,6 +702,22 @@ K2PgStatus PgGate_DmlBuildPgTupleId(Oid db_oid, Oid table_oid, const std::vector
     return K2PgStatus::OK;
 }
 
+// This function returns the tuple id (k2pgctid) of a Postgres tuple.
+K2PgStatus PgGate_DmlBuildPgTupleId(Oid db_oid, Oid table_oid, const std::vector<K2PgAttributeDef>& attrs,
+                                    uint64_t *k2pgctid){
+    elog(DEBUG5, "PgGateAPI: PgGate_DmlBuildPgTupleId db: %d, table %d, attr size: %lu", db_oid, table_oid, attrs.size());
+
+    skv::http::dto::SKVRecord fullRecord;
+    std::shared_ptr<k2pg::PgTableDesc> pg_table = k2pg::pg_session->LoadTable(db_oid, table_oid);
+    K2PgStatus status = makeSKVRecordFromK2PgAttributes(db_oid, table_oid, attrs, fullRecord, pg_table);
+    if (status.pg_code != ERRCODE_SUCCESSFUL_COMPLETION) {
+        return status;
+    }
+    skv::http::dto::SKVRecord record = fullRecord.getSKVKeyRecord();
+
+    return serializeTupleId(record, k2pgctid);
+}
+
 // INSERT ------------------------------------------------------------------------------------------
 
 K2PgStatus PgGate_ExecInsert(K2PgOid database_oid,
@@ -685,6 +789,180 @@ K2PgStatus PgGate_ExecInsert(K2PgOid database_oid,
     return status;
 }
 
+K2PgStatus PgGate_ExecInsertIfNotExists(K2PgOid database_oid,
+                                        K2PgOid table_oid,
+                                        std::vector<K2PgAttributeDef>& columns,
+                                        Datum* k2pgtupleid,
+                                        bool* exists) {
+    K2PgStatus status = PgGate_ExecInsert(database_oid, table_oid, false /* upsert */, false, columns, k2pgtupleid);
+    // 412 Precondition failed means that the NotExists precondition failed, i.e. the key exists
+    *exists = (status.k2_code == 412);
+    return *exists ? K2PgStatus::OK : status;
+}
+
+K2PgStatus PgGate_GenerateRowId(K2PgRowIdStrategy strategy, Datum* rowid) {
+    elog(DEBUG5, "PgGateAPI: PgGate_GenerateRowId strategy: %d", strategy);
+
+    k2pg::RowIdStrategy rowid_strategy = k2pg::RowIdStrategy::kRandom;
+    if (strategy == K2PG_ROWID_TIME_ORDERED) {
+        rowid_strategy = k2pg::RowIdStrategy::kTimeOrdered;
+    } else if (strategy == K2PG_ROWID_SHARDED) {
+        rowid_strategy = k2pg::RowIdStrategy::kSharded;
+    }
+    std::string row_id = k2pg::pg_session->GenerateNewRowid(rowid_strategy);
+    char* datum = (char*)(palloc0(row_id.size() + VARHDRSZ));
+    memcpy(VARDATA(datum), row_id.data(), row_id.size());
+    SET_VARSIZE(datum, row_id.size() + VARHDRSZ);
+    *rowid = PointerGetDatum(datum);
+    return K2PgStatus::OK;
+}
+
+K2PgStatus PgGate_NewBulkInsert(K2PgOid database_oid,
+                                K2PgOid table_oid,
+                                bool upsert,
+                                K2PgBulkInsert **handle) {
+    elog(DEBUG5, "PgGateAPI: PgGate_NewBulkInsert %d, %d, upsert: %d", database_oid, table_oid, upsert);
+
+    std::shared_ptr<k2pg::PgTableDesc> pg_table = k2pg::pg_session->LoadTable(database_oid, table_oid);
+    if (pg_table == nullptr) {
+        K2PgStatus status {
+            .pg_code = ERRCODE_INTERNAL_ERROR,
+            .k2_code = 404,
+            .msg = "LoadTable failed",
+            .detail = ""
+        };
+        return status;
+    }
+
+    auto [status, schema] = k2pg::TXMgr.getSchema(pg_table->collection_name(), pg_table->schema_name()).get();
+    if (!status.is2xxOK()) {
+        return k2pg::K2StatusToK2PgStatus(std::move(status));
+    }
+
+    *handle = new K2PgBulkInsert();
+    GetCurrentK2Memctx()->Cache([ptr=*handle] () { delete ptr;});
+    (*handle)->collectionName = pg_table->collection_name();
+    (*handle)->schema = schema;
+    (*handle)->table = pg_table;
+    (*handle)->tableId = pg_table->base_table_oid();
+    (*handle)->indexId = pg_table->base_table_oid() == table_oid ? 0 : table_oid;
+    (*handle)->upsert = upsert;
+    (*handle)->hasRowId = pg_table->FindColumn(k2pg::to_underlying(k2pg::PgSystemAttrNum::kPgRowId)) != NULL;
+    uint32_t maxInFlight = k2pg::TXMgr.getConfig().get<uint32_t>("pggate.bulk_insert_max_in_flight", 64);
+    (*handle)->maxInFlight = maxInFlight > 0 ? maxInFlight : 1;
+    for (const auto& column : pg_table->columns()) {
+        // we have two extra fields, i.e., table_id and index_id, in skv key
+        (*handle)->attrToField[column.attr_num()] = column.index() + K2_FIELD_OFFSET;
+    }
+
+    return K2PgStatus::OK;
+}
+
+// Waits for the oldest outstanding write, keeping the first error seen and the tag of its row
+static void waitBulkInsertFront(K2PgBulkInsert *handle) {
+    auto [k2status] = handle->inFlight.front().first.get();
+    uint64_t tag = handle->inFlight.front().second;
+    handle->inFlight.pop_front();
+    if (handle->firstError.IsOK() && !k2status.is2xxOK()) {
+        handle->firstError = k2pg::K2StatusToK2PgStatus(std::move(k2status));
+        handle->failedTag = tag;
+    }
+}
+
+K2PgStatus PgGate_BulkInsertAdd(K2PgBulkInsert *handle,
+                                const std::vector<K2PgAttributeDef>& columns,
+                                uint64_t tag,
+                                Datum* k2pgtupleid) {
+    elog(DEBUG5, "PgGateAPI: PgGate_BulkInsertAdd %s", handle->collectionName.c_str());
+
+    // errors found before the write is sent belong to this row
+    handle->failedTag = tag;
+
+    const std::vector<K2PgAttributeDef>* recordColumns = &columns;
+    std::vector<K2PgAttributeDef> columnsWithRowId;
+    if (handle->hasRowId) {
+        // generate a row_id to populate the kPgRowId column, unless the caller provided it
+        bool kPgRowIdProvided = false;
+        for (const auto& column: columns) {
+            if (column.attr_num == k2pg::to_underlying(k2pg::PgSystemAttrNum::kPgRowId)) {
+                kPgRowIdProvided = true;
+                break;
+            }
+        }
+        if (!kPgRowIdProvided) {
+            std::string row_id = k2pg::pg_session->GenerateNewRowid();
+            char* datum = (char*)(palloc0(row_id.size() + VARHDRSZ));
+            memcpy(VARDATA(datum), row_id.data(), row_id.size());
+            SET_VARSIZE(datum, row_id.size() + VARHDRSZ);
+            K2PgAttributeDef kPgRowIdColumn {
+                .attr_num = k2pg::to_underlying(k2pg::PgSystemAttrNum::kPgRowId),
+                .value = {
+                    .type_id = BYTEAOID,
+                    .datum = PointerGetDatum(datum),
+                    .is_null = false
+                }
+            };
+            columnsWithRowId = columns;
+            columnsWithRowId.push_back(std::move(kPgRowIdColumn));
+            recordColumns = &columnsWithRowId;
+        }
+    }
+
+    for (const auto& column : *recordColumns) {
+        if (handle->attrToField.find(column.attr_num) == handle->attrToField.end()) {
+            K2PgStatus status {
+                .pg_code = ERRCODE_INTERNAL_ERROR,
+                .k2_code = 404,
+                .msg = "Cannot find column with attr_num",
+                .detail = handle->table->table_name()
+            };
+            return status;
+        }
+    }
+
+    skv::http::dto::SKVRecordBuilder builder(handle->collectionName, handle->schema);
+    K2PgStatus status = serializePgAttributesToSKV(builder, handle->tableId, handle->indexId, *recordColumns, handle->attrToField);
+    if (status.pg_code != ERRCODE_SUCCESSFUL_COMPLETION) {
+        return status;
+    }
+    skv::http::dto::SKVRecord record = builder.build();
+
+    if (k2pgtupleid) {
+        skv::http::dto::SKVRecord keyRecord = record.getSKVKeyRecord();
+        status = serializeTupleId(keyRecord, k2pgtupleid);
+        if (status.pg_code != ERRCODE_SUCCESSFUL_COMPLETION) {
+            return status;
+        }
+    }
+
+    // Bound the number of outstanding writes, the caller encodes the next rows while these are in flight
+    while (handle->inFlight.size() >= handle->maxInFlight) {
+        waitBulkInsertFront(handle);
+    }
+    if (!handle->firstError.IsOK()) {
+        return handle->firstError;
+    }
+
+    handle->inFlight.emplace_back(k2pg::TXMgr.write(record, false,
+        handle->upsert ? skv::http::dto::ExistencePrecondition::None : skv::http::dto::ExistencePrecondition::NotExists), tag);
+
+    return K2PgStatus::OK;
+}
+
+K2PgStatus PgGate_BulkInsertFlush(K2PgBulkInsert *handle) {
+    elog(DEBUG5, "PgGateAPI: PgGate_BulkInsertFlush %s, in flight: %lu", handle->collectionName.c_str(), handle->inFlight.size());
+
+    while (!handle->inFlight.empty()) {
+        waitBulkInsertFront(handle);
+    }
+
+    return handle->firstError;
+}
+
+uint64_t PgGate_BulkInsertFailedTag(K2PgBulkInsert *handle) {
+    return handle->failedTag;
+}
+
 // UPDATE ------------------------------------------------------------------------------------------
 K2PgStatus PgGate_ExecUpdate(K2PgOid database_oid,
                              K2PgOid table_oid,
@@ -826,6 +1104,384 @@ K2PgStatus PgGate_ExecDelete(K2PgOid database_oid,
     return K2PgStatus::OK;
 }
 
+// BULK UPDATE AND DELETE --------------------------------------------------------------------------
+K2PgStatus PgGate_NewBulkModify(K2PgOid database_oid,
+                                K2PgOid table_oid,
+                                K2PgBulkModify **handle) {
+    elog(DEBUG5, "PgGateAPI: PgGate_NewBulkModify %d, %d", database_oid, table_oid);
+
+    std::shared_ptr<k2pg::PgTableDesc> pg_table = k2pg::pg_session->LoadTable(database_oid, table_oid);
+    if (pg_table == nullptr) {
+        K2PgStatus status {
+            .pg_code = ERRCODE_INTERNAL_ERROR,
+            .k2_code = 404,
+            .msg = "LoadTable failed",
+            .detail = ""
+        };
+        return status;
+    }
+
+    auto [status, schema] = k2pg::TXMgr.getSchema(pg_table->collection_name(), pg_table->schema_name()).get();
+    if (!status.is2xxOK()) {
+        return k2pg::K2StatusToK2PgStatus(std::move(status));
+    }
+
+    *handle = new K2PgBulkModify();
+    GetCurrentK2Memctx()->Cache([ptr=*handle] () { delete ptr;});
+    (*handle)->collectionName = pg_table->collection_name();
+    (*handle)->schema = schema;
+    (*handle)->table = pg_table;
+    uint32_t maxInFlight = k2pg::TXMgr.getConfig().get<uint32_t>("pggate.bulk_modify_max_in_flight", 64);
+    (*handle)->maxInFlight = maxInFlight > 0 ? maxInFlight : 1;
+
+    return K2PgStatus::OK;
+}
+
+// Waits for the oldest outstanding write. As for PgGate_ExecUpdate and PgGate_ExecDelete a failed
+// precondition only means that the row did not exist
+static void waitBulkModifyFront(K2PgBulkModify *handle) {
+    auto [k2status] = handle->inFlight.front().get();
+    handle->inFlight.pop_front();
+    if (k2status.is2xxOK()) {
+        handle->rowsAffected++;
+    } else if (handle->firstError.IsOK() && k2status.code != 412) {
+        handle->firstError = k2pg::K2StatusToK2PgStatus(std::move(k2status));
+    }
+}
+
+// Serializes the key fields of the row addressed by the tuple id attribute, which the caller got from a scan
+static K2PgStatus serializeBulkModifyKeys(K2PgBulkModify *handle,
+                                          const std::vector<K2PgAttributeDef>& columns,
+                                          skv::http::dto::SKVRecordBuilder& builder) {
+    for (const auto& column : columns) {
+        if (column.attr_num == K2PgTupleIdAttributeNumber && !column.value.is_null && column.value.datum != 0) {
+            skv::http::dto::SKVRecord record = tupleIDDatumToSKVRecord(column.value.datum, handle->collectionName, handle->schema);
+            return serializeKeysFromSKVRecord(record, builder);
+        }
+    }
+
+    K2PgStatus status {
+        .pg_code = ERRCODE_INTERNAL_ERROR,
+        .k2_code = 0,
+        .msg = "Missing tuple id in bulk update or delete",
+        .detail = handle->table->table_name()
+    };
+    return status;
+}
+
+// Bounds the number of outstanding writes before the next one is sent
+static K2PgStatus reserveBulkModifySlot(K2PgBulkModify *handle) {
+    while (handle->inFlight.size() >= handle->maxInFlight) {
+        waitBulkModifyFront(handle);
+    }
+    return handle->firstError;
+}
+
+K2PgStatus PgGate_BulkUpdateAdd(K2PgBulkModify *handle,
+                                const std::vector<K2PgAttributeDef>& columns) {
+    elog(DEBUG5, "PgGateAPI: PgGate_BulkUpdateAdd %s", handle->collectionName.c_str());
+
+    if (!handle->firstError.IsOK()) {
+        return handle->firstError;
+    }
+
+    skv::http::dto::SKVRecordBuilder builder(handle->collectionName, handle->schema);
+    K2PgStatus status = serializeBulkModifyKeys(handle, columns, builder);
+    if (status.pg_code != ERRCODE_SUCCESSFUL_COMPLETION) {
+        return status;
+    }
+
+    // Same field selection as PgGate_ExecUpdate
+    std::unordered_map<int, K2PgConstant> attr_map;
+    std::vector<uint32_t> fieldsForUpdate;
+    for (const auto& column : columns) {
+        if (column.attr_num == K2PgTupleIdAttributeNumber) {
+            continue;
+        }
+        k2pg::PgColumn *pg_column = handle->table->FindColumn(column.attr_num);
+        if (pg_column == NULL) {
+            K2PgStatus status {
+                .pg_code = ERRCODE_INTERNAL_ERROR,
+                .k2_code = 404,
+                .msg = "Cannot find column with attr_num",
+                .detail = handle->table->table_name()
+            };
+            return status;
+        }
+        // we have two extra fields, i.e., table_id and index_id, in skv key
+        fieldsForUpdate.push_back(pg_column->index() + K2_FIELD_OFFSET);
+        attr_map[pg_column->index() + K2_FIELD_OFFSET] = column.value;
+    }
+
+    try {
+        size_t offset = handle->schema->partitionKeyFields.size();
+        for (size_t i = offset; i < handle->schema->fields.size(); ++i) {
+            auto it = attr_map.find(i);
+            if (it == attr_map.end()) {
+                builder.serializeNull();
+            } else {
+                serializePGConstToK2SKV(builder, it->second);
+            }
+        }
+    }
+    catch (const std::exception& err) {
+        K2PgStatus status {
+            .pg_code = ERRCODE_INTERNAL_ERROR,
+            .k2_code = 0,
+            .msg = "Serialization error in PgGate_BulkUpdateAdd",
+            .detail = err.what()
+        };
+        return status;
+    }
+
+    skv::http::dto::SKVRecord record = builder.build();
+    status = reserveBulkModifySlot(handle);
+    if (!status.IsOK()) {
+        return status;
+    }
+    handle->inFlight.push_back(k2pg::TXMgr.partialUpdate(record, std::move(fieldsForUpdate)));
+
+    return K2PgStatus::OK;
+}
+
+K2PgStatus PgGate_BulkDeleteAdd(K2PgBulkModify *handle,
+                                const std::vector<K2PgAttributeDef>& columns) {
+    elog(DEBUG5, "PgGateAPI: PgGate_BulkDeleteAdd %s", handle->collectionName.c_str());
+
+    if (!handle->firstError.IsOK()) {
+        return handle->firstError;
+    }
+
+    skv::http::dto::SKVRecordBuilder builder(handle->collectionName, handle->schema);
+    K2PgStatus status = serializeBulkModifyKeys(handle, columns, builder);
+    if (status.pg_code != ERRCODE_SUCCESSFUL_COMPLETION) {
+        return status;
+    }
+
+    // Serialize remaining non-key fields as null to create a valid SKVRecord
+    try {
+        size_t offset = handle->schema->partitionKeyFields.size();
+        for (size_t i = offset; i < handle->schema->fields.size(); ++i) {
+            builder.serializeNull();
+        }
+    }
+    catch (const std::exception& err) {
+        K2PgStatus status {
+            .pg_code = ERRCODE_INTERNAL_ERROR,
+            .k2_code = 0,
+            .msg = "Serialization error in PgGate_BulkDeleteAdd",
+            .detail = err.what()
+        };
+        return status;
+    }
+
+    skv::http::dto::SKVRecord record = builder.build();
+    status = reserveBulkModifySlot(handle);
+    if (!status.IsOK()) {
+        return status;
+    }
+    handle->inFlight.push_back(k2pg::TXMgr.write(record, true, skv::http::dto::ExistencePrecondition::Exists));
+
+    return K2PgStatus::OK;
+}
+
+K2PgStatus PgGate_BulkModifyFlush(K2PgBulkModify *handle, uint64_t *rows_affected) {
+    elog(DEBUG5, "PgGateAPI: PgGate_BulkModifyFlush %s, in flight: %lu", handle->collectionName.c_str(), handle->inFlight.size());
+
+    while (!handle->inFlight.empty()) {
+        waitBulkModifyFront(handle);
+    }
+    if (rows_affected) {
+        *rows_affected = handle->rowsAffected;
+    }
+
+    return handle->firstError;
+}
+
+// POINT OPERATIONS --------------------------------------------------------------------------------
+K2PgStatus PgGate_NewPointOp(K2PgOid database_oid,
+                             K2PgOid table_oid,
+                             K2PgPointOpType type,
+                             K2PgPointOp **handle) {
+    elog(DEBUG5, "PgGateAPI: PgGate_NewPointOp %d, %d, type: %d", database_oid, table_oid, type);
+
+    std::shared_ptr<k2pg::PgTableDesc> pg_table = k2pg::pg_session->LoadTable(database_oid, table_oid);
+    if (pg_table == nullptr) {
+        K2PgStatus status {
+            .pg_code = ERRCODE_INTERNAL_ERROR,
+            .k2_code = 404,
+            .msg = "LoadTable failed",
+            .detail = ""
+        };
+        return status;
+    }
+
+    // Tables without a primary key need a generated k2pgrowid, which is left to the regular insert path
+    if (pg_table->FindColumn(k2pg::to_underlying(k2pg::PgSystemAttrNum::kPgRowId)) != NULL) {
+        K2PgStatus status {
+            .pg_code = ERRCODE_FEATURE_NOT_SUPPORTED,
+            .k2_code = 0,
+            .msg = "Point operations require a primary key",
+            .detail = pg_table->table_name()
+        };
+        return status;
+    }
+
+    auto [status, schema] = k2pg::TXMgr.getSchema(pg_table->collection_name(), pg_table->schema_name()).get();
+    if (!status.is2xxOK()) {
+        return k2pg::K2StatusToK2PgStatus(std::move(status));
+    }
+
+    *handle = new K2PgPointOp();
+    GetCurrentK2Memctx()->Cache([ptr=*handle] () { delete ptr;});
+    (*handle)->type = type;
+    (*handle)->collectionName = pg_table->collection_name();
+    (*handle)->schema = schema;
+    (*handle)->table = pg_table;
+    (*handle)->tableId = pg_table->base_table_oid();
+    (*handle)->indexId = pg_table->base_table_oid() == table_oid ? 0 : table_oid;
+    for (const auto& column : pg_table->columns()) {
+        if (column.attr_num() <= 0) {
+            continue;
+        }
+        if ((size_t)column.attr_num() >= (*handle)->attrToField.size()) {
+            (*handle)->attrToField.resize(column.attr_num() + 1, -1);
+        }
+        (*handle)->attrToField[column.attr_num()] = column.index() + K2_FIELD_OFFSET;
+    }
+
+    return K2PgStatus::OK;
+}
+
+// Serializes a full record for a point op, with the fields missing from columns set to null. If
+// fieldsForUpdate is given, the fields of all the passed in columns are collected into it
+static K2PgStatus makePointOpRecord(K2PgPointOp* handle, const std::vector<K2PgAttributeDef>& columns,
+                                    skv::http::dto::SKVRecord& record, std::vector<uint32_t>* fieldsForUpdate) {
+    std::vector<const K2PgConstant*> fieldValues(handle->schema->fields.size(), nullptr);
+    for (const auto& column : columns) {
+        if (column.attr_num <= 0 || (size_t)column.attr_num >= handle->attrToField.size() ||
+            handle->attrToField[column.attr_num] < 0) {
+            K2PgStatus status {
+                .pg_code = ERRCODE_INTERNAL_ERROR,
+                .k2_code = 404,
+                .msg = "Cannot find column with attr_num",
+                .detail = handle->table->table_name()
+            };
+            return status;
+        }
+        int field = handle->attrToField[column.attr_num];
+        fieldValues[field] = &column.value;
+        if (fieldsForUpdate) {
+            fieldsForUpdate->push_back(field);
+        }
+    }
+
+    try {
+        skv::http::dto::SKVRecordBuilder builder(handle->collectionName, handle->schema);
+        builder.serializeNext<int64_t>((int64_t)handle->tableId);
+        builder.serializeNext<int64_t>((int64_t)handle->indexId);
+        for (size_t i = K2_FIELD_OFFSET; i < fieldValues.size(); ++i) {
+            if (fieldValues[i] == nullptr) {
+                builder.serializeNull();
+            } else {
+                serializePGConstToK2SKV(builder, *fieldValues[i]);
+            }
+        }
+        record = builder.build();
+    }
+    catch (const std::exception& err) {
+        K2PgStatus status {
+            .pg_code = ERRCODE_INTERNAL_ERROR,
+            .k2_code = 0,
+            .msg = "Serialization error in makePointOpRecord",
+            .detail = err.what()
+        };
+
+        return status;
+    }
+
+    return K2PgStatus::OK;
+}
+
+K2PgStatus PgGate_ExecPointRead(K2PgPointOp *handle,
+                                const std::vector<K2PgAttributeDef>& keys,
+                                int32_t natts,
+                                uint64_t *values,
+                                bool *isnulls,
+                                bool *has_data) {
+    elog(DEBUG5, "PgGateAPI: PgGate_ExecPointRead %s", handle->collectionName.c_str());
+
+    *has_data = false;
+    skv::http::dto::SKVRecord record;
+    K2PgStatus status = makePointOpRecord(handle, keys, record, nullptr);
+    if (status.pg_code != ERRCODE_SUCCESSFUL_COMPLETION) {
+        return status;
+    }
+
+    auto [k2status, resp] = k2pg::TXMgr.read(record.getSKVKeyRecord()).get();
+    if (k2status.code == 404) {
+        return K2PgStatus::OK;
+    }
+    if (!k2status.is2xxOK()) {
+        return k2pg::K2StatusToK2PgStatus(std::move(k2status));
+    }
+
+    K2PgSysColumns syscols{};
+    status = populateDatumsFromSKVRecord(resp, handle->table, natts, values, isnulls, &syscols);
+    if (status.IsOK()) {
+        *has_data = true;
+    }
+
+    return status;
+}
+
+K2PgStatus PgGate_ExecPointWrite(K2PgPointOp *handle,
+                                 const std::vector<K2PgAttributeDef>& columns,
+                                 int *rows_affected) {
+    elog(DEBUG5, "PgGateAPI: PgGate_ExecPointWrite %s, type: %d", handle->collectionName.c_str(), handle->type);
+
+    *rows_affected = 0;
+    skv::http::dto::SKVRecord record;
+    std::vector<uint32_t> fieldsForUpdate;
+    K2PgStatus status = makePointOpRecord(handle, columns, record,
+                                          handle->type == K2PG_POINT_UPDATE ? &fieldsForUpdate : nullptr);
+    if (status.pg_code != ERRCODE_SUCCESSFUL_COMPLETION) {
+        return status;
+    }
+
+    boost::future<skv::http::Response<>> fut;
+    switch (handle->type) {
+        case K2PG_POINT_INSERT:
+            fut = k2pg::TXMgr.write(record, false, skv::http::dto::ExistencePrecondition::NotExists);
+            break;
+        case K2PG_POINT_UPDATE:
+            fut = k2pg::TXMgr.partialUpdate(record, std::move(fieldsForUpdate));
+            break;
+        case K2PG_POINT_DELETE:
+            fut = k2pg::TXMgr.write(record, true, skv::http::dto::ExistencePrecondition::Exists);
+            break;
+        default: {
+            K2PgStatus err {
+                .pg_code = ERRCODE_INTERNAL_ERROR,
+                .k2_code = 0,
+                .msg = "Invalid point op type for PgGate_ExecPointWrite",
+                .detail = ""
+            };
+            return err;
+        }
+    }
+
+    auto [k2status] = fut.get();
+    // For update and delete, 412 Precondition failed means the row does not exist, which is not an error for PG
+    if (!k2status.is2xxOK() && (k2status.code != 412 || handle->type == K2PG_POINT_INSERT)) {
+        return k2pg::K2StatusToK2PgStatus(std::move(k2status));
+    } else if (k2status.is2xxOK()) {
+        *rows_affected = 1;
+    }
+
+    return K2PgStatus::OK;
+}
+
 // SELECT ------------------------------------------------------------------------------------------
 K2PgStatus PgGate_NewSelect(K2PgOid database_oid,
                          K2PgOid table_oid,
@@ -1082,18 +1738,54 @@ K2PgStatus PgGate_ExecSelect(
         where_conds = Expression();
     }
 
-    auto [status, query] = k2pg::TXMgr.createQuery(start.build(), end.build(), std::move(where_conds), std::move(projection), limit, !forward_scan).get();
+    auto queryFut = k2pg::TXMgr.createQuery(start.build(), end.build(), std::move(where_conds), std::move(projection), limit, !forward_scan);
+    auto [status, query] = waitForScanResponse(handle, queryFut);
+    handle->stats.create_queries++;
     if (!status.is2xxOK()) {
         K2LOG_ERT(k2log::k2pg, "error creating query: {}", status);
         return k2pg::K2StatusToK2PgStatus(std::move(status));
     }
     handle->query = query;
+
+    // Pages are requested ahead of the rows being returned, unless few rows are expected: a LIMIT,
+    // a lookup by tuple id or a planner estimate of at most one row
+    bool pointLookup = false;
+    for (const K2PgConstraintDef& constraint: constraints) {
+        if (constraint.attr_num == K2PgTupleIdAttributeNumber && constraint.constraint == K2PG_CONSTRAINT_EQ) {
+            pointLookup = true;
+        }
+    }
+    if (limit > 0 || pointLookup || (handle->estimatedRows > 0 && handle->estimatedRows <= 1)) {
+        handle->readaheadPages = 0;
+    } else {
+        handle->readaheadPages = k2pg::TXMgr.getConfig().get<uint32_t>("pggate.scan_readahead_pages", 4);
+        handle->readaheadMaxBytes = k2pg::TXMgr.getConfig().get<uint64_t>("pggate.scan_readahead_max_bytes", 16 * 1024 * 1024);
+    }
+
     // prefetch first page
+    handle->queryDone = false;
+    handle->lastPageRecords = 0;
     handle->queryReq = k2pg::TXMgr.query(handle->query);
     handle->queryInFlight = true;
     return K2PgStatus::OK;
 }
 
+void PgGate_SetScanEstimate(K2PgScanHandle *handle, double estimated_rows) {
+    handle->estimatedRows = estimated_rows;
+}
+
+void PgGate_AddScanStats(const K2PgScanHandle* handle, K2PgScanStats* stats) {
+    const K2PgScanStats& scanStats = handle->stats;
+    stats->create_queries += scanStats.create_queries;
+    stats->query_pages += scanStats.query_pages;
+    stats->records_received += scanStats.records_received;
+    stats->records_returned += scanStats.records_returned;
+    stats->records_passed += scanStats.records_passed;
+    stats->point_reads += scanStats.point_reads;
+    stats->bytes_received += scanStats.bytes_received;
+    stats->wait_usecs += scanStats.wait_usecs;
+}
+
 // Transaction control -----------------------------------------------------------------------------
 
 K2PgStatus PgGate_BeginTransaction(){
@@ -1119,17 +1811,20 @@ K2PgStatus PgGate_AbortTransaction(){
 
 K2PgStatus PgGate_SetTransactionIsolationLevel(int isolation){
   elog(DEBUG5, "PgGateAPI: PgGate_SetTransactionIsolationLevel %d", isolation);
-  return K2PgStatus::NotSupported;
+  // K23SI txns are serializable, which satisfies every level PG can ask for
+  return K2PgStatus::OK;
 }
 
 K2PgStatus PgGate_SetTransactionReadOnly(bool read_only){
   elog(DEBUG5, "PgGateAPI: PgGate_SetTransactionReadOnly %d", read_only);
-  return K2PgStatus::NotSupported;
+  k2pg::TXMgr.setTxnReadOnly(read_only);
+  return K2PgStatus::OK;
 }
 
 K2PgStatus PgGate_SetTransactionDeferrable(bool deferrable){
-  elog(DEBUG5, "PgGateAPI: PgGate_SetTransactionReadOnly %d", deferrable);
-  return K2PgStatus::NotSupported;
+  elog(DEBUG5, "PgGateAPI: PgGate_SetTransactionDeferrable %d", deferrable);
+  // A K23SI read-only txn never has to wait for a safe snapshot, so there is nothing to defer
+  return K2PgStatus::OK;
 }
 
 K2PgStatus PgGate_EnterSeparateDdlTxnMode(){
@@ -1148,7 +1843,107 @@ K2PgStatus PgGate_ExitSeparateDdlTxnMode(bool success){
 // Check if foreign key reference exists in cache.
 bool PgGate_ForeignKeyReferenceExists(K2PgOid table_oid, const char* k2pgctid, int64_t k2pgctid_size) {
     elog(DEBUG5, "PgGateAPI: PgGate_ForeignKeyReferenceExists %d, %p, %ld", table_oid, k2pgctid, k2pgctid_size);
-    return k2pg::pg_session->ForeignKeyReferenceExists(table_oid, std::string(k2pgctid, k2pgctid_size));
+    bool exists = k2pg::pg_session->ForeignKeyReferenceExists(table_oid, std::string(k2pgctid, k2pgctid_size));
+    if (exists) {
+        k2pg::RecordK2Op(k2pg::K2Op::FKLookupSaved, std::chrono::nanoseconds{0}, true, 0, 1);
+    }
+    return exists;
+}
+
+int PgGate_GetForeignKeyCheckBatchSize() {
+    return k2pg::TXMgr.getConfig().get<int>("pggate.fk_check_batch_size", 1024);
+}
+
+// Waits for the oldest outstanding parent read of a foreign key check batch
+static K2PgStatus waitForeignKeyReadFront(std::deque<std::pair<size_t, boost::future<skv::http::Response<skv::http::dto::SKVRecord>>>>& inFlight,
+                                          std::vector<int>& keyState) {
+    auto [key, fut] = std::move(inFlight.front());
+    inFlight.pop_front();
+    auto [k2status, record] = fut.get();
+    if (k2status.is2xxOK()) {
+        keyState[key] = 1;
+    } else if (k2status.code == 404) {
+        keyState[key] = 0;
+    } else {
+        return k2pg::K2StatusToK2PgStatus(std::move(k2status));
+    }
+    return K2PgStatus::OK;
+}
+
+K2PgStatus PgGate_CheckForeignKeyReferences(K2PgOid database_oid,
+                                            K2PgOid table_oid,
+                                            const std::vector<std::string>& k2pgctids,
+                                            std::vector<bool>& exists) {
+    elog(DEBUG5, "PgGateAPI: PgGate_CheckForeignKeyReferences %d, %d, references: %lu", database_oid, table_oid, k2pgctids.size());
+
+    k2pg::Metric mt(k2pg::K2Op::FKCheckBatch);
+    exists.assign(k2pgctids.size(), false);
+
+    std::shared_ptr<k2pg::PgTableDesc> pg_table = k2pg::pg_session->LoadTable(database_oid, table_oid);
+    if (pg_table == nullptr) {
+        mt.report(false);
+        K2PgStatus status {
+            .pg_code = ERRCODE_INTERNAL_ERROR,
+            .k2_code = 404,
+            .msg = "LoadTable failed",
+            .detail = ""
+        };
+        return status;
+    }
+
+    auto [schema_status, schema] = k2pg::TXMgr.getSchema(pg_table->collection_name(), pg_table->schema_name()).get();
+    if (!schema_status.is2xxOK()) {
+        mt.report(false);
+        return k2pg::K2StatusToK2PgStatus(std::move(schema_status));
+    }
+
+    // Many child rows usually reference the same parent, each distinct key is read once
+    std::unordered_map<std::string, size_t> keyIndex;
+    std::vector<size_t> refToKey(k2pgctids.size());
+    for (size_t i = 0; i < k2pgctids.size(); ++i) {
+        refToKey[i] = keyIndex.emplace(k2pgctids[i], keyIndex.size()).first->second;
+    }
+
+    uint32_t maxInFlight = k2pg::TXMgr.getConfig().get<uint32_t>("pggate.fk_check_max_in_flight", 64);
+    maxInFlight = maxInFlight > 0 ? maxInFlight : 1;
+    std::vector<int> keyState(keyIndex.size(), -1);
+    std::deque<std::pair<size_t, boost::future<skv::http::Response<skv::http::dto::SKVRecord>>>> inFlight;
+    K2PgStatus status = K2PgStatus::OK;
+    for (const auto& [k2pgctid, key] : keyIndex) {
+        while (inFlight.size() >= maxInFlight && status.IsOK()) {
+            status = waitForeignKeyReadFront(inFlight, keyState);
+        }
+        if (!status.IsOK()) {
+            break;
+        }
+        skv::http::dto::SKVRecord record = tupleIDDatumToSKVRecord(PointerGetDatum(k2pgctid.data()), pg_table->collection_name(), schema);
+        inFlight.emplace_back(key, k2pg::TXMgr.read(std::move(record)));
+    }
+    while (!inFlight.empty()) {
+        K2PgStatus readStatus = waitForeignKeyReadFront(inFlight, keyState);
+        if (status.IsOK()) {
+            status = std::move(readStatus);
+        }
+    }
+    if (!status.IsOK()) {
+        mt.report(false);
+        return status;
+    }
+
+    for (const auto& [k2pgctid, key] : keyIndex) {
+        if (keyState[key] == 1) {
+            k2pg::pg_session->CacheForeignKeyReference(table_oid, std::string(k2pgctid));
+        }
+    }
+    for (size_t i = 0; i < k2pgctids.size(); ++i) {
+        exists[i] = keyState[refToKey[i]] == 1;
+    }
+
+    mt.report(true, 0, keyIndex.size());
+    if (k2pgctids.size() > keyIndex.size()) {
+        k2pg::RecordK2Op(k2pg::K2Op::FKLookupSaved, std::chrono::nanoseconds{0}, true, 0, k2pgctids.size() - keyIndex.size());
+    }
+    return K2PgStatus::OK;
 }
 
 // Add an entry to foreign key reference cache.
@@ -24,6 +24,9 @@ Copyright(c) 2022 Futurewei Cloud
 #include <string>
 #include <sstream>
 #include <assert.h>
+#include <chrono>
+#include <functional>
+#include <unistd.h>
 #include <boost/uuid/nil_generator.hpp>
 
 #include "access/k2/pg_ids.h"
@@ -91,6 +94,63 @@ std::string ObjectIdGenerator::Next(const bool binary_id) {
                    : b2a_hex(reinterpret_cast<const char *>(oid.data), sizeof(oid.data));
 }
 
+std::string RowIdGenerator::Next(RowIdStrategy strategy) {
+  switch (strategy) {
+    case RowIdStrategy::kTimeOrdered:
+      return NextTimeOrdered();
+    case RowIdStrategy::kSharded:
+      return NextSharded();
+    case RowIdStrategy::kRandom:
+    default: {
+      boost::uuids::uuid id = random_generator_();
+      return std::string(reinterpret_cast<const char *>(id.data), sizeof(id.data));
+    }
+  }
+}
+
+std::string RowIdGenerator::NextTimeOrdered() {
+  uint64_t millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+  // keep the ids of this session increasing if the clock goes back or the sequence wraps
+  if (millis > last_millis_) {
+    last_millis_ = millis;
+    millis_seq_ = 0;
+  } else if (++millis_seq_ > 0x0FFF) {
+    ++last_millis_;
+    millis_seq_ = 0;
+  }
+
+  boost::uuids::uuid id = random_generator_();
+  for (int i = 0; i < 6; i++) {
+    id.data[i] = (last_millis_ >> (40 - 8 * i)) & 0xFF;
+  }
+  id.data[6] = 0x70 | ((millis_seq_ >> 8) & 0x0F);
+  id.data[7] = millis_seq_ & 0xFF;
+  // RFC 4122 variant
+  id.data[8] = (id.data[8] & 0x3F) | 0x80;
+  return std::string(reinterpret_cast<const char *>(id.data), sizeof(id.data));
+}
+
+std::string RowIdGenerator::NextSharded() {
+  if (shard_prefix_.empty()) {
+    char host[256] = {0};
+    gethostname(host, sizeof(host) - 1);
+    uint32_t node = static_cast<uint32_t>(std::hash<std::string>{}(host));
+    boost::uuids::uuid session = random_generator_();
+    for (int i = 0; i < 4; i++) {
+      shard_prefix_.push_back(static_cast<char>((node >> (24 - 8 * i)) & 0xFF));
+    }
+    shard_prefix_.append(reinterpret_cast<const char *>(session.data), 8);
+  }
+
+  std::string rowid = shard_prefix_;
+  uint64_t seq = shard_seq_++;
+  for (int i = 0; i < 8; i++) {
+    rowid.push_back(static_cast<char>((seq >> (56 - 8 * i)) & 0xFF));
+  }
+  return rowid;
+}
+
 std::string PgObjectId::ToString() const {
   std::stringstream ss;
   ss << "(" << database_oid_ << ", " << object_oid_ << ")";
@@ -28,6 +28,7 @@ Copyright(c) 2022 Futurewei Cloud
 #include "access/k2/status.h"
 #include "access/k2/log.h"
 #include "access/k2/k2pg_aux.h"
+#include "access/k2/k2_util.h"
 #include "postgres.h"
 #include "access/xact.h"
 namespace k2pg {
@@ -51,21 +52,22 @@ static void K2XactCallback(XactEvent event, void* arg) {
             reportXactError("TXMgr abort failed", status);
         }
 
-        if (auto [status] = TXMgr.beginTxn().get(); !status.is2xxOK()) {
-            K2LOG_ECT(k2log::k2pg, "XACT_EVENT_START, TXMgr begin failed due to: {}", status);
-            reportXactError("TXMgr begin failed", status);
-        }
+        // The K2 txn is begun by the first K2 operation, so that PG txns which never reach K2 cost nothing
     } else if (event == XACT_EVENT_COMMIT) {
         K2LOG_DCT(k2log::k2pg, "event XACT_EVENT_COMMIT");
         elog(DEBUG2, "XACT_EVENT_COMMIT");
-        if (auto [status] = TXMgr.endTxn(sh::dto::EndAction::Commit).get(); !status.is2xxOK()) {
+        if (!TXMgr.isActive()) {
+            // no K2 operation was issued in this txn, there is nothing to commit but the txn state is still reset
+            TXMgr.endTxn(sh::dto::EndAction::Commit).get();
+        } else if (auto [status] = TXMgr.endTxn(sh::dto::EndAction::Commit).get(); !status.is2xxOK()) {
+            // a 410 here means the txn is gone on the server, e.g. expired or aborted, so its writes are lost
             K2LOG_ECT(k2log::k2pg, "XACT_EVENT_COMMIT, TXMgr commit failed due to: {}", status);
             reportXactError("TXMgr commit failed", status);
         }
     } else if (event == XACT_EVENT_ABORT) {
         K2LOG_DCT(k2log::k2pg, "event XACT_EVENT_ABORT");
         elog(DEBUG2, "XACT_EVENT_ABORT");
-        if (auto [status] = TXMgr.endTxn(sh::dto::EndAction::Abort).get(); !status.is2xxOK()) {
+        if (auto [status] = TXMgr.endTxn(sh::dto::EndAction::Abort).get(); (!status.is2xxOK() && status.code != 410)) {
             K2LOG_ECT(k2log::k2pg, "XACT_EVENT_ABORT, TXMgr abort failed due to: {}", status);
             reportXactError("TXMgr abort failed", status);
         }
@@ -88,17 +90,16 @@ void TxnManager::_init() {
                           lcfg.get<std::map<std::string, std::string>>("moduleOverrides")
             );
 
+        _asyncReadOnlyEnd = _config.sub("txn_opts").get<bool>("async_readonly_end", true);
+        _readCacheSize = _config.sub("txn_opts").get<uint32_t>("read_cache_size", 1024);
+
         RegisterXactCallback(K2XactCallback, NULL);
         // TODO
         // We don't really handle nested transactions separately - all ops are just bundled in the parent
         // if we did, register this callback to handle nested txns:
         // RegisterSubXactCallback(K2SubxactCallback, NULL);
         _initialized = true;
-        auto clientConfig = _config.sub("client");
-        std::string host = clientConfig.get<std::string>("host", "localhost");
-        int port = clientConfig.get<int>("port", 30000);
-        K2LOG_I(k2log::k2pg, "Initializing SKVClient with url {}:{}", host, port);
-        _client = std::make_shared<sh::Client>(host, port);
+        _client = makeSKVBackend(_config.sub("client"));
     }
 }
 
@@ -107,26 +108,107 @@ void TxnManager::setSessionTxnOpts(sh::dto::TxnOptions opts) {
     _txnOpts = std::move(opts);
 }
 
+void TxnManager::setTxnReadOnly(bool readOnly) {
+    K2LOG_DCT(k2log::k2pg, "txn read only: {}, has writes: {}", readOnly, _txnHasWrites);
+    _txnReadOnly = readOnly;
+}
+
+void TxnManager::_reapPendingEnds() {
+    // A txn without writes has nothing to finalize, its end only releases the txn state in SKV. Bound the
+    // number of outstanding ends so that a slow SKV cannot make them pile up
+    constexpr size_t maxPendingEnds = 16;
+    while (!_pendingEnds.empty() && (_pendingEnds.front().is_ready() || _pendingEnds.size() >= maxPendingEnds)) {
+        _pendingEnds.front().get();
+        _pendingEnds.pop_front();
+    }
+}
+
+std::string TxnManager::_cacheKey(sh::dto::SKVRecord& record) {
+    sh::dto::SKVRecord keyRecord = record.getSKVKeyRecord();
+    const auto& storage = keyRecord.getStorage();
+    std::string key = record.collectionName;
+    key.push_back('\0');
+    key += record.schema->name;
+    key.push_back('\0');
+    // null key fields are not in fieldData, only marked as excluded
+    for (bool excluded : storage.excludedFields) {
+        key.push_back(excluded ? '1' : '0');
+    }
+    key.push_back('\0');
+    key.append((const char*)storage.fieldData.data(), storage.fieldData.size());
+    return key;
+}
+
+void TxnManager::_cachePut(const std::string& key, uint64_t epoch, bool exists, sh::dto::SKVRecord* record) {
+    if (epoch != _cacheEpoch) {
+        return;
+    }
+    auto it = _cache.find(key);
+    if (it == _cache.end()) {
+        if (_cache.size() >= _readCacheSize) {
+            _cache.erase(_cacheLru.back());
+            _cacheLru.pop_back();
+        }
+        _cacheLru.push_front(key);
+        it = _cache.emplace(key, CachedRecord{}).first;
+        it->second.lru = _cacheLru.begin();
+    } else {
+        _cacheLru.splice(_cacheLru.begin(), _cacheLru, it->second.lru);
+    }
+    it->second.exists = exists;
+    if (exists) {
+        it->second.collectionName = record->collectionName;
+        it->second.schema = record->schema;
+        it->second.storage = record->getStorage().share();
+    }
+}
+
+void TxnManager::_cacheInvalidate(const std::string& key) {
+    ++_cacheEpoch;
+    auto it = _cache.find(key);
+    if (it != _cache.end()) {
+        _cacheLru.erase(it->second.lru);
+        _cache.erase(it);
+    }
+}
+
+void TxnManager::_cacheClear() {
+    ++_cacheEpoch;
+    _cache.clear();
+    _cacheLru.clear();
+}
+
+void TxnManager::_countWrite(SchemaOpCounters* counters, const sh::Status& status, uint64_t bytes) {
+    if (status.is2xxOK()) {
+        counters->recordsWritten.fetch_add(1, std::memory_order_relaxed);
+        counters->bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+    } else if (status.code != 412) {
+        // a failed existence precondition is the expected outcome of inserts of existing keys
+        counters->errors.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
 boost::future<sh::Response<>> TxnManager::beginTxn() {
     _init();
     auto status = sh::Statuses::S200_OK;
     if (!_txn) {
         K2LOG_DCT(k2log::k2pg, "Starting new transaction");
+        _reapPendingEnds();
         auto txConf = _config.sub("txn_opts");
         setSessionTxnOpts(sh::dto::TxnOptions{
                 .timeout= txConf.getDurationMillis("op_timeout_ms", 1s),
                 .priority= static_cast<sh::dto::TxnPriority>(txConf.get<uint8_t>("priority", 128)), // 0 is highest, 255 is lowest.
                 .syncFinalize = txConf.get<bool>("sync_finalize", false)
             });
-        Metric mt("beginTxn", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
-        _txnMt = Metric("txnTotalDuration", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+        Metric mt(K2Op::BeginTxn);
+        _txnMt = Metric(K2Op::TxnTotal);
         return _client->beginTxn(_txnOpts)
         .then([this, mt=std::move(mt)] (auto&& respFut) mutable {
-            mt.report();
             auto&& [status, handle] = respFut.get();
+            mt.report(status.is2xxOK());
             if (status.is2xxOK()) {
-                K2LOG_DCT(k2log::k2pg, "Started new txn: {}", handle);
-                _txn = std::make_unique<sh::TxnHandle>(std::move(handle));
+                _txn = std::move(handle);
+                K2LOG_DCT(k2log::k2pg, "Started new txn: {}", _txn->toString());
             } else {
                 K2LOG_ECT(k2log::k2pg, "Unable to begin txn due to: {}", status);
             }
@@ -139,17 +221,46 @@ boost::future<sh::Response<>> TxnManager::beginTxn() {
 
 boost::future<sh::Response<>> TxnManager::endTxn(sh::dto::EndAction endAction) {
     _init();
+    bool hasWrites = _txnHasWrites;
+    _txnReadOnly = false;
+    _txnHasWrites = false;
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _cacheClear();
+    }
+    {
+        // queries end with their txn
+        std::lock_guard<std::mutex> lock(_queryCountersMutex);
+        _queryCounters.clear();
+    }
+    if (_txn && !hasWrites && _asyncReadOnlyEnd) {
+        // Nothing was written, so the outcome of the end cannot change what the client sees. Don't wait for it
+        K2LOG_DCT(k2log::k2pg, "end txn without writes {}, with action: {}", _txn->toString(), endAction);
+        Metric mt(K2Op::EndTxn);
+        std::shared_ptr<SKVTxn> txn(std::move(_txn));
+        _pendingEnds.push_back(txn->endTxn(endAction)
+            .then([txn, mt=std::move(mt), txnMt=std::move(_txnMt)](auto&& respFut) mutable {
+                auto&& [status] = respFut.get();
+                txnMt.report(status.is2xxOK());
+                mt.report(status.is2xxOK());
+                if (!status.is2xxOK()) {
+                    K2LOG_WCT(k2log::k2pg, "error ending transaction without writes {}: {}", txn->toString(), status);
+                }
+                return sh::Response<>(std::move(status));
+            }));
+        return sh::MakeResponse<>(sh::Statuses::S200_OK);
+    }
     if (_txn) {
-        K2LOG_DCT(k2log::k2pg, "end txn {}, with action: {}", (*_txn), endAction);
-        Metric mt("endTxn", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+        K2LOG_DCT(k2log::k2pg, "end txn {}, with action: {}", _txn->toString(), endAction);
+        Metric mt(K2Op::EndTxn);
         return _txn->endTxn(endAction)
             .then([this, endAction, mt=std::move(mt)](auto&& respFut) mutable {
-                _txnMt.report();
-                mt.report();
-                K2LOG_DCT(k2log::k2pg, "txn {} ended, with action: {}", (*_txn), endAction);
+                K2LOG_DCT(k2log::k2pg, "txn {} ended, with action: {}", _txn->toString(), endAction);
                 auto&& [status] = respFut.get();
+                _txnMt.report(status.is2xxOK());
+                mt.report(status.is2xxOK());
                 if (!status.is2xxOK()) {
-                    K2LOG_ECT(k2log::k2pg, "error ending transaction{}: {}", (*_txn), status);
+                    K2LOG_ECT(k2log::k2pg, "error ending transaction{}: {}", _txn->toString(), status);
                 }
                 _txn.reset();
                 return sh::Response<>(std::move(status));
@@ -164,11 +275,11 @@ boost::future<sh::Response<std::shared_ptr<sh::dto::Schema>>>
 TxnManager::getSchema(const sh::String& collectionName, const sh::String& schemaName, int64_t schemaVersion) {
     _init();
     K2LOG_DCT(k2log::k2pg, "cname: {}, sname: {}, version: {}", collectionName, schemaName, schemaVersion);
-    Metric mt("getSchema", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+    Metric mt(K2Op::GetSchema);
     return _client->getSchema(collectionName, schemaName, schemaVersion)
         .then([mt=std::move(mt)](auto&& respFut) {
-            mt.report();
             auto&& [status, schema] = respFut.get();
+            mt.report(status.is2xxOK());
             if (!status.is2xxOK()) {
                 K2LOG_DCT(k2log::k2pg, "error: {}", status);
             }
@@ -180,11 +291,11 @@ boost::future<sh::Response<>>
 TxnManager::createSchema(const sh::String& collectionName, const sh::dto::Schema& schema) {
     _init();
     K2LOG_DCT(k2log::k2pg, "cname: {}, schema: {}", collectionName, schema);
-    Metric mt("createSchema", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+    Metric mt(K2Op::CreateSchema);
     return _client->createSchema(collectionName, schema)
         .then([mt=std::move(mt)](auto&& respFut) {
-            mt.report();
             auto&& [status] = respFut.get();
+            mt.report(status.is2xxOK());
             if (!status.is2xxOK()) {
                 K2LOG_ECT(k2log::k2pg, "error: {}", status);
             }
@@ -196,11 +307,11 @@ boost::future<sh::Response<>>
 TxnManager::createCollection(sh::dto::CollectionMetadata metadata, std::vector<sh::String> rangeEnds) {
     _init();
     K2LOG_DCT(k2log::k2pg, "createCollection: {}, rends: {}", metadata, rangeEnds);
-    Metric mt("createCollection", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+    Metric mt(K2Op::CreateCollection);
     return _client->createCollection(metadata, rangeEnds)
         .then([mt=std::move(mt)](auto&& respFut) {
-            mt.report();
             auto&& [status] = respFut.get();
+            mt.report(status.is2xxOK());
             if (!status.is2xxOK()) {
                 K2LOG_ECT(k2log::k2pg, "error: {}", status);
             }
@@ -209,14 +320,25 @@ TxnManager::createCollection(sh::dto::CollectionMetadata metadata, std::vector<s
 }
 
 boost::future<sh::Response<>>
-TxnManager::createCollection(const std::string& collection_name, const std::string& DBName) {
+TxnManager::createCollection(const std::string& collection_name, const std::string& DBName,
+                             const CollectionPartitioning& partitioning) {
     _init();
     K2LOG_DCT(k2log::k2pg, "Create collection: name={} for database: {}", collection_name, DBName);
 
+    // CREATE DATABASE options take precedence over the config of the database
     auto cconf = _config.sub("create_collections").sub(DBName);
-    std::vector<std::string> rangeEnds = cconf.get<std::vector<std::string>>("range_ends");
+    std::vector<std::string> rangeEnds = partitioning.rangeEnds.has_value() ? *partitioning.rangeEnds :
+        cconf.get<std::vector<std::string>>("range_ends");
 
-    sh::dto::HashScheme scheme = rangeEnds.size() ? sh::dto::HashScheme::Range : sh::dto::HashScheme::HashCRC32C;
+    sh::dto::HashScheme scheme = partitioning.hashScheme.has_value() ? *partitioning.hashScheme :
+        (rangeEnds.size() ? sh::dto::HashScheme::Range : sh::dto::HashScheme::HashCRC32C);
+    if (scheme != sh::dto::HashScheme::Range) {
+        rangeEnds.clear();
+    } else if (rangeEnds.empty()) {
+        return sh::MakeResponse<>(sh::Statuses::S400_Bad_Request(
+            fmt::format("range partitioning of collection {} requires range ends", collection_name)));
+    }
+    uint32_t minNodes = partitioning.minNodes > 0 ? partitioning.minNodes : cconf.get<uint32_t>("min_nodes", 1);
     sh::dto::CollectionMetadata metadata{
         .name = collection_name,
         .hashScheme = scheme,
@@ -225,7 +347,7 @@ TxnManager::createCollection(const std::string& collection_name, const std::stri
             .dataCapacityMegaBytes = 0,
             .readIOPs = 0,
             .writeIOPs = 0,
-            .minNodes = 1   // K2 Http proxy hangs if minNodes = 0
+            .minNodes = minNodes   // K2 Http proxy hangs if minNodes = 0
         },
         .retentionPeriod = cconf.getDurationMillis("retention_period", 1h*24*90),
         .heartbeatDeadline = sh::Duration(0),
@@ -238,7 +360,28 @@ TxnManager::createCollection(const std::string& collection_name, const std::stri
 boost::future<sh::Response<sh::dto::SKVRecord>>
 TxnManager::read(sh::dto::SKVRecord record) {
     K2LOG_DRT(k2log::k2pg, "read: {}", record);
-    Metric mt("read", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+    std::string cacheKey;
+    uint64_t epoch = 0;
+    if (_readCacheSize > 0) {
+        cacheKey = _cacheKey(record);
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        auto it = _cache.find(cacheKey);
+        if (it != _cache.end()) {
+            Metric mt(K2Op::CachedRead);
+            _cacheLru.splice(_cacheLru.begin(), _cacheLru, it->second.lru);
+            CachedRecord& cached = it->second;
+            mt.report(true, cached.exists ? cached.storage.fieldData.size() : 0, cached.exists ? 1 : 0);
+            if (!cached.exists) {
+                return sh::MakeResponse<sh::dto::SKVRecord>(sh::Statuses::S404_Not_Found("record not found"), sh::dto::SKVRecord{});
+            }
+            return sh::MakeResponse<sh::dto::SKVRecord>(sh::Statuses::S200_OK,
+                sh::dto::SKVRecord(cached.collectionName, cached.schema, cached.storage.share()));
+        }
+        epoch = _cacheEpoch;
+    }
+    Metric mt(K2Op::Read);
+    SchemaOpCounters* counters = GetSchemaOpCounters(record.collectionName, record.schema->name);
+    counters->reads.fetch_add(1, std::memory_order_relaxed);
     return beginTxn()
         .then([this, record = std::move(record)](auto&& beginFut) mutable {
             auto&& [beginStatus] = beginFut.get();
@@ -248,12 +391,22 @@ TxnManager::read(sh::dto::SKVRecord record) {
             return _txn->read(std::move(record));
         })
         .unwrap()
-        .then([mt=std::move(mt)](auto&& respFut) {
-            mt.report();
+        .then([this, mt=std::move(mt), counters, cacheKey=std::move(cacheKey), epoch](auto&& respFut) {
             auto&& [status, rec] = respFut.get();
+            mt.report(status.is2xxOK(), status.is2xxOK() ? rec.getStorage().fieldData.size() : 0, status.is2xxOK() ? 1 : 0);
+            if (status.is2xxOK()) {
+                counters->recordsRead.fetch_add(1, std::memory_order_relaxed);
+                counters->bytesRead.fetch_add(rec.getStorage().fieldData.size(), std::memory_order_relaxed);
+            } else if (status.code != 404) {
+                counters->errors.fetch_add(1, std::memory_order_relaxed);
+            }
             if (!status.is2xxOK()) {
                 K2LOG_ERT(k2log::k2pg, "error: {}", status);
             }
+            if (!cacheKey.empty() && (status.is2xxOK() || status.code == 404)) {
+                std::lock_guard<std::mutex> lock(_cacheMutex);
+                _cachePut(cacheKey, epoch, status.is2xxOK(), &rec);
+            }
             return sh::Response<sh::dto::SKVRecord>(std::move(status), rec);
         });
 }
@@ -262,7 +415,25 @@ boost::future<sh::Response<>>
 TxnManager::write(sh::dto::SKVRecord record, bool erase,
                   sh::dto::ExistencePrecondition precondition) {
     K2LOG_DWT(k2log::k2pg, "write: {}, erase: {}, precond: {}", record, erase, precondition);
-    Metric mt("write", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+    if (_txnReadOnly) {
+        return sh::MakeResponse<>(ReadOnlyTxnStatus());
+    }
+    _txnHasWrites = true;
+    // Drop the cached key now and cache the written record once the write succeeds
+    std::string cacheKey;
+    uint64_t epoch = 0;
+    std::shared_ptr<sh::dto::SKVRecord> cacheRecord;
+    if (_readCacheSize > 0) {
+        cacheKey = _cacheKey(record);
+        cacheRecord = std::make_shared<sh::dto::SKVRecord>(record.collectionName, record.schema, record.getStorage().share());
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _cacheInvalidate(cacheKey);
+        epoch = _cacheEpoch;
+    }
+    Metric mt(K2Op::Write);
+    uint64_t bytes = record.getStorage().fieldData.size();
+    SchemaOpCounters* counters = GetSchemaOpCounters(record.collectionName, record.schema->name);
+    counters->writes.fetch_add(1, std::memory_order_relaxed);
     return beginTxn()
         .then([this, record = std::move(record), erase = erase, precondition = precondition](auto&& beginFut) mutable {
             auto&& [beginStatus] = beginFut.get();
@@ -272,11 +443,15 @@ TxnManager::write(sh::dto::SKVRecord record, bool erase,
             return _txn->write(record, erase, precondition);
         })
         .unwrap()
-        .then([mt=std::move(mt)](auto&& respFut) {
-            mt.report();
+        .then([this, mt=std::move(mt), bytes, counters, cacheKey=std::move(cacheKey), epoch, erase, cacheRecord=std::move(cacheRecord)](auto&& respFut) {
             auto&& [status] = respFut.get();
+            mt.report(status.is2xxOK(), bytes, 1);
+            _countWrite(counters, status, bytes);
             if (!status.is2xxOK()) {
                 K2LOG_EWT(k2log::k2pg, "error: {}", status);
+            } else if (!cacheKey.empty()) {
+                std::lock_guard<std::mutex> lock(_cacheMutex);
+                _cachePut(cacheKey, epoch, !erase, cacheRecord.get());
             }
             return sh::Response<>(std::move(status));
         });
@@ -285,7 +460,20 @@ TxnManager::write(sh::dto::SKVRecord record, bool erase,
 boost::future<sh::Response<>>
 TxnManager::partialUpdate(sh::dto::SKVRecord record, std::vector<uint32_t> fieldsForPartialUpdate) {
     K2LOG_DWT(k2log::k2pg, "partialUpdate: {}, fields: {}", record, fieldsForPartialUpdate);
-    Metric mt("partialUpdate", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+    if (_txnReadOnly) {
+        return sh::MakeResponse<>(ReadOnlyTxnStatus());
+    }
+    _txnHasWrites = true;
+    // The merged record is only known to SKV, so the next read of this key goes there
+    if (_readCacheSize > 0) {
+        std::string cacheKey = _cacheKey(record);
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _cacheInvalidate(cacheKey);
+    }
+    Metric mt(K2Op::PartialUpdate);
+    uint64_t bytes = record.getStorage().fieldData.size();
+    SchemaOpCounters* counters = GetSchemaOpCounters(record.collectionName, record.schema->name);
+    counters->writes.fetch_add(1, std::memory_order_relaxed);
     return beginTxn()
         .then([this, record = std::move(record), fields = std::move(fieldsForPartialUpdate)](auto&& beginFut) mutable {
             auto&& [beginStatus] = beginFut.get();
@@ -295,9 +483,10 @@ TxnManager::partialUpdate(sh::dto::SKVRecord record, std::vector<uint32_t> field
             return _txn->partialUpdate(record, std::move(fields));
         })
         .unwrap()
-        .then([mt=std::move(mt)](auto&& respFut) {
-            mt.report();
+        .then([mt=std::move(mt), bytes, counters](auto&& respFut) {
             auto&& [status] = respFut.get();
+            mt.report(status.is2xxOK(), bytes, 1);
+            _countWrite(counters, status, bytes);
             if (!status.is2xxOK()) {
                 K2LOG_EWT(k2log::k2pg, "error: {}", status);
             }
@@ -313,7 +502,16 @@ TxnManager::query(std::shared_ptr<sh::dto::QueryRequest> query) {
     else {
         K2LOG_ERT(k2log::k2pg, "null query");
     }
-    Metric mt("query", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+    Metric mt(K2Op::Query);
+    SchemaOpCounters* counters = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_queryCountersMutex);
+        auto it = _queryCounters.find(query.get());
+        if (it != _queryCounters.end()) {
+            counters = it->second;
+            counters->queryPages.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
     return beginTxn()
         .then([this, query = std::move(query)](auto&& beginFut) mutable {
             auto&& [beginStatus] = beginFut.get();
@@ -323,9 +521,21 @@ TxnManager::query(std::shared_ptr<sh::dto::QueryRequest> query) {
             return _txn->query(std::move(query));
         })
         .unwrap()
-        .then([mt=std::move(mt)](auto&& respFut) {
-            mt.report();
+        .then([mt=std::move(mt), counters](auto&& respFut) {
             auto&& [status, qresp] = respFut.get();
+            uint64_t bytes = 0;
+            for (const auto& storage : qresp.records) {
+                bytes += storage.fieldData.size();
+            }
+            mt.report(status.is2xxOK(), bytes, qresp.records.size());
+            if (counters != nullptr) {
+                if (status.is2xxOK()) {
+                    counters->recordsRead.fetch_add(qresp.records.size(), std::memory_order_relaxed);
+                    counters->bytesRead.fetch_add(bytes, std::memory_order_relaxed);
+                } else {
+                    counters->errors.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
             if (!status.is2xxOK()) {
                 K2LOG_ERT(k2log::k2pg, "error: {}", status);
             }
@@ -340,7 +550,8 @@ TxnManager::createQuery(sh::dto::SKVRecord startKey, sh::dto::SKVRecord endKey,
                         bool reverseDirection, bool includeVersionMismatch) {
     K2LOG_DRT(k2log::k2pg, "startKey={}, endKey={}, filter={}, projection={}, recordLimit={}, reverseDirection={}, includeVersionMismatch={}",
             startKey, endKey, filter, projection, recordLimit, reverseDirection, includeVersionMismatch);
-    Metric mt("createQuery", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+    Metric mt(K2Op::CreateQuery);
+    SchemaOpCounters* counters = GetSchemaOpCounters(startKey.collectionName, startKey.schema->name);
     return beginTxn()
         .then([this, startKey=std::move(startKey), endKey=std::move(endKey), filter = std::move(filter),
                projection = std::move(projection), recordLimit, reverseDirection,
@@ -354,9 +565,13 @@ TxnManager::createQuery(sh::dto::SKVRecord startKey, sh::dto::SKVRecord endKey,
                                      includeVersionMismatch);
         })
         .unwrap()
-        .then([mt=std::move(mt)](auto&& respFut) {
-            mt.report();
+        .then([this, mt=std::move(mt), counters](auto&& respFut) {
             auto&& [status, req] = respFut.get();
+            mt.report(status.is2xxOK());
+            if (status.is2xxOK() && req) {
+                std::lock_guard<std::mutex> lock(_queryCountersMutex);
+                _queryCounters[req.get()] = counters;
+            }
             if (!status.is2xxOK()) {
                 K2LOG_ERT(k2log::k2pg, "error: {}", status);
             }
@@ -371,7 +586,11 @@ TxnManager::destroyQuery(std::shared_ptr<sh::dto::QueryRequest> query) {
     } else {
         K2LOG_ERT(k2log::k2pg, "null query");
     }
-    Metric mt("destroyQuery", _config.sub("logging").getDurationMillis("op_latency_warn_threshold_ms", 100ms));
+    Metric mt(K2Op::DestroyQuery);
+    {
+        std::lock_guard<std::mutex> lock(_queryCountersMutex);
+        _queryCounters.erase(query.get());
+    }
     return beginTxn()
         .then([this, query](auto&& beginFut) mutable {
             auto&& [beginStatus] = beginFut.get();
@@ -382,8 +601,8 @@ TxnManager::destroyQuery(std::shared_ptr<sh::dto::QueryRequest> query) {
         })
         .unwrap()
         .then([mt=std::move(mt)](auto&& respFut) {
-            mt.report();
             auto&& [status] = respFut.get();
+            mt.report(status.is2xxOK());
             if (!status.is2xxOK()) {
                 K2LOG_ERT(k2log::k2pg, "error: {}", status);
             }
@@ -21,12 +21,28 @@ Copyright(c) 2022 Futurewei Cloud
     SOFTWARE.
 */
 #pragma once
+#include <deque>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <skvhttp/client/SKVClient.h>
 #include "config.h"
+#include "skv_backend.h"
 #include "access/k2/pg_session.h"
+#include "access/k2/op_metrics.h"
 namespace k2pg {
 namespace sh=skv::http;
 
+// Partitioning of a new collection requested by CREATE DATABASE. Unset fields fall back to the
+// create_collections config of the database, then to hash partitioning on one node
+struct CollectionPartitioning {
+    std::optional<sh::dto::HashScheme> hashScheme;
+    // the end keys of the partitions of a range partitioned collection
+    std::optional<std::vector<std::string>> rangeEnds;
+    uint32_t minNodes = 0;
+};
+
 // The TxnManager class enforces single-txn per thread model. It manages the lifetime of the transaction by
 // observing callbacks from PG
 class TxnManager {
@@ -66,26 +82,76 @@ public:
     boost::future<sh::Response<>>
         createCollection(sh::dto::CollectionMetadata metadata, std::vector<std::string> rangeEnds);
     boost::future<sh::Response<>>
-        createCollection(const std::string& collection_name, const std::string& DBName);
+        createCollection(const std::string& collection_name, const std::string& DBName,
+                         const CollectionPartitioning& partitioning = CollectionPartitioning{});
 
     // use to set the txn options for all new txns in the thread/session
     void setSessionTxnOpts(sh::dto::TxnOptions opts);
 
+    // Marks the current txn (or the next one if none is open) read-only. Writes are rejected until the txn ends.
+    // Txns that did not write are ended without waiting for the result whether or not they are marked read-only
+    void setTxnReadOnly(bool readOnly);
+
+    // Whether a K2 txn was begun by an operation of the current PG txn and has not ended yet
+    bool isActive() const { return _txn != nullptr; }
+
     Config& getConfig() { return _config; }
 
 private:
     // Helper used to initialize the skv client and register txn callbacks
     void _init();
 
+    // Collects the results of finished ends of txns without writes. Waits for the oldest ones if too many are pending
+    void _reapPendingEnds();
+
+    // Txn-local read cache. Reads of a key return what the txn last read or wrote for it, which is what SKV
+    // would return within the same K23SI txn. Entries are dropped when the txn ends.
+    struct CachedRecord {
+        bool exists{false};
+        std::string collectionName;
+        std::shared_ptr<sh::dto::Schema> schema;
+        sh::dto::SKVRecord::Storage storage;
+        std::list<std::string>::iterator lru;
+    };
+    // The cache key of a record: collection, schema name and the serialized key fields
+    std::string _cacheKey(sh::dto::SKVRecord& record);
+    // The following are called with _cacheMutex held. Responses to requests issued before the latest
+    // invalidation (epoch) are not cached, since they may predate a write to the same key
+    void _cachePut(const std::string& key, uint64_t epoch, bool exists, sh::dto::SKVRecord* record);
+    void _cacheInvalidate(const std::string& key);
+    void _cacheClear();
+
+    // Counts a finished write or partial update in the per-schema counters
+    static void _countWrite(SchemaOpCounters* counters, const sh::Status& status, uint64_t bytes);
+
     // this txn is managed by this manager.
-    std::unique_ptr<sh::TxnHandle> _txn;
+    std::unique_ptr<SKVTxn> _txn;
     Metric _txnMt;
 
-    std::shared_ptr<sh::Client> _client;
+    std::shared_ptr<SKVBackend> _client;
 
     Config _config;
     bool _initialized{false};
     sh::dto::TxnOptions _txnOpts;
+
+    bool _txnReadOnly{false};
+    bool _txnHasWrites{false};
+    // txn_opts.async_readonly_end, read once on init
+    bool _asyncReadOnlyEnd{true};
+    // ends of txns without writes, which commit does not wait for
+    std::deque<boost::future<sh::Response<>>> _pendingEnds;
+
+    // txn_opts.read_cache_size, the max number of cached keys, 0 disables the cache. Read once on init
+    size_t _readCacheSize{0};
+    // responses are completed on client threads, so the cache is locked
+    std::mutex _cacheMutex;
+    uint64_t _cacheEpoch{0};
+    std::unordered_map<std::string, CachedRecord> _cache;
+    std::list<std::string> _cacheLru; // most recently used first
+
+    // the per-schema counters of the open queries, for pg_stat_k2_schemas. Locked like the cache
+    std::mutex _queryCountersMutex;
+    std::unordered_map<const sh::dto::QueryRequest*, SchemaOpCounters*> _queryCounters;
 };
 
 // the thread-local TxnManager. It allows access to k2 from any thread in opengauss,
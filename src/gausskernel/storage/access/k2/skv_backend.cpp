@@ -0,0 +1,133 @@
+/*
+MIT License
+
+Copyright(c) 2022 Futurewei Cloud
+
+    Permission is hereby granted,
+    free of charge, to any person obtaining a copy of this software and associated documentation files(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and / or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS",
+    WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER
+    LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "skv_backend.h"
+#include "inproc_skv.h"
+
+namespace k2pg {
+
+// SKVTxn over a K2 HTTP proxy transaction
+class HttpSKVTxn : public SKVTxn {
+public:
+    HttpSKVTxn(sh::TxnHandle&& handle) : _handle(std::move(handle)) {}
+
+    boost::future<sh::Response<>>
+    endTxn(sh::dto::EndAction endAction) override {
+        return _handle.endTxn(endAction);
+    }
+
+    boost::future<sh::Response<sh::dto::SKVRecord>>
+    read(sh::dto::SKVRecord record) override {
+        return _handle.read(std::move(record));
+    }
+
+    boost::future<sh::Response<>>
+    write(sh::dto::SKVRecord& record, bool erase, sh::dto::ExistencePrecondition precondition) override {
+        return _handle.write(record, erase, precondition);
+    }
+
+    boost::future<sh::Response<>>
+    partialUpdate(sh::dto::SKVRecord& record, std::vector<uint32_t> fieldsForPartialUpdate) override {
+        return _handle.partialUpdate(record, std::move(fieldsForPartialUpdate));
+    }
+
+    boost::future<sh::Response<sh::dto::QueryResponse>>
+    query(std::shared_ptr<sh::dto::QueryRequest> query) override {
+        return _handle.query(std::move(query));
+    }
+
+    boost::future<sh::Response<std::shared_ptr<sh::dto::QueryRequest>>>
+    createQuery(sh::dto::SKVRecord& startKey, sh::dto::SKVRecord& endKey, sh::dto::expression::Expression&& filter,
+                std::vector<std::string>&& projection, int32_t recordLimit, bool reverseDirection,
+                bool includeVersionMismatch) override {
+        return _handle.createQuery(startKey, endKey, std::move(filter), std::move(projection), recordLimit,
+                                   reverseDirection, includeVersionMismatch);
+    }
+
+    boost::future<sh::Response<>>
+    destroyQuery(std::shared_ptr<sh::dto::QueryRequest> query) override {
+        return _handle.destroyQuery(query);
+    }
+
+    std::string toString() const override {
+        return fmt::format("{}", _handle);
+    }
+
+private:
+    sh::TxnHandle _handle;
+};
+
+// SKVBackend over the K2 HTTP proxy
+class HttpSKVBackend : public SKVBackend {
+public:
+    HttpSKVBackend(const std::string& host, int port) : _client(host, port) {}
+
+    boost::future<sh::Response<std::unique_ptr<SKVTxn>>>
+    beginTxn(sh::dto::TxnOptions opts) override {
+        return _client.beginTxn(std::move(opts))
+            .then([](auto&& respFut) {
+                auto&& [status, handle] = respFut.get();
+                std::unique_ptr<SKVTxn> txn;
+                if (status.is2xxOK()) {
+                    txn = std::make_unique<HttpSKVTxn>(std::move(handle));
+                }
+                return sh::Response<std::unique_ptr<SKVTxn>>(std::move(status), std::move(txn));
+            });
+    }
+
+    boost::future<sh::Response<>>
+    createSchema(const std::string& collectionName, const sh::dto::Schema& schema) override {
+        return _client.createSchema(collectionName, schema);
+    }
+
+    boost::future<sh::Response<std::shared_ptr<sh::dto::Schema>>>
+    getSchema(const std::string& collectionName, const std::string& schemaName, int64_t schemaVersion) override {
+        return _client.getSchema(collectionName, schemaName, schemaVersion);
+    }
+
+    boost::future<sh::Response<>>
+    createCollection(sh::dto::CollectionMetadata metadata, std::vector<std::string> rangeEnds) override {
+        return _client.createCollection(std::move(metadata), std::move(rangeEnds));
+    }
+
+private:
+    sh::Client _client;
+};
+
+std::shared_ptr<SKVBackend> makeSKVBackend(Config clientConfig) {
+    std::string backend = clientConfig.get<std::string>("backend", "http");
+    if (backend == "inproc") {
+        K2LOG_I(k2log::k2pg, "Initializing in-process SKV backend");
+        return inproc::InProcSKV::instance(clientConfig.sub("inproc"));
+    }
+    if (backend != "http") {
+        K2LOG_W(k2log::k2pg, "Unknown SKV backend {}, using http", backend);
+    }
+
+    std::string host = clientConfig.get<std::string>("host", "localhost");
+    int port = clientConfig.get<int>("port", 30000);
+    K2LOG_I(k2log::k2pg, "Initializing SKVClient with url {}:{}", host, port);
+    return std::make_shared<HttpSKVBackend>(host, port);
+}
+
+} // ns
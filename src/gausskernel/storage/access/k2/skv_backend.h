@@ -0,0 +1,76 @@
+/*
+MIT License
+
+Copyright(c) 2022 Futurewei Cloud
+
+    Permission is hereby granted,
+    free of charge, to any person obtaining a copy of this software and associated documentation files(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and / or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS",
+    WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER
+    LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <skvhttp/client/SKVClient.h>
+#include "config.h"
+
+namespace k2pg {
+namespace sh=skv::http;
+
+// A transaction against an SKV backend. Mirrors the parts of sh::TxnHandle used by TxnManager
+class SKVTxn {
+public:
+    virtual ~SKVTxn() = default;
+
+    virtual boost::future<sh::Response<>>
+        endTxn(sh::dto::EndAction endAction) = 0;
+    virtual boost::future<sh::Response<sh::dto::SKVRecord>>
+        read(sh::dto::SKVRecord record) = 0;
+    virtual boost::future<sh::Response<>>
+        write(sh::dto::SKVRecord& record, bool erase, sh::dto::ExistencePrecondition precondition) = 0;
+    virtual boost::future<sh::Response<>>
+        partialUpdate(sh::dto::SKVRecord& record, std::vector<uint32_t> fieldsForPartialUpdate) = 0;
+    virtual boost::future<sh::Response<sh::dto::QueryResponse>>
+        query(std::shared_ptr<sh::dto::QueryRequest> query) = 0;
+    virtual boost::future<sh::Response<std::shared_ptr<sh::dto::QueryRequest>>>
+        createQuery(sh::dto::SKVRecord& startKey, sh::dto::SKVRecord& endKey, sh::dto::expression::Expression&& filter,
+                    std::vector<std::string>&& projection, int32_t recordLimit, bool reverseDirection,
+                    bool includeVersionMismatch) = 0;
+    virtual boost::future<sh::Response<>>
+        destroyQuery(std::shared_ptr<sh::dto::QueryRequest> query) = 0;
+
+    // human-readable description of the txn, for logging
+    virtual std::string toString() const = 0;
+};
+
+// The SKV backend used by TxnManager. Mirrors the parts of sh::Client used by TxnManager
+class SKVBackend {
+public:
+    virtual ~SKVBackend() = default;
+
+    virtual boost::future<sh::Response<std::unique_ptr<SKVTxn>>>
+        beginTxn(sh::dto::TxnOptions opts) = 0;
+    virtual boost::future<sh::Response<>>
+        createSchema(const std::string& collectionName, const sh::dto::Schema& schema) = 0;
+    virtual boost::future<sh::Response<std::shared_ptr<sh::dto::Schema>>>
+        getSchema(const std::string& collectionName, const std::string& schemaName, int64_t schemaVersion) = 0;
+    virtual boost::future<sh::Response<>>
+        createCollection(sh::dto::CollectionMetadata metadata, std::vector<std::string> rangeEnds) = 0;
+};
+
+// Creates the backend selected by the "client" section of the K2 config:
+//   "backend": "http" (default) talks to the K2 HTTP proxy at "host":"port"
+//   "backend": "inproc" uses the in-process store configured by the "inproc" sub-section
+std::shared_ptr<SKVBackend> makeSKVBackend(Config clientConfig);
+
+} // ns
@@ -47,7 +47,8 @@
 /*
  * Number of OIDs to prefetch (preallocate) in K2PG setup.
  * Given there are multiple Postgres nodes, each node should prefetch
- * in smaller chunks.
+ * in smaller chunks. This is only the minimum, the K2 catalog manager grows
+ * the reserved range while OIDs are consumed quickly, e.g., by bulk DDL.
  */
 #define K2PG_OID_PREFETCH	        256
 
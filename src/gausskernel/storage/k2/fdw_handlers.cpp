@@ -99,6 +99,7 @@ struct K2FdwExecState {
     std::vector<int> targets_attrnum;
     bool forward_scan{true};
     K2PgSelectLimitParams limit_params;
+    bool is_exec_done{false};
 
     K2PgScanHandle* k2_handle{0};     /* the handle generated by pggate */
 };
@@ -378,6 +379,8 @@ k2BeginForeignScan(ForeignScanState *node, int eflags)
 
     HandleK2PgStatus(PgGate_NewSelect(K2PgGetDatabaseOid(relation), RelationGetRelid(relation),
                                       std::move(index_params), &k2pg_state->k2_handle));
+    /* Let pggate size the readahead of the scan from the planner estimate */
+    PgGate_SetScanEstimate(k2pg_state->k2_handle, foreignScan->scan.plan.plan_rows);
 
     // TODO Add this back when we consolidate PGStatement and K2PGScanHandle
     /* Set the current syscatalog version (will check that we are up to date) */
@@ -401,8 +404,11 @@ k2IterateForeignScan(ForeignScanState *node)
     K2FdwExecState *k2pg_state = (K2FdwExecState *) node->fdw_state;
     Relation relation = node->ss.ss_currentRelation;
 
-    HandleK2PgStatus(PgGate_ExecSelect(k2pg_state->k2_handle, k2pg_state->constraints,
-                    k2pg_state->targets_attrnum, k2pg_state->forward_scan, k2pg_state->limit_params));
+    if (!k2pg_state->is_exec_done) {
+        HandleK2PgStatus(PgGate_ExecSelect(k2pg_state->k2_handle, k2pg_state->constraints,
+                        k2pg_state->targets_attrnum, k2pg_state->forward_scan, k2pg_state->limit_params));
+        k2pg_state->is_exec_done = true;
+    }
 
     /* Clear tuple slot before starting */
     slot = node->ss.ss_ScanTupleSlot;
@@ -439,6 +445,24 @@ k2IterateForeignScan(ForeignScanState *node)
     return slot;
 }
 
+/*
+ * Report the remote work done by the scan in EXPLAIN ANALYZE
+ */
+void k2ExplainForeignScan(ForeignScanState *node, ExplainState *es) {
+    K2FdwExecState *k2pg_state = (K2FdwExecState *) node->fdw_state;
+    if (!es->analyze || k2pg_state == NULL || k2pg_state->k2_handle == NULL) {
+        return;
+    }
+
+    K2PgScanStats stats;
+    PgGate_AddScanStats(k2pg_state->k2_handle, &stats);
+    // local quals are evaluated by the executor, so the rows emitted by the node are the ones which passed
+    if (node->ss.ps.instrument != NULL) {
+        stats.records_passed = (uint64_t)node->ss.ps.instrument->ntuples;
+    }
+    ExplainK2ScanStats(&stats, es);
+}
+
 /*
  * Step 5. Done with scan
  */
@@ -44,4 +44,6 @@ void k2EndForeignScan(ForeignScanState *node);
 
 TupleTableSlot * k2IterateForeignScan(ForeignScanState *node);
 
+void k2ExplainForeignScan(ForeignScanState *node, ExplainState *es);
+
 } // ns
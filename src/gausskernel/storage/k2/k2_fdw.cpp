@@ -75,7 +75,7 @@ Datum k2_fdw_handler(PG_FUNCTION_ARGS)
         .IsForeignRelUpdatable = NULL,
 
         /* Support functions for EXPLAIN */
-        .ExplainForeignScan = NULL,
+        .ExplainForeignScan = k2ExplainForeignScan,
         .ExplainForeignModify = NULL,
 
         /* Support functions for ANALYZE */
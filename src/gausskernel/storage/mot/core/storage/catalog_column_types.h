@@ -99,6 +99,14 @@ typedef struct __attribute__((packed)) _decimal {
 #define DECIMAL_MAX_SIZE (sizeof(MOT::DecimalSt) + DECIMAL_MAX_DIGITS * sizeof(uint16_t))
 #define DECIMAL_SIZE(d) (sizeof(MOT::DecimalSt) + d->m_hdr.m_ndigits * sizeof(int16_t))
 
+// Decimal key representation (memcmp ordered): class byte, biased weight, digits, truncation marker
+#define DECIMAL_KEY_CLASS_NEGATIVE 0x01
+#define DECIMAL_KEY_CLASS_ZERO 0x02
+#define DECIMAL_KEY_CLASS_POSITIVE 0x03
+#define DECIMAL_KEY_CLASS_NAN 0x04
+#define DECIMAL_KEY_WEIGHT_BIAS 0x8000
+#define DECIMAL_KEY_OVERHEAD (sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint8_t))
+
 typedef struct __attribute__((packed)) _interval {
     uint64_t m_time;
     int32_t m_day;
@@ -717,13 +717,52 @@ bool ColumnDECIMAL::Pack(uint8_t* dest, uintptr_t src, size_t len)
 
 bool ColumnDECIMAL::PackKey(uint8_t* dest, uintptr_t src, size_t len, uint8_t fill)
 {
-    DecimalSt* d = (DecimalSt*)src;
-
-    if (len > m_size)
-        len = m_size;
-    errno_t erc = memcpy_s(dest, m_size, (void*)d, len);
+    // The key is laid out so that memcmp order equals numeric order (NaN sorts above all numbers, as in the
+    // envelope): a class byte (negative < zero < positive < NaN), the weight biased to unsigned, then a fixed
+    // number of base-10000 digits zero-padded on the right, all in big-endian. Negative values invert the weight
+    // and the digits so that larger magnitudes sort first. Equal values (e.g. 1.5 and 1.50) get the same key since
+    // the display scale is ignored, and leading/trailing zero digits are stripped.
+    // Search values with more significant digits than the column can hold are truncated and marked in the last
+    // byte, so the key falls strictly between the keys of the two neighbouring column values.
+    const DecimalSt* d = (const DecimalSt*)src;
+    uint32_t keyDigits = (m_keySize - DECIMAL_KEY_OVERHEAD) / sizeof(uint16_t);
+    uint8_t* digitsBuf = dest + sizeof(uint8_t) + sizeof(uint16_t);
+    uint8_t* truncMarker = dest + m_keySize - sizeof(uint8_t);
+
+    errno_t erc = memset_s(dest, m_keySize, 0x00, m_keySize);
     securec_check(erc, "\0", "\0");
 
+    if (d->m_hdr.m_flags & DECIMAL_NAN) {
+        *dest = DECIMAL_KEY_CLASS_NAN;
+        return true;
+    }
+
+    const uint16_t* digits = d->m_digits;
+    int32_t weight = (int32_t)(int16_t)d->m_hdr.m_weight;
+    uint32_t ndigits = d->m_hdr.m_ndigits;
+    while (ndigits > 0 && digits[0] == 0) {
+        ++digits;
+        --ndigits;
+        --weight;
+    }
+    while (ndigits > 0 && digits[ndigits - 1] == 0) {
+        --ndigits;
+    }
+    if (ndigits == 0) {
+        *dest = DECIMAL_KEY_CLASS_ZERO;
+        return true;
+    }
+
+    bool negative = (d->m_hdr.m_flags & DECIMAL_NEGATIVE) != 0;
+    uint16_t mask = negative ? 0xFFFF : 0x0000;
+    *dest = negative ? DECIMAL_KEY_CLASS_NEGATIVE : DECIMAL_KEY_CLASS_POSITIVE;
+    *(uint16_t*)(dest + 1) = htobe16((uint16_t)(weight + DECIMAL_KEY_WEIGHT_BIAS) ^ mask);
+    for (uint32_t i = 0; i < keyDigits; ++i) {
+        uint16_t digit = (i < ndigits) ? digits[i] : 0;
+        *(uint16_t*)(digitsBuf + i * sizeof(uint16_t)) = htobe16(digit ^ mask);
+    }
+    *truncMarker = (ndigits > keyDigits ? 0x01 : 0x00) ^ (uint8_t)mask;
+
     return true;
 }
 
@@ -734,7 +773,8 @@ void ColumnDECIMAL::Unpack(uint8_t* data, uintptr_t* dest, size_t& len)
 
 void ColumnDECIMAL::SetKeySize()
 {
-    m_keySize = m_size;
+    // the column size bounds the number of digits a value may carry (see the NUMERIC(p,s) sizing in the FDW)
+    m_keySize = DECIMAL_KEY_OVERHEAD + (m_size - sizeof(DecimalSt));
 }
 
 uint16_t ColumnDECIMAL::PrintValue(uint8_t* data, char* destBuf, size_t len)
@@ -0,0 +1,508 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Primary index implementation using a concurrent resizable hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "hash_index.h"
+#include "mot_engine.h"
+#include "mm_global_api.h"
+#include <algorithm>
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashPrimaryIndex, Storage);
+
+void HashPrimaryIndex::HashIterator::Next()
+{
+    if (m_node == nullptr) {
+        return;
+    }
+
+    HashNode* node = m_node->m_next.load(std::memory_order_acquire);
+    if (m_matchLen != 0) {
+        while (node != nullptr &&
+               !KeyMatch(node, m_matchNode->m_hash, m_matchNode->m_key.GetKeyBuf(), m_matchLen)) {
+            node = node->m_next.load(std::memory_order_acquire);
+        }
+        m_node = node;
+    } else {
+        SkipEmptyBuckets(node);
+    }
+}
+
+void HashPrimaryIndex::HashIterator::SkipEmptyBuckets(HashNode* node)
+{
+    // the buckets of a stripe are the ones congruent to it, scanned in the array the stripe points to
+    while (node == nullptr) {
+        m_bucket += LOCK_STRIPE_COUNT;
+        if (m_bucket >= m_table->m_bucketCount) {
+            uint32_t stripe = StripeOf(m_bucket) + 1;
+            if (stripe == LOCK_STRIPE_COUNT) {
+                break;
+            }
+            m_table = m_index->m_stripeTables[stripe].load(std::memory_order_acquire);
+            m_bucket = stripe;
+        }
+        node = m_table->m_buckets[m_bucket].load(std::memory_order_acquire);
+    }
+    m_node = node;
+}
+
+uint64_t HashPrimaryIndex::HashKey(const uint8_t* buf, uint32_t len)
+{
+    static constexpr uint64_t mul = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash = 0xCBF29CE484222325ULL ^ len;
+    uint32_t offset = 0;
+
+    for (; offset + sizeof(uint64_t) <= len; offset += sizeof(uint64_t)) {
+        uint64_t word;
+        errno_t erc = memcpy_s(&word, sizeof(word), buf + offset, sizeof(word));
+        securec_check(erc, "\0", "\0");
+        hash = (hash ^ word) * mul;
+        hash ^= hash >> 32;
+    }
+    for (; offset < len; ++offset) {
+        hash = (hash ^ buf[offset]) * mul;
+    }
+
+    // final avalanche so the low bits used for bucket and stripe selection depend on all the key bytes
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+HashPrimaryIndex::HashTable* HashPrimaryIndex::AllocTable(uint64_t bucketCount)
+{
+    uint64_t size = sizeof(HashTable) + bucketCount * sizeof(std::atomic<HashNode*>);
+    HashTable* table = (HashTable*)MemGlobalAllocAligned(size, CACHE_LINE_SIZE);
+    if (table == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Hash Index",
+            "Failed to allocate hash index bucket array of %" PRIu64 " buckets (%" PRIu64 " bytes)",
+            bucketCount,
+            size);
+        return nullptr;
+    }
+
+    table->m_bucketCount = bucketCount;
+    for (uint64_t i = 0; i < bucketCount; ++i) {
+        table->m_buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+    return table;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::AllocNode(const Key* key, uint64_t hash, Sentinel* sentinel)
+{
+    HashNode* node = (HashNode*)m_nodePool->Alloc();
+    if (node == nullptr) {
+        return nullptr;
+    }
+
+    MOT_ASSERT(key->GetKeyLength() <= m_keyLength);
+    node->m_next.store(nullptr, std::memory_order_relaxed);
+    node->m_sentinel = sentinel;
+    node->m_hash = hash;
+    new (&node->m_key) Key(m_keyLength, KeyType::PRIMARY_KEY);
+    node->m_key.CpKey(key->GetKeyBuf(), key->GetKeyLength());
+    return node;
+}
+
+RC HashPrimaryIndex::IndexInitImpl(void** args)
+{
+    m_nodePool = ObjAllocInterface::GetObjPool(sizeof(HashNode) + ALIGN8(m_keyLength), false);
+    if (m_nodePool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash index node pool");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    HashTable* table = AllocTable(INITIAL_BUCKET_COUNT);
+    if (table == nullptr) {
+        DestroyPools();
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to initialize hash index");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    for (uint32_t i = 0; i < LOCK_STRIPE_COUNT; ++i) {
+        m_stripeTables[i].store(table, std::memory_order_relaxed);
+    }
+    m_oldTable.store(nullptr, std::memory_order_relaxed);
+    m_migratedStripes.store(0, std::memory_order_relaxed);
+    m_table.store(table, std::memory_order_release);
+    m_count.store(0, std::memory_order_relaxed);
+    m_initialized = true;
+    return RC_OK;
+}
+
+void HashPrimaryIndex::DestroyPools()
+{
+    // nodes retired to the GC are released by their callbacks unless the index is dropped, in which case
+    // the GC elements of this index were already cleared
+    HashTable* table = m_table.exchange(nullptr);
+    if (table != nullptr) {
+        MemGlobalFree(table);
+    }
+    table = m_oldTable.exchange(nullptr);
+    if (table != nullptr) {
+        MemGlobalFree(table);
+    }
+    for (uint32_t i = 0; i < LOCK_STRIPE_COUNT; ++i) {
+        m_stripeTables[i].store(nullptr, std::memory_order_relaxed);
+    }
+    if (m_nodePool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+}
+
+Sentinel* HashPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    uint64_t hash = HashKey(key->GetKeyBuf(), GetKeySizeNoSuffix());
+    uint32_t stripe = StripeOf(hash);
+    spin_lock& lock = m_locks[stripe];
+    HashTable* retired = nullptr;
+    Sentinel* result = nullptr;
+
+    inserted = false;
+    lock.lock();
+
+    // move the stripe to the newest array first, the array of a stripe cannot be replaced while it is held
+    MigrateStripe(stripe, retired);
+    HashTable* table = m_stripeTables[stripe].load(std::memory_order_relaxed);
+    std::atomic<HashNode*>& bucket = table->m_buckets[hash & (table->m_bucketCount - 1)];
+    HashNode* head = bucket.load(std::memory_order_relaxed);
+    HashNode* node = head;
+    while (node != nullptr && !KeyMatch(node, hash, key->GetKeyBuf(), m_keyLength)) {
+        node = node->m_next.load(std::memory_order_relaxed);
+    }
+
+    if (node != nullptr) {
+        result = node->m_sentinel;  // key mapping already exists
+    } else {
+        node = AllocNode(key, hash, sentinel);
+        if (node != nullptr) {
+            node->m_next.store(head, std::memory_order_relaxed);
+            bucket.store(node, std::memory_order_release);
+            inserted = true;
+        }
+    }
+    lock.unlock();
+
+    if (retired != nullptr) {
+        FinishResize(retired);
+    }
+    if (inserted) {
+        const HashTable* newest = m_table.load(std::memory_order_acquire);
+        if (m_count.fetch_add(1, std::memory_order_relaxed) + 1 > newest->m_bucketCount * MAX_LOAD_FACTOR) {
+            StartResize();
+        }
+    } else if (result == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Insert", "Failed to allocate hash node for index %s", m_name.c_str());
+    }
+    MigrateStep();
+    return result;
+}
+
+Sentinel* HashPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    uint64_t hash = HashKey(key->GetKeyBuf(), GetKeySizeNoSuffix());
+    const HashTable* table = m_stripeTables[StripeOf(hash)].load(std::memory_order_acquire);
+    HashNode* node = table->m_buckets[hash & (table->m_bucketCount - 1)].load(std::memory_order_acquire);
+
+    while (node != nullptr) {
+        if (KeyMatch(node, hash, key->GetKeyBuf(), m_keyLength)) {
+            return node->m_sentinel;
+        }
+        node = node->m_next.load(std::memory_order_acquire);
+    }
+    return nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    uint64_t hash = HashKey(key->GetKeyBuf(), GetKeySizeNoSuffix());
+    uint32_t stripe = StripeOf(hash);
+    spin_lock& lock = m_locks[stripe];
+    HashTable* retired = nullptr;
+    Sentinel* sentinel = nullptr;
+    HashNode* node = nullptr;
+
+    lock.lock();
+    MigrateStripe(stripe, retired);
+    HashTable* table = m_stripeTables[stripe].load(std::memory_order_relaxed);
+    std::atomic<HashNode*>* link = &table->m_buckets[hash & (table->m_bucketCount - 1)];
+    for (node = link->load(std::memory_order_relaxed); node != nullptr;
+         node = node->m_next.load(std::memory_order_relaxed)) {
+        if (KeyMatch(node, hash, key->GetKeyBuf(), m_keyLength)) {
+            // readers positioned on the node still see its successor until the GC releases it
+            link->store(node->m_next.load(std::memory_order_relaxed), std::memory_order_release);
+            sentinel = node->m_sentinel;
+            break;
+        }
+        link = &node->m_next;
+    }
+    lock.unlock();
+
+    if (retired != nullptr) {
+        FinishResize(retired);
+    }
+    if (node != nullptr) {
+        m_count.fetch_sub(1, std::memory_order_relaxed);
+        RetireNode(node);
+    }
+    MigrateStep();
+    return sentinel;
+}
+
+void HashPrimaryIndex::StartResize()
+{
+    if (!m_resizeLock.try_lock()) {
+        return;  // another writer is starting a resize
+    }
+
+    // a new resize starts only after all the stripes were moved by the previous one
+    HashTable* table = m_table.load(std::memory_order_acquire);
+    if (m_oldTable.load(std::memory_order_acquire) == nullptr &&
+        m_count.load(std::memory_order_relaxed) > table->m_bucketCount * MAX_LOAD_FACTOR) {
+        HashTable* newTable = AllocTable(table->m_bucketCount * 2);
+        if (newTable == nullptr) {
+            MOT_LOG_WARN("Failed to resize hash index %s to %" PRIu64 " buckets, keeping %" PRIu64 " buckets",
+                m_name.c_str(),
+                table->m_bucketCount * 2,
+                table->m_bucketCount);
+        } else {
+            // the stripes keep pointing to the current array until they are migrated one by one
+            m_migratedStripes.store(0, std::memory_order_relaxed);
+            m_oldTable.store(table, std::memory_order_relaxed);
+            m_table.store(newTable, std::memory_order_seq_cst);
+        }
+    }
+    m_resizeLock.unlock();
+}
+
+void HashPrimaryIndex::MigrateStripe(uint32_t stripe, HashTable*& retired)
+{
+    HashTable* newTable = m_table.load(std::memory_order_acquire);
+    HashTable* oldTable = m_stripeTables[stripe].load(std::memory_order_relaxed);
+    if (oldTable == newTable) {
+        return;
+    }
+
+    // concurrent readers keep traversing the old chains, so the nodes are copied rather than relinked; the
+    // new buckets of the stripe are not visible to anyone until the stripe points to the new array
+    uint64_t mask = newTable->m_bucketCount - 1;
+    for (uint64_t i = stripe; i < oldTable->m_bucketCount; i += LOCK_STRIPE_COUNT) {
+        for (HashNode* node = oldTable->m_buckets[i].load(std::memory_order_relaxed); node != nullptr;
+             node = node->m_next.load(std::memory_order_relaxed)) {
+            HashNode* copy = AllocNode(&node->m_key, node->m_hash, node->m_sentinel);
+            if (copy == nullptr) {
+                // leave the stripe in the old array, a later writer retries
+                for (uint64_t j = stripe; j < newTable->m_bucketCount; j += LOCK_STRIPE_COUNT) {
+                    HashNode* partial = newTable->m_buckets[j].exchange(nullptr, std::memory_order_relaxed);
+                    while (partial != nullptr) {
+                        HashNode* next = partial->m_next.load(std::memory_order_relaxed);
+                        m_nodePool->Release(partial);
+                        partial = next;
+                    }
+                }
+                MOT_LOG_WARN("Failed to migrate stripe %u of hash index %s, will retry", stripe, m_name.c_str());
+                return;
+            }
+            std::atomic<HashNode*>& bucket = newTable->m_buckets[node->m_hash & mask];
+            copy->m_next.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            bucket.store(copy, std::memory_order_relaxed);
+        }
+    }
+
+    m_stripeTables[stripe].store(newTable, std::memory_order_release);
+    RetireStripeNodes(oldTable, stripe);
+    if (m_migratedStripes.fetch_add(1, std::memory_order_acq_rel) + 1 == LOCK_STRIPE_COUNT) {
+        retired = oldTable;
+    }
+}
+
+void HashPrimaryIndex::MigrateStep()
+{
+    if (m_oldTable.load(std::memory_order_acquire) == nullptr) {
+        return;
+    }
+
+    uint32_t stripe = m_migrateCursor.fetch_add(1, std::memory_order_relaxed) & (LOCK_STRIPE_COUNT - 1);
+    HashTable* retired = nullptr;
+    m_locks[stripe].lock();
+    MigrateStripe(stripe, retired);
+    m_locks[stripe].unlock();
+    if (retired != nullptr) {
+        FinishResize(retired);
+    }
+}
+
+void HashPrimaryIndex::FinishResize(HashTable* oldTable)
+{
+    // the nodes were retired stripe by stripe, only the array itself is left
+    MOT_ASSERT(m_oldTable.load(std::memory_order_relaxed) == oldTable);
+    RetireTable(oldTable);
+    m_oldTable.store(nullptr, std::memory_order_release);
+}
+
+void HashPrimaryIndex::RetireStripeNodes(HashTable* table, uint32_t stripe)
+{
+    for (uint64_t i = stripe; i < table->m_bucketCount; i += LOCK_STRIPE_COUNT) {
+        HashNode* node = table->m_buckets[i].load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            HashNode* next = node->m_next.load(std::memory_order_relaxed);
+            RetireNode(node);
+            node = next;
+        }
+    }
+}
+
+void HashPrimaryIndex::RetireNode(HashNode* node)
+{
+    GcManager* gcSession = GetCurrentGcSession();
+    if (gcSession != nullptr) {
+        gcSession->GcRecordObject(
+            GetIndexId(), (void*)m_nodePool, (void*)node, DeallocateNodeCallBack, m_nodePool->m_size);
+    } else {
+        m_nodePool->Release(node);
+    }
+}
+
+void HashPrimaryIndex::RetireTable(HashTable* table)
+{
+    GcManager* gcSession = GetCurrentGcSession();
+    if (gcSession != nullptr) {
+        uint64_t size = sizeof(HashTable) + table->m_bucketCount * sizeof(std::atomic<HashNode*>);
+        gcSession->GcRecordObject(GetIndexId(),
+            (void*)table,
+            nullptr,
+            DeallocateTableCallBack,
+            (uint32_t)std::min(size, (uint64_t)UINT32_MAX));
+    } else {
+        MemGlobalFree(table);
+    }
+}
+
+uint32_t HashPrimaryIndex::DeallocateNodeCallBack(void* pool, void* ptr, bool dropIndex)
+{
+    // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+    ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)pool;
+
+    if (dropIndex == false) {
+        localPoolPtr->Release(ptr);
+    }
+    return localPoolPtr->m_size;
+}
+
+uint32_t HashPrimaryIndex::DeallocateTableCallBack(void* table, void* unused, bool dropIndex)
+{
+    // Bucket arrays are not pooled, so they are released also when the index is dropped
+    HashTable* hashTable = (HashTable*)table;
+    uint64_t size = sizeof(HashTable) + hashTable->m_bucketCount * sizeof(std::atomic<HashNode*>);
+    MemGlobalFree(hashTable);
+    return (uint32_t)std::min(size, (uint64_t)UINT32_MAX);
+}
+
+uint64_t HashPrimaryIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_keyPool->GetStats(stats);
+    uint64_t res = stats.m_poolCount * stats.m_poolGrossSize;
+    uint64_t netto = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_sentinelPool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    const HashTable* tables[] = {m_table.load(std::memory_order_acquire), m_oldTable.load(std::memory_order_acquire)};
+    for (const HashTable* table : tables) {
+        if (table != nullptr) {
+            uint64_t tableSize = sizeof(HashTable) + table->m_bucketCount * sizeof(std::atomic<HashNode*>);
+            res += tableSize;
+            netto += tableSize;
+        }
+    }
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    const HashTable* table = m_stripeTables[0].load(std::memory_order_acquire);
+    HashNode* node = table->m_buckets[0].load(std::memory_order_acquire);
+
+    HashIterator* itr = new (std::nothrow) HashIterator(this, table, 0, node, 0);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create hash index iterator");
+        return nullptr;
+    }
+    itr->SkipEmptyBuckets(node);
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    // Only exact matches can be served: there is no next or previous key in a hash index
+    uint32_t matchLen = GetKeySizeNoSuffix();
+    uint64_t hash = HashKey(key->GetKeyBuf(), matchLen);
+    const HashTable* table = m_stripeTables[StripeOf(hash)].load(std::memory_order_acquire);
+    uint64_t bucket = hash & (table->m_bucketCount - 1);
+    HashNode* node = nullptr;
+
+    if (matchKey) {
+        node = table->m_buckets[bucket].load(std::memory_order_acquire);
+        while (node != nullptr && !KeyMatch(node, hash, key->GetKeyBuf(), matchLen)) {
+            node = node->m_next.load(std::memory_order_acquire);
+        }
+    }
+    found = (node != nullptr);
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(this, table, bucket, node, matchLen);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create hash index iterator");
+    }
+    return itr;
+}
+
+GcManager* HashPrimaryIndex::GetCurrentGcSession()
+{
+    return MOTEngine::GetInstance()->GetCurrentGcSession();
+}
+}  // namespace MOT
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Primary index implementation using a concurrent resizable hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_PRIMARY_INDEX_H
+#define HASH_PRIMARY_INDEX_H
+
+#include "index.h"
+#include "utilities.h"
+#include "spin_lock.h"
+#include <atomic>
+
+namespace MOT {
+class GcManager;
+
+/**
+ * @class HashPrimaryIndex.
+ * @brief Primary index implementation using a concurrent resizable hash table.
+ * @detail Readers traverse the bucket chains without locking. Writers serialize per lock stripe. A bucket always
+ * belongs to the stripe of its index modulo the stripe count, so a resize migrates the index one stripe at a time:
+ * each stripe points to the bucket array holding its entries, and the stripes are copied into the doubled array
+ * by the subsequent writers, each holding only the stripe it migrates. Unlinked nodes and replaced bucket arrays
+ * are retired through the GC, so concurrent readers and iterators never observe freed memory. Entries of a
+ * non-unique index are hashed without the row-id suffix, so all the entries of the same key share a chain.
+ * The index serves only point lookups with all the key columns: there is no key ordering, and searching for a key
+ * that is not in the index returns an invalid iterator.
+ */
+class HashPrimaryIndex : public Index {
+private:
+    /**
+     * @struct HashNode
+     * @brief A chain entry. The key buffer follows the node in the same allocation.
+     */
+    struct HashNode {
+        /** @var The next entry in the bucket chain. */
+        std::atomic<HashNode*> m_next;
+
+        /** @var The indexed sentinel. */
+        Sentinel* m_sentinel;
+
+        /** @var The hash of the key (without the non-unique suffix). */
+        uint64_t m_hash;
+
+        /** @var The key. Must be last. */
+        Key m_key;
+    };
+
+    /**
+     * @struct HashTable
+     * @brief A bucket array. The buckets follow the header in the same allocation.
+     */
+    struct HashTable {
+        /** @var The number of buckets (power of 2). */
+        uint64_t m_bucketCount;
+
+        /** @var The bucket chain heads. */
+        std::atomic<HashNode*> m_buckets[0];
+    };
+
+    /**
+     * @class HashIterator
+     * @brief An index iterator implementation for a primary hash index. Iterates either all the entries
+     * matching a search key, or all the entries of the index in no particular order. A full scan visits the
+     * stripes in turn, each one in the bucket array it pointed to when the scan reached it.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param index The scanned index.
+         * @param table The bucket array of the current stripe.
+         * @param bucket The bucket of the current entry.
+         * @param node The current entry, null for an invalid iterator.
+         * @param matchLen The key prefix length all the iterated entries must match, or zero for a full scan.
+         */
+        HashIterator(
+            const HashPrimaryIndex* index, const HashTable* table, uint64_t bucket, HashNode* node, uint32_t matchLen)
+            : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false),
+              m_index(index),
+              m_table(table),
+              m_bucket(bucket),
+              m_node(node),
+              m_matchNode(node),
+              m_matchLen(matchLen)
+        {}
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~HashIterator()
+        {
+            m_index = nullptr;
+            m_table = nullptr;
+            m_node = nullptr;
+            m_matchNode = nullptr;
+        }
+
+        /**
+         * @brief Queries whether this iterator is valid.
+         * @return True if the iterator is valid.
+         */
+        virtual bool IsValid() const
+        {
+            return (m_node != nullptr);
+        }
+
+        /**
+         * @brief Invalidates the iterator such that subsequent calls to isValid() return false.
+         */
+        virtual void Invalidate()
+        {
+            m_node = nullptr;
+        }
+
+        /**
+         * @brief Retrieves the key of the currently iterated item.
+         * @return A pointer to the key of the currently iterated item.
+         */
+        virtual const void* GetKey() const
+        {
+            return &m_node->m_key;
+        }
+
+        /**
+         * @brief Retrieves the row of the currently iterated item.
+         * @return A pointer to the row of the currently iterated item.
+         */
+        virtual Row* GetRow() const
+        {
+            return m_node->m_sentinel->GetData();
+        }
+
+        /**
+         * @brief Retrieves the currently iterated primary sentinel.
+         * @return The primary sentinel.
+         */
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_sentinel;
+        }
+
+        /**
+         * @brief Moves forwards the iterator to the next item.
+         */
+        virtual void Next();
+
+        /**
+         * @brief Moves a full scan forwards to the first entry at or after the current bucket.
+         * @param node The head of the current bucket chain.
+         */
+        void SkipEmptyBuckets(HashNode* node);
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported, hash index entries are not ordered.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        /**
+         * @brief Queries whether this index iterator equals to another index iterator.
+         * @param rhs The index iterator with which to compare this iterator.
+         * @return True if iterators point to the same index item, otherwise false.
+         */
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return (m_node == static_cast<const HashIterator*>(rhs)->m_node);
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         * @param serializeFunc The serialization function.
+         * @param buff The buffer into which the iterator is to be serialized.
+         */
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         * @param deserializeFunc The deserialization function.
+         * @param buff The buffer from which the iterator is to be deserialized.
+         */
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+    private:
+        /** @var The scanned index. */
+        const HashPrimaryIndex* m_index;
+
+        /** @var The bucket array of the current stripe. Stays valid until the GC retires it. */
+        const HashTable* m_table;
+
+        /** @var The bucket of the current entry. */
+        uint64_t m_bucket;
+
+        /** @var The current entry. */
+        HashNode* m_node;
+
+        /** @var The first entry matching the search key. */
+        HashNode* m_matchNode;
+
+        /** @var The matched key prefix length, zero for a full scan. */
+        uint32_t m_matchLen;
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_table(nullptr),
+          m_oldTable(nullptr),
+          m_nodePool(nullptr),
+          m_count(0),
+          m_migratedStripes(0),
+          m_migrateCursor(0),
+          m_initialized(false)
+    {}
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HashPrimaryIndex()
+    {
+        if (m_initialized) {
+            m_initialized = false;
+            DestroyPools();
+        }
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index.
+     * @return The number of rows stored in the index.
+     */
+    virtual uint64_t GetSize() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy the node pool and the bucket array.
+     */
+    virtual void DestroyPools();
+
+    /**
+     * @brief Destroy all memory pools and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyPools();
+
+        return IndexInitImpl(NULL);
+    }
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var Initial number of buckets. */
+    static constexpr uint64_t INITIAL_BUCKET_COUNT = 1024;
+
+    /** @var Number of writer lock stripes (power of 2, not above the initial bucket count). */
+    static constexpr uint32_t LOCK_STRIPE_COUNT = 256;
+
+    /** @brief Gets the lock stripe of a hash, which is also the stripe of its bucket in any bucket array. */
+    static inline uint32_t StripeOf(uint64_t hash)
+    {
+        return (uint32_t)(hash & (LOCK_STRIPE_COUNT - 1));
+    }
+
+    /** @var Average chain length that triggers doubling the bucket array. */
+    static constexpr uint64_t MAX_LOAD_FACTOR = 2;
+
+    /** @var The newest bucket array, the target of a resize in progress. */
+    std::atomic<HashTable*> m_table;
+
+    /** @var The bucket array being migrated from, or null if no resize is in progress. */
+    std::atomic<HashTable*> m_oldTable;
+
+    /** @var The bucket array holding the entries of each stripe, either the newest or the old one. */
+    std::atomic<HashTable*> m_stripeTables[LOCK_STRIPE_COUNT];
+
+    /** @var Memory pool for chain entries (node and key). */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var Number of entries in the index. */
+    std::atomic<uint64_t> m_count;
+
+    /** @var Number of stripes already migrated by the resize in progress. */
+    std::atomic<uint32_t> m_migratedStripes;
+
+    /** @var Round-robin choice of the next stripe a writer helps to migrate. */
+    std::atomic<uint32_t> m_migrateCursor;
+
+    /** @var Writer lock stripes, a bucket is guarded by the stripe of its (hash % LOCK_STRIPE_COUNT). */
+    spin_lock m_locks[LOCK_STRIPE_COUNT];
+
+    /** @var Serializes starting a resize. */
+    spin_lock m_resizeLock;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    /**
+     * @brief Computes the hash of a key buffer.
+     */
+    static uint64_t HashKey(const uint8_t* buf, uint32_t len);
+
+    /** @brief Queries whether a chain entry matches a key buffer of the given length. */
+    static inline bool KeyMatch(const HashNode* node, uint64_t hash, const uint8_t* buf, uint32_t len)
+    {
+        return (node->m_hash == hash) && (memcmp(node->m_key.GetKeyBuf(), buf, len) == 0);
+    }
+
+    /** @brief Allocates an empty bucket array. */
+    static HashTable* AllocTable(uint64_t bucketCount);
+
+    /** @brief Allocates a chain entry holding a copy of the given key. */
+    HashNode* AllocNode(const Key* key, uint64_t hash, Sentinel* sentinel);
+
+    /** @brief Starts doubling the bucket array if the load factor is exceeded and no resize is in progress. */
+    void StartResize();
+
+    /**
+     * @brief Copies the entries of a stripe into the newest bucket array, if not done yet. The stripe must be locked.
+     * @param stripe The stripe to migrate.
+     * @param[out] retired The old bucket array when this was the last stripe to migrate, to be passed to
+     * FinishResize() once the stripe is unlocked.
+     */
+    void MigrateStripe(uint32_t stripe, HashTable*& retired);
+
+    /** @brief Migrates the next stripe of the resize in progress, if any. Called by writers after their operation. */
+    void MigrateStep();
+
+    /** @brief Retires the old bucket array once all the stripes were migrated. */
+    void FinishResize(HashTable* oldTable);
+
+    /** @brief Retires the nodes of one stripe of a replaced bucket array. */
+    void RetireStripeNodes(HashTable* table, uint32_t stripe);
+
+    /** @brief Releases a chain entry after all concurrent readers are done with it. */
+    void RetireNode(HashNode* node);
+
+    /** @brief Releases a bucket array after all concurrent readers are done with it. */
+    void RetireTable(HashTable* table);
+
+    /** @brief Static GC callback for releasing a chain entry. */
+    static uint32_t DeallocateNodeCallBack(void* pool, void* ptr, bool dropIndex);
+
+    /** @brief Static GC callback for releasing a bucket array. */
+    static uint32_t DeallocateTableCallBack(void* table, void* unused, bool dropIndex);
+
+    /** @brief Static helper for getting current GC Session. */
+    static GcManager* GetCurrentGcSession();
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_PRIMARY_INDEX_H */
@@ -508,6 +508,7 @@ Row* Table::RemoveRow(Row* row, uint64_t tid, GcManager* gc)
     Row* OutputRow = nullptr;
     uint32_t numIndexes = GetNumIndexes();
     Sentinel* currSentinel = nullptr;
+    bool destroyRow = false;
     // Build keys and mark sentinels for delete
     for (uint16_t i = 0; i < numIndexes; i++) {
         MOT::Index* ix = GetIndex(i);
@@ -530,7 +531,8 @@ Row* Table::RemoveRow(Row* row, uint64_t tid, GcManager* gc)
                             MOT_LOG_ERROR("RemoveRow called without GC when not recovering");
                             return nullptr;
                         }
-                        DestroyRow(row);
+                        // the row is still needed for building the secondary keys
+                        destroyRow = true;
                         ix->SentinelDtor(currSentinel, nullptr, false);
                     }
                 }
@@ -561,6 +563,9 @@ Row* Table::RemoveRow(Row* row, uint64_t tid, GcManager* gc)
         MOT_ASSERT(currSentinel != nullptr);
         MOT_ASSERT(currSentinel->IsCommited() == true);
     }
+    if (destroyRow) {
+        DestroyRow(row);
+    }
     return OutputRow;
 }
 
@@ -58,7 +58,12 @@ CheckpointManager::CheckpointManager()
       m_inProgressId(CheckpointControlFile::invalidId),
       m_lastReplayLsn(0),
       m_inProcessTxnsLsn(0),
-      m_numSerializedEntries(0)
+      m_numSerializedEntries(0),
+      m_isDelta(false),
+      m_deltaTracking(GetGlobalConfiguration().m_enableDeltaCheckpoint),
+      m_deltaBaseValid(false),
+      m_cutoffCsn(CSNManager::INVALID_CSN),
+      m_prevCutoffCsn(CSNManager::INVALID_CSN)
 {}
 
 bool CheckpointManager::Initialize()
@@ -234,6 +239,9 @@ bool CheckpointManager::Abort()
         UnlockAndClearTables(m_finishedTasks);
         m_numCpTasks = 0;
 
+        // The tracking state may have changed at the aborted snapshot, take a full image next time
+        m_deltaBaseValid = false;
+
         // Move to rest
         m_lock.WrLock();
         MoveToNextPhase();
@@ -365,6 +373,19 @@ void CheckpointManager::MoveToNextPhase()
             // it is safe to ignore any redo replay before this LSN.
             SetLastReplayLsn(std::max(m_inProcessTxnsLsn, GetRecoveryManager()->GetLastReplayLsn()));
         }
+
+        // No transaction is committing at this point, so all the rows with a CSN up to the current one are
+        // part of the snapshot, and all the rows committed later will have a higher CSN. A delta can be taken only
+        // if the deletes were tracked during the whole period since the previous snapshot.
+        m_cutoffCsn = GetCSNManager().GetCurrentCSN();
+        m_isDelta = m_deltaTracking && m_deltaBaseValid && !MOTEngine::GetInstance()->IsRecovering() &&
+                    !m_chain.empty() && (m_chain.size() <= GetGlobalConfiguration().m_deltaCheckpointChainLength);
+        m_deltaTracking = GetGlobalConfiguration().m_enableDeltaCheckpoint;
+        if (!m_deltaTracking) {
+            std::lock_guard<std::mutex> guard(m_deltaLock);
+            m_deltaDeletes.clear();
+        }
+        m_deltaTableIds.clear();
     }
 
     // there are no open transactions from previous phase, we can move forward to next phase
@@ -459,6 +480,73 @@ void CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType
             MOT_LOG_ERROR("Unknown transaction start phase: %s", CheckpointManager::PhaseToString(startPhase));
             MOT_ASSERT(false);
     }
+
+    if (type == DEL && m_deltaTracking && !MOTEngine::GetInstance()->IsRecovering()) {
+        RecordDelete(txnMan, origRow);
+    }
+}
+
+void CheckpointManager::RecordDelete(TxnManager* txnMan, Row* origRow)
+{
+    Table* table = origRow->GetTable();
+    Index* index = table->GetPrimaryIndex();
+    MaxKey key;
+    key.InitKey(index->GetKeyLength());
+    index->BuildKey(table, origRow, &key);
+
+    CheckpointUtils::EntryHeader entryHeader;
+    entryHeader.m_csn = txnMan->GetCommitSequenceNumber();
+    entryHeader.m_rowId = origRow->GetRowId();
+    entryHeader.m_dataLen = 0;
+    entryHeader.m_keyLen = key.GetKeyLength();
+    MOT_ASSERT(entryHeader.m_csn != CSNManager::INVALID_CSN);
+
+    const uint8_t* header = reinterpret_cast<const uint8_t*>(&entryHeader);
+    std::lock_guard<std::mutex> guard(m_deltaLock);
+    std::vector<uint8_t>& deletes = m_deltaDeletes[table->GetTableId()];
+    deletes.insert(deletes.end(), header, header + sizeof(CheckpointUtils::EntryHeader));
+    deletes.insert(deletes.end(), key.GetKeyBuf(), key.GetKeyBuf() + key.GetKeyLength());
+}
+
+void CheckpointManager::OnTableTruncated(uint32_t tableId)
+{
+    std::lock_guard<std::mutex> guard(m_deltaLock);
+    (void)m_fullImageTables.insert(tableId);
+    (void)m_deltaDeletes.erase(tableId);
+}
+
+bool CheckpointManager::GetDeltaTask(Table* table, uint64_t& minCsn, std::vector<uint8_t>& deletes)
+{
+    uint32_t tableId = table->GetTableId();
+    std::lock_guard<std::mutex> guard(m_deltaLock);
+    bool isDelta = m_isDelta && (m_prevTables.count(tableId) != 0) && (m_fullImageTables.count(tableId) == 0);
+    (void)m_fullImageTables.erase(tableId);
+    minCsn = isDelta ? m_prevCutoffCsn : CSNManager::INVALID_CSN;
+
+    // Deletes up to the snapshot are written now (or are not needed in a full image), later ones are kept
+    auto it = m_deltaDeletes.find(tableId);
+    if (it != m_deltaDeletes.end()) {
+        std::vector<uint8_t> remaining;
+        const std::vector<uint8_t>& pending = it->second;
+        size_t pos = 0;
+        while (pos < pending.size()) {
+            const CheckpointUtils::EntryHeader* entry =
+                reinterpret_cast<const CheckpointUtils::EntryHeader*>(pending.data() + pos);
+            size_t entrySize = sizeof(CheckpointUtils::EntryHeader) + entry->m_keyLen;
+            if (entry->m_csn > m_cutoffCsn) {
+                remaining.insert(remaining.end(), pending.data() + pos, pending.data() + pos + entrySize);
+            } else if (isDelta) {
+                deletes.insert(deletes.end(), pending.data() + pos, pending.data() + pos + entrySize);
+            }
+            pos += entrySize;
+        }
+        if (remaining.empty()) {
+            (void)m_deltaDeletes.erase(it);
+        } else {
+            it->second.swap(remaining);
+        }
+    }
+    return isDelta;
 }
 
 void CheckpointManager::FillTasksQueue()
@@ -486,7 +574,7 @@ void CheckpointManager::UnlockAndClearTables(std::list<Table*>& tables)
     tables.clear();
 }
 
-void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
+void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool isDelta, bool success)
 {
     MOT_ASSERT(table);
     if (success) { /* only successful tasks are added to the map file */
@@ -498,10 +586,17 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
         if (entry != nullptr) {
             entry->m_tableId = table->GetTableId();
             entry->m_maxSegId = numSegs;
-            MOT_LOG_DEBUG("TaskDone %lu: %u %u segs", m_inProgressId, entry->m_tableId, numSegs);
+            MOT_LOG_DEBUG("TaskDone %lu: %u %u segs%s",
+                m_inProgressId,
+                entry->m_tableId,
+                numSegs,
+                isDelta ? " (delta)" : "");
             std::lock_guard<std::mutex> guard(m_tasksMutex);
             m_mapfileInfo.push_back(entry);
             m_finishedTasks.push_back(table);
+            if (isDelta) {
+                m_deltaTableIds.push_back(entry->m_tableId);
+            }
         } else {
             OnError(CheckpointWorkerPool::ErrCodes::MEMORY, "Failed to allocate map file entry");
             return;
@@ -521,11 +616,27 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    // The map file creation releases the entries
+    std::set<uint32_t> tables;
+    for (MapFileEntry* entry : m_mapfileInfo) {
+        (void)tables.insert(entry->m_tableId);
+    }
+
     if (!CreateCheckpointMap()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create map file");
         return;
     }
 
+    // A delta in which all the tables were written as a full image starts a new chain
+    if (m_deltaTableIds.empty()) {
+        m_isDelta = false;
+    }
+
+    if (m_isDelta && !CreateDeltaFile()) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create delta file");
+        return;
+    }
+
     if (!ctrlFile->IsValid()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Invalid control file");
         return;
@@ -546,6 +657,11 @@ void CheckpointManager::CompleteCheckpoint()
 
         // Update checkpoint Id
         SetId(m_inProgressId);
+        if (m_isDelta) {
+            m_chain.push_back(m_inProgressId);
+        } else {
+            m_chain.assign(1, m_inProgressId);
+        }
         finishedUpdatingFiles = true;
     } while (0);
     (void)pthread_rwlock_unlock(&m_fetchLock);
@@ -554,10 +670,28 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    UpdateDeltaState(tables);
     RemoveOldCheckpoints(m_inProgressId);
     m_inProcessTxnsLsn = 0;
     m_numSerializedEntries = 0;
-    MOT_LOG_INFO("Checkpoint [%lu] completed", m_inProgressId);
+    MOT_LOG_INFO("Checkpoint [%lu] completed%s", m_inProgressId, m_isDelta ? " (delta)" : "");
+}
+
+void CheckpointManager::UpdateDeltaState(const std::set<uint32_t>& tables)
+{
+    std::lock_guard<std::mutex> guard(m_deltaLock);
+    m_prevCutoffCsn = m_cutoffCsn;
+    m_prevTables = tables;
+    m_deltaBaseValid = !MOTEngine::GetInstance()->IsRecovering();
+
+    // Tables that were dropped, or created after the snapshot, will be written as a full image
+    for (auto it = m_deltaDeletes.begin(); it != m_deltaDeletes.end();) {
+        if (tables.count(it->first) == 0) {
+            it = m_deltaDeletes.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void CheckpointManager::DestroyCheckpointers()
@@ -616,7 +750,7 @@ void CheckpointManager::RemoveOldCheckpoints(uint64_t curCheckcpointId)
             }
 
             uint64_t chkptId = strtoll(p->d_name + strlen(CheckpointUtils::dirPrefix), NULL, 10);
-            if (chkptId == curCheckcpointId) {
+            if (chkptId == curCheckcpointId || std::find(m_chain.begin(), m_chain.end(), chkptId) != m_chain.end()) {
                 MOT_LOG_DEBUG("RemoveOldCheckpoints: exclude %lu", chkptId);
                 continue;
             }
@@ -746,6 +880,8 @@ void CheckpointManager::OnError(int errCode, const char* errMsg, const char* opt
         m_errorSet = true;
         m_checkpointEnded = true;
     }
+    // Deletes handed to the workers are lost, take a full image next time
+    m_deltaBaseValid = false;
     m_errorReportLock.unlock();
 }
 
@@ -1004,4 +1140,59 @@ bool CheckpointManager::CreateEndFile()
 
     return ret;
 }
+
+bool CheckpointManager::CreateDeltaFile()
+{
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+    bool ret = false;
+
+    do {
+        if (!CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+            break;
+        }
+
+        CheckpointUtils::MakeDeltaFilename(fileName, workingDir, m_inProgressId);
+        if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+            MOT_LOG_ERROR(
+                "CreateDeltaFile: failed to create file '%s' - %d - %s", fileName.c_str(), errno, gs_strerror(errno));
+            break;
+        }
+
+        CheckpointUtils::DeltaFileHeader deltaFileHeader{CP_MGR_MAGIC, m_id, m_chain.size(), m_deltaTableIds.size()};
+        if (CheckpointUtils::WriteFile(fd, (char*)&deltaFileHeader, sizeof(CheckpointUtils::DeltaFileHeader)) !=
+            sizeof(CheckpointUtils::DeltaFileHeader)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to write delta file's header");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        bool writeFailed = false;
+        for (uint32_t tableId : m_deltaTableIds) {
+            if (CheckpointUtils::WriteFile(fd, (char*)&tableId, sizeof(uint32_t)) != sizeof(uint32_t)) {
+                MOT_LOG_ERROR("CreateDeltaFile: failed to write delta file entry");
+                writeFailed = true;
+                break;
+            }
+        }
+        if (writeFailed) {
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to flush delta file");
+            break;
+        }
+
+        if (CheckpointUtils::CloseFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to close delta file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    return ret;
+}
 }  // namespace MOT
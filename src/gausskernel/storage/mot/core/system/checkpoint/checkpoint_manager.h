@@ -33,6 +33,8 @@
 #include "txn.h"
 #include "txn_access.h"
 #include <queue>
+#include <set>
+#include <unordered_map>
 #include "checkpoint_worker.h"
 #include "checkpoint_ctrlfile.h"
 #include "spin_lock.h"
@@ -109,14 +111,37 @@ public:
      */
     void ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType type);
 
+    /**
+     * @brief Records a committed delete of a row, so the next delta checkpoint can carry it.
+     * @param txnMan Transaction's TxnManger pointer.
+     * @param origRow The deleted global row.
+     */
+    void RecordDelete(TxnManager* txnMan, Row* origRow);
+
+    /**
+     * @brief Notifies that a table was truncated, so the next checkpoint writes a full image of it.
+     * @param tableId The truncated table's id.
+     */
+    void OnTableTruncated(uint32_t tableId);
+
     /**
      * @brief Checkpoint task completion callback
      * @param checkpointId The checkpoint's id.
      * @param table The table's pointer.
      * @param numSegs number of segments written.
+     * @param isDelta Indicates the table was written as a delta.
      * @param success Indicates a success or a failure.
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success);
+    virtual void TaskDone(Table* table, uint32_t numSegs, bool isDelta, bool success);
+
+    /**
+     * @brief Determines whether a table is written as a delta or as a full image.
+     * @param table The table's pointer.
+     * @param minCsn The returned CSN of the previous checkpoint.
+     * @param deletes The returned deleted keys.
+     * @return True if the table should be written as a delta.
+     */
+    virtual bool GetDeltaTask(Table* table, uint64_t& minCsn, std::vector<uint8_t>& deletes);
 
     virtual bool ShouldStop() const
     {
@@ -132,7 +157,7 @@ public:
     virtual void OnError(int errCode, const char* errMsg, const char* optionalMsg = nullptr);
 
     /**
-     * @brief Deletes 'old' checkpoint directories
+     * @brief Deletes 'old' checkpoint directories, except for the ones in the current delta chain
      * @param the current checkpoint id which should not be deleted
      */
     void RemoveOldCheckpoints(uint64_t curCheckcpointId);
@@ -171,6 +196,24 @@ public:
         m_id = id;
     }
 
+    /**
+     * @brief Sets the delta chain the current checkpoint depends on (used by recovery).
+     * @param chain The checkpoint ids of the chain, starting with the full checkpoint and ending with the current one.
+     */
+    void SetChain(const std::vector<uint64_t>& chain)
+    {
+        m_chain = chain;
+    }
+
+    /**
+     * @brief Retrieves the delta chain of the current checkpoint. Must be called under the fetch lock.
+     * @return The checkpoint ids of the chain, starting with the full checkpoint and ending with the current one.
+     */
+    const std::vector<uint64_t>& GetChain() const
+    {
+        return m_chain;
+    }
+
     uint64_t GetLastReplayLsn()
     {
         return m_lastReplayLsn;
@@ -277,6 +320,39 @@ private:
     // this lock guards gs_ctl checkpoint fetching
     pthread_rwlock_t m_fetchLock;
 
+    // Indicates the in-progress checkpoint is a delta of the previous one
+    bool m_isDelta;
+
+    // Indicates deletes are being recorded for the next delta checkpoint
+    volatile bool m_deltaTracking;
+
+    // Indicates all the changes since the last checkpoint were tracked, so a delta can be taken on top of it
+    bool m_deltaBaseValid;
+
+    // The CSN of the in-progress checkpoint snapshot, all the rows with this CSN or lower are captured
+    uint64_t m_cutoffCsn;
+
+    // The CSN of the last valid checkpoint snapshot
+    uint64_t m_prevCutoffCsn;
+
+    // The checkpoint ids the last valid checkpoint depends on, starting with a full checkpoint
+    std::vector<uint64_t> m_chain;
+
+    // The tables that were written in the last valid checkpoint
+    std::set<uint32_t> m_prevTables;
+
+    // The tables that must be written as a full image in the next checkpoint (e.g. truncated)
+    std::set<uint32_t> m_fullImageTables;
+
+    // The tables written as delta in the in-progress checkpoint
+    std::list<uint32_t> m_deltaTableIds;
+
+    // Serialized deleted keys per table, not yet written to a checkpoint
+    std::unordered_map<uint32_t, std::vector<uint8_t>> m_deltaDeletes;
+
+    // mutex for safeguarding the delta tracking state
+    std::mutex m_deltaLock;
+
     CheckpointPhase GetPhase() const
     {
         return m_phase;
@@ -389,6 +465,18 @@ private:
      */
     bool CreateEndFile();
 
+    /**
+     * @brief Creates the delta file: the previous checkpoint id and the tables written as delta.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateDeltaFile();
+
+    /**
+     * @brief Updates the delta tracking state once a checkpoint is completed.
+     * @param tables The tables included in the completed checkpoint.
+     */
+    void UpdateDeltaState(const std::set<uint32_t>& tables);
+
     /**
      * @brief Serializes inProcess transactions to disk
      * @return RC value denoting the status of the operation.
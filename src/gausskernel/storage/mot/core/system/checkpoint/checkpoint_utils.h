@@ -35,6 +35,9 @@
 
 const uint64_t CP_MGR_MAGIC = 0xaabbccdd;
 
+/* Data file whose entries are written as LZ4 compressed blocks (see compression.h) following the file header. */
+const uint64_t CP_MGR_LZ4_MAGIC = 0xaabbccde;
+
 namespace MOT {
 namespace CheckpointUtils {
 
@@ -180,6 +183,9 @@ static const char* tpcFileSuffix = ".tpc";
 // End file suffix
 static const char* validFileSuffix = ".end";
 
+// Delta file suffix
+static const char* deltaFileSuffix = ".delta";
+
 // Max path len
 static const size_t maxPath = 1024;
 
@@ -300,6 +306,19 @@ inline void MakeEndFilename(std::string& fileName, std::string& workingDir, uint
     fileName.append(validFileSuffix);
 }
 
+/**
+ * @brief Creates a delta checkpoint descriptor filename
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param cpId The checkpoint id.
+ */
+inline void MakeDeltaFilename(std::string& fileName, std::string& workingDir, uint64_t cpId)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(std::to_string(cpId));
+    fileName.append(deltaFileSuffix);
+}
+
 /**
  * @brief Sets the cpu affinity for a given thread
  * @param cpu The cpu that the thread should run on.
@@ -328,6 +347,14 @@ struct EntryHeader {
     uint16_t m_keyLen;
 };
 
+/**
+ * @brief A delta checkpoint data file entry with no row data (m_dataLen is zero) denotes a deleted key.
+ */
+inline bool IsDeleteEntry(const EntryHeader& entry)
+{
+    return (entry.m_dataLen == 0);
+}
+
 struct MetaFileHeader {
     FileHeader m_fileHeader;
     EntryHeader m_entryHeader;
@@ -348,6 +375,18 @@ struct TpcEntryHeader {
     uint64_t m_len;
 };
 
+/**
+ * @brief Header of the delta descriptor file, which exists only in delta checkpoints. It is followed by
+ * m_numEntries table ids (uint32_t) of the tables that were written as a delta. All other tables of the
+ * checkpoint were written as a full image. m_prevId is the checkpoint this delta applies on top of.
+ */
+struct DeltaFileHeader {
+    uint64_t m_magic;
+    uint64_t m_prevId;
+    uint64_t m_chainLength;
+    uint64_t m_numEntries;
+};
+
 /**
  * @brief Produces a pretty hex printout of a given buffer to stderr
  * @param msg A text the will be displayed before the hex data printout.
@@ -30,6 +30,8 @@
 #include "checkpoint_utils.h"
 #include "checkpoint_worker.h"
 #include "checkpoint_manager.h"
+#include "compression.h"
+#include "log_statistics.h"
 #include "mot_engine.h"
 
 namespace MOT {
@@ -39,9 +41,18 @@ struct WorkerThreads {
     std::vector<std::thread> m_vec;
 };
 
+/* Per worker scratch buffer into which the data buffer is compressed before it is written. */
+static __thread char* cpCompressBuffer = nullptr;
+static __thread uint32_t cpCompressBufferSize = 0;
+
+/* Per worker raw and compressed byte counters of the table being written. */
+static __thread uint64_t cpRawBytes = 0;
+static __thread uint64_t cpCompressedBytes = 0;
+
 void CheckpointWorkerPool::Start()
 {
     MOT_LOG_DEBUG("CheckpointWorkerPool::start() %d workers", m_numWorkers.load());
+    m_compress = GetGlobalConfiguration().m_enableCheckpointCompression;
 
     if (!CheckpointUtils::SetWorkingDir(m_workingDir, m_checkpointId)) {
         m_cpManager.OnError(ErrCodes::FILE_IO, "failed to setup working dir");
@@ -85,8 +96,7 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     if (buffer->Size() + primaryKey->GetKeyLength() + row->GetTupleSize() + sizeof(CheckpointUtils::EntryHeader) >
         buffer->MaxSize()) {
         // need to flush the buffer before serializing the next row
-        size_t wrSta = CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size());
-        if (wrSta != buffer->Size()) {
+        if (!FlushBuffer(fd, buffer)) {
             MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to write %u bytes to [%d] (%d:%s)",
                 buffer->Size(),
                 fd,
@@ -99,7 +109,6 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
             MOT_LOG_ERROR("CheckpointWorkerPool::write - failed to flush [%d]", fd);
             return false;
         }
-        buffer->Reset();
     }
     CheckpointUtils::EntryHeader entryHeader;
     entryHeader.m_keyLen = primaryKey->GetKeyLength();
@@ -122,7 +131,45 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     return true;
 }
 
-int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted)
+int CheckpointWorkerPool::WriteIfModified(Buffer* buffer, Row* row, int fd, uint64_t minCsn)
+{
+    if (row->GetCommitSequenceNumber() <= minCsn) {
+        // unchanged since the previous checkpoint, the row is already in the chain
+        return 0;
+    }
+    return Write(buffer, row, fd) ? 1 : -1;
+}
+
+bool CheckpointWorkerPool::WriteDeletes(Buffer* buffer, const std::vector<uint8_t>& deletes, int fd, uint64_t& numOps)
+{
+    size_t pos = 0;
+    while (pos < deletes.size()) {
+        const CheckpointUtils::EntryHeader* entry =
+            reinterpret_cast<const CheckpointUtils::EntryHeader*>(deletes.data() + pos);
+        size_t entrySize = sizeof(CheckpointUtils::EntryHeader) + entry->m_keyLen;
+        MOT_ASSERT(CheckpointUtils::IsDeleteEntry(*entry) && (pos + entrySize <= deletes.size()));
+        if (buffer->Size() + entrySize > buffer->MaxSize()) {
+            if (!FlushBuffer(fd, buffer)) {
+                MOT_LOG_ERROR("CheckpointWorkerPool::WriteDeletes - failed to write %u bytes to [%d] (%d:%s)",
+                    buffer->Size(),
+                    fd,
+                    errno,
+                    gs_strerror(errno));
+                return false;
+            }
+        }
+        if (!buffer->Append(deletes.data() + pos, entrySize)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteDeletes Failed to write entry to buffer");
+            return false;
+        }
+        pos += entrySize;
+        numOps++;
+    }
+    return true;
+}
+
+int CheckpointWorkerPool::Checkpoint(
+    Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, uint64_t minCsn, bool& isDeleted)
 {
     Row* mainRow = sentinel->GetData();
     Row* stableRow = nullptr;
@@ -163,14 +210,10 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                 break;
             }
 
-            if (!Write(buffer, stableRow, fd)) {
-                wrote = -1;
-            } else {
-                if (isDeleted == false) {
-                    CheckpointUtils::DestroyStableRow(stableRow);
-                    sentinel->SetStable(nullptr);
-                }
-                wrote = 1;
+            wrote = WriteIfModified(buffer, stableRow, fd, minCsn);
+            if (wrote >= 0 && isDeleted == false) {
+                CheckpointUtils::DestroyStableRow(stableRow);
+                sentinel->SetStable(nullptr);
             }
             break;
         } else { /* no stable version */
@@ -180,11 +223,7 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                     break;
                 }
                 sentinel->SetStableStatus(!m_na);
-                if (!Write(buffer, mainRow, fd)) {
-                    wrote = -1;  // we failed to write, set error
-                } else {
-                    wrote = 1;
-                }
+                wrote = WriteIfModified(buffer, mainRow, fd, minCsn);
                 break;
             }
 
@@ -244,10 +283,24 @@ void CheckpointWorkerPool::WorkerFunc()
         return;
     }
 
+    if (m_compress) {
+        cpCompressBufferSize = Compression::CompressBound(buffer.MaxSize());
+        cpCompressBuffer = new (std::nothrow) char[cpCompressBufferSize];
+        if (cpCompressBuffer == nullptr) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to allocate compression buffer");
+            m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
+            MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
+            MOT_LOG_DEBUG("thread exiting");
+            return;
+        }
+    }
+
     SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
     if (sessionContext == nullptr) {
         MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to initialize Session Context");
         m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
+        delete[] cpCompressBuffer;
+        cpCompressBuffer = nullptr;
         MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
         MOT_LOG_DEBUG("thread exiting");
         return;
@@ -265,6 +318,8 @@ void CheckpointWorkerPool::WorkerFunc()
         MOT_LOG_ERROR("CheckpointWorkerPool::WorkerFunc: Failed to allocate memory for deleted sentinel list");
         m_cpManager.OnError(ErrCodes::MEMORY, "Memory allocation failure");
         GetSessionManager()->DestroySessionContext(sessionContext);
+        delete[] cpCompressBuffer;
+        cpCompressBuffer = nullptr;
         MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
         MOT_LOG_DEBUG("thread exiting");
         return;
@@ -275,6 +330,7 @@ void CheckpointWorkerPool::WorkerFunc()
         uint64_t exId = 0;
         uint32_t maxSegId = 0;
         bool taskSucceeded = false;
+        bool isDelta = false;
 
         if (m_cpManager.ShouldStop()) {
             break;
@@ -299,7 +355,13 @@ void CheckpointWorkerPool::WorkerFunc()
                 uint64_t numOps = 0;
                 clock_gettime(CLOCK_MONOTONIC, &start);
 
-                errCode = WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps);
+                uint64_t minCsn = 0;
+                std::vector<uint8_t> deletes;
+                cpRawBytes = 0;
+                cpCompressedBytes = 0;
+                isDelta = m_cpManager.GetDeltaTask(table, minCsn, deletes);
+                errCode = WriteTableDataFile(
+                    table, &buffer, deletedList, gcSession, threadId, minCsn, deletes, maxSegId, numOps);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WorkerFunc: failed to write table data file for table %u", tableId);
@@ -316,13 +378,21 @@ void CheckpointWorkerPool::WorkerFunc()
                  */
                 uint64_t deltaUs = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
                 MOT_LOG_DEBUG(
-                    "CheckpointWorkerPool::WorkerFunc: checkpoint of table %u completed in %luus, (%lu elements)",
+                    "CheckpointWorkerPool::WorkerFunc: %s checkpoint of table %u completed in %luus, (%lu elements)",
+                    isDelta ? "delta" : "full",
                     tableId,
                     deltaUs,
                     numOps);
+                if (m_compress && cpRawBytes > 0) {
+                    MOT_LOG_DEBUG("CheckpointWorkerPool::WorkerFunc: table %u data compressed from %lu to %lu bytes",
+                        tableId,
+                        cpRawBytes,
+                        cpCompressedBytes);
+                    LogStatisticsProvider::GetInstance().AddCompression(cpRawBytes, cpCompressedBytes);
+                }
             } while (0);
 
-            m_cpManager.TaskDone(table, maxSegId, taskSucceeded);
+            m_cpManager.TaskDone(table, maxSegId, isDelta, taskSucceeded);
 
             if (!taskSucceeded) {
                 break;
@@ -332,6 +402,8 @@ void CheckpointWorkerPool::WorkerFunc()
         }
     }
     delete[] deletedList;
+    delete[] cpCompressBuffer;
+    cpCompressBuffer = nullptr;
     GetSessionManager()->DestroySessionContext(sessionContext);
     MOT::MOTEngine::GetInstance()->OnCurrentThreadEnding();
     MOT_LOG_DEBUG("thread exiting");
@@ -346,7 +418,7 @@ bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_
         return false;
     }
     MOT_LOG_DEBUG("CheckpointWorkerPool::beginFile: %s", fileName.c_str());
-    CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, 0};
+    CheckpointUtils::FileHeader fileHeader{m_compress ? CP_MGR_LZ4_MAGIC : CP_MGR_MAGIC, tableId, exId, 0};
     if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
         sizeof(CheckpointUtils::FileHeader)) {
         MOT_LOG_ERROR("CheckpointWorkerPool::BeginFile: failed to write file header: %s", fileName.c_str());
@@ -365,7 +437,7 @@ bool CheckpointWorkerPool::FinishFile(int& fd, uint32_t tableId, uint64_t numOps
             MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to seek in file (id: %u)", tableId);
             break;
         }
-        CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, numOps};
+        CheckpointUtils::FileHeader fileHeader{m_compress ? CP_MGR_LZ4_MAGIC : CP_MGR_MAGIC, tableId, exId, numOps};
         if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
             sizeof(CheckpointUtils::FileHeader)) {
             MOT_LOG_ERROR("CheckpointWorkerPool::FinishFile: failed to write to file (id: %u)", tableId);
@@ -456,7 +528,18 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableMetadataFile(Tabl
 bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
 {
     if (buffer->Size() > 0) {  // there is data in the buffer that needs to be written
-        if (CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size()) != buffer->Size()) {
+        char* data = (char*)buffer->Data();
+        size_t size = buffer->Size();
+        if (m_compress) {
+            size = Compression::CompressBlock(data, buffer->Size(), cpCompressBuffer, cpCompressBufferSize);
+            if (size == 0) {
+                return false;
+            }
+            data = cpCompressBuffer;
+            cpRawBytes += buffer->Size();
+            cpCompressedBytes += size;
+        }
+        if (CheckpointUtils::WriteFile(fd, data, size) != size) {
             return false;
         }
         buffer->Reset();
@@ -465,7 +548,8 @@ bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
 }
 
 CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* table, Buffer* buffer,
-    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps)
+    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint64_t minCsn,
+    const std::vector<uint8_t>& deletes, uint32_t& maxSegId, uint64_t& numOps)
 {
     uint32_t tableId = table->GetTableId();
     uint64_t exId = table->GetTableExId();
@@ -506,7 +590,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             it->Next();
             continue;
         }
-        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted);
+        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, minCsn, isDeleted);
         if (isDeleted) {
             deletedList[deletedListLocation++] = sentinel;
             ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, DELETE_LIST_SIZE);
@@ -567,6 +651,14 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
     }
     table->ClearThreadMemoryCache();
 
+    if (errCode == ErrCodes::SUCCESS && !WriteDeletes(buffer, deletes, fd, currFileOps)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDataFile: failed to write deleted keys to data file %u for "
+                      "table %u",
+            maxSegId,
+            tableId);
+        errCode = ErrCodes::FILE_IO;
+    }
+
     if (errCode != ErrCodes::SUCCESS) {
         if (fd != -1) {
             (void)CheckpointUtils::CloseFile(fd);
@@ -50,9 +50,20 @@ public:
      * @param checkpointId The checkpoint's id.
      * @param table The table's pointer.
      * @param numSegs number of segments written.
+     * @param isDelta Indicates the table was written as a delta.
      * @param success Indicates a success or a failure.
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success) = 0;
+    virtual void TaskDone(Table* table, uint32_t numSegs, bool isDelta, bool success) = 0;
+
+    /**
+     * @brief Determines whether a table is written as a delta or as a full image, and retrieves the
+     * keys deleted from it since the previous checkpoint.
+     * @param table The table's pointer.
+     * @param minCsn The returned CSN of the previous checkpoint, only rows with a higher CSN are written.
+     * @param deletes The returned deleted keys, serialized as data file entries.
+     * @return True if the table should be written as a delta.
+     */
+    virtual bool GetDeltaTask(Table* table, uint64_t& minCsn, std::vector<uint8_t>& deletes) = 0;
 
     /**
      * @brief Checks if the thread should terminate it work
@@ -79,7 +90,13 @@ public:
 class CheckpointWorkerPool {
 public:
     CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, CheckpointManagerCallbacks& m)
-        : m_numWorkers(n), m_tasksList(l), m_checkpointId(id), m_na(b), m_cpManager(m), m_checkpointSegsize(s)
+        : m_numWorkers(n),
+          m_tasksList(l),
+          m_checkpointId(id),
+          m_na(b),
+          m_cpManager(m),
+          m_checkpointSegsize(s),
+          m_compress(false)
     {
         Start();
     }
@@ -107,16 +124,37 @@ private:
      */
     bool Write(Buffer* buffer, Row* row, int fd);
 
+    /**
+     * @brief Appends a row to the buffer, unless it was not modified since the previous checkpoint.
+     * @param buffer The buffer to fill.
+     * @param row The row to write.
+     * @param fd The file descriptor to write to.
+     * @param minCsn Rows with this CSN or lower are skipped.
+     * @return -1 on error, 0 if the row was skipped and 1 if the row was written.
+     */
+    int WriteIfModified(Buffer* buffer, Row* row, int fd, uint64_t minCsn);
+
+    /**
+     * @brief Appends serialized deleted key entries to the buffer. The buffer will be flushed in case it is full.
+     * @param buffer The buffer to fill.
+     * @param deletes The deleted key entries.
+     * @param fd The file descriptor to write to.
+     * @param numOps The number of entries written is added to this counter.
+     * @return Boolean value denoting success or failure.
+     */
+    bool WriteDeletes(Buffer* buffer, const std::vector<uint8_t>& deletes, int fd, uint64_t& numOps);
+
     /**
      * @brief Checkpoints a row, according to whether a stable version exists or not.
      * @param buffer The buffer to fill.
      * @param sentinel The sentinel that holds to row.
      * @param fd The file descriptor to write to.
      * @param threadId The thread id.
+     * @param minCsn Rows with this CSN or lower are not written (delta checkpoint), zero for a full image.
      * @param isDeleted The row delete status.
      * @return -1 on error, 0 if nothing was written and 1 if the row was written.
      */
-    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted);
+    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, uint64_t minCsn, bool& isDeleted);
 
     /**
      * @brief Pops a task (table pointer) from the tasks queue.
@@ -167,13 +205,23 @@ private:
      * @param deletedList Array to collect the sentinels deleted rows to be cleaned.
      * @param gcSession GC manager object.
      * @param threadId The thread id.
+     * @param minCsn Rows with this CSN or lower are not written (delta checkpoint), zero for a full image.
+     * @param deletes Deleted key entries to write after the rows (delta checkpoint).
      * @param maxSegId The maximum segment ID of the table.
      * @param numOps The number of rows written.
      * @return Returns the error code of type ErrCodes.
      */
     ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, Sentinel** deletedList, GcManager* gcSession,
-        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps);
+        uint16_t threadId, uint64_t minCsn, const std::vector<uint8_t>& deletes, uint32_t& maxSegId,
+        uint64_t& numOps);
 
+    /**
+     * @brief Writes the buffer contents to the file and resets the buffer. If checkpoint compression is enabled,
+     * the contents are written as a single compressed block.
+     * @param fd The file descriptor to write to.
+     * @param buffer The buffer to flush.
+     * @return Boolean value denoting success or failure.
+     */
     bool FlushBuffer(int fd, Buffer* buffer);
 
     // Workers
@@ -201,6 +249,9 @@ private:
 
     // Size threshold
     uint32_t m_checkpointSegsize;
+
+    // Data files are written as compressed blocks
+    bool m_compress;
 };
 }  // namespace MOT
 
@@ -387,6 +387,8 @@ ScopedSessionManager::ScopedSessionManager()
     m_localUSess.mot_cxt.jit_tvm_do_while_stack = nullptr;
     m_localUSess.mot_cxt.jit_context = nullptr;
     m_localUSess.mot_cxt.jit_txn = nullptr;
+    m_localUSess.mot_cxt.jit_exec_count = 0;
+    m_localUSess.mot_cxt.jit_exec_spi_count = 0;
 
     // setup the session context
     u_sess = &m_localUSess;
@@ -50,6 +50,7 @@ constexpr RedoLogHandlerType MOTConfiguration::DEFAULT_REDO_LOG_HANDLER_TYPE;
 constexpr uint32_t MOTConfiguration::DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT;
 constexpr uint32_t MOTConfiguration::MIN_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT;
 constexpr uint32_t MOTConfiguration::MAX_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_REDO_LOG_COMPRESSION;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_GROUP_COMMIT;
 constexpr uint64_t MOTConfiguration::DEFAULT_GROUP_COMMIT_SIZE;
 constexpr uint64_t MOTConfiguration::MIN_GROUP_COMMIT_SIZE;
@@ -69,6 +70,11 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_DELTA_CHECKPOINT;
+constexpr uint32_t MOTConfiguration::DEFAULT_DELTA_CHECKPOINT_CHAIN_LENGTH;
+constexpr uint32_t MOTConfiguration::MIN_DELTA_CHECKPOINT_CHAIN_LENGTH;
+constexpr uint32_t MOTConfiguration::MAX_DELTA_CHECKPOINT_CHAIN_LENGTH;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_CHECKPOINT_COMPRESSION;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
@@ -441,6 +447,7 @@ MOTConfiguration::MOTConfiguration()
       m_loggerType(DEFAULT_LOGGER_TYPE),
       m_redoLogHandlerType(DEFAULT_REDO_LOG_HANDLER_TYPE),
       m_asyncRedoLogBufferArrayCount(DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT),
+      m_enableRedoLogCompression(DEFAULT_ENABLE_REDO_LOG_COMPRESSION),
       m_enableGroupCommit(DEFAULT_ENABLE_GROUP_COMMIT),
       m_groupCommitSize(DEFAULT_GROUP_COMMIT_SIZE),
       m_groupCommitTimeoutUSec(DEFAULT_GROUP_COMMIT_TIMEOUT_USEC),
@@ -449,6 +456,9 @@ MOTConfiguration::MOTConfiguration()
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_enableDeltaCheckpoint(DEFAULT_ENABLE_DELTA_CHECKPOINT),
+      m_deltaCheckpointChainLength(DEFAULT_DELTA_CHECKPOINT_CHAIN_LENGTH),
+      m_enableCheckpointCompression(DEFAULT_ENABLE_CHECKPOINT_COMPRESSION),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
       m_abortBufferEnable(true),
       m_preAbort(true),
@@ -547,6 +557,7 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseLoggerType(name, "logger_type", value, &m_loggerType)) {
     } else if (ParseRedoLogHandlerType(name, "redo_log_handler_type", value, &m_redoLogHandlerType)) {
     } else if (ParseUint32(name, "async_log_buffer_count", value, &m_asyncRedoLogBufferArrayCount)) {
+    } else if (ParseBool(name, "enable_redo_log_compression", value, &m_enableRedoLogCompression)) {
     } else if (ParseBool(name, "enable_group_commit", value, &m_enableGroupCommit)) {
     } else if (ParseUint64(name, "group_commit_size", value, &m_groupCommitSize)) {
     } else if (ParseUint64(name, "group_commit_timeout_usec", value, &m_groupCommitTimeoutUSec)) {
@@ -555,6 +566,9 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseBool(name, "enable_delta_checkpoint", value, &m_enableDeltaCheckpoint)) {
+    } else if (ParseUint32(name, "delta_checkpoint_chain_length", value, &m_deltaCheckpointChainLength)) {
+    } else if (ParseBool(name, "enable_checkpoint_compression", value, &m_enableCheckpointCompression)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
@@ -902,6 +916,7 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT,
         MIN_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT,
         MAX_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT);
+    UPDATE_BOOL_CFG(m_enableRedoLogCompression, "enable_redo_log_compression", DEFAULT_ENABLE_REDO_LOG_COMPRESSION);
 
     // commit configuration
     UPDATE_BOOL_CFG(m_enableGroupCommit, "enable_group_commit", DEFAULT_ENABLE_GROUP_COMMIT);
@@ -941,6 +956,14 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_BOOL_CFG(m_enableDeltaCheckpoint, "enable_delta_checkpoint", DEFAULT_ENABLE_DELTA_CHECKPOINT);
+    UPDATE_INT_CFG(m_deltaCheckpointChainLength,
+        "delta_checkpoint_chain_length",
+        DEFAULT_DELTA_CHECKPOINT_CHAIN_LENGTH,
+        MIN_DELTA_CHECKPOINT_CHAIN_LENGTH,
+        MAX_DELTA_CHECKPOINT_CHAIN_LENGTH);
+    UPDATE_BOOL_CFG(
+        m_enableCheckpointCompression, "enable_checkpoint_compression", DEFAULT_ENABLE_CHECKPOINT_COMPRESSION);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
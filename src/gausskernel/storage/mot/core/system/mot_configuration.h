@@ -142,6 +142,9 @@ public:
     /** Determines the number of asynchronous redo log buffer arrays. */
     uint32_t m_asyncRedoLogBufferArrayCount;
 
+    /** Enable LZ4 compression of redo log records. */
+    bool m_enableRedoLogCompression;
+
     /**********************************************************************/
     // Commit configuration
     /**********************************************************************/
@@ -172,6 +175,15 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Enable delta checkpoints (write only the rows modified since the previous checkpoint). */
+    bool m_enableDeltaCheckpoint;
+
+    /** @var Maximum number of delta checkpoints on top of a full checkpoint before a full one is taken. */
+    uint32_t m_deltaCheckpointChainLength;
+
+    /** @var Enable LZ4 compression of checkpoint data files. */
+    bool m_enableCheckpointCompression;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -419,6 +431,9 @@ public:
     /** @var Default asynchronous redo log buffer array count. */
     static constexpr uint32_t DEFAULT_ASYNC_REDO_LOG_BUFFER_ARRAY_COUNT = 24;
 
+    /** @var Default enable redo log compression. */
+    static constexpr bool DEFAULT_ENABLE_REDO_LOG_COMPRESSION = false;
+
     /** @var Default enable group commit. */
     static constexpr bool DEFAULT_ENABLE_GROUP_COMMIT = false;
 
@@ -456,6 +471,17 @@ public:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default enable delta checkpoint. */
+    static constexpr bool DEFAULT_ENABLE_DELTA_CHECKPOINT = false;
+
+    /** @var Default maximum number of delta checkpoints between two full checkpoints. */
+    static constexpr uint32_t DEFAULT_DELTA_CHECKPOINT_CHAIN_LENGTH = 8;
+    static constexpr uint32_t MIN_DELTA_CHECKPOINT_CHAIN_LENGTH = 1;
+    static constexpr uint32_t MAX_DELTA_CHECKPOINT_CHAIN_LENGTH = 1024;
+
+    /** @var Default enable checkpoint compression. */
+    static constexpr bool DEFAULT_ENABLE_CHECKPOINT_COMPRESSION = false;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
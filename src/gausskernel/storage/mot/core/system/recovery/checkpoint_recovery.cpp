@@ -23,9 +23,13 @@
  */
 
 #include <thread>
+#include <algorithm>
+#include <time.h>
 #include "mot_engine.h"
 #include "checkpoint_recovery.h"
 #include "checkpoint_utils.h"
+#include "compression.h"
+#include "buffer.h"
 #include "irecovery_manager.h"
 #include "redo_log_transaction_iterator.h"
 
@@ -121,11 +125,22 @@ bool CheckpointRecovery::Recover()
      * we will need to retrieve it before a new checkpoint is created.
      */
     engine->GetCheckpointManager()->SetId(m_checkpointId);
+    engine->GetCheckpointManager()->SetChain(m_chain);
 
     MOT_LOG_INFO("Checkpoint Recovery: finished recovering %lu tables from checkpoint id: %lu",
         m_tableIds.size(),
         m_checkpointId);
 
+    if (m_compressedBytes > 0) {
+        // the decompression time is summed over all the workers, so the throughput is per worker
+        uint64_t decompressUs = m_decompressUs.load();
+        MOT_LOG_INFO("Checkpoint Recovery: decompressed %lu bytes into %lu bytes (ratio %.2f), %.2f MB/s per worker",
+            m_compressedBytes.load(),
+            m_rawBytes.load(),
+            (double)m_rawBytes / m_compressedBytes,
+            (decompressUs > 0) ? ((double)m_rawBytes / (1024 * 1024)) / ((double)decompressUs / 1000000) : 0.0);
+    }
+
     m_tableIds.clear();
     MOTEngine::GetInstance()->GetCheckpointManager()->RemoveOldCheckpoints(m_checkpointId);
     return true;
@@ -144,6 +159,25 @@ bool CheckpointRecovery::PerformRecovery()
         }
     }
 
+    RunWorkers();
+
+    // The deltas are applied once all the full images are loaded. The deltas of a table
+    // are applied by a single worker in the chain order, different tables in parallel.
+    if (!m_deltaTasksList.empty() && !m_errorSet) {
+        MOT_LOG_INFO("CheckpointRecovery: applying deltas of %lu tables (chain length %lu)",
+            m_deltaTasksList.size(),
+            m_chain.size());
+        m_tasksLock.lock();
+        m_tasksList.splice(m_tasksList.end(), m_deltaTasksList);
+        m_tasksLock.unlock();
+        RunWorkers();
+    }
+
+    return true;
+}
+
+void CheckpointRecovery::RunWorkers()
+{
     std::vector<std::thread> threadPool;
     for (uint32_t i = 0; i < m_numWorkers; ++i) {
         threadPool.push_back(std::thread(CheckpointRecoveryWorker, this));
@@ -160,8 +194,6 @@ bool CheckpointRecovery::PerformRecovery()
             worker.join();
         }
     }
-
-    return true;
 }
 
 int CheckpointRecovery::FillTasksFromMapFile()
@@ -170,53 +202,172 @@ int CheckpointRecovery::FillTasksFromMapFile()
         return 0;  // fresh install probably. no error
     }
 
+    if (!ReadCheckpointChain()) {
+        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read the checkpoint chain");
+        return -1;
+    }
+
+    for (uint64_t checkpointId : m_chain) {
+        if (!ReadMapFile(checkpointId, m_segments[checkpointId])) {
+            return -1;
+        }
+    }
+
+    for (const auto& tableSegs : m_segments[m_checkpointId]) {
+        uint32_t tableId = tableSegs.first;
+        m_tableIds.insert(tableId);
+
+        // The table's rows are loaded from the latest checkpoint it was fully written in
+        size_t base = m_chain.size() - 1;
+        while (base > 0 && m_deltaTables[m_chain[base]].count(tableId) != 0) {
+            base--;
+        }
+
+        uint64_t baseId = m_chain[base];
+        auto baseSegs = m_segments[baseId].find(tableId);
+        if (baseSegs == m_segments[baseId].end()) {
+            MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: table %u is missing in checkpoint %lu",
+                tableId,
+                baseId);
+            return -1;
+        }
+
+        for (uint32_t i = 0; i <= baseSegs->second; i++) {
+            Task* recoveryTask = new (std::nothrow) Task(tableId, i, baseId);
+            if (recoveryTask == nullptr) {
+                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to allocate task object");
+                return -1;
+            }
+            m_tasksList.push_back(recoveryTask);
+        }
+
+        if (base + 1 < m_chain.size()) {
+            Task* deltaTask = new (std::nothrow) Task(tableId, 0, m_chain[base + 1], true);
+            if (deltaTask == nullptr) {
+                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to allocate task object");
+                return -1;
+            }
+            m_deltaTasksList.push_back(deltaTask);
+        }
+    }
+
+    MOT_LOG_INFO("CheckpointRecovery::fillTasksFromMapFile: filled %lu tasks, %lu delta tasks",
+        m_tasksList.size(),
+        m_deltaTasksList.size());
+    return 1;
+}
+
+bool CheckpointRecovery::ReadMapFile(uint64_t checkpointId, std::map<uint32_t, uint32_t>& segments)
+{
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(workingDir, checkpointId)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to obtain checkpoint's working dir");
+        return false;
+    }
+
     std::string mapFile;
-    CheckpointUtils::MakeMapFilename(mapFile, m_workingDir, m_checkpointId);
+    CheckpointUtils::MakeMapFilename(mapFile, workingDir, checkpointId);
     int fd = -1;
     if (!CheckpointUtils::OpenFileRead(mapFile, fd)) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to open map file '%s'", mapFile.c_str());
-        return -1;
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to open map file '%s'", mapFile.c_str());
+        return false;
     }
 
     CheckpointUtils::MapFileHeader mapFileHeader;
     if (CheckpointUtils::ReadFile(fd, (char*)&mapFileHeader, sizeof(CheckpointUtils::MapFileHeader)) !=
         sizeof(CheckpointUtils::MapFileHeader)) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read map file '%s' header", mapFile.c_str());
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to read map file '%s' header", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
-        return -1;
+        return false;
     }
 
     if (mapFileHeader.m_magic != CP_MGR_MAGIC) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to verify map file'%s'", mapFile.c_str());
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to verify map file'%s'", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
-        return -1;
+        return false;
     }
 
     CheckpointManager::MapFileEntry entry;
     for (uint64_t i = 0; i < mapFileHeader.m_numEntries; i++) {
         if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointManager::MapFileEntry)) !=
             sizeof(CheckpointManager::MapFileEntry)) {
-            MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read map file '%s' entry: %lu",
-                mapFile.c_str(),
-                i);
+            MOT_LOG_ERROR(
+                "CheckpointRecovery::ReadMapFile: failed to read map file '%s' entry: %lu", mapFile.c_str(), i);
             CheckpointUtils::CloseFile(fd);
-            return -1;
+            return false;
         }
-        m_tableIds.insert(entry.m_tableId);
-        for (uint32_t i = 0; i <= entry.m_maxSegId; i++) {
-            Task* recoveryTask = new (std::nothrow) Task(entry.m_tableId, i);
-            if (recoveryTask == nullptr) {
+        segments[entry.m_tableId] = entry.m_maxSegId;
+    }
+
+    CheckpointUtils::CloseFile(fd);
+    return true;
+}
+
+bool CheckpointRecovery::ReadCheckpointChain()
+{
+    uint64_t checkpointId = m_checkpointId;
+    m_chain.clear();
+    while (true) {
+        m_chain.insert(m_chain.begin(), checkpointId);
+        if (m_chain.size() > MOTConfiguration::MAX_DELTA_CHECKPOINT_CHAIN_LENGTH + 1) {
+            MOT_LOG_ERROR(
+                "CheckpointRecovery::ReadCheckpointChain: chain of checkpoint %lu is too long", m_checkpointId);
+            return false;
+        }
+
+        std::string workingDir;
+        if (!CheckpointUtils::SetWorkingDir(workingDir, checkpointId)) {
+            MOT_LOG_ERROR("CheckpointRecovery::ReadCheckpointChain: failed to obtain checkpoint's working dir");
+            return false;
+        }
+
+        std::string fileName;
+        CheckpointUtils::MakeDeltaFilename(fileName, workingDir, checkpointId);
+        if (!CheckpointUtils::IsFileExists(fileName)) {
+            break;  // a full checkpoint, the chain is complete
+        }
+
+        int fd = -1;
+        if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+            MOT_LOG_ERROR("CheckpointRecovery::ReadCheckpointChain: failed to open delta file '%s'", fileName.c_str());
+            return false;
+        }
+
+        CheckpointUtils::DeltaFileHeader deltaFileHeader;
+        if (CheckpointUtils::ReadFile(fd, (char*)&deltaFileHeader, sizeof(CheckpointUtils::DeltaFileHeader)) !=
+                sizeof(CheckpointUtils::DeltaFileHeader) ||
+            deltaFileHeader.m_magic != CP_MGR_MAGIC) {
+            MOT_LOG_ERROR(
+                "CheckpointRecovery::ReadCheckpointChain: failed to verify delta file '%s'", fileName.c_str());
+            CheckpointUtils::CloseFile(fd);
+            return false;
+        }
+
+        std::set<uint32_t>& deltaTables = m_deltaTables[checkpointId];
+        for (uint64_t i = 0; i < deltaFileHeader.m_numEntries; i++) {
+            uint32_t tableId = 0;
+            if (CheckpointUtils::ReadFile(fd, (char*)&tableId, sizeof(uint32_t)) != sizeof(uint32_t)) {
+                MOT_LOG_ERROR("CheckpointRecovery::ReadCheckpointChain: failed to read delta file '%s' entry: %lu",
+                    fileName.c_str(),
+                    i);
                 CheckpointUtils::CloseFile(fd);
-                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to allocate task object");
-                return -1;
+                return false;
             }
-            m_tasksList.push_back(recoveryTask);
+            deltaTables.insert(tableId);
+        }
+        CheckpointUtils::CloseFile(fd);
+
+        if (!IsCheckpointValid(deltaFileHeader.m_prevId)) {
+            MOT_LOG_ERROR("CheckpointRecovery::ReadCheckpointChain: checkpoint %lu depends on a missing checkpoint %lu",
+                checkpointId,
+                deltaFileHeader.m_prevId);
+            return false;
         }
+        checkpointId = deltaFileHeader.m_prevId;
     }
 
-    CheckpointUtils::CloseFile(fd);
-    MOT_LOG_INFO("CheckpointRecovery::fillTasksFromMapFile: filled %lu tasks", m_tasksList.size());
-    return 1;
+    MOT_LOG_INFO("CheckpointRecovery: checkpoint %lu depends on %lu checkpoints", m_checkpointId, m_chain.size() - 1);
+    return true;
 }
 
 bool CheckpointRecovery::RecoverTableMetadata(uint32_t tableId)
@@ -380,7 +531,11 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
         CheckpointRecovery::Task* task = checkpointRecovery->GetTask();
         if (task != nullptr) {
             bool hadError = false;
-            if (!checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status)) {
+            bool recovered =
+                task->m_isDelta
+                    ? checkpointRecovery->RecoverTableDeltas(task, keyData, entryData, maxCsn, sState, status)
+                    : checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status);
+            if (!recovered) {
                 MOT_LOG_ERROR("CheckpointRecovery::WorkerFunc recovery of table %lu's data failed", task->m_tableId);
                 checkpointRecovery->OnError(status,
                     "CheckpointRecovery::WorkerFunc failed to recover table: ",
@@ -432,8 +587,14 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(workingDir, task->m_checkpointId)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to obtain checkpoint's working dir");
+        return false;
+    }
+
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    CheckpointUtils::MakeCpFilename(tableId, fileName, workingDir, seg);
     if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to open file: %s", fileName.c_str());
         return false;
@@ -447,7 +608,8 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
-    if (fileHeader.m_magic != CP_MGR_MAGIC || fileHeader.m_tableId != tableId) {
+    if ((fileHeader.m_magic != CP_MGR_MAGIC && fileHeader.m_magic != CP_MGR_LZ4_MAGIC) ||
+        fileHeader.m_tableId != tableId) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: file: %s is corrupted", fileName.c_str());
         CheckpointUtils::CloseFile(fd);
         return false;
@@ -465,15 +627,13 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
+    SegmentReader segReader(fd, fileHeader.m_magic == CP_MGR_LZ4_MAGIC);
     CheckpointUtils::EntryHeader entry;
     for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
-        reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
-        if (reader != sizeof(CheckpointUtils::EntryHeader)) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu), reader %lu",
+        if (!segReader.Read((char*)&entry, sizeof(CheckpointUtils::EntryHeader))) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry header (elem: %lu / %lu)",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                fileHeader.m_numOps);
             status = RC_ERROR;
             break;
         }
@@ -489,38 +649,45 @@ bool CheckpointRecovery::RecoverTableRows(
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, keyData, entry.m_keyLen);
-        if (reader != entry.m_keyLen) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu), reader %lu",
+        if (!segReader.Read(keyData, entry.m_keyLen)) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry key (elem: %lu / %lu)",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                fileHeader.m_numOps);
             status = RC_ERROR;
             break;
         }
 
-        reader = CheckpointUtils::ReadFile(fd, entryData, entry.m_dataLen);
-        if (reader != entry.m_dataLen) {
-            MOT_LOG_ERROR(
-                "CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu), reader %lu",
+        if (!segReader.Read(entryData, entry.m_dataLen)) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to read entry data (elem: %lu / %lu)",
                 i,
-                fileHeader.m_numOps,
-                reader);
+                fileHeader.m_numOps);
             status = RC_ERROR;
             break;
         }
 
-        InsertRow(table,
-            keyData,
-            entry.m_keyLen,
-            entryData,
-            entry.m_dataLen,
-            entry.m_csn,
-            MOTCurrThreadId,
-            sState,
-            status,
-            entry.m_rowId);
+        if (task->m_isDelta) {
+            ApplyDeltaRow(table,
+                keyData,
+                entry.m_keyLen,
+                entryData,
+                entry.m_dataLen,
+                entry.m_csn,
+                MOTCurrThreadId,
+                sState,
+                status,
+                entry.m_rowId);
+        } else {
+            InsertRow(table,
+                keyData,
+                entry.m_keyLen,
+                entryData,
+                entry.m_dataLen,
+                entry.m_csn,
+                MOTCurrThreadId,
+                sState,
+                status,
+                entry.m_rowId);
+        }
 
         if (status != RC_OK) {
             MOT_LOG_ERROR(
@@ -532,6 +699,9 @@ bool CheckpointRecovery::RecoverTableRows(
             maxCsn = entry.m_csn;
     }
     CheckpointUtils::CloseFile(fd);
+    m_rawBytes += segReader.GetRawBytes();
+    m_compressedBytes += segReader.GetCompressedBytes();
+    m_decompressUs += segReader.GetDecompressUs();
 
     MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u, %lu rows recovered (%s)",
         MOTCurrThreadId,
@@ -542,6 +712,128 @@ bool CheckpointRecovery::RecoverTableRows(
     return (status == RC_OK);
 }
 
+bool CheckpointRecovery::RecoverTableDeltas(
+    Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status)
+{
+    auto pos = std::find(m_chain.begin(), m_chain.end(), task->m_checkpointId);
+    if (pos == m_chain.end()) {
+        MOT_LOG_ERROR(
+            "CheckpointRecovery::RecoverTableDeltas: checkpoint %lu is not in the chain", task->m_checkpointId);
+        return false;
+    }
+
+    for (; pos != m_chain.end(); ++pos) {
+        // the maps are only read by the workers
+        auto segments = m_segments.find(*pos);
+        if (segments == m_segments.end()) {
+            return false;
+        }
+        auto maxSeg = segments->second.find(task->m_tableId);
+        if (maxSeg == segments->second.end()) {
+            MOT_LOG_ERROR("CheckpointRecovery::RecoverTableDeltas: table %u is missing in checkpoint %lu",
+                task->m_tableId,
+                *pos);
+            return false;
+        }
+        for (uint32_t i = 0; i <= maxSeg->second; i++) {
+            Task segTask(task->m_tableId, i, *pos, true);
+            if (!RecoverTableRows(&segTask, keyData, entryData, maxCsn, sState, status)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool CheckpointRecovery::SegmentReader::Read(char* data, size_t len)
+{
+    if (!m_compressed) {
+        return (CheckpointUtils::ReadFile(m_fd, data, len) == len);
+    }
+
+    while (len > 0) {
+        if (m_dataPos == m_dataSize && !ReadBlock()) {
+            return false;
+        }
+        size_t chunk = std::min(len, (size_t)(m_dataSize - m_dataPos));
+        errno_t erc = memcpy_s(data, len, m_data + m_dataPos, chunk);
+        securec_check(erc, "\0", "\0");
+        data += chunk;
+        len -= chunk;
+        m_dataPos += chunk;
+    }
+    return true;
+}
+
+bool CheckpointRecovery::SegmentReader::ReadBlock()
+{
+    CompressedBlockHeader header;
+    if (CheckpointUtils::ReadFile(m_fd, (char*)&header, sizeof(CompressedBlockHeader)) !=
+        sizeof(CompressedBlockHeader)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadBlock: failed to read block header");
+        return false;
+    }
+
+    // blocks are written from the checkpoint worker buffer, so a larger block is corrupted
+    if (header.m_rawSize == 0 || header.m_rawSize > DEFAULT_BUFFER_SIZE ||
+        header.m_compressedSize > header.m_rawSize) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadBlock: invalid block header (raw %u, compressed %u)",
+            header.m_rawSize,
+            header.m_compressedSize);
+        return false;
+    }
+
+    if (header.m_rawSize > m_dataCapacity) {
+        free(m_data);
+        m_data = (char*)malloc(header.m_rawSize);
+        m_dataCapacity = (m_data != nullptr) ? header.m_rawSize : 0;
+        if (m_data == nullptr) {
+            MOT_LOG_ERROR("CheckpointRecovery::ReadBlock: failed to allocate %u bytes", header.m_rawSize);
+            return false;
+        }
+    }
+
+    if (header.m_compressedSize == header.m_rawSize) {
+        // stored as is, read directly
+        if (CheckpointUtils::ReadFile(m_fd, m_data, header.m_rawSize) != header.m_rawSize) {
+            MOT_LOG_ERROR("CheckpointRecovery::ReadBlock: failed to read block data");
+            return false;
+        }
+    } else {
+        if (header.m_compressedSize > m_blockCapacity) {
+            free(m_block);
+            m_block = (char*)malloc(header.m_compressedSize);
+            m_blockCapacity = (m_block != nullptr) ? header.m_compressedSize : 0;
+            if (m_block == nullptr) {
+                MOT_LOG_ERROR("CheckpointRecovery::ReadBlock: failed to allocate %u bytes", header.m_compressedSize);
+                return false;
+            }
+        }
+
+        if (CheckpointUtils::ReadFile(m_fd, m_block, header.m_compressedSize) != header.m_compressedSize) {
+            MOT_LOG_ERROR("CheckpointRecovery::ReadBlock: failed to read block data");
+            return false;
+        }
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (!Compression::DecompressBlock(header, m_block, m_data, m_dataCapacity)) {
+            MOT_LOG_ERROR("CheckpointRecovery::ReadBlock: failed to decompress block (raw %u, compressed %u)",
+                header.m_rawSize,
+                header.m_compressedSize);
+            return false;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        m_decompressUs += (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+    }
+
+    m_rawBytes += header.m_rawSize;
+    m_compressedBytes += sizeof(CompressedBlockHeader) + header.m_compressedSize;
+    m_dataSize = header.m_rawSize;
+    m_dataPos = 0;
+    return true;
+}
+
 CheckpointRecovery::Task* CheckpointRecovery::GetTask()
 {
     Task* task = nullptr;
@@ -608,6 +900,34 @@ void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen,
     }
 }
 
+void CheckpointRecovery::ApplyDeltaRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen,
+    uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId)
+{
+    MaxKey key;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    Sentinel* sentinel = table->GetPrimaryIndex()->IndexReadSentinel(&key, tid);
+    Row* row = (sentinel != nullptr) ? sentinel->GetData() : nullptr;
+    if (row != nullptr) {
+        if (row->GetCommitSequenceNumber() >= csn) {
+            // a newer version was already applied
+            status = RC_OK;
+            return;
+        }
+        if (table->RemoveRow(row, tid) == nullptr) {
+            status = RC_ERROR;
+            MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "Recovery Manager Apply Delta", "failed to remove row");
+            return;
+        }
+    }
+
+    if (rowLen == 0) {
+        // deleted key
+        status = RC_OK;
+        return;
+    }
+    InsertRow(table, keyData, keyLen, rowData, rowLen, csn, tid, sState, status, rowId);
+}
+
 bool CheckpointRecovery::RecoverInProcessTxns()
 {
     int fd = -1;
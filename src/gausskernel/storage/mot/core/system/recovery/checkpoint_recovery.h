@@ -26,8 +26,11 @@
 #define CHECKPOINT_RECOVERY_H
 
 #include <set>
+#include <map>
 #include <list>
+#include <vector>
 #include <mutex>
+#include <atomic>
 #include "global.h"
 #include "spin_lock.h"
 #include "table.h"
@@ -43,7 +46,10 @@ public:
           m_numWorkers(GetGlobalConfiguration().m_checkpointRecoveryWorkers),
           m_stopWorkers(false),
           m_errorSet(false),
-          m_errorCode(RC_OK)
+          m_errorCode(RC_OK),
+          m_rawBytes(0),
+          m_compressedBytes(0),
+          m_decompressUs(0)
     {}
 
     ~CheckpointRecovery()
@@ -68,15 +74,19 @@ public:
 
     /**
      * @struct Task
-     * @brief Describes a checkpoint recovery task by its table id and
-     * segment file number.
+     * @brief Describes a checkpoint recovery task by its table id,
+     * segment file number and the checkpoint it belongs to. A delta task
+     * applies all the deltas of a table, starting at the given checkpoint.
      */
     struct Task {
-        explicit Task(uint32_t tableId = 0, uint32_t segId = 0) : m_tableId(tableId), m_segId(segId)
+        explicit Task(uint32_t tableId = 0, uint32_t segId = 0, uint64_t checkpointId = 0, bool isDelta = false)
+            : m_tableId(tableId), m_segId(segId), m_checkpointId(checkpointId), m_isDelta(isDelta)
         {}
 
         uint32_t m_tableId;
         uint32_t m_segId;
+        uint64_t m_checkpointId;
+        bool m_isDelta;
     };
 
     /**
@@ -99,6 +109,20 @@ public:
     bool RecoverTableRows(
         Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status);
 
+    /**
+     * @brief Applies the delta checkpoints of a table on top of its full image, oldest first.
+     * @param task The delta task (table id / first delta checkpoint id) to recover from.
+     * @param keyData A key buffer.
+     * @param entryData A row buffer..
+     * @param maxCsn The returned maxCsn encountered during the recovery.
+     * @param sState Surrogate key state structure that will be filled.
+     * during the recovery.
+     * @param status RC returned from the Insert function.
+     * @return Boolean value denoting success or failure.
+     */
+    bool RecoverTableDeltas(
+        Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status);
+
     uint64_t GetLsn() const
     {
         return m_lsn;
@@ -111,6 +135,94 @@ public:
     static void CheckpointRecoveryWorker(CheckpointRecovery* checkpointRecovery);
 
 private:
+    /**
+     * @class SegmentReader
+     * @brief Reads the entries of a checkpoint data file. Files written with checkpoint compression
+     * are read block by block, each block is decompressed before its entries are returned.
+     */
+    class SegmentReader {
+    public:
+        SegmentReader(int fd, bool compressed)
+            : m_fd(fd),
+              m_compressed(compressed),
+              m_block(nullptr),
+              m_blockCapacity(0),
+              m_data(nullptr),
+              m_dataCapacity(0),
+              m_dataSize(0),
+              m_dataPos(0),
+              m_rawBytes(0),
+              m_compressedBytes(0),
+              m_decompressUs(0)
+        {}
+
+        ~SegmentReader()
+        {
+            if (m_block != nullptr) {
+                free(m_block);
+                m_block = nullptr;
+            }
+            if (m_data != nullptr) {
+                free(m_data);
+                m_data = nullptr;
+            }
+        }
+
+        /**
+         * @brief Reads the next bytes of the file's entries.
+         * @param data The buffer to read to.
+         * @param len The number of bytes to read.
+         * @return Boolean value denoting success or failure.
+         */
+        bool Read(char* data, size_t len);
+
+        uint64_t GetRawBytes() const
+        {
+            return m_rawBytes;
+        }
+
+        uint64_t GetCompressedBytes() const
+        {
+            return m_compressedBytes;
+        }
+
+        uint64_t GetDecompressUs() const
+        {
+            return m_decompressUs;
+        }
+
+    private:
+        /**
+         * @brief Reads and decompresses the next block of the file.
+         * @return Boolean value denoting success or failure.
+         */
+        bool ReadBlock();
+
+        int m_fd;
+
+        bool m_compressed;
+
+        // The compressed block read from the file
+        char* m_block;
+
+        uint32_t m_blockCapacity;
+
+        // The decompressed block
+        char* m_data;
+
+        uint32_t m_dataCapacity;
+
+        uint32_t m_dataSize;
+
+        uint32_t m_dataPos;
+
+        uint64_t m_rawBytes;
+
+        uint64_t m_compressedBytes;
+
+        uint64_t m_decompressUs;
+    };
+
     /**
      * @brief Reads and creates a table's definition from a checkpoint
      * metadata file
@@ -127,6 +239,26 @@ private:
      */
     int FillTasksFromMapFile();
 
+    /**
+     * @brief Reads a checkpoint map file.
+     * @param checkpointId The checkpoint id.
+     * @param segments The returned maximum segment id per table.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadMapFile(uint64_t checkpointId, std::map<uint32_t, uint32_t>& segments);
+
+    /**
+     * @brief Walks the delta files back from the current checkpoint to the full
+     * checkpoint it depends on, and fills the checkpoint chain.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadCheckpointChain();
+
+    /**
+     * @brief Runs the recovery workers until the tasks queue is drained.
+     */
+    void RunWorkers();
+
     /**
      * @brief Checks if there are any more tasks left in the queue
      * @return Int value where 0 means failure and 1 success
@@ -165,6 +297,22 @@ private:
     void InsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen, uint64_t csn,
         uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId);
 
+    /**
+     * @brief Applies a delta entry: inserts, replaces or deletes a row, unless a newer version of it exists.
+     * @param table the table's object pointer.
+     * @param keyData key's data buffer.
+     * @param keyLen key's data buffer len.
+     * @param rowData row's data buffer.
+     * @param rowLen row's data buffer len, zero for a deleted key.
+     * @param csn the operation's csn.
+     * @param tid the thread id of the recovering thread.
+     * @param sState the returned surrogate state.
+     * @param status the returned status of the operation
+     * @param rowId the row's internal id
+     */
+    void ApplyDeltaRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen, uint64_t csn,
+        uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId);
+
     /**
      * @brief performs table creation.
      * @param data the table's data
@@ -213,6 +361,25 @@ private:
     std::set<uint32_t> m_tableIds;
 
     std::list<Task*> m_tasksList;
+
+    // Delta tasks, executed after all the full images were recovered
+    std::list<Task*> m_deltaTasksList;
+
+    // The checkpoint ids the recovered checkpoint depends on, starting with a full checkpoint
+    std::vector<uint64_t> m_chain;
+
+    // The maximum segment id per table, per checkpoint of the chain
+    std::map<uint64_t, std::map<uint32_t, uint32_t>> m_segments;
+
+    // The tables written as a delta, per delta checkpoint of the chain
+    std::map<uint64_t, std::set<uint32_t>> m_deltaTables;
+
+    // Decompression totals of compressed data files, over all the workers
+    std::atomic<uint64_t> m_rawBytes;
+
+    std::atomic<uint64_t> m_compressedBytes;
+
+    std::atomic<uint64_t> m_decompressUs;
 };
 }  // namespace MOT
 
@@ -157,6 +157,19 @@ bool TxnManager::IsUpdatedInCurrStmt()
     return false;
 }
 
+bool TxnManager::HasPendingChanges()
+{
+    if (m_txnDdlAccess->Size() > 0) {
+        return true;
+    }
+    for (const auto& raPair : m_accessMgr->GetOrderedRowSet()) {
+        if (raPair.second->m_type != RD) {
+            return true;
+        }
+    }
+    return false;
+}
+
 RC TxnManager::StartTransaction(uint64_t transactionId, int isolationLevel)
 {
     m_transactionId = transactionId;
@@ -565,6 +578,9 @@ void TxnManager::CleanDDLChanges()
                 }
                 table->FreeObjectPool(indexArr->GetRowPool());
                 delete indexArr;
+                if (GetGlobalConfiguration().m_enableCheckpoint) {
+                    GetCheckpointManager()->OnTableTruncated(table->GetTableId());
+                }
                 break;
             case DDL_ACCESS_CREATE_INDEX:
                 index = (Index*)ddl_access->GetEntry();
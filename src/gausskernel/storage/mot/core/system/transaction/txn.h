@@ -482,6 +482,12 @@ public:
 
     bool IsUpdatedInCurrStmt();
 
+    /**
+     * @brief Queries whether the transaction has uncommitted row or DDL changes.
+     * @return True if the transaction changed anything so far.
+     */
+    bool HasPendingChanges();
+
 private:
     static constexpr uint32_t SESSION_ID_BITS = 32;
 
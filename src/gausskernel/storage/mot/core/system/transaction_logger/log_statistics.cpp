@@ -39,10 +39,16 @@ LogThreadStatistics::LogThreadStatistics(uint64_t threadId, void* inplaceBuffer)
     : ThreadStatistics(threadId, inplaceBuffer),
       m_txnBuffersDrained(MakeName("txn-buffers-drained", threadId).c_str()),
       m_txnBytesDrained(MakeName("txn-bytes-drained", threadId).c_str()),
-      m_bytesWritten(MakeName("log-bytes-written", threadId).c_str())
+      m_bytesWritten(MakeName("log-bytes-written", threadId).c_str()),
+      m_compressBytesIn(MakeName("compress-bytes-in", threadId).c_str()),
+      m_compressBytesOut(MakeName("compress-bytes-out", threadId).c_str()),
+      m_compressRatio(MakeName("compress-ratio", threadId).c_str(), 1, "%")
 {
     RegisterStatistics(&m_txnBuffersDrained);
     RegisterStatistics(&m_txnBytesDrained);
+    RegisterStatistics(&m_compressBytesIn);
+    RegisterStatistics(&m_compressBytesOut);
+    RegisterStatistics(&m_compressRatio);
 }
 
 LogGlobalStatistics::LogGlobalStatistics(GlobalStatistics::NamingScheme namingScheme)
@@ -56,10 +56,22 @@ public:
         m_bytesWritten.AddSample(bytes);
     }
 
+    inline void AddCompression(uint64_t rawBytes, uint64_t compressedBytes)
+    {
+        m_compressBytesIn.AddSample(rawBytes);
+        m_compressBytesOut.AddSample(compressedBytes);
+        if (rawBytes > 0) {
+            m_compressRatio.AddSample(compressedBytes * 100 / rawBytes);
+        }
+    }
+
 private:
     FrequencyStatisticVariable m_txnBuffersDrained;
     DataRateStatisticVariable m_txnBytesDrained;
     DataRateStatisticVariable m_bytesWritten;
+    DataRateStatisticVariable m_compressBytesIn;
+    DataRateStatisticVariable m_compressBytesOut;
+    NumericStatisticVariable m_compressRatio;
 };
 
 class LogGlobalStatistics : public GlobalStatistics {
@@ -121,6 +133,19 @@ public:
         }
     }
 
+    /**
+     * @brief Records a compressed redo record or checkpoint block.
+     * @param rawBytes The size of the data before compression.
+     * @param compressedBytes The size of the data after compression.
+     */
+    inline void AddCompression(uint64_t rawBytes, uint64_t compressedBytes)
+    {
+        LogThreadStatistics* lts = GetCurrentThreadStatistics<LogThreadStatistics>();
+        if (lts != nullptr) {
+            lts->AddCompression(rawBytes, compressedBytes);
+        }
+    }
+
     inline void AddLogFlush()
     {
         LogGlobalStatistics* lts = GetGlobalStatistics<LogGlobalStatistics>();
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * compression.cpp
+ *    LZ4 block compression helpers for checkpoint and redo data.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/utils/compression.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "global.h"
+#include "compression.h"
+#include "debug_utils.h"
+#include "lz4.h"
+
+namespace MOT {
+namespace Compression {
+extern uint32_t CompressBound(uint32_t rawSize)
+{
+    return sizeof(CompressedBlockHeader) + (uint32_t)LZ4_compressBound((int)rawSize);
+}
+
+extern uint32_t CompressBlock(const char* src, uint32_t srcSize, char* dst, uint32_t dstCapacity)
+{
+    if (dstCapacity < CompressBound(srcSize)) {
+        return 0;
+    }
+
+    CompressedBlockHeader* header = reinterpret_cast<CompressedBlockHeader*>(dst);
+    char* data = dst + sizeof(CompressedBlockHeader);
+    uint32_t dataCapacity = dstCapacity - sizeof(CompressedBlockHeader);
+    int compressedSize = LZ4_compress_default(src, data, (int)srcSize, (int)dataCapacity);
+    header->m_rawSize = srcSize;
+    if (compressedSize > 0 && (uint32_t)compressedSize < srcSize) {
+        header->m_compressedSize = (uint32_t)compressedSize;
+    } else {
+        // incompressible data is stored as is
+        errno_t erc = memcpy_s(data, dataCapacity, src, srcSize);
+        securec_check(erc, "\0", "\0");
+        header->m_compressedSize = srcSize;
+    }
+    return sizeof(CompressedBlockHeader) + header->m_compressedSize;
+}
+
+extern bool DecompressBlock(const CompressedBlockHeader& header, const char* src, char* dst, uint32_t dstCapacity)
+{
+    if (header.m_rawSize > dstCapacity || header.m_compressedSize > header.m_rawSize) {
+        return false;
+    }
+
+    if (header.m_compressedSize == header.m_rawSize) {
+        errno_t erc = memcpy_s(dst, dstCapacity, src, header.m_rawSize);
+        securec_check(erc, "\0", "\0");
+        return true;
+    }
+
+    int rawSize = LZ4_decompress_safe(src, dst, (int)header.m_compressedSize, (int)dstCapacity);
+    return (rawSize >= 0 && (uint32_t)rawSize == header.m_rawSize);
+}
+}  // namespace Compression
+}  // namespace MOT
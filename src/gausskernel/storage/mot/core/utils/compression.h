@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * compression.h
+ *    LZ4 block compression helpers for checkpoint and redo data.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/utils/compression.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef MOT_COMPRESSION_H
+#define MOT_COMPRESSION_H
+
+#include <stdint.h>
+
+namespace MOT {
+/**
+ * @struct CompressedBlockHeader
+ * @brief Header of a compressed block. If the data did not compress, it is stored as is, and the compressed
+ * size equals the raw size.
+ */
+struct CompressedBlockHeader {
+    /** @var The size of the data before compression. */
+    uint32_t m_rawSize;
+
+    /** @var The size of the data following the header. */
+    uint32_t m_compressedSize;
+};
+
+namespace Compression {
+/**
+ * @brief Retrieves the maximum size of a compressed block (including its header).
+ * @param rawSize The size of the data to compress.
+ * @return The maximum block size.
+ */
+extern uint32_t CompressBound(uint32_t rawSize);
+
+/**
+ * @brief Compresses data into a block.
+ * @param src The data to compress.
+ * @param srcSize The size of the data to compress.
+ * @param dst The block buffer, at least CompressBound(srcSize) bytes.
+ * @param dstCapacity The size of the block buffer.
+ * @return The size of the block (including its header), or zero on failure.
+ */
+extern uint32_t CompressBlock(const char* src, uint32_t srcSize, char* dst, uint32_t dstCapacity);
+
+/**
+ * @brief Decompresses the data of a block.
+ * @param header The block header.
+ * @param src The block data following the header.
+ * @param dst The buffer to decompress into, at least header.m_rawSize bytes.
+ * @param dstCapacity The size of the buffer.
+ * @return True if the block was decompressed successfully.
+ */
+extern bool DecompressBlock(const CompressedBlockHeader& header, const char* src, char* dst, uint32_t dstCapacity);
+}  // namespace Compression
+}  // namespace MOT
+
+#endif /* MOT_COMPRESSION_H */
@@ -73,10 +73,12 @@
 
 #include "mot_internal.h"
 #include "storage/mot/jit_exec.h"
+#include "storage/mot/mot_fdw.h"
 #include "mot_engine.h"
 #include "table.h"
 #include "txn.h"
 #include "checkpoint_manager.h"
+#include "checkpoint_utils.h"
 #include <queue>
 #include "recovery_manager.h"
 #include "redo_log_handler_type.h"
@@ -131,6 +133,7 @@ static ForeignScan* MOTGetForeignPlan(PlannerInfo* root, RelOptInfo* baserel, Oi
 static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es);
 static void MOTBeginForeignScan(ForeignScanState* node, int eflags);
 static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node);
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node);
 static void MOTReScanForeignScan(ForeignScanState* node);
 static void MOTEndForeignScan(ForeignScanState* node);
 static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRte, Relation targetRelation);
@@ -296,10 +299,11 @@ Datum mot_fdw_handler(PG_FUNCTION_ARGS)
     fdwroutine->ExplainForeignScan = MOTExplainForeignScan;
     fdwroutine->BeginForeignScan = MOTBeginForeignScan;
     fdwroutine->IterateForeignScan = MOTIterateForeignScan;
+    fdwroutine->VecIterateForeignScan = MOTVecIterateForeignScan;
     fdwroutine->ReScanForeignScan = MOTReScanForeignScan;
     fdwroutine->EndForeignScan = MOTEndForeignScan;
-    fdwroutine->AnalyzeForeignTable = NULL;
-    fdwroutine->AcquireSampleRows = NULL;
+    fdwroutine->AnalyzeForeignTable = MOTAnalyzeForeignTable;
+    fdwroutine->AcquireSampleRows = MOTAcquireSampleRowsFunc;
     fdwroutine->ValidateTableDef = MOTValidateTableDef;
     fdwroutine->PartitionTblProcess = NULL;
     fdwroutine->BuildRuntimePredicate = NULL;
@@ -472,12 +476,16 @@ static void MOTGetForeignRelSize(PlannerInfo* root, RelOptInfo* baserel, Oid for
         }
     }
 
-    baserel->rows = planstate->m_table->GetRowCount();
     baserel->tuples = planstate->m_table->GetRowCount();
-    if (baserel->rows == 0)
-        baserel->rows = baserel->tuples = 100000;
+    if (baserel->tuples == 0) {
+        // fall back to the row count of the last ANALYZE before guessing
+        baserel->tuples = (rel->rd_rel->reltuples > 0) ? rel->rd_rel->reltuples : 100000;
+    }
+    // column statistics gathered by ANALYZE make the restriction selectivity meaningful
+    baserel->rows = clamp_row_est(
+        baserel->tuples * clauselist_selectivity(root, baserel->baserestrictinfo, 0, JOIN_INNER, nullptr));
     planstate->m_startupCost = 0.1;
-    planstate->m_totalCost = baserel->rows * planstate->m_startupCost;
+    planstate->m_totalCost = baserel->tuples * planstate->m_startupCost;
 
     RelationClose(rel);
 }
@@ -530,6 +538,42 @@ static bool IsOrderingApplicable(PathKey* pathKey, RelOptInfo* rel, MOT::Index*
     return res;
 }
 
+/*
+ * Checks whether the current transaction can run scans split among SMP workers. The workers read in their own
+ * MOT transactions, so they neither see the uncommitted changes of the current transaction nor share its
+ * repeatable read snapshot.
+ */
+bool MOTIsParallelScanAllowed()
+{
+    if (u_sess->utils_cxt.XactIsoLevel != XACT_READ_COMMITTED) {
+        return false;
+    }
+    return !GetSafeTxn(__FUNCTION__)->HasPendingChanges();
+}
+
+/*
+ * Returns the number of SMP workers that should scan the relation, 1 if it cannot be scanned in parallel.
+ * Only plain full scans of large tables with a tree primary index are split.
+ */
+static int MOTGetParallelScanDop(RelOptInfo* baserel, MOTFdwStateSt* planstate)
+{
+    int dop = u_sess->opt_cxt.query_dop;
+    if (dop <= 1 || planstate->m_bestIx != nullptr || planstate->m_cmdOper != CMD_SELECT ||
+        planstate->m_hasForUpdate) {
+        return 1;
+    }
+
+    if (baserel->tuples < MOT_PARALLEL_SCAN_MIN_ROWS ||
+        planstate->m_table->GetPrimaryIndex()->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_TREE) {
+        return 1;
+    }
+
+    if (!MOTIsParallelScanAllowed()) {
+        return 1;
+    }
+    return dop;
+}
+
 /*
  *
  */
@@ -544,7 +588,9 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
     MatchIndex* best = nullptr;
     Path* fpReg = nullptr;
     Path* fpIx = nullptr;
+    Path* fpPar = nullptr;
     bool hasRegularPath = false;
+    int dop = 1;
 
     planstate->m_order = SORTDIR_ENUM::SORTDIR_ASC;
     // first create regular path based on relation restrictions
@@ -561,10 +607,7 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
     if (best != nullptr) {
         OrderSt ord;
         ord.init();
-        double ntuples = best->m_cost;
-        ntuples = ntuples * clauselist_selectivity(root, bestClause, 0, JOIN_INNER, nullptr);
-        ntuples = clamp_row_est(ntuples);
-        baserel->rows = baserel->tuples = ntuples;
+        // baserel->rows was estimated from the statistics of all the restrictions, keep it for join planning
         planstate->m_startupCost = 0.001;
         planstate->m_totalCost = best->m_cost;
         planstate->m_bestIx = best;
@@ -624,6 +667,21 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
         nullptr,  // private data will be assigned later
         0);
 
+    dop = MOTGetParallelScanDop(baserel, planstate);
+    if (dop > 1) {
+        // each worker scans its own key range
+        Cost runCost = planstate->m_totalCost - planstate->m_startupCost;
+        Cost parallelCost = planstate->m_startupCost + runCost / dop + u_sess->opt_cxt.smp_thread_cost * (dop - 1);
+        fpPar = (Path*)create_foreignscan_path(root,
+            baserel,
+            planstate->m_startupCost,
+            parallelCost,
+            NIL,      /* the order of the rows is lost */
+            nullptr,  /* no outer rel either */
+            nullptr,  // private data will be assigned later
+            dop);
+    }
+
     foreach (lc, baserel->pathlist) {
         Path* path = (Path*)lfirst(lc);
         if (IsA(path, IndexPath) && path->param_info == nullptr) {
@@ -661,10 +719,6 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
         if (best != nullptr) {
             OrderSt ord;
             ord.init();
-            double ntuples = best->m_cost;
-            ntuples = ntuples * clauselist_selectivity(root, bestClause, 0, JOIN_INNER, nullptr);
-            ntuples = clamp_row_est(ntuples);
-            baserel->rows = baserel->tuples = ntuples;
             planstate->m_paramBestIx = best;
             planstate->m_startupCost = 0.001;
             planstate->m_totalCost = best->m_cost;
@@ -694,6 +748,7 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
                 0);
 
             fpIx->param_info = bestPath->param_info;
+            fpIx->rows = bestPath->param_info->ppi_rows;
         }
     }
 
@@ -714,9 +769,39 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
         add_path(root, baserel, fpReg);
     if (fpIx != nullptr)
         add_path(root, baserel, fpIx);
+    if (fpPar != nullptr)
+        add_path(root, baserel, fpPar);
     set_cheapest(baserel);
 }
 
+/*
+ * A full or range scan feeding a vectorized plan produces its rows directly as column batches.
+ * Point lookups, parameterized scans and scans returning the row id keep producing tuples.
+ */
+static bool MOTIsVectorScan(RelOptInfo* baserel, ForeignPath* bestPath, MOTFdwStateSt* planstate, List* tlist)
+{
+    ListCell* lc = nullptr;
+
+    if (!u_sess->attr.attr_sql.enable_vector_engine || planstate->m_cmdOper != CMD_SELECT ||
+        planstate->m_hasForUpdate || bestPath->path.param_info != nullptr || baserel->rows < MOT_VECTOR_SCAN_MIN_ROWS) {
+        return false;
+    }
+
+    if (planstate->m_bestIx != nullptr && planstate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
+        planstate->m_bestIx->m_ix->GetUnique()) {
+        return false;
+    }
+
+    foreach (lc, tlist) {
+        TargetEntry* tle = (TargetEntry*)lfirst(lc);
+        if (IsA(tle->expr, Var) && ((Var*)tle->expr)->varattno < 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /*
  *
  */
@@ -783,8 +868,13 @@ static ForeignScan* MOTGetForeignPlan(
     if (tmpLocal != nullptr)
         list_free(tmpLocal);
 
+    if (best_path->path.dop > 1 && planstate->m_bestIx == nullptr) {
+        planstate->m_parallelBounds = MOTAdaptor::GetParallelScanBounds(planstate->m_table, best_path->path.dop);
+    }
+
+    bool vecOutput = MOTIsVectorScan(baserel, best_path, planstate, tlist);
     List* quals = planstate->m_localConds;
-    return make_foreignscan(tlist,
+    ForeignScan* fscan = make_foreignscan(tlist,
         quals,
         scanRelid,
         remote, /* no expressions to evaluate */
@@ -796,6 +886,8 @@ static ForeignScan* MOTGetForeignPlan(
         nullptr
 #endif
     );
+    ((Plan*)fscan)->vec_output = vecOutput;
+    return fscan;
 }
 
 /*
@@ -878,6 +970,21 @@ static void MOTBeginForeignScan(ForeignScanState* node, int eflags)
         node->ss.ps.state->es_result_relation_info->ri_FdwState = festate;
     festate->m_currTxn->SetTxnIsoLevel(u_sess->utils_cxt.XactIsoLevel);
 
+    // a parallel scan is executed by all the SMP workers of the plan, each reading its own key range
+    festate->m_parallelDop = SET_DOP(node->ss.ps.plan->dop);
+    festate->m_parallelId = (festate->m_parallelDop > 1) ? (uint32_t)u_sess->stream_cxt.smp_id : 0;
+
+    // the leader only sets up the scan run by the workers. Parallel plans are only built while the transaction can
+    // run them, and cached ones are replaced by a serial custom plan when it no longer can (see ChooseCustomPlan)
+    if (festate->m_parallelDop > 1 && !StreamThreadAmI() && !(eflags & EXEC_FLAG_EXPLAIN_ONLY) &&
+        !MOTIsParallelScanAllowed()) {
+        ereport(ERROR,
+            (errmodule(MOD_MOT),
+                errcode(ERRCODE_INTERNAL_ERROR),
+                errmsg("Parallel scan of MOT table \"%s\" was not replanned for the current transaction",
+                    RelationGetRelationName(node->ss.ss_currentRelation))));
+    }
+
     foreach (t, node->ss.ps.plan->targetlist) {
         TargetEntry* tle = (TargetEntry*)lfirst(t);
         Var* v = (Var*)tle->expr;
@@ -1089,6 +1196,80 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
     }
 }
 
+/*
+ * Vectorized variant of MOTIterateForeignScan: fills the scan batch directly from the MOT rows, column by column,
+ * without forming a tuple for each row. An empty batch marks the end of the scan.
+ */
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node)
+{
+    MOT::RC rc = MOT::RC_OK;
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    VectorBatch* batch = node->m_pScanBatch;
+    int rows = 0;
+
+    batch->Reset(true);
+    if (node->ss.is_scan_end) {
+        return batch;
+    }
+
+    if (!festate->m_cursorOpened) {
+        ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
+        festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
+        festate->m_econtext = node->ss.ps.ps_ExprContext;
+        CleanCursors(festate);
+        MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
+
+        festate->m_cursorOpened = true;
+    }
+
+    // festate->cursor[1] might be NULL (in case it is not in use)
+    if (festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid() ||
+        (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid())) {
+        node->ss.is_scan_end = true;
+        return batch;
+    }
+
+    while (rows < BatchMaxSize && festate->m_cursor[0]->IsValid()) {
+        MOT::Sentinel* sentinel = festate->m_cursor[0]->GetPrimarySentinel();
+        MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, sentinel, rc);
+        if (currRow == nullptr) {
+            if (rc != MOT::RC_OK) {
+                if (MOT_IS_SEVERE()) {
+                    MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTVecIterateForeignScan", "Failed to lookup row");
+                    MOT_LOG_ERROR_STACK("Failed to lookup row");
+                }
+
+                CleanQueryStatesOnError(festate->m_currTxn);
+                report_pg_error(rc,
+                    (void*)(festate->m_currTxn->m_errIx != NULL ? festate->m_currTxn->m_errIx->GetName().c_str()
+                                                                : "unknown"),
+                    (void*)festate->m_currTxn->m_errMsgBuf);
+                return nullptr;
+            }
+            festate->m_cursor[0]->Next();
+            continue;
+        }
+
+        // check end condition for range search
+        if (MOTAdaptor::IsScanEnd(festate)) {
+            festate->m_cursor[0]->Invalidate();
+            break;
+        }
+
+        MOTAdaptor::UnpackRowToBatch(
+            batch, rows, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
+        rows++;
+        festate->m_cursor[0]->Next();
+    }
+
+    batch->m_rows = rows;
+    festate->m_rowsFound += rows;
+    if (rows < BatchMaxSize || !festate->m_cursor[0]->IsValid()) {
+        node->ss.is_scan_end = true;
+    }
+    return batch;
+}
+
 /*
  *
  */
@@ -1148,10 +1329,32 @@ static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRt
     parsetree->targetList = lappend(parsetree->targetList, tle);
 }
 
+/*
+ * Copies the committed version of a row for sampling. The sentinel lock is only tried, so ANALYZE never waits
+ * for a committing (or prepared) transaction, and it is held just for the copy.
+ */
+static bool MOTCopyCommittedRow(MOT::Sentinel* sentinel, uint64_t tid, uint8_t* dest, uint32_t size)
+{
+    bool copied = false;
+
+    if (!sentinel->TryLock(tid)) {
+        return false;
+    }
+
+    MOT::Row* row = sentinel->GetData();
+    if (sentinel->IsCommited() && row != nullptr && !row->IsAbsentRow()) {
+        errno_t erc = memcpy_s(dest, size, row->GetData(), size);
+        securec_check(erc, "\0", "\0");
+        copied = true;
+    }
+    sentinel->Release();
+
+    return copied;
+}
+
 static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* rows, int targrows, double* totalrows,
     double* totaldeadrows, void* additionalData, bool estimateTableRowNum)
 {
-    MOT::RC rc = MOT::RC_OK;
     int numrows = 0; /* # of sample rows collected */
     /* for random sampling */
     double samplerows = 0;                              /* # of rows fetched */
@@ -1164,12 +1367,13 @@ static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* ro
             ERRCODE_UNDEFINED_TABLE, MOT_TABLE_NOTFOUND, (char*)RelationGetRelationName(relation));
         return 0;
     }
-    MOT::IndexIterator* cursor = table->Begin(currTxn->GetThdId());
     TupleDesc desc = RelationGetDescr(relation);
     TupleTableSlot* slot = MakeSingleTupleTableSlot(desc);
-    uint8_t attrsUsed[8];
+    uint8_t* attrsUsed = (uint8_t*)palloc0(BITMAP_GETLEN(desc->natts));
+    uint32_t tupleSize = table->GetTupleSize();
+    uint8_t* rowCopy = (uint8_t*)palloc(tupleSize);
+    uint64_t tid = currTxn->GetThdId();
     int pos = 0;
-    MOT::Row* row = nullptr;
 
     for (int i = 0; i < desc->natts; i++) {
         if (!desc->attrs[i]->attisdropped) {
@@ -1177,14 +1381,20 @@ static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* ro
         }
     }
 
-    while (cursor->IsValid()) {
-        row = NULL;
+    /*
+     * Rows are read from their committed version instead of through the transaction, so sampling neither fills
+     * the read set of ANALYZE nor makes it abort on concurrent updates. The GC session keeps the scanned index
+     * nodes and rows alive.
+     */
+    currTxn->GcSessionStart();
+    MOT::IndexIterator* cursor = table->Begin(currTxn->GetThdId());
 
-        MOT::Sentinel* Sentinel = cursor->GetPrimarySentinel();
-        row = currTxn->RowLookup(MOT::AccessType::RD, Sentinel, rc);
+    while (cursor != nullptr && cursor->IsValid()) {
+        MOT::Sentinel* sentinel = cursor->GetPrimarySentinel();
         cursor->Next();
 
-        if (row == NULL) {
+        /* deleted rows and rows of uncommitted inserts */
+        if (!sentinel->IsCommited()) {
             continue;
         }
 
@@ -1197,7 +1407,7 @@ static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* ro
          */
         if (numrows < targrows) {
             /* First targrows rows are always included into the sample */
-            pos = numrows++;
+            pos = numrows;
         } else {
             /*
              * Now we start replacing tuples in the sample until we reach the end
@@ -1211,7 +1421,6 @@ static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* ro
                 /* Choose a random reservoir element to replace. */
                 pos = (int)(targrows * anl_random_fract());
                 Assert(pos >= 0 && pos < targrows);
-                heap_freetuple(rows[pos]);
             } else {
                 /* Skip this tuple. */
                 pos = -1;
@@ -1220,20 +1429,27 @@ static int MOTAcquireSampleRowsFunc(Relation relation, int elevel, HeapTuple* ro
             rowstoskip -= 1;
         }
 
-        if (pos >= 0) {
+        if (pos >= 0 && MOTCopyCommittedRow(sentinel, tid, rowCopy, tupleSize)) {
             /*
              * Create sample tuple from current result row, and store it in the
              * position determined above.  The tuple has to be created in anl_cxt.
              */
             (void)ExecClearTuple(slot);
-            MOTAdaptor::UnpackRow(slot, table, attrsUsed, const_cast<uint8_t*>(row->GetData()));
+            MOTAdaptor::UnpackRow(slot, table, attrsUsed, rowCopy);
             ExecStoreVirtualTuple(slot);
+            if (pos < numrows) {
+                heap_freetuple(rows[pos]);
+            } else {
+                numrows++;
+            }
             rows[pos] = ExecCopySlotTuple(slot);
         }
     }
 
     /* clean up */
     ExecDropSingleTupleTableSlot(slot);
+    pfree(rowCopy);
+    pfree(attrsUsed);
 
     if (cursor != NULL) {
         cursor->Invalidate();
@@ -1615,7 +1831,9 @@ static void MOTXactCallback(XactEvent event, void* arg)
         MOT_ASSERT(txnState == MOT::TxnState::TXN_COMMIT || txnState == MOT::TxnState::TXN_PREPARE);
         elog(DEBUG2, "XACT_EVENT_RECORD_COMMIT, tid %lu", tid);
 
-        // Need to get the envelope CSN for cross transaction support.
+        // Need to get the envelope CSN for cross transaction support. The commit was already registered in the
+        // checkpoint phase by the validation (or the prepare), so the CSN is above the cutoff of any checkpoint
+        // that does not include this transaction.
         uint64_t csn = MOT::GetCSNManager().GetNextCSN();
         if (txnState == MOT::TxnState::TXN_PREPARE) {
             MOTAdaptor::CommitPrepared(csn);
@@ -1654,9 +1872,8 @@ static void MOTXactCallback(XactEvent event, void* arg)
             MOTAdaptor::CommitPrepared(csn);
         } else if (txnState == MOT::TxnState::TXN_START) {
             elog(DEBUG2, "XACT_EVENT_COMMIT_PREPARED, tid %lu", tid);
-            // Need to get the envelope CSN for cross transaction support.
-            uint64_t csn = MOT::GetCSNManager().GetNextCSN();
-            rc = MOTAdaptor::Commit(csn);
+            // The CSN is taken inside, after the validation registered the commit in the checkpoint phase.
+            rc = MOTAdaptor::Commit();
         } else if (txnState != MOT::TxnState::TXN_ROLLBACK && txnState != MOT::TxnState::TXN_COMMIT) {
             elog(DEBUG2, "XACT_EVENT_COMMIT_PREPARED, tid %lu", tid);
             abortParentTransactionParamsNoDetail(
@@ -1791,6 +2008,14 @@ static void MOTValidateTableDef(Node* obj)
                         errmsg("Cannot create MOT tables while incremental checkpoint is enabled.")));
             }
 
+            // the engine does not support partitions, so reject the clause rather than silently ignoring it
+            if (((CreateForeignTableStmt*)obj)->part_state != nullptr) {
+                ereport(ERROR,
+                    (errcode(ERRCODE_FDW_OPERATION_NOT_SUPPORTED),
+                        errmodule(MOD_MOT),
+                        errmsg("Partitioned memory tables are not supported.")));
+            }
+
             MOTAdaptor::CreateTable((CreateForeignTableStmt*)obj, tid);
             break;
         }
@@ -1978,6 +2203,30 @@ bool MOTCheckpointExists(
     return true;
 }
 
+bool MOTCheckpointChainDir(uint32_t index, char* checkpointDir, size_t checkpointLen)
+{
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    if (engine == nullptr || engine->GetCheckpointManager() == nullptr) {
+        return false;
+    }
+
+    // the last checkpoint of the chain is the current one
+    const std::vector<uint64_t>& chain = engine->GetCheckpointManager()->GetChain();
+    if (chain.empty() || index >= chain.size() - 1) {
+        return false;
+    }
+
+    std::string workingDir;
+    if (!MOT::CheckpointUtils::SetWorkingDir(workingDir, chain[index])) {
+        ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR), errmodule(MOD_MOT), errmsg("Failed to obtain working dir")));
+        return false;
+    }
+
+    errno_t rc = snprintf_s(checkpointDir, checkpointLen, checkpointLen - 1, "%s", workingDir.c_str());
+    securec_check_ss(rc, "", "");
+    return true;
+}
+
 inline bool IsNotEqualOper(OpExpr* op)
 {
     switch (op->opno) {
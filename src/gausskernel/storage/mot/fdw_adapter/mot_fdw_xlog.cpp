@@ -32,11 +32,13 @@
 #include "mot_fdw_xlog.h"
 #include "mot_engine.h"
 #include "recovery_manager.h"
+#include "compression.h"
+#include "log_statistics.h"
 #include "miscadmin.h"
 
 bool IsValidEntry(uint8 code)
 {
-    return code == MOT_REDO_DATA;
+    return code == MOT_REDO_DATA || code == MOT_REDO_DATA_LZ4;
 }
 
 void RedoTransactionCommit(TransactionId xid, void* arg)
@@ -67,13 +69,38 @@ void MOTRedo(XLogReaderState* record)
     char* data = XLogRecGetData(record);
     size_t len = XLogRecGetDataLen(record);
     uint64_t lsn = record->EndRecPtr;
+    char* rawData = nullptr;
     if (!IsValidEntry(recordType)) {
         elog(ERROR, "MOTRedo: invalid op code %u", recordType);
     }
+    if (recordType == MOT_REDO_DATA_LZ4) {
+        MOT::CompressedBlockHeader header;
+        if (len < sizeof(MOT::CompressedBlockHeader)) {
+            elog(ERROR, "MOTRedo: invalid compressed record length %lu", len);
+        }
+        errno_t erc = memcpy_s(&header, sizeof(header), data, sizeof(MOT::CompressedBlockHeader));
+        securec_check(erc, "\0", "\0");
+        if (header.m_compressedSize != len - sizeof(MOT::CompressedBlockHeader)) {
+            elog(ERROR, "MOTRedo: invalid compressed record length %lu", len);
+        }
+        rawData = (char*)palloc(header.m_rawSize);
+        if (!MOT::Compression::DecompressBlock(
+                header, data + sizeof(MOT::CompressedBlockHeader), rawData, header.m_rawSize)) {
+            elog(ERROR,
+                "MOTRedo: failed to decompress record (raw %u, compressed %u)",
+                header.m_rawSize,
+                header.m_compressedSize);
+        }
+        data = rawData;
+        len = header.m_rawSize;
+    }
     if (MOT::GetRecoveryManager()->IsErrorSet() || !MOT::GetRecoveryManager()->ApplyRedoLog(lsn, data, len)) {
         // we treat errors fatally.
         ereport(FATAL, (errcode(ERRCODE_INTERNAL_ERROR), errmsg("MOT recovery failed.")));
     }
+    if (rawData != nullptr) {
+        pfree(rawData);
+    }
 }
 
 uint64_t XLOGLogger::AddToLog(MOT::RedoLogBuffer** redoLogBufferArray, uint32_t size)
@@ -83,11 +110,34 @@ uint64_t XLOGLogger::AddToLog(MOT::RedoLogBuffer** redoLogBufferArray, uint32_t
 
 uint64_t XLOGLogger::AddToLog(uint8_t* data, uint32_t size)
 {
+    char* block = nullptr;
+    uint32_t blockSize = 0;
+    if (MOT::GetGlobalConfiguration().m_enableRedoLogCompression && size >= MOT_REDO_COMPRESS_MIN_SIZE) {
+        // compress before entering the critical section, the record is logged raw if it does not shrink
+        uint32_t blockCapacity = MOT::Compression::CompressBound(size);
+        block = (char*)malloc(blockCapacity);
+        if (block != nullptr) {
+            blockSize = MOT::Compression::CompressBlock((const char*)data, size, block, blockCapacity);
+            if (blockSize > 0) {
+                MOT::LogStatisticsProvider::GetInstance().AddCompression(size, blockSize);
+            }
+        }
+    }
+
     START_CRIT_SECTION();
     XLogBeginInsert();
-    XLogRegisterData((char*)data, size);
-    XLogInsert(RM_MOT_ID, MOT_REDO_DATA);
+    if (blockSize > 0 && blockSize < size) {
+        XLogRegisterData(block, blockSize);
+        XLogInsert(RM_MOT_ID, MOT_REDO_DATA_LZ4);
+    } else {
+        XLogRegisterData((char*)data, size);
+        XLogInsert(RM_MOT_ID, MOT_REDO_DATA);
+    }
     END_CRIT_SECTION();
+
+    if (block != nullptr) {
+        free(block);
+    }
     return size;
 }
 
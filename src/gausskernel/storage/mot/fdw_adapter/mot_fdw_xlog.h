@@ -35,6 +35,12 @@
  */
 const int MOT_REDO_DATA = 0x10;
 
+/* Redo data compressed into a single LZ4 block (see compression.h) */
+const int MOT_REDO_DATA_LZ4 = 0x20;
+
+/* Redo data smaller than this is never compressed */
+const uint32_t MOT_REDO_COMPRESS_MIN_SIZE = 256;
+
 MOT::TxnCommitStatus GetTransactionStateCallback(uint64_t transactionId);
 void RedoTransactionCommit(TransactionId xid, void* arg);
 
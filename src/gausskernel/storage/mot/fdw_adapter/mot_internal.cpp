@@ -549,14 +549,21 @@ void MOTAdaptor::RecordCommit(uint64_t csn)
     }
 }
 
-MOT::RC MOTAdaptor::Commit(uint64_t csn)
+MOT::RC MOTAdaptor::Commit()
 {
     EnsureSafeThreadAccessInline();
     MOT::TxnManager* txn = GetSafeTxn(__FUNCTION__);
-    txn->SetCommitSequenceNumber(csn);
     if (!IS_PGXC_COORDINATOR) {
-        return txn->Commit();
+        // The CSN must be taken after the validation registered the commit in the current checkpoint phase.
+        // Taken before, a checkpoint could set its cutoff CSN above it without including this transaction.
+        MOT::RC rc = txn->ValidateCommit();
+        if (rc == MOT::RC_OK) {
+            txn->SetCommitSequenceNumber(MOT::GetCSNManager().GetNextCSN());
+            txn->RecordCommit();
+        }
+        return rc;
     } else {
+        txn->SetCommitSequenceNumber(MOT::GetCSNManager().GetNextCSN());
         txn->LiteCommit();
         return MOT::RC_OK;
     }
@@ -798,6 +805,19 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
             MOT::Index* ix = festate->m_table->GetPrimaryIndex();
             uint16_t keyLength = ix->GetKeyLength();
 
+            // parallel scan, each worker reads the keys from its bound (inclusive) to the next one (exclusive)
+            if (festate->m_parallelDop > 1) {
+                if (festate->m_parallelBounds == nullptr) {
+                    // less than two distinct keys when planned, the first worker reads the whole range
+                    if (festate->m_parallelId > 0) {
+                        break;
+                    }
+                } else {
+                    OpenParallelScanCursors(festate, ix);
+                    break;
+                }
+            }
+
             if (festate->m_order == SORTDIR_ENUM::SORTDIR_ASC) {
                 fIx = 0;
                 bIx = 1;
@@ -1042,8 +1062,8 @@ void MOTAdaptor::ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::Tx
         return;
     }
 
-    if (strcmp(stmt->accessMethod, "btree") != 0) {
-        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE only (btree or btree_art)")));
+    if (strcmp(stmt->accessMethod, "btree") != 0 && strcmp(stmt->accessMethod, "hash") != 0) {
+        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE or HASH only")));
         return;
     }
 
@@ -1086,9 +1106,12 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
     MOT::Index* index = nullptr;
     MOT::IndexOrder index_order = MOT::IndexOrder::INDEX_ORDER_SECONDARY;
 
-    // Use the default index tree flavor from configuration file
+    // Use the default index tree flavor from configuration file, the flavor is ignored for hash indexes
     MOT::IndexingMethod indexing_method = MOT::IndexingMethod::INDEXING_METHOD_TREE;
     MOT::IndexTreeFlavor flavor = MOT::GetGlobalConfiguration().m_indexTreeFlavor;
+    if (strcmp(stmt->accessMethod, "hash") == 0) {
+        indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+    }
 
     // check if we have primary and delete previous definition
     if (stmt->primary) {
@@ -1132,16 +1155,6 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
             return MOT::RC_ERROR;
         }
 
-        // Temp solution, we have to support DECIMAL and NUMERIC indexes as well
-        if (col->m_type == MOT::MOT_CATALOG_FIELD_TYPES::MOT_TYPE_DECIMAL) {
-            delete index;
-            ereport(ERROR,
-                (errmodule(MOD_MOT),
-                    errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                    errmsg("Can't create index on field"),
-                    errdetail("INDEX on NUMERIC or DECIMAL fields not supported yet")));
-            return MOT::RC_ERROR;
-        }
         if (col->m_keySize > MAX_KEY_SIZE) {
             delete index;
             ereport(ERROR,
@@ -1734,6 +1747,99 @@ void MOTAdaptor::CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start
     festate->m_bestIx->m_ix->AdjustKey(&festate->m_stateKey[start], pattern);
 }
 
+void MOTAdaptor::OpenParallelScanCursors(MOTFdwStateSt* festate, MOT::Index* ix)
+{
+    bool found = false;
+    uint16_t keyLength = ix->GetKeyLength();
+    uint32_t id = festate->m_parallelId;
+    const uint8_t* bounds = (const uint8_t*)VARDATA(festate->m_parallelBounds);
+    errno_t erc;
+
+    festate->m_forwardDirectionScan = true;
+    if (id == 0) {
+        festate->m_cursor[0] = festate->m_table->Begin(festate->m_currTxn->GetThdId());
+    } else {
+        festate->m_stateKey[0].InitKey(keyLength);
+        erc = memcpy_s(festate->m_stateKey[0].GetKeyBuf(), keyLength, bounds + (size_t)keyLength * (id - 1), keyLength);
+        securec_check(erc, "\0", "\0");
+        festate->m_cursor[0] =
+            ix->Search(&festate->m_stateKey[0], true, true, festate->m_currTxn->GetThdId(), found);
+    }
+
+    // the end cursor points to the last key before the next bound, or to the last key of the index
+    festate->m_stateKey[1].InitKey(keyLength);
+    if (id + 1 < festate->m_parallelDop) {
+        erc = memcpy_s(festate->m_stateKey[1].GetKeyBuf(), keyLength, bounds + (size_t)keyLength * id, keyLength);
+    } else {
+        erc = memset_s(festate->m_stateKey[1].GetKeyBuf(), keyLength, 0xff, keyLength);
+    }
+    securec_check(erc, "\0", "\0");
+    festate->m_cursor[1] = ix->Search(&festate->m_stateKey[1], false, false, festate->m_currTxn->GetThdId(), found);
+}
+
+bytea* MOTAdaptor::GetParallelScanBounds(MOT::Table* table, uint32_t dop)
+{
+    bool found = false;
+    bytea* result = nullptr;
+    MOT::MaxKey maxKey;
+    MOT::TxnManager* txn = GetSafeTxn(__FUNCTION__);
+    MOT::Index* ix = table->GetPrimaryIndex();
+    uint16_t keyLength = ix->GetKeyLength();
+
+    EnsureSafeThreadAccessInline();
+    maxKey.InitKey(keyLength);
+    errno_t erc = memset_s(maxKey.GetKeyBuf(), keyLength, 0xff, keyLength);
+    securec_check(erc, "\0", "\0");
+    MOT::IndexIterator* first = ix->Begin(txn->GetThdId());
+    MOT::IndexIterator* last = ix->Search(&maxKey, false, false, txn->GetThdId(), found);
+
+    if (first != nullptr && last != nullptr && first->IsValid() && last->IsValid()) {
+        const uint8_t* low = reinterpret_cast<const MOT::Key*>(first->GetKey())->GetKeyBuf();
+        const uint8_t* high = reinterpret_cast<const MOT::Key*>(last->GetKey())->GetKeyBuf();
+        uint16_t prefix = 0;
+        while (prefix < keyLength && low[prefix] == high[prefix]) {
+            prefix++;
+        }
+
+        if (prefix < keyLength) {
+            // interpolate the first bytes after the common prefix, the rest of each bound is zeroed
+            uint64_t lowVal = 0;
+            uint64_t highVal = 0;
+            for (uint16_t i = 0; i < MOT_PARALLEL_SCAN_SPLIT_BYTES; i++) {
+                uint32_t pos = prefix + i;
+                lowVal = (lowVal << 8) | (pos < keyLength ? low[pos] : 0);
+                highVal = (highVal << 8) | (pos < keyLength ? high[pos] : 0);
+            }
+            uint64_t step = (highVal - lowVal) / dop;
+
+            size_t len = (size_t)keyLength * (dop - 1);
+            result = (bytea*)palloc0(VARHDRSZ + len);
+            SET_VARSIZE(result, VARHDRSZ + len);
+            uint8_t* bound = (uint8_t*)VARDATA(result);
+            for (uint32_t w = 1; w < dop; w++, bound += keyLength) {
+                uint64_t val = lowVal + step * w;
+                if (prefix > 0) {
+                    erc = memcpy_s(bound, keyLength, low, prefix);
+                    securec_check(erc, "\0", "\0");
+                }
+                for (uint16_t i = 0; i < MOT_PARALLEL_SCAN_SPLIT_BYTES && prefix + i < keyLength; i++) {
+                    bound[prefix + i] = (uint8_t)(val >> (8 * (MOT_PARALLEL_SCAN_SPLIT_BYTES - 1 - i)));
+                }
+            }
+        }
+    }
+
+    MOT::IndexIterator* cursors[] = {first, last};
+    for (MOT::IndexIterator* cursor : cursors) {
+        if (cursor != nullptr) {
+            cursor->Invalidate();
+            cursor->Destroy();
+            delete cursor;
+        }
+    }
+    return result;
+}
+
 bool MOTAdaptor::IsScanEnd(MOTFdwStateSt* festate)
 {
     bool res = false;
@@ -1850,6 +1956,56 @@ void MOTAdaptor::UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_
     }
 }
 
+void MOTAdaptor::UnpackRowToBatch(
+    VectorBatch* batch, int rowIdx, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow)
+{
+    EnsureSafeThreadAccessInline();
+    size_t len = 0;
+
+    // column count includes null bits field
+    int cols = (int)table->GetFieldCount() - 1;
+
+    for (int i = 0; i < cols; i++) {
+        ScalarVector* vec = &batch->m_arr[i];
+        vec->m_rows++;
+        if (!BITMAP_GET(attrs_used, i) || !BITMAP_GET(srcRow, i)) {
+            vec->SetNull(rowIdx);
+            continue;
+        }
+
+        MOT::Column* col = table->GetField(i + 1);
+        switch (vec->m_desc.typeId) {
+            case VARCHAROID:
+            case BPCHAROID:
+            case TEXTOID:
+            case CLOBOID:
+            case BYTEAOID: {
+                // copy the string directly into the vector buffer, no intermediate varlena
+                uintptr_t tmp;
+                col->Unpack(srcRow, &tmp, len);
+                (void)vec->AddVarCharWithoutHeader((const char*)tmp, (int)len, rowIdx);
+                break;
+            }
+            case NUMERICOID: {
+                MOT::DecimalSt* d;
+                col->Unpack(srcRow, (uintptr_t*)&d, len);
+                (void)vec->AddVar(NumericGetDatum(MOTNumericToPG(d)), rowIdx);
+                break;
+            }
+            default: {
+                Datum value;
+                col->Unpack(srcRow, &value, len);
+                if (vec->m_desc.encoded) {
+                    (void)vec->AddVar(value, rowIdx);
+                } else {
+                    vec->m_vals[rowIdx] = value;
+                }
+                break;
+            }
+        }
+    }
+}
+
 // useful functions for data conversion: utils/fmgr/gmgr.cpp
 void MOTAdaptor::MOTToDatum(MOT::Table* table, const Form_pg_attribute attr, uint8_t* data, Datum* value, bool* is_null)
 {
@@ -2120,8 +2276,14 @@ MOTFdwStateSt* InitializeFdwState(void* fdwState, List** fdwExpr, uint64_t exTab
         BitmapDeSerialize(state->m_attrsUsed, len, &cell);
 
         if (cell != NULL) {
-            state->m_bestIx = &state->m_bestIxBuf;
-            state->m_bestIx->Deserialize(cell, exTableID);
+            Const* value = (Const*)lfirst(cell);
+            if (value->consttype == BYTEAOID) {
+                // key range bounds of a parallel scan
+                state->m_parallelBounds = (bytea*)DatumGetPointer(value->constvalue);
+            } else {
+                state->m_bestIx = &state->m_bestIxBuf;
+                state->m_bestIx->Deserialize(cell, exTableID);
+            }
         }
 
         if (fdwExpr != NULL && *fdwExpr != NULL) {
@@ -2165,6 +2327,9 @@ void* SerializeFdwState(MOTFdwStateSt* state)
 
     if (state->m_bestIx != nullptr) {
         state->m_bestIx->Serialize(&result);
+    } else if (state->m_parallelBounds != nullptr) {
+        result = lappend(result,
+            makeConst(BYTEAOID, -1, InvalidOid, -1, PointerGetDatum(state->m_parallelBounds), false, false));
     }
     ReleaseFdwState(state);
     return result;
@@ -122,6 +122,15 @@ typedef struct MOTRecConvert {
 
 #define SORT_STRATEGY(x) ((x == BTGreaterStrategyNumber) ? SORTDIR_DESC : SORTDIR_ASC)
 
+/* Tables with fewer rows are always scanned by a single worker */
+#define MOT_PARALLEL_SCAN_MIN_ROWS 100000
+
+/* Number of leading key bytes (after the common prefix) used to split the key range of a parallel scan */
+#define MOT_PARALLEL_SCAN_SPLIT_BYTES 8
+
+/* Full scans expected to return fewer rows are never vectorized */
+#define MOT_VECTOR_SCAN_MIN_ROWS 1000
+
 struct MOTFdwState_St {
     ::TransactionId m_txnId;
     bool m_allocInScan;
@@ -156,6 +165,14 @@ struct MOTFdwState_St {
     MOT::MaxKey m_stateKey[2];
     bool m_forwardDirectionScan;
     MOT::AccessType m_internalCmdOper;
+
+    // parallel (SMP) scan, the number of workers (0 or 1 when not parallel) and the id of the current worker
+    uint32_t m_parallelDop;
+    uint32_t m_parallelId;
+
+    // parallel (SMP) scan, the dop - 1 primary keys splitting the key range among the workers (nullptr: worker 0
+    // scans the whole range)
+    bytea* m_parallelBounds;
 };
 
 class MOTAdaptor {
@@ -209,7 +226,7 @@ public:
     static MotSessionMemoryDetail* GetSessionMemSize(uint32_t* sessionCount);
     static MOT::RC ValidateCommit();
     static void RecordCommit(uint64_t csn);
-    static MOT::RC Commit(uint64_t csn);  // Does both ValidateCommit and RecordCommit
+    static MOT::RC Commit();  // Does both ValidateCommit and RecordCommit, taking the CSN in between
     static void EndTransaction();
     static void Rollback();
     static MOT::RC Prepare();
@@ -267,10 +284,26 @@ public:
     static void PackRow(TupleTableSlot* slot, MOT::Table* table, uint8_t* attrs_used, uint8_t* destRow);
     static void PackUpdateRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* destRow);
     static void UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
+    static void UnpackRowToBatch(
+        VectorBatch* batch, int rowIdx, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
 
     // scan helpers
     static void OpenCursor(Relation rel, MOTFdwStateSt* festate);
+    static void OpenParallelScanCursors(MOTFdwStateSt* festate, MOT::Index* ix);
     static bool IsScanEnd(MOTFdwStateSt* festate);
+
+    /**
+     * @brief Splits the primary key range of a table among the workers of a parallel scan.
+     * @detail The range between the lowest and the highest key is split evenly, by interpolating the first
+     * bytes that differ between them. The bounds only balance the work, each worker scans the keys from its
+     * lower bound (inclusive) to the next one (exclusive) and the first and last workers have open ranges, so
+     * every row is read by exactly one worker even if the table changed since the bounds were computed.
+     * @param table The table to scan.
+     * @param dop The number of workers.
+     * @return The dop - 1 bounds, each of the key length of the primary index, or nullptr if the table has
+     * less than two distinct keys.
+     */
+    static bytea* GetParallelScanBounds(MOT::Table* table, uint32_t dop);
     static void CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start);
 
     // planning helpers
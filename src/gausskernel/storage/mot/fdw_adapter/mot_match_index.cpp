@@ -377,6 +377,11 @@ double MatchIndex::GetCost(int numClauses)
         return INT_MAX;
     }
 
+    // hash indexes serve only point lookups on all the index columns
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH && !IsPointMatch()) {
+        return INT_MAX;
+    }
+
     return m_cost;
 }
 
@@ -407,10 +412,29 @@ bool MatchIndex::AdjustForOrdering(bool desc)
     return true;
 }
 
+bool MatchIndex::IsPointMatch() const
+{
+    if (m_start < 0) {
+        return false;
+    }
+
+    for (int16_t i = 0; i < m_ix->GetNumFields(); i++) {
+        if (m_colMatch[m_start][i] == nullptr || m_opers[m_start][i] != KEY_OPER::READ_KEY_EXACT) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool MatchIndex::CanApplyOrdering(const int* orderCols) const
 {
     int16_t numKeyCols = m_ix->GetNumFields();
 
+    // hash index entries are not ordered
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        return false;
+    }
+
     // check if order columns are overlap index matched columns or are suffix for it
     for (int16_t i = 0; i < numKeyCols; i++) {
         // overlap: we can use index ordering
@@ -120,6 +120,7 @@ public:
         return m_numMatches[0];
     }
 
+    bool IsPointMatch() const;
     double GetCost(int numClauses);
     bool CanApplyOrdering(const int* orderCols) const;
     bool AdjustForOrdering(bool desc);
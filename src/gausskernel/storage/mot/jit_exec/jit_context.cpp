@@ -522,6 +522,12 @@ extern void DestroyJitContext(JitContext* jitContext)
         // cleanup JOIN keys(s)
         CleanupJitContextInner(jitContext);
 
+        // cleanup GROUP BY hash table of an unfinished grouped aggregate
+        if (jitContext->m_groupTable != nullptr) {
+            freeGroupTable(jitContext->m_groupTable);
+            jitContext->m_groupTable = nullptr;
+        }
+
         // cleanup bitmap set
         if (jitContext->m_bitmapSet != nullptr) {
             MOT::MemSessionFree(jitContext->m_bitmapSet->GetData());
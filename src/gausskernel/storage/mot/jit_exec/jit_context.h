@@ -209,10 +209,14 @@ struct JitContext {
     /** @var The number of full query executions. */
     uint64_t m_queryCount;  // L1 offset 40
 
+    /*---------------------- Grouped aggregation state -------------------*/
+    /** @var Hash table of groups for GROUP BY aggregate (stateful execution). */
+    void* m_groupTable;  // L1 offset 48
+
     /*---------------------- Debug execution state -------------------*/
     /** @var The number of times this context was invoked for execution. */
 #ifdef MOT_JIT_DEBUG
-    uint64_t m_execCount;  // L1 offset 48
+    uint64_t m_execCount;  // L1 offset 56
 #endif
 };
 
@@ -123,7 +123,7 @@ extern JitPlan* IsJittable(Query* query, const char* queryString)
         }
     }
 
-    MOT_LOG_TRACE("Query %s jittable: %s", (jitPlan != nullptr) ? "is" : "is not", queryString);
+    JitExplainEligibility(queryString, jitPlan);
 
     // update statistics
     if (limitBreached) {
@@ -162,6 +162,11 @@ static void ProcessJitResult(MOT::RC result, JitContext* jitContext, int newScan
                     MOT_LOG_INFO("JIT total queries executed: %" PRIu64, MOT_ATOMIC_LOAD(totalExecCount));
 #endif
                     JitStatisticsProvider::GetInstance().AddExecQuery();
+                    ++u_sess->mot_cxt.jit_exec_count;
+                    if (u_sess->SPI_cxt._connected >= 0) {  // issued by a stored procedure
+                        JitStatisticsProvider::GetInstance().AddExecSpiQuery();
+                        ++u_sess->mot_cxt.jit_exec_spi_count;
+                    }
                 }
                 return;
             default:
@@ -474,6 +479,11 @@ extern int JitExecQuery(
             MOT_LOG_INFO("JIT total queries executed: %" PRIu64, MOT_ATOMIC_LOAD(totalExecCount));
 #endif
             JitStatisticsProvider::GetInstance().AddExecQuery();
+            ++u_sess->mot_cxt.jit_exec_count;
+            if (u_sess->SPI_cxt._connected >= 0) {  // issued by a stored procedure
+                JitStatisticsProvider::GetInstance().AddExecSpiQuery();
+                ++u_sess->mot_cxt.jit_exec_spi_count;
+            }
         }
     } else {
         ProcessJitResult((MOT::RC)result, jitContext, newScan);
@@ -633,10 +633,14 @@ static void ExplainAggregateOperator(int indent, const JitAggregate* aggregate,
     if (aggregate->_distinct) {
         MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, "DISTINCT(");
     }
-    MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE,
-        "%s.%s)",
-        aggregate->_table->GetTableName().c_str(),
-        aggregate->_table->GetFieldName(aggregate->_table_column_id));
+    if (aggregate->_table_column_id < 0) {
+        MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, "*)");
+    } else {
+        MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE,
+            "%s.%s)",
+            aggregate->_table->GetTableName().c_str(),
+            aggregate->_table->GetFieldName(aggregate->_table_column_id));
+    }
     if (aggregate->_distinct) {
         MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, ")");
     }
@@ -645,6 +649,17 @@ static void ExplainAggregateOperator(int indent, const JitAggregate* aggregate,
     }
 }
 
+static void ExplainGroupByColumns(MOT::Table* table, const JitGroupBy* groupBy)
+{
+    for (int i = 0; i < groupBy->_column_count; ++i) {
+        MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE,
+            "%s%s.%s",
+            (i > 0) ? ", " : "",
+            table->GetTableName().c_str(),
+            table->GetFieldName(groupBy->_columns[i]._table_column_id));
+    }
+}
+
 static void ExplainRangeSelectPlan(Query* query, JitRangeSelectPlan* plan, bool isSubQuery /* = false */)
 {
     if (isSubQuery) {
@@ -658,6 +673,13 @@ static void ExplainRangeSelectPlan(Query* query, JitRangeSelectPlan* plan, bool
         indent += 2;
         ExplainAggregateOperator(indent, &plan->_aggregate, isSubQuery);
     }
+    if (plan->_group_by._column_count > 0) {
+        // grouped aggregate is never a sub-query
+        indent += 2;
+        MOT_LOG_BEGIN(MOT::LogLevel::LL_TRACE, "%*sGROUP BY ", indent, "");
+        ExplainGroupByColumns(plan->_index_scan._table, &plan->_group_by);
+        MOT_LOG_END(MOT::LogLevel::LL_TRACE);
+    }
     if (plan->_limit_count > 0) {
         if (isSubQuery) {
             MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, " LIMIT %d", plan->_limit_count);
@@ -779,4 +801,76 @@ extern void JitExplainPlan(Query* query, JitPlan* plan)
         }
     }
 }
+
+static const char* JitPlanToString(
+    JitPlan* plan, const JitAggregate** aggregate, const JitRangeSelectPlan** groupedPlan, int* limitCount)
+{
+    *aggregate = nullptr;
+    *groupedPlan = nullptr;
+    *limitCount = 0;
+    switch (plan->_plan_type) {
+        case JIT_PLAN_INSERT_QUERY:
+            return "INSERT";
+
+        case JIT_PLAN_POINT_QUERY:
+            return "point query";
+
+        case JIT_PLAN_RANGE_SCAN:
+            if (((JitRangeScanPlan*)plan)->_command_type == JIT_COMMAND_SELECT) {
+                JitRangeSelectPlan* selectPlan = (JitRangeSelectPlan*)plan;
+                *aggregate = &selectPlan->_aggregate;
+                *limitCount = selectPlan->_limit_count;
+                if (selectPlan->_group_by._column_count > 0) {
+                    *groupedPlan = selectPlan;
+                }
+                return "range SELECT";
+            }
+            return "range UPDATE";
+
+        case JIT_PLAN_JOIN:
+            *aggregate = &((JitJoinPlan*)plan)->_aggregate;
+            *limitCount = ((JitJoinPlan*)plan)->_limit_count;
+            return "JOIN";
+
+        case JIT_PLAN_COMPOUND:
+            return "compound query";
+
+        case JIT_PLAN_INVALID:
+        default:
+            return "invalid plan";
+    }
+}
+
+extern void JitExplainEligibility(const char* queryString, JitPlan* plan)
+{
+    if (plan == nullptr) {
+        MOT_LOG_TRACE("[JIT] Query is not JIT-eligible: %s", queryString);
+    } else if (plan == MOT_READY_JIT_PLAN) {
+        MOT_LOG_TRACE("[JIT] Query is JIT-eligible (cached source): %s", queryString);
+    } else {
+        const JitAggregate* aggregate = nullptr;
+        const JitRangeSelectPlan* groupedPlan = nullptr;
+        int limitCount = 0;
+        const char* planName = JitPlanToString(plan, &aggregate, &groupedPlan, &limitCount);
+        MOT_LOG_BEGIN(MOT::LogLevel::LL_TRACE, "[JIT] Query is JIT-eligible as %s", planName);
+        if ((aggregate != nullptr) && (aggregate->_aggreaget_op != JIT_AGGREGATE_NONE)) {
+            MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE,
+                " with aggregate %s(%s)",
+                JitAggregateOperatorToString(aggregate->_aggreaget_op),
+                (aggregate->_table_column_id < 0) ? "*" : aggregate->_table->GetFieldName(aggregate->_table_column_id));
+        }
+        if (groupedPlan != nullptr) {
+            MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, " grouped by ");
+            ExplainGroupByColumns(groupedPlan->_index_scan._table, &groupedPlan->_group_by);
+        }
+        if (JitPlanHasSort(plan)) {
+            MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, " ordered by index");
+        }
+        if (limitCount > 0) {
+            MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, " LIMIT %d", limitCount);
+        }
+        MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, ": %s", queryString);
+        MOT_LOG_END(MOT::LogLevel::LL_TRACE);
+    }
+}
 }  // namespace JitExec
@@ -30,6 +30,7 @@
 #include "libintl.h"
 #include "codegen/gscodegen.h"
 #include "access/xact.h"
+#include "access/hash.h"
 #include "utils/array.h"
 #include "utils/builtins.h"
 
@@ -37,6 +38,7 @@
 #include "jit_common.h"
 #include "mot_internal.h"
 #include "utilities.h"
+#include <algorithm>
 #include <unordered_set>
 
 typedef std::unordered_set<int64_t> DistinctIntSetType;
@@ -108,6 +110,151 @@ static void destroyDistinctDoubleSet(void* distinct_set)
     MOT::MemSessionFree(distinct_set);
 }
 
+/** @define The initial number of groups in a GROUP BY hash table. */
+#define JIT_GROUP_TABLE_INITIAL_CAPACITY 16
+
+/** @struct A single group of a GROUP BY aggregate, holding the aggregation state of the group. */
+struct JitGroup {
+    /** @var The hash code of the grouping key. */
+    uint32_t m_hashCode;
+
+    /** @var The length in bytes of the grouping key image. */
+    uint32_t m_keyLength;
+
+    /** @var The binary image of the grouping key. */
+    uint8_t* m_key;
+
+    /** @var The aggregated value of the group (SUM/MAX/MIN/COUNT). */
+    Datum m_aggValue;
+
+    /** @var Specifies no value was aggregated yet in the group for MAX/MIN. */
+    uint64_t m_maxMinAggNull;
+
+    /** @var The aggregated array of the group (AVG). */
+    Datum m_avgArray;
+};
+
+/**
+ * @struct A small linear-probing hash table of groups. Groups are kept in order of first appearance, so when the scan
+ * follows the order of the ORDER BY clause, groups are also reported in that order.
+ */
+struct JitGroupTable {
+    /** @var The groups in order of first appearance. */
+    JitGroup* m_groups;
+
+    /** @var The hash slots, each holding a one-based group index, or zero if the slot is empty. */
+    uint32_t* m_slots;
+
+    /** @var The number of groups. */
+    uint32_t m_groupCount;
+
+    /** @var The number of groups that fit in the group array (half the number of hash slots). */
+    uint32_t m_groupCapacity;
+
+    /** @var The group whose aggregation state is loaded into the JIT context. */
+    uint32_t m_currentGroup;
+
+    /** @var The next group to report to the caller. */
+    uint32_t m_nextGroup;
+
+    /** @var The type of each grouping key column. */
+    int m_keyTypes[MOT_JIT_MAX_GROUP_BY_COLUMNS];
+
+    /** @var The binary image of the grouping key of the current row. */
+    uint8_t* m_probe;
+
+    /** @var The length in bytes of the current grouping key image. */
+    uint32_t m_probeLength;
+
+    /** @var The size in bytes of the grouping key image buffer. */
+    uint32_t m_probeCapacity;
+};
+
+/** @brief Queries whether a grouping key type is passed by value. */
+static inline bool isGroupKeyTypeByVal(int key_type)
+{
+    return (key_type != TEXTOID) && (key_type != VARCHAROID);
+}
+
+/** @brief Allocates session memory for a GROUP BY hash table, raising an error if out of memory. */
+static void* allocGroupTableBuffer(uint32_t size)
+{
+    void* buf = MOT::MemSessionAlloc(size);
+    if (buf == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Execute JIT", "Failed to allocate %u bytes for GROUP BY hash table", size);
+        abortParentTransactionParamsNoDetail(
+            ERRCODE_OUT_OF_LOGICAL_MEMORY, "Failed to allocate %u bytes for GROUP BY hash table", size);
+    }
+    return buf;
+}
+
+/** @brief Places a group in the first free hash slot of its hash code. */
+static void placeGroup(JitGroupTable* group_table, uint32_t group_index)
+{
+    uint32_t mask = (group_table->m_groupCapacity * 2) - 1;
+    uint32_t slot = group_table->m_groups[group_index].m_hashCode & mask;
+    while (group_table->m_slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    group_table->m_slots[slot] = group_index + 1;
+}
+
+/** @brief Doubles the capacity of a GROUP BY hash table, keeping the load factor below one half. */
+static void growGroupTable(JitGroupTable* group_table)
+{
+    uint32_t capacity = group_table->m_groupCapacity * 2;
+    JitGroup* groups = (JitGroup*)allocGroupTableBuffer(sizeof(JitGroup) * capacity);
+    uint32_t* slots = (uint32_t*)allocGroupTableBuffer(sizeof(uint32_t) * capacity * 2);
+    errno_t erc = memcpy_s(groups,
+        sizeof(JitGroup) * capacity,
+        group_table->m_groups,
+        sizeof(JitGroup) * group_table->m_groupCount);
+    securec_check(erc, "\0", "\0");
+    erc = memset_s(slots, sizeof(uint32_t) * capacity * 2, 0, sizeof(uint32_t) * capacity * 2);
+    securec_check(erc, "\0", "\0");
+
+    MOT::MemSessionFree(group_table->m_groups);
+    MOT::MemSessionFree(group_table->m_slots);
+    group_table->m_groups = groups;
+    group_table->m_slots = slots;
+    group_table->m_groupCapacity = capacity;
+    for (uint32_t i = 0; i < group_table->m_groupCount; ++i) {
+        placeGroup(group_table, i);
+    }
+}
+
+/** @brief Appends bytes to the grouping key image of the current row. */
+static void appendGroupKeyBytes(JitGroupTable* group_table, const void* data, uint32_t size)
+{
+    if (group_table->m_probeLength + size > group_table->m_probeCapacity) {
+        uint32_t capacity = std::max(group_table->m_probeCapacity * 2, group_table->m_probeLength + size);
+        uint8_t* probe = (uint8_t*)allocGroupTableBuffer(capacity);
+        if (group_table->m_probeLength > 0) {
+            errno_t erc = memcpy_s(probe, capacity, group_table->m_probe, group_table->m_probeLength);
+            securec_check(erc, "\0", "\0");
+        }
+        MOT::MemSessionFree(group_table->m_probe);
+        group_table->m_probe = probe;
+        group_table->m_probeCapacity = capacity;
+    }
+    if (size > 0) {
+        errno_t erc = memcpy_s(group_table->m_probe + group_table->m_probeLength,
+            group_table->m_probeCapacity - group_table->m_probeLength,
+            data,
+            size);
+        securec_check(erc, "\0", "\0");
+        group_table->m_probeLength += size;
+    }
+}
+
+/** @brief Copies the aggregation state of a group into the JIT context. */
+static void loadGroupState(JitExec::JitContext* jit_context, const JitGroup* group)
+{
+    jit_context->m_aggValue = group->m_aggValue;
+    jit_context->m_maxMinAggNull = group->m_maxMinAggNull;
+    jit_context->m_avgArray = group->m_avgArray;
+}
+
 /*---------------------------  DEBUG Print Helpers ---------------------------*/
 #ifdef MOT_JIT_DEBUG
 /** @brief Prints to log a numeric value. */
@@ -1310,6 +1457,170 @@ void destroyDistinctSet(int element_type)
     }
 }
 
+void prepareGroupTable()
+{
+    MOT_LOG_DEBUG("Preparing GROUP BY hash table");
+    JitGroupTable* group_table = (JitGroupTable*)allocGroupTableBuffer(sizeof(JitGroupTable));
+    errno_t erc = memset_s(group_table, sizeof(JitGroupTable), 0, sizeof(JitGroupTable));
+    securec_check(erc, "\0", "\0");
+    u_sess->mot_cxt.jit_context->m_groupTable = group_table;
+
+    uint32_t capacity = JIT_GROUP_TABLE_INITIAL_CAPACITY;
+    group_table->m_groups = (JitGroup*)allocGroupTableBuffer(sizeof(JitGroup) * capacity);
+    group_table->m_slots = (uint32_t*)allocGroupTableBuffer(sizeof(uint32_t) * capacity * 2);
+    erc = memset_s(group_table->m_slots, sizeof(uint32_t) * capacity * 2, 0, sizeof(uint32_t) * capacity * 2);
+    securec_check(erc, "\0", "\0");
+    group_table->m_groupCapacity = capacity;
+}
+
+int isGroupTableNull()
+{
+    int result = (u_sess->mot_cxt.jit_context->m_groupTable == nullptr) ? 1 : 0;
+    MOT_LOG_DEBUG("Checked if GROUP BY hash table is null: result=%d", result);
+    return result;
+}
+
+void setGroupKeyColumn(int key_index, int key_type, Datum value)
+{
+    JitGroupTable* group_table = (JitGroupTable*)u_sess->mot_cxt.jit_context->m_groupTable;
+    if (key_index == 0) {
+        group_table->m_probeLength = 0;
+    }
+    group_table->m_keyTypes[key_index] = key_type;
+
+    // the key image holds a null flag per column, followed by the datum of by-value types, or by the length and data
+    // of text types (equal values of the supported types always have the same image)
+    uint8_t isnull = (uint8_t)getExprArgIsNull(0);
+    appendGroupKeyBytes(group_table, &isnull, sizeof(uint8_t));
+    if (!isnull) {
+        if (isGroupKeyTypeByVal(key_type)) {
+            appendGroupKeyBytes(group_table, &value, sizeof(Datum));
+        } else {
+            uint32_t length = (uint32_t)VARSIZE_ANY_EXHDR(DatumGetPointer(value));
+            appendGroupKeyBytes(group_table, &length, sizeof(uint32_t));
+            appendGroupKeyBytes(group_table, VARDATA_ANY(DatumGetPointer(value)), length);
+        }
+    }
+}
+
+int selectGroup()
+{
+    JitExec::JitContext* jit_context = u_sess->mot_cxt.jit_context;
+    JitGroupTable* group_table = (JitGroupTable*)jit_context->m_groupTable;
+    uint32_t hash_code = DatumGetUInt32(hash_any(group_table->m_probe, (int)group_table->m_probeLength));
+
+    // search for an existing group, and if found load its aggregation state
+    uint32_t mask = (group_table->m_groupCapacity * 2) - 1;
+    for (uint32_t slot = hash_code & mask; group_table->m_slots[slot] != 0; slot = (slot + 1) & mask) {
+        uint32_t group_index = group_table->m_slots[slot] - 1;
+        JitGroup* group = &group_table->m_groups[group_index];
+        if ((group->m_hashCode == hash_code) && (group->m_keyLength == group_table->m_probeLength) &&
+            (memcmp(group->m_key, group_table->m_probe, group->m_keyLength) == 0)) {
+            MOT_LOG_DEBUG("Selected existing group %u", group_index);
+            group_table->m_currentGroup = group_index;
+            loadGroupState(jit_context, group);
+            return 0;
+        }
+    }
+
+    // add a new group, whose aggregation state is prepared by the caller
+    if (group_table->m_groupCount == group_table->m_groupCapacity) {
+        growGroupTable(group_table);
+    }
+    uint32_t group_index = group_table->m_groupCount;
+    JitGroup* group = &group_table->m_groups[group_index];
+    group->m_hashCode = hash_code;
+    group->m_keyLength = group_table->m_probeLength;
+    group->m_key = (uint8_t*)allocGroupTableBuffer(group->m_keyLength);
+    errno_t erc = memcpy_s(group->m_key, group->m_keyLength, group_table->m_probe, group_table->m_probeLength);
+    securec_check(erc, "\0", "\0");
+    ++group_table->m_groupCount;
+    placeGroup(group_table, group_index);
+    group_table->m_currentGroup = group_index;
+    MOT_LOG_DEBUG("Added new group %u", group_index);
+    return 1;
+}
+
+void saveGroup()
+{
+    JitExec::JitContext* jit_context = u_sess->mot_cxt.jit_context;
+    JitGroupTable* group_table = (JitGroupTable*)jit_context->m_groupTable;
+    JitGroup* group = &group_table->m_groups[group_table->m_currentGroup];
+    group->m_aggValue = jit_context->m_aggValue;
+    group->m_maxMinAggNull = jit_context->m_maxMinAggNull;
+    group->m_avgArray = jit_context->m_avgArray;
+}
+
+int fetchNextGroup()
+{
+    JitExec::JitContext* jit_context = u_sess->mot_cxt.jit_context;
+    JitGroupTable* group_table = (JitGroupTable*)jit_context->m_groupTable;
+    if (group_table->m_nextGroup == group_table->m_groupCount) {
+        MOT_LOG_DEBUG("No more groups to fetch");
+        return 0;
+    }
+    group_table->m_currentGroup = group_table->m_nextGroup++;
+    loadGroupState(jit_context, &group_table->m_groups[group_table->m_currentGroup]);
+    MOT_LOG_DEBUG("Fetched group %u", group_table->m_currentGroup);
+    return 1;
+}
+
+void selectGroupKeyColumn(TupleTableSlot* slot, int key_index, int tuple_colid)
+{
+    JitGroupTable* group_table = (JitGroupTable*)u_sess->mot_cxt.jit_context->m_groupTable;
+    const uint8_t* key = group_table->m_groups[group_table->m_currentGroup].m_key;
+
+    // skip preceding key columns in the key image
+    for (int i = 0; i < key_index; ++i) {
+        uint8_t isnull = *key++;
+        if (!isnull) {
+            if (isGroupKeyTypeByVal(group_table->m_keyTypes[i])) {
+                key += sizeof(Datum);
+            } else {
+                uint32_t length = *(const uint32_t*)key;
+                key += sizeof(uint32_t) + length;
+            }
+        }
+    }
+
+    Datum value = PointerGetDatum(NULL);
+    uint8_t isnull = *key++;
+    if (!isnull) {
+        if (isGroupKeyTypeByVal(group_table->m_keyTypes[key_index])) {
+            value = *(const Datum*)key;
+        } else {
+            uint32_t length = *(const uint32_t*)key;
+            value = PointerGetDatum(cstring_to_text_with_len((const char*)(key + sizeof(uint32_t)), (int)length));
+        }
+    }
+    MOT_LOG_DEBUG("Selecting group key %d into tuple column %d", key_index, tuple_colid);
+    slot->tts_values[tuple_colid] = value;
+    slot->tts_isnull[tuple_colid] = (isnull != 0);
+}
+
+void destroyGroupTable()
+{
+    MOT_LOG_DEBUG("Destroying GROUP BY hash table");
+    freeGroupTable(u_sess->mot_cxt.jit_context->m_groupTable);
+    u_sess->mot_cxt.jit_context->m_groupTable = nullptr;
+}
+
+void freeGroupTable(void* group_table)
+{
+    JitGroupTable* table = (JitGroupTable*)group_table;
+    if (table != nullptr) {
+        for (uint32_t i = 0; i < table->m_groupCount; ++i) {
+            MOT::MemSessionFree(table->m_groups[i].m_key);
+        }
+        MOT::MemSessionFree(table->m_groups);
+        MOT::MemSessionFree(table->m_slots);
+        if (table->m_probe != nullptr) {
+            MOT::MemSessionFree(table->m_probe);
+        }
+        MOT::MemSessionFree(table);
+    }
+}
+
 void resetTupleDatum(TupleTableSlot* slot, int tuple_colid, int zero_type)
 {
     // write zero numeric on the fly (we rely on current memory context to clean up)
@@ -505,6 +505,50 @@ int insertDistinctItem(int element_type, Datum item);
 /** @brief Destroys the set of distinct items for DISTINCT() operator. */
 void destroyDistinctSet(int element_type);
 
+/*---------------------------  Group By Aggregate Helpers ---------------------------*/
+/** @brief Prepares an empty hash table of groups for GROUP BY aggregate. */
+void prepareGroupTable();
+
+/** @brief Queries whether the hash table of groups is null. */
+int isGroupTableNull();
+
+/**
+ * @brief Sets a grouping key column of the current row (null status is taken from argument position zero).
+ * @param key_index The zero-based index of the column in the GROUP BY clause.
+ * @param key_type The Oid of the column type.
+ * @param value The column value.
+ */
+void setGroupKeyColumn(int key_index, int key_type, Datum value);
+
+/**
+ * @brief Selects the group of the current row grouping key, and loads its aggregation state.
+ * @return Non-zero value if this is a new group, whose aggregation state must be prepared, otherwise zero.
+ */
+int selectGroup();
+
+/** @brief Saves the aggregation state into the selected group. */
+void saveGroup();
+
+/**
+ * @brief Selects the next group to report in order of first appearance, and loads its aggregation state.
+ * @return Non-zero value if a group was selected, or zero if all groups were reported.
+ */
+int fetchNextGroup();
+
+/**
+ * @brief Selects a grouping key column of the selected group into a tuple.
+ * @param slot The tuple.
+ * @param key_index The zero-based index of the column in the GROUP BY clause.
+ * @param tuple_colid The zero-based column index of the tuple into which the key is to be written.
+ */
+void selectGroupKeyColumn(TupleTableSlot* slot, int key_index, int tuple_colid);
+
+/** @brief Destroys the hash table of groups for GROUP BY aggregate. */
+void destroyGroupTable();
+
+/** @brief Frees a hash table of groups (used when the owning JIT context is destroyed). */
+void freeGroupTable(void* group_table);
+
 /**
  * @brief Resets a tuple datum to zero value.
  * @param slot The tuple.
@@ -2177,9 +2177,13 @@ bool buildAggregateRow(
 {
     bool result = false;
 
-    // extract the aggregated column
-    llvm::Value* table = (aggregate->_table == ctx->_table_info.m_table) ? ctx->table_value : ctx->inner_table_value;
-    llvm::Value* expr = AddReadDatumColumn(ctx, table, row, aggregate->_table_column_id, 0);
+    // extract the aggregated column (COUNT(*) only counts rows, so no column is read)
+    llvm::Value* expr = nullptr;
+    if (aggregate->_table_column_id >= 0) {
+        llvm::Value* table =
+            (aggregate->_table == ctx->_table_info.m_table) ? ctx->table_value : ctx->inner_table_value;
+        expr = AddReadDatumColumn(ctx, table, row, aggregate->_table_column_id, 0);
+    }
 
     // we first check if we have DISTINCT modifier
     if (aggregate->_distinct) {
@@ -2205,16 +2209,16 @@ bool buildAggregateRow(
     return result;
 }
 
-void buildAggregateResult(JitLlvmCodeGenContext* ctx, const JitAggregate* aggregate)
+void buildAggregateResult(JitLlvmCodeGenContext* ctx, const JitAggregate* aggregate, int tuple_colid /* = 0 */)
 {
     // in case of average we compute it when aggregate loop is done
     if (aggregate->_aggreaget_op == JIT_AGGREGATE_AVG) {
         llvm::Value* avg_value = AddComputeAvgFromArray(
             ctx, aggregate->_avg_element_type);  // we infer this during agg op analysis, but don't save it...
-        AddWriteTupleDatum(ctx, 0, avg_value);   // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, tuple_colid, avg_value);  // slot tuple 0 unless grouped
     } else {
         llvm::Value* count_value = AddGetAggValue(ctx);
-        AddWriteTupleDatum(ctx, 0, count_value);  // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, tuple_colid, count_value);  // slot tuple 0 unless grouped
     }
 
     // we take the opportunity to cleanup as well
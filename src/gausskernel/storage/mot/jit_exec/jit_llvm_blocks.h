@@ -92,7 +92,7 @@ bool prepareAggregate(JitLlvmCodeGenContext* ctx, JitAggregate* aggregate);
 bool buildAggregateRow(
     JitLlvmCodeGenContext* ctx, JitAggregate* aggregate, llvm::Value* row, llvm::BasicBlock* next_block);
 
-void buildAggregateResult(JitLlvmCodeGenContext* ctx, const JitAggregate* aggregate);
+void buildAggregateResult(JitLlvmCodeGenContext* ctx, const JitAggregate* aggregate, int tuple_colid = 0);
 
 void buildCheckLimit(JitLlvmCodeGenContext* ctx, int limit_count);
 
@@ -558,6 +558,53 @@ inline void defineDestroyDistinctSet(JitLlvmCodeGenContext* ctx, llvm::Module* m
     ctx->destroyDistinctSetFunc = defineFunction(module, ctx->VOID_T, "destroyDistinctSet", ctx->INT32_T, nullptr);
 }
 
+inline void definePrepareGroupTable(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->prepareGroupTableFunc = defineFunction(module, ctx->VOID_T, "prepareGroupTable", nullptr);
+}
+
+inline void defineIsGroupTableNull(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->isGroupTableNullFunc = defineFunction(module, ctx->INT32_T, "isGroupTableNull", nullptr);
+}
+
+inline void defineSetGroupKeyColumn(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->setGroupKeyColumnFunc =
+        defineFunction(module, ctx->VOID_T, "setGroupKeyColumn", ctx->INT32_T, ctx->INT32_T, ctx->DATUM_T, nullptr);
+}
+
+inline void defineSelectGroup(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->selectGroupFunc = defineFunction(module, ctx->INT32_T, "selectGroup", nullptr);
+}
+
+inline void defineSaveGroup(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->saveGroupFunc = defineFunction(module, ctx->VOID_T, "saveGroup", nullptr);
+}
+
+inline void defineFetchNextGroup(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->fetchNextGroupFunc = defineFunction(module, ctx->INT32_T, "fetchNextGroup", nullptr);
+}
+
+inline void defineSelectGroupKeyColumn(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->selectGroupKeyColumnFunc = defineFunction(module,
+        ctx->VOID_T,
+        "selectGroupKeyColumn",
+        ctx->TupleTableSlotType->getPointerTo(),
+        ctx->INT32_T,
+        ctx->INT32_T,
+        nullptr);
+}
+
+inline void defineDestroyGroupTable(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->destroyGroupTableFunc = defineFunction(module, ctx->VOID_T, "destroyGroupTable", nullptr);
+}
+
 inline void defineResetTupleDatum(JitLlvmCodeGenContext* ctx, llvm::Module* module)
 {
     ctx->resetTupleDatumFunc = defineFunction(module,
@@ -1277,6 +1324,51 @@ inline void AddDestroyDistinctSet(JitLlvmCodeGenContext* ctx, int element_type)
     AddFunctionCall(ctx, ctx->destroyDistinctSetFunc, element_type_value, nullptr);
 }
 
+inline void AddPrepareGroupTable(JitLlvmCodeGenContext* ctx)
+{
+    AddFunctionCall(ctx, ctx->prepareGroupTableFunc, nullptr);
+}
+
+inline llvm::Value* AddIsGroupTableNull(JitLlvmCodeGenContext* ctx)
+{
+    return AddFunctionCall(ctx, ctx->isGroupTableNullFunc, nullptr);
+}
+
+inline void AddSetGroupKeyColumn(JitLlvmCodeGenContext* ctx, int key_index, int key_type, llvm::Value* value)
+{
+    llvm::ConstantInt* key_index_value = llvm::ConstantInt::get(ctx->INT32_T, key_index, true);
+    llvm::ConstantInt* key_type_value = llvm::ConstantInt::get(ctx->INT32_T, key_type, true);
+    AddFunctionCall(ctx, ctx->setGroupKeyColumnFunc, key_index_value, key_type_value, value, nullptr);
+}
+
+inline llvm::Value* AddSelectGroup(JitLlvmCodeGenContext* ctx)
+{
+    return AddFunctionCall(ctx, ctx->selectGroupFunc, nullptr);
+}
+
+inline void AddSaveGroup(JitLlvmCodeGenContext* ctx)
+{
+    AddFunctionCall(ctx, ctx->saveGroupFunc, nullptr);
+}
+
+inline llvm::Value* AddFetchNextGroup(JitLlvmCodeGenContext* ctx)
+{
+    return AddFunctionCall(ctx, ctx->fetchNextGroupFunc, nullptr);
+}
+
+/** @brief Adds a call to selectGroupKeyColumn(slot, key_index, tuple_colid). */
+inline void AddSelectGroupKeyColumn(JitLlvmCodeGenContext* ctx, int key_index, int tuple_colid)
+{
+    llvm::ConstantInt* key_index_value = llvm::ConstantInt::get(ctx->INT32_T, key_index, true);
+    llvm::ConstantInt* tuple_colid_value = llvm::ConstantInt::get(ctx->INT32_T, tuple_colid, true);
+    AddFunctionCall(ctx, ctx->selectGroupKeyColumnFunc, ctx->slot_value, key_index_value, tuple_colid_value, nullptr);
+}
+
+inline void AddDestroyGroupTable(JitLlvmCodeGenContext* ctx)
+{
+    AddFunctionCall(ctx, ctx->destroyGroupTableFunc, nullptr);
+}
+
 /** @brief Adds a call to writeTupleDatum(slot, tuple_colid, value). */
 inline void AddWriteTupleDatum(JitLlvmCodeGenContext* ctx, int tuple_colid, llvm::Value* value)
 {
@@ -159,6 +159,15 @@ struct JitLlvmCodeGenContext {
     llvm::FunctionCallee insertDistinctItemFunc;
     llvm::FunctionCallee destroyDistinctSetFunc;
 
+    llvm::FunctionCallee prepareGroupTableFunc;
+    llvm::FunctionCallee isGroupTableNullFunc;
+    llvm::FunctionCallee setGroupKeyColumnFunc;
+    llvm::FunctionCallee selectGroupFunc;
+    llvm::FunctionCallee saveGroupFunc;
+    llvm::FunctionCallee fetchNextGroupFunc;
+    llvm::FunctionCallee selectGroupKeyColumnFunc;
+    llvm::FunctionCallee destroyGroupTableFunc;
+
     llvm::FunctionCallee resetTupleDatumFunc;
     llvm::FunctionCallee readTupleDatumFunc;
     llvm::FunctionCallee writeTupleDatumFunc;
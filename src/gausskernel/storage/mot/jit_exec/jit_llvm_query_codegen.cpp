@@ -128,6 +128,15 @@ void InitCodeGenContextFuncs(JitLlvmCodeGenContext* ctx)
     defineInsertDistinctItem(ctx, module);
     defineDestroyDistinctSet(ctx, module);
 
+    definePrepareGroupTable(ctx, module);
+    defineIsGroupTableNull(ctx, module);
+    defineSetGroupKeyColumn(ctx, module);
+    defineSelectGroup(ctx, module);
+    defineSaveGroup(ctx, module);
+    defineFetchNextGroup(ctx, module);
+    defineSelectGroupKeyColumn(ctx, module);
+    defineDestroyGroupTable(ctx, module);
+
     defineResetTupleDatum(ctx, module);
     defineReadTupleDatum(ctx, module);
     defineWriteTupleDatum(ctx, module);
@@ -1004,6 +1013,154 @@ static JitContext* JitAggregateRangeSelectCodegen(
     return jit_context;
 }
 
+/** @brief Generates code for range SELECT query with GROUP BY aggregate. */
+static JitContext* JitGroupedAggregateRangeSelectCodegen(
+    const Query* query, const char* query_string, JitRangeSelectPlan* plan)
+{
+    MOT_LOG_DEBUG("Generating code for MOT grouped aggregate range select at thread %p", (void*)pthread_self());
+
+    GsCodeGen* code_gen = SetupCodegenEnv();
+    if (code_gen == nullptr) {
+        return nullptr;
+    }
+    GsCodeGen::LlvmBuilder builder(code_gen->context());
+
+    MOT::Table* table = plan->_index_scan._table;
+    int index_id = plan->_index_scan._index_id;
+    JitLlvmCodeGenContext cg_ctx = {0};
+    if (!InitCodeGenContext(&cg_ctx, code_gen, &builder, table, table->GetIndex(index_id))) {
+        return nullptr;
+    }
+    JitLlvmCodeGenContext* ctx = &cg_ctx;
+
+    // prepare the jitted function (declare, get arguments into context and define locals)
+    CreateJittedFunction(ctx, "MotJittedGroupedAggregateRangeSelect");
+    IssueDebugLog("Starting execution of jitted grouped aggregate range SELECT");
+
+    // clear tuple even if no group is reported later
+    AddExecClearTuple(ctx);
+
+    // emit code to cleanup groups of a previous unfinished scan in case this is a new scan
+    JIT_IF_BEGIN(cleanup_old_groups)
+    JIT_IF_EVAL(ctx->isNewScanValue)
+    IssueDebugLog("Destroying group table due to new scan");
+    AddDestroyGroupTable(ctx);
+    JIT_IF_END()
+
+    // the first call aggregates all rows into the group table, and then each call reports one group
+    int max_arg = 0;
+    MOT::AccessType access_mode = query->hasForUpdate ? MOT::AccessType::RD_FOR_UPDATE : MOT::AccessType::RD;
+    JitIndexScanDirection indexScanDirection = plan->_index_scan._scan_direction;
+
+    JIT_IF_BEGIN(build_group_table)
+    llvm::Value* is_group_table_null = AddIsGroupTableNull(ctx);
+    JIT_IF_EVAL(is_group_table_null)
+    IssueDebugLog("Aggregating rows into group table");
+    AddPrepareGroupTable(ctx);
+    AddResetStateLimitCounter(ctx);
+
+    // build range iterators
+    MOT_LOG_DEBUG("Generating range cursor for grouped aggregate range SELECT query");
+    JitLlvmRuntimeCursor cursor =
+        buildRangeCursor(ctx, &plan->_index_scan, &max_arg, JIT_RANGE_SCAN_MAIN, indexScanDirection, nullptr);
+    if (cursor.begin_itr == nullptr) {
+        MOT_LOG_TRACE(
+            "Failed to generate jitted code for grouped aggregate range SELECT query: unsupported WHERE clause type");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+
+    JIT_WHILE_BEGIN(cursor_group_loop)
+    llvm::Value* res = AddIsScanEnd(ctx, indexScanDirection, &cursor, JIT_RANGE_SCAN_MAIN);
+    JIT_WHILE_EVAL_NOT(res)
+    llvm::Value* row = buildGetRowFromIterator(
+        ctx, JIT_WHILE_POST_BLOCK(), access_mode, indexScanDirection, &cursor, JIT_RANGE_SCAN_MAIN);
+
+    // check for additional filters, if not try to fetch next row
+    if (!buildFilterRow(ctx, row, &plan->_index_scan._filters, &max_arg, JIT_WHILE_COND_BLOCK())) {
+        MOT_LOG_TRACE("Failed to generate jitted code for grouped aggregate range SELECT query: unsupported filter");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+
+    // select the group of the row by its grouping key, and prepare aggregation state for a new group
+    for (int i = 0; i < plan->_group_by._column_count; ++i) {
+        const JitGroupByColumn* column = &plan->_group_by._columns[i];
+        llvm::Value* key = AddReadDatumColumn(ctx, ctx->table_value, row, column->_table_column_id, 0);
+        AddSetGroupKeyColumn(ctx, i, column->_column_type, key);
+    }
+    JIT_IF_BEGIN(new_group)
+    llvm::Value* is_new_group = AddSelectGroup(ctx);
+    JIT_IF_EVAL(is_new_group)
+    if (!prepareAggregate(ctx, &plan->_aggregate)) {
+        MOT_LOG_TRACE(
+            "Failed to generate jitted code for grouped aggregate range SELECT query: failed to prepare aggregate");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+    JIT_IF_END()
+
+    // aggregate into the group
+    if (!buildAggregateRow(ctx, &plan->_aggregate, row, JIT_WHILE_COND_BLOCK())) {
+        MOT_LOG_TRACE("Failed to generate jitted code for grouped aggregate range SELECT query: unsupported aggregate");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+    AddSaveGroup(ctx);
+    JIT_WHILE_END()
+
+    // cleanup
+    IssueDebugLog("Reached end of grouped aggregate range select loop");
+    AddDestroyCursor(ctx, &cursor);
+    JIT_IF_END()
+
+    // report the next group, or signal scan ended when all groups were reported
+    buildResetRowsProcessed(ctx);
+    JIT_IF_BEGIN(no_more_groups)
+    llvm::Value* group_found = AddFetchNextGroup(ctx);
+    JIT_IF_EVAL_NOT(group_found)
+    IssueDebugLog("Reported all groups, raising internal state scan end flag");
+    AddDestroyGroupTable(ctx);
+    AddSetTpProcessed(ctx);
+    AddSetScanEnded(ctx, 1);
+    JIT_RETURN_CONST(MOT::RC_OK);
+    JIT_IF_END()
+
+    // select grouping keys and wrap up aggregation of the group into the result tuple
+    for (int i = 0; i < plan->_group_by._column_count; ++i) {
+        AddSelectGroupKeyColumn(ctx, i, plan->_group_by._columns[i]._tuple_column_id);
+    }
+    buildAggregateResult(ctx, &plan->_aggregate, plan->_group_by._aggregate_tuple_column_id);
+    AddExecStoreVirtualTuple(ctx);
+    buildIncrementRowsProcessed(ctx);
+
+    // if a limit clause exists, then increment limit counter and check if reached limit (groups are counted)
+    if (plan->_limit_count > 0) {
+        AddIncrementStateLimitCounter(ctx);
+        JIT_IF_BEGIN(limit_count_reached)
+        llvm::Value* current_limit_count = AddGetStateLimitCounter(ctx);
+        JIT_IF_EVAL_CMP(current_limit_count, JIT_CONST(plan->_limit_count), JIT_ICMP_EQ);
+        IssueDebugLog("Reached limit specified in limit clause, raising internal state scan end flag");
+        AddDestroyGroupTable(ctx);
+        AddSetScanEnded(ctx, 1);
+        JIT_IF_END()
+    }
+
+    // execute *tp_processed = rows_processed
+    AddSetTpProcessed(ctx);
+
+    // return success from calling function
+    builder.CreateRet(llvm::ConstantInt::get(ctx->INT32_T, (int)MOT::RC_OK, true));
+
+    // wrap up
+    JitContext* jit_context = FinalizeCodegen(ctx, max_arg, JIT_COMMAND_AGGREGATE_RANGE_SELECT);
+
+    // cleanup
+    DestroyCodeGenContext(ctx);
+
+    return jit_context;
+}
+
 static JitContext* JitPointJoinCodegen(const Query* query, const char* query_string, JitJoinPlan* plan)
 {
     MOT_LOG_DEBUG("Generating code for MOT Point JOIN query at thread %p", (void*)pthread_self());
@@ -1518,7 +1675,10 @@ static JitContext* JitAggregateRangeJoinCodegen(Query* query, const char* query_
     // find out to which table the aggreate expression refers, and aggregate it
     // if row disqualified due to DISTINCT operator then go back to inner loop test block
     bool aggRes = false;
-    if (plan->_aggregate._table == ctx->_inner_table_info.m_table) {
+    if (plan->_aggregate._table == nullptr) {
+        // COUNT(*) counts the joined rows and reads no column, so the outer row copy is not needed
+        aggRes = buildAggregateRow(ctx, &plan->_aggregate, inner_row, JIT_WHILE_COND_BLOCK());
+    } else if (plan->_aggregate._table == ctx->_inner_table_info.m_table) {
         aggRes = buildAggregateRow(ctx, &plan->_aggregate, inner_row, JIT_WHILE_COND_BLOCK());
     } else {
         // retrieve the safe copy of the outer row
@@ -1900,6 +2060,8 @@ static JitContext* JitRangeScanCodegen(Query* query, const char* query_string, J
             JitRangeSelectPlan* range_select_plan = (JitRangeSelectPlan*)plan;
             if (range_select_plan->_aggregate._aggreaget_op == JIT_AGGREGATE_NONE) {
                 jit_context = JitRangeSelectCodegen(query, query_string, range_select_plan);
+            } else if (range_select_plan->_group_by._column_count > 0) {
+                jit_context = JitGroupedAggregateRangeSelectCodegen(query, query_string, range_select_plan);
             } else {
                 jit_context = JitAggregateRangeSelectCodegen(query, query_string, range_select_plan);
             }
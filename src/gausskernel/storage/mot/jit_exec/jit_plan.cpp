@@ -86,7 +86,8 @@ static bool countWhereClauseEqualsLeaves(Query* query, MOT::Table* table, MOT::I
         return false;                                                            \
     }
 
-static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool allowAggregate, bool allowSublink)
+static bool CheckQueryAttributes(
+    const Query* query, bool allowSorting, bool allowAggregate, bool allowSublink, bool allowGrouping = false)
 {
     checkJittableAttribute(query, hasWindowFuncs);
     checkJittableAttribute(query, hasDistinctOn);
@@ -94,7 +95,6 @@ static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool all
     checkJittableAttribute(query, hasModifyingCTE);
 
     checkJittableClause(query, returningList);
-    checkJittableClause(query, groupClause);
     checkJittableClause(query, groupingSets);
     checkJittableClause(query, havingQual);
     checkJittableClause(query, windowClause);
@@ -114,6 +114,11 @@ static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool all
         checkJittableAttribute(query, hasSubLinks);
     }
 
+    // grouped aggregation is generated only for single-table range scans (see getGroupByColumns())
+    if (!allowGrouping) {
+        checkJittableClause(query, groupClause);
+    }
+
     return true;
 }
 
@@ -732,6 +737,22 @@ static bool getTargetEntryAggregateOperator(Query* query, TargetEntry* target_en
         MOT_LOG_TRACE("getTargetEntryAggregateOperator(): Unsupported aggregate result type %d", agg_ref->aggtype);
     } else if (!isValidAggregateDistinctClause(agg_ref->aggdistinct)) {
         MOT_LOG_TRACE("getTargetEntryAggregateOperator(): Unsupported aggregate distinct clause");
+    } else if (agg_ref->aggstar) {
+        // COUNT(*) has no argument, so rows are counted without reading any column
+        if (classifyAggregateOperator(agg_ref->aggfnoid) != JIT_AGGREGATE_COUNT) {
+            MOT_LOG_TRACE("getTargetEntryAggregateOperator(): Unsupported aggregate operator %d with '*' argument",
+                agg_ref->aggfnoid);
+        } else {
+            MOT_LOG_TRACE("getTargetEntryAggregateOperator(): target entry for COUNT(*) query is jittable");
+            aggregate->_aggreaget_op = JIT_AGGREGATE_COUNT;
+            aggregate->_element_type = agg_ref->aggtype;
+            aggregate->_avg_element_type = -1;
+            aggregate->_func_id = agg_ref->aggfnoid;
+            aggregate->_table = nullptr;
+            aggregate->_table_column_id = -1;
+            aggregate->_distinct = false;
+            result = true;
+        }
     } else if (list_length(agg_ref->args) != 1) {
         MOT_LOG_TRACE(
             "getTargetEntryAggregateOperator(): Unsupported aggregate argument list with length unequal to 1");
@@ -788,6 +809,8 @@ static bool getAggregateOperator(Query* query, JitAggregate* aggregate)
             if (entry_count != 1) {
                 MOT_LOG_TRACE(
                     "getAggregateOperator(): Disqualifying query - aggregate must specify only 1 target entry");
+                result = false;
+                break;
             }
             result = getTargetEntryAggregateOperator(query, target_entry, aggregate);
         }
@@ -801,6 +824,122 @@ static bool getAggregateOperator(Query* query, JitAggregate* aggregate)
     return result;
 }
 
+static inline bool isValidGroupByColumnType(int column_type)
+{
+    // grouping keys are hashed and compared by their binary image, so only types in which equal values always have
+    // the same image are supported (unlike floating point, numeric and blank-padded character types)
+    bool result = false;
+    if ((column_type == INT1OID) || (column_type == INT2OID) || (column_type == INT4OID) ||
+        (column_type == INT8OID) || (column_type == DATEOID) || (column_type == TIMESTAMPOID) ||
+        (column_type == TEXTOID) || (column_type == VARCHAROID)) {
+        result = true;
+    }
+    return result;
+}
+
+static bool isGroupByTargetEntry(const JitGroupBy* group_by, const TargetEntry* target_entry)
+{
+    for (int i = 0; i < group_by->_column_count; ++i) {
+        if (group_by->_columns[i]._tuple_column_id == (target_entry->resno - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool getGroupByColumns(Query* query, MOT::Table* table, JitGroupBy* group_by)
+{
+    if (list_length(query->groupClause) > MOT_JIT_MAX_GROUP_BY_COLUMNS) {
+        MOT_LOG_TRACE("getGroupByColumns(): Disqualifying query - GROUP BY clause has more than %d columns",
+            MOT_JIT_MAX_GROUP_BY_COLUMNS);
+        return false;
+    }
+
+    ListCell* lc = nullptr;
+    foreach (lc, query->groupClause) {
+        SortGroupClause* sgc = (SortGroupClause*)lfirst(lc);
+        TargetEntry* te = getRefTargetEntry(query->targetList, sgc->tleSortGroupRef);
+        if (te == nullptr) {
+            MOT_LOG_TRACE("getGroupByColumns(): Cannot find TargetEntry by ref-index %d", sgc->tleSortGroupRef);
+            return false;
+        }
+
+        // grouping keys are reported from the group table, so each one must be selected as a plain column
+        if (te->resjunk) {
+            MOT_LOG_TRACE("getGroupByColumns(): Disqualifying query - GROUP BY column is not selected");
+            return false;
+        }
+        if (te->expr->type != T_Var) {
+            MOT_LOG_TRACE("getGroupByColumns(): Disqualifying query - GROUP BY expression is not a column");
+            return false;
+        }
+
+        Var* var_expr = (Var*)te->expr;
+        if (!isValidGroupByColumnType(var_expr->vartype)) {
+            MOT_LOG_TRACE(
+                "getGroupByColumns(): Disqualifying query - unsupported GROUP BY column type %d", var_expr->vartype);
+            return false;
+        }
+
+        int table_column_id = getRealColumnId(query, var_expr->varno, var_expr->varattno, table);
+        if (table_column_id <= 0) {
+            MOT_LOG_TRACE("getGroupByColumns(): Disqualifying query - invalid GROUP BY column %d", table_column_id);
+            return false;
+        }
+
+        JitGroupByColumn* column = &group_by->_columns[group_by->_column_count];
+        column->_table_column_id = table_column_id;
+        column->_tuple_column_id = te->resno - 1;
+        column->_column_type = var_expr->vartype;
+        ++group_by->_column_count;
+        MOT_LOG_TRACE("getGroupByColumns(): Found GROUP BY table column id %d, tuple column id %d",
+            column->_table_column_id,
+            column->_tuple_column_id);
+    }
+
+    return true;
+}
+
+static bool getGroupedAggregateOperator(
+    Query* query, MOT::Table* table, JitAggregate* aggregate, JitGroupBy* group_by)
+{
+    // a grouped aggregate has exactly one aggregate, and all other target entries are grouping keys
+    if (!getGroupByColumns(query, table, group_by)) {
+        return false;
+    }
+
+    ListCell* lc = nullptr;
+    foreach (lc, query->targetList) {
+        TargetEntry* target_entry = (TargetEntry*)lfirst(lc);
+        if (target_entry->expr->type == T_Aggref) {
+            if (aggregate->_aggreaget_op != JIT_AGGREGATE_NONE) {
+                MOT_LOG_TRACE("getGroupedAggregateOperator(): Disqualifying query - more than one aggregate");
+                return false;
+            }
+            if (!getTargetEntryAggregateOperator(query, target_entry, aggregate)) {
+                return false;
+            }
+            // the distinct set is kept per scan, not per group
+            if (aggregate->_distinct) {
+                MOT_LOG_TRACE("getGroupedAggregateOperator(): Disqualifying query - DISTINCT grouped aggregate");
+                return false;
+            }
+            group_by->_aggregate_tuple_column_id = target_entry->resno - 1;
+        } else if (target_entry->resjunk || !isGroupByTargetEntry(group_by, target_entry)) {
+            MOT_LOG_TRACE("getGroupedAggregateOperator(): Disqualifying query - target entry is neither aggregate nor "
+                          "GROUP BY column");
+            return false;
+        }
+    }
+
+    if (aggregate->_aggreaget_op == JIT_AGGREGATE_NONE) {
+        MOT_LOG_TRACE("getGroupedAggregateOperator(): Disqualifying query - GROUP BY without aggregate");
+        return false;
+    }
+
+    return true;
+}
+
 static double evaluatePlan(const JitRangeSelectPlan* plan)
 {
     // currently the value of a range scan plan is how much it matches the used index
@@ -1022,7 +1161,13 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
     // the limit count and aggregation can be inferred regardless of plan
     int limit_count = 0;
     JitAggregate aggregate = {JIT_AGGREGATE_NONE, 0, 0, nullptr, 0, 0, 0, false};
-    if (!getLimitCount(query, &limit_count) || !getAggregateOperator(query, &aggregate)) {
+    JitGroupBy group_by;
+    errno_t erc = memset_s(&group_by, sizeof(JitGroupBy), 0, sizeof(JitGroupBy));
+    securec_check(erc, "\0", "\0");
+    bool aggregate_valid = (query->groupClause == nullptr)
+                               ? getAggregateOperator(query, &aggregate)
+                               : getGroupedAggregateOperator(query, table, &aggregate, &group_by);
+    if (!getLimitCount(query, &limit_count) || !aggregate_valid) {
         MOT_LOG_TRACE(
             "JitPrepareRangeSelectPlan(): Disqualifying query - unsupported scan limit count or aggregate operation");
         return nullptr;
@@ -1040,6 +1185,10 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
         if (next_plan == nullptr) {
             MOT_LOG_TRACE(
                 "Failed to prepare range select plan with index %d: failed to prepare range scan plan", index_id);
+            // a hash index is just not usable for anything but a point lookup, try the other indexes
+            if (table->GetIndex(index_id)->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+                continue;
+            }
             clean_plan = true;
             break;
         }
@@ -1063,6 +1212,7 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
                                                          : JIT_INDEX_SCAN_BACKWARDS;
             next_plan->_limit_count = limit_count;
             next_plan->_aggregate = aggregate;
+            next_plan->_group_by = group_by;
             MOT_LOG_TRACE("Found a candidate plan with value %0.2f:", evaluatePlan(next_plan));
             JitExplainPlan(query, (JitPlan*)next_plan);
             if (plan == nullptr) {
@@ -1151,8 +1301,11 @@ static JitPlan* JitPrepareSimplePlan(Query* query)
                     plan = JitPrepareRangeUpdatePlan(query, table);
                 }
             } else if (query->commandType == CMD_SELECT) {
-                if (!CheckQueryAttributes(
-                        query, true, true, false)) {  // range select can specify sort clause or aggregate clause
+                if (!CheckQueryAttributes(query,
+                        true,
+                        true,
+                        false,
+                        true)) {  // range select can specify sort clause, aggregate clause or group clause
                     MOT_LOG_TRACE(
                         "JitPrepareSimplePlan(): Disqualifying range select query - Invalid query attributes");
                 } else {
@@ -167,6 +167,9 @@ struct JitRangeSelectPlan {
 
     /** @var An aggregate function (if one is specified then only one select expression should exist). */
     JitAggregate _aggregate;
+
+    /** @var The GROUP BY columns of a grouped aggregate (if any exist then no select expression is used). */
+    JitGroupBy _group_by;
 };
 
 /** @strut Plan for JOIN queries. */
@@ -238,6 +241,14 @@ extern bool JitPlanHasSort(JitPlan* plan);
  */
 extern void JitExplainPlan(Query* query, JitPlan* plan);
 
+/**
+ * @brief Reports in a single line whether a query is JIT-eligible, and if so with which plan, aggregate, index
+ * order and limit it is to be executed.
+ * @param queryString The query text.
+ * @param plan The plan of the query, @ref MOT_READY_JIT_PLAN if cached source exists, or NULL if not jittable.
+ */
+extern void JitExplainEligibility(const char* queryString, JitPlan* plan);
+
 /**
  * @brief Releases all resources associated with a plan.
  * @param plan The plan to destroy.
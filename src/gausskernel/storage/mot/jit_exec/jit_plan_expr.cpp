@@ -144,9 +144,16 @@ void RangeScanExpressionCollector::EvaluateScanType()
         return;
     }
 
+    // hash indexes serve only point lookups on all the index columns
+    bool isHashIndex = (_index->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH);
+
     // if no expression was collected, this is an invalid scan (we do not support full scans yet)
     int columnCount = _index_op_count;
     if (_index_op_count == 0) {
+        if (isHashIndex) {
+            MOT_LOG_TRACE("RangeScanExpressionCollector(): Disqualifying query - full scan on hash index");
+            return;
+        }
         MOT_LOG_TRACE("RangeScanExpressionCollector(): no expression was collected, assuming full scan");
         _index_scan->_scan_type = JIT_INDEX_SCAN_FULL;
         _index_scan->_column_count = 0;
@@ -177,6 +184,12 @@ void RangeScanExpressionCollector::EvaluateScanType()
         return;
     }
 
+    if (isHashIndex && (scanType != JIT_INDEX_SCAN_POINT) &&
+        ((scanType != JIT_INDEX_SCAN_CLOSED) || (columnCount != _index->GetNumFields()))) {
+        MOT_LOG_TRACE("RangeScanExpressionCollector(): Disqualifying query - range scan on hash index");
+        return;
+    }
+
     // final step: verify we have no holes in the columns according to the expected scan type
     if (!ScanHasHoles(scanType)) {
         _index_scan->_scan_type = scanType;
@@ -1409,6 +1422,10 @@ bool getRangeSearchExpressions(
     } else {
         Node* quals = query->jointree->quals;
         if (quals == nullptr) {
+            if (index->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+                MOT_LOG_TRACE("No range search expressions collected (empty WHERE clause) - cannot scan hash index");
+                return true;  // scan type remains invalid
+            }
             MOT_LOG_TRACE("No range search expressions collected (empty WHERE clause) - using a full index scan");
             index_scan->_scan_type = JIT_INDEX_SCAN_FULL;
             return true;
@@ -436,10 +436,13 @@ struct JitAggregate {
     /** @var The aggregate function identifier. */
     int _func_id;
 
-    /** @var The table column id to aggregate (we always aggregate into slot tuple column id 0). */
+    /**
+     * @var The table column id to aggregate (we always aggregate into slot tuple column id 0), or -1 for COUNT(*),
+     * in which case no column is read.
+     */
     int _table_column_id;
 
-    /** @var The table to which the aggregated column belongs (required if this is in JOIN). */
+    /** @var The table to which the aggregated column belongs (required if this is in JOIN), null for COUNT(*). */
     MOT::Table* _table;
 
     /** @var The type of the aggregated value. */
@@ -455,6 +458,30 @@ struct JitAggregate {
     bool _distinct;
 };
 
+/** @struct Specifies a single GROUP BY column. */
+struct JitGroupByColumn {
+    /** @var The table column id of the grouping key. */
+    int _table_column_id;
+
+    /** @var The zero-based result tuple column into which the grouping key is selected. */
+    int _tuple_column_id;
+
+    /** @var The type of the grouping key. */
+    int _column_type;
+};
+
+/** @struct Specifies grouped aggregation parameters. */
+struct JitGroupBy {
+    /** @var The number of grouping keys (zero if the query has no GROUP BY clause). */
+    int _column_count;
+
+    /** @var The grouping keys, in GROUP BY clause order. */
+    JitGroupByColumn _columns[MOT_JIT_MAX_GROUP_BY_COLUMNS];
+
+    /** @var The zero-based result tuple column into which the aggregate of each group is written. */
+    int _aggregate_tuple_column_id;
+};
+
 /** @struct Specifies join of an outer column with an inner column. */
 struct JitJoinExpr {
     /** @var The outer column identifier. */
@@ -61,6 +61,12 @@ public:
         m_invokeQueryCount.AddSample();
     }
 
+    /** @brief Updates the successful JIT query execution count statistics of stored procedure (SPI) queries. */
+    inline void AddExecSpiQuery()
+    {
+        m_execSpiQueryCount.AddSample();
+    }
+
     /** @brief Updates the failed JIT query execution count statistics. */
     inline void AddExecFailQuery()
     {
@@ -80,6 +86,9 @@ private:
     /** @var The successful JIT query invocation count statistic variable. */
     MOT::FrequencyStatisticVariable m_invokeQueryCount;
 
+    /** @var The successful JIT query execution count statistic variable of stored procedure queries. */
+    MOT::FrequencyStatisticVariable m_execSpiQueryCount;
+
     /** @var The failed JIT query execution count statistic variable. */
     MOT::FrequencyStatisticVariable m_execFailQueryCount;
 
@@ -280,6 +289,15 @@ public:
         }
     }
 
+    /** @brief Records a JIT query execution issued by a stored procedure. */
+    inline void AddExecSpiQuery()
+    {
+        JitThreadStatistics* jts = GetCurrentThreadStatistics<JitThreadStatistics>();
+        if (jts != nullptr) {
+            jts->AddExecSpiQuery();
+        }
+    }
+
     /** @brief Records a insert-row event. */
     inline void AddFailExecQuery()
     {
@@ -2136,8 +2136,11 @@ bool buildAggregateRow(JitTvmCodeGenContext* ctx, JitAggregate* aggregate, Instr
 {
     bool result = false;
 
-    // extract the aggregated column
-    Expression* expr = AddReadDatumColumn(ctx, aggregate->_table, row, aggregate->_table_column_id, 0);
+    // extract the aggregated column (COUNT(*) only counts rows, so no column is read)
+    Expression* expr = nullptr;
+    if (aggregate->_table_column_id >= 0) {
+        expr = AddReadDatumColumn(ctx, aggregate->_table, row, aggregate->_table_column_id, 0);
+    }
 
     // we first check if we have DISTINCT modifier
     if (aggregate->_distinct) {
@@ -2163,17 +2166,17 @@ bool buildAggregateRow(JitTvmCodeGenContext* ctx, JitAggregate* aggregate, Instr
     return result;
 }
 
-void buildAggregateResult(JitTvmCodeGenContext* ctx, const JitAggregate* aggregate)
+void buildAggregateResult(JitTvmCodeGenContext* ctx, const JitAggregate* aggregate, int tuple_colid /* = 0 */)
 {
     // in case of average we compute it when aggregate loop is done
     if (aggregate->_aggreaget_op == JIT_AGGREGATE_AVG) {
         Instruction* avg_value = AddComputeAvgFromArray(
             ctx, aggregate->_avg_element_type);  // we infer this during agg op analysis, but don't save it...
-        AddWriteTupleDatum(ctx, 0, avg_value);   // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, tuple_colid, avg_value);  // slot tuple 0 unless grouped
     } else {
         Expression* count_expr = AddGetAggValue(ctx);
         Instruction* count_value = buildExpression(ctx, count_expr);
-        AddWriteTupleDatum(ctx, 0, count_value);  // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, tuple_colid, count_value);  // slot tuple 0 unless grouped
     }
 
     // we take the opportunity to cleanup as well
@@ -81,7 +81,7 @@ bool prepareAggregate(JitTvmCodeGenContext* ctx, JitAggregate* aggregate);
 bool buildAggregateRow(
     JitTvmCodeGenContext* ctx, JitAggregate* aggregate, tvm::Instruction* row, tvm::BasicBlock* next_block);
 
-void buildAggregateResult(JitTvmCodeGenContext* ctx, const JitAggregate* aggregate);
+void buildAggregateResult(JitTvmCodeGenContext* ctx, const JitAggregate* aggregate, int tuple_colid = 0);
 
 void buildCheckLimit(JitTvmCodeGenContext* ctx, int limit_count);
 
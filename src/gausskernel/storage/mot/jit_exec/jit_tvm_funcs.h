@@ -2628,6 +2628,190 @@ private:
     int _element_type;
 };
 
+/** @class PrepareGroupTableInstruction */
+class PrepareGroupTableInstruction : public tvm::Instruction {
+public:
+    PrepareGroupTableInstruction() : Instruction(tvm::Instruction::Void)
+    {}
+
+    ~PrepareGroupTableInstruction() final
+    {}
+
+    uint64_t Exec(tvm::ExecContext* exec_context) final
+    {
+        prepareGroupTable();
+        return (uint64_t)MOT::RC_OK;
+    }
+
+    void Dump() final
+    {
+        (void)fprintf(stderr, "prepareGroupTable()");
+    }
+};
+
+/** @class IsGroupTableNullInstruction */
+class IsGroupTableNullInstruction : public tvm::Instruction {
+public:
+    IsGroupTableNullInstruction()
+    {}
+
+    ~IsGroupTableNullInstruction() final
+    {}
+
+protected:
+    uint64_t ExecImpl(tvm::ExecContext* exec_context) final
+    {
+        return (uint64_t)isGroupTableNull();
+    }
+
+    void DumpImpl() final
+    {
+        (void)fprintf(stderr, "isGroupTableNull()");
+    }
+};
+
+/** @class SetGroupKeyColumnInstruction */
+class SetGroupKeyColumnInstruction : public tvm::Instruction {
+public:
+    SetGroupKeyColumnInstruction(int key_index, int key_type, tvm::Expression* value)
+        : Instruction(tvm::Instruction::Void), _key_index(key_index), _key_type(key_type), _value(value)
+    {}
+
+    ~SetGroupKeyColumnInstruction() final
+    {
+        _value = nullptr;
+    }
+
+    uint64_t Exec(tvm::ExecContext* exec_context) final
+    {
+        Datum value = (Datum)_value->eval(exec_context);
+        setGroupKeyColumn(_key_index, _key_type, value);
+        return (uint64_t)MOT::RC_OK;
+    }
+
+    void Dump() final
+    {
+        (void)fprintf(stderr, "setGroupKeyColumn(key_index=%d, key_type=%d, ", _key_index, _key_type);
+        _value->dump();
+        (void)fprintf(stderr, ")");
+    }
+
+private:
+    int _key_index;
+    int _key_type;
+    tvm::Expression* _value;
+};
+
+/** @class SelectGroupInstruction */
+class SelectGroupInstruction : public tvm::Instruction {
+public:
+    SelectGroupInstruction()
+    {}
+
+    ~SelectGroupInstruction() final
+    {}
+
+protected:
+    uint64_t ExecImpl(tvm::ExecContext* exec_context) final
+    {
+        return (uint64_t)selectGroup();
+    }
+
+    void DumpImpl() final
+    {
+        (void)fprintf(stderr, "selectGroup()");
+    }
+};
+
+/** @class SaveGroupInstruction */
+class SaveGroupInstruction : public tvm::Instruction {
+public:
+    SaveGroupInstruction() : Instruction(tvm::Instruction::Void)
+    {}
+
+    ~SaveGroupInstruction() final
+    {}
+
+    uint64_t Exec(tvm::ExecContext* exec_context) final
+    {
+        saveGroup();
+        return (uint64_t)MOT::RC_OK;
+    }
+
+    void Dump() final
+    {
+        (void)fprintf(stderr, "saveGroup()");
+    }
+};
+
+/** @class FetchNextGroupInstruction */
+class FetchNextGroupInstruction : public tvm::Instruction {
+public:
+    FetchNextGroupInstruction()
+    {}
+
+    ~FetchNextGroupInstruction() final
+    {}
+
+protected:
+    uint64_t ExecImpl(tvm::ExecContext* exec_context) final
+    {
+        return (uint64_t)fetchNextGroup();
+    }
+
+    void DumpImpl() final
+    {
+        (void)fprintf(stderr, "fetchNextGroup()");
+    }
+};
+
+/** @class SelectGroupKeyColumnInstruction */
+class SelectGroupKeyColumnInstruction : public tvm::Instruction {
+public:
+    SelectGroupKeyColumnInstruction(int key_index, int tuple_colid)
+        : Instruction(tvm::Instruction::Void), _key_index(key_index), _tuple_colid(tuple_colid)
+    {}
+
+    ~SelectGroupKeyColumnInstruction() final
+    {}
+
+    uint64_t Exec(tvm::ExecContext* exec_context) final
+    {
+        selectGroupKeyColumn(exec_context->_slot, _key_index, _tuple_colid);
+        return (uint64_t)MOT::RC_OK;
+    }
+
+    void Dump() final
+    {
+        (void)fprintf(stderr, "selectGroupKeyColumn(%%slot, key_index=%d, tuple_colid=%d)", _key_index, _tuple_colid);
+    }
+
+private:
+    int _key_index;
+    int _tuple_colid;
+};
+
+/** @class DestroyGroupTableInstruction */
+class DestroyGroupTableInstruction : public tvm::Instruction {
+public:
+    DestroyGroupTableInstruction() : Instruction(tvm::Instruction::Void)
+    {}
+
+    ~DestroyGroupTableInstruction() final
+    {}
+
+    uint64_t Exec(tvm::ExecContext* exec_context) final
+    {
+        destroyGroupTable();
+        return (uint64_t)MOT::RC_OK;
+    }
+
+    void Dump() final
+    {
+        (void)fprintf(stderr, "destroyGroupTable()");
+    }
+};
+
 /** @class ResetTupleDatumInstruction */
 class ResetTupleDatumInstruction : public tvm::Instruction {
 public:
@@ -3133,6 +3317,46 @@ inline void AddDestroyDistinctSet(JitTvmCodeGenContext* ctx, int element_type)
     (void)ctx->_builder->addInstruction(new (std::nothrow) DestroyDistinctSetInstruction(element_type));
 }
 
+inline void AddPrepareGroupTable(JitTvmCodeGenContext* ctx)
+{
+    (void)ctx->_builder->addInstruction(new (std::nothrow) PrepareGroupTableInstruction());
+}
+
+inline tvm::Instruction* AddIsGroupTableNull(JitTvmCodeGenContext* ctx)
+{
+    return ctx->_builder->addInstruction(new (std::nothrow) IsGroupTableNullInstruction());
+}
+
+inline void AddSetGroupKeyColumn(JitTvmCodeGenContext* ctx, int key_index, int key_type, tvm::Expression* value)
+{
+    (void)ctx->_builder->addInstruction(new (std::nothrow) SetGroupKeyColumnInstruction(key_index, key_type, value));
+}
+
+inline tvm::Instruction* AddSelectGroup(JitTvmCodeGenContext* ctx)
+{
+    return ctx->_builder->addInstruction(new (std::nothrow) SelectGroupInstruction());
+}
+
+inline void AddSaveGroup(JitTvmCodeGenContext* ctx)
+{
+    (void)ctx->_builder->addInstruction(new (std::nothrow) SaveGroupInstruction());
+}
+
+inline tvm::Instruction* AddFetchNextGroup(JitTvmCodeGenContext* ctx)
+{
+    return ctx->_builder->addInstruction(new (std::nothrow) FetchNextGroupInstruction());
+}
+
+inline void AddSelectGroupKeyColumn(JitTvmCodeGenContext* ctx, int key_index, int tuple_colid)
+{
+    (void)ctx->_builder->addInstruction(new (std::nothrow) SelectGroupKeyColumnInstruction(key_index, tuple_colid));
+}
+
+inline void AddDestroyGroupTable(JitTvmCodeGenContext* ctx)
+{
+    (void)ctx->_builder->addInstruction(new (std::nothrow) DestroyGroupTableInstruction());
+}
+
 inline void AddWriteTupleDatum(JitTvmCodeGenContext* ctx, int tuple_colid, tvm::Instruction* datum_value)
 {
     (void)ctx->_builder->addInstruction(new (std::nothrow) WriteTupleDatumInstruction(tuple_colid, datum_value));
@@ -582,6 +582,11 @@ void PerformMotCheckpointFetch()
             /* send the checkpoint dir */
             sendDir(fullChkptDir, (int)basePathLen, false, NIL, false);
 
+            /* send the checkpoint dirs the current delta checkpoint depends on */
+            for (uint32_t i = 0; MOTCheckpointChainDir(i, fullChkptDir, MAXPGPATH); i++) {
+                sendDir(fullChkptDir, (int)basePathLen, false, NIL, false);
+            }
+
             /* CopyDone */
             pq_putemptymessage_noblock('c');
         }
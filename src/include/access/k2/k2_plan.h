@@ -41,6 +41,10 @@ bool K2PgIsSingleRowModify(PlannedStmt *pstmt);
 
 bool K2PgIsSingleRowUpdateOrDelete(ModifyTable *modifyTable);
 
+bool K2PgIsBulkUpdateOrDelete(ModifyTable *modifyTable);
+
+bool K2PgIsNativeUpsert(ModifyTable *modifyTable);
+
 bool K2PgAllPrimaryKeysProvided(Oid relid, Bitmapset *attrs);
 
 #endif // K2_PLAN_H
@@ -54,6 +54,46 @@ extern void K2PgExecuteInsertIndex(Relation rel,
 								  bool *isnull,
 								  Datum k2pgctid);
 
+/*
+ * Pipelined insert of many tuples, e.g. for COPY FROM. Rows of the table and of
+ * its secondary indexes are sent with a bounded number of writes in flight, so
+ * errors may only be reported by a later call or by K2PgEndBulkInsert, which
+ * must be called before AFTER triggers fire. Each row carries a caller tag
+ * (e.g. the COPY line number), errorRow is called with the tag of the failing
+ * row right before its error is raised.
+ */
+typedef struct K2PgBulkInsertState K2PgBulkInsertState;
+typedef void (*K2PgBulkInsertErrorRowHook)(void *arg, uint64 tag);
+
+extern K2PgBulkInsertState *K2PgBeginBulkInsert(ResultRelInfo *resultRelInfo,
+                                                K2PgBulkInsertErrorRowHook errorRow,
+                                                void *errorArg);
+
+extern void K2PgBulkInsertTuple(K2PgBulkInsertState *state,
+                                TupleTableSlot *slot,
+                                HeapTuple tuple,
+                                EState *estate,
+                                uint64 tag);
+
+extern void K2PgEndBulkInsert(K2PgBulkInsertState *state);
+
+/*
+ * INSERT ... ON DUPLICATE KEY UPDATE or UPDATE NOTHING that writes the row only
+ * if its key does not exist instead of checking the unique indexes first, see
+ * K2PgIsNativeUpsert. K2PgBeginUpsert returns NULL if the statement or the
+ * relation does not qualify. K2PgUpsertTuple returns true if the row was
+ * inserted, false if an existing row was updated or left as it is.
+ */
+typedef struct K2PgUpsertState K2PgUpsertState;
+
+extern K2PgUpsertState *K2PgBeginUpsert(ModifyTableState *mtstate, EState *estate);
+
+extern bool K2PgUpsertTuple(K2PgUpsertState *state,
+                            TupleTableSlot *slot,
+                            HeapTuple tuple,
+                            EState *estate,
+                            bool canSetTag);
+
 /*
  * Delete a tuple (identified by k2pgctid) from a K2PG table.
  * If this is a single row op we will return false in the case that there was
@@ -64,6 +104,26 @@ extern bool K2PgExecuteDelete(Relation rel,
 							 TupleTableSlot *slot,
 							 EState *estate,
 							 ModifyTableState *mtstate);
+/*
+ * Pipelined update or delete of the rows produced by the scan of a set-based
+ * UPDATE or DELETE, see K2PgIsBulkUpdateOrDelete. K2PgBeginBulkModify returns
+ * NULL if the rows must be modified one at a time instead. Each row is counted
+ * as modified when it is sent, and K2PgEndBulkModify, which reports any write
+ * error, must be called before AFTER STATEMENT triggers fire.
+ */
+typedef struct K2PgBulkModifyState K2PgBulkModifyState;
+
+extern K2PgBulkModifyState *K2PgBeginBulkModify(ModifyTableState *mtstate, EState *estate);
+
+extern bool K2PgBulkDeleteTuple(K2PgBulkModifyState *state, TupleTableSlot *slot);
+
+extern bool K2PgBulkUpdateTuple(K2PgBulkModifyState *state,
+                                TupleTableSlot *slot,
+                                HeapTuple tuple,
+                                Bitmapset *updatedCols);
+
+extern void K2PgEndBulkModify(K2PgBulkModifyState *state);
+
 /*
  * Delete a tuple (identified by index columns and base table k2pgctid) from an
  * index's backing K2PG index table.
@@ -44,6 +44,18 @@ public:
     }
 };
 
+// TxnManager rejects the writes of a transaction marked read-only with a 405 carrying this message.
+// SKV uses 405 for bugs in K2 usage otherwise
+constexpr const char* K2_READ_ONLY_TXN_MESSAGE = "cannot write in a read-only transaction";
+
+inline skv::http::Status ReadOnlyTxnStatus() {
+    return skv::http::Statuses::S405_Method_Not_Allowed(K2_READ_ONLY_TXN_MESSAGE);
+}
+
+inline bool IsReadOnlyTxnStatus(const skv::http::Status& status) {
+    return status.code == 405 && status.message == K2_READ_ONLY_TXN_MESSAGE;
+}
+
 Status K2StatusToK2PgStatus(skv::http::Status&& status);
 
 }  // namespace k2pg
@@ -40,7 +40,7 @@ extern void K2FinishInitDB();
 /*  Database Functions -------------------------------------------------------------------------- */
 
 extern void K2PgCreateDatabase(
-	Oid dboid, const char *dbname, Oid src_dboid, Oid next_oid);
+	Oid dboid, const char *dbname, Oid src_dboid, Oid next_oid, const K2PgCollectionOptions *options);
 
 extern void K2PgDropDatabase(Oid dboid, const char *dbname);
 
@@ -57,6 +57,8 @@ extern void K2PgCreateTable(CreateStmt *stmt,
 
 extern void K2PgDropTable(Oid relationId);
 
+extern void K2PgTruncateTable(Relation rel);
+
 extern void K2PgCreateIndex(const char *indexName,
 						   IndexInfo *indexInfo,
 						   TupleDesc indexTupleDesc,
@@ -78,6 +78,13 @@ typedef struct CamScanDescData
 	 *   execution in K2 node.
 	 */
 	K2PgSelectLimitParams exec_params;
+
+	/*
+	 * Counters for EXPLAIN ANALYZE: rows passing the scan keys rechecked here,
+	 * heap fetches done through the index and the work of earlier scans of a
+	 * rescanned index. The remote work of the current scan lives in the handle.
+	 */
+	K2PgScanStats stats;
 } CamScanDescData;
 
 typedef struct CamScanDescData *CamScanDesc;
@@ -124,6 +131,9 @@ IndexTuple cam_getnext_indextuple(CamScanDesc camScan, bool is_forward_scan, boo
 
 void camEndScan(CamScanDesc camScan);
 
+/* Collect the remote work done by the scan so far, for EXPLAIN ANALYZE */
+void camGetScanStats(CamScanDesc camScan, K2PgScanStats *stats);
+
 /* Number of rows assumed for a K2PG table if no size estimates exist */
 #define K2PG_DEFAULT_NUM_ROWS  1000
 
@@ -162,7 +172,7 @@ extern void camIndexCostEstimate(IndexPath *path, Selectivity *selectivity,
 /*
  * Fetch a single tuple by the k2pgctid.
  */
-extern HeapTuple CamFetchTuple(Relation relation, Datum k2pgctid);
+extern HeapTuple CamFetchTuple(Relation relation, Datum k2pgctid, K2PgScanStats *stats = NULL);
 
 
 
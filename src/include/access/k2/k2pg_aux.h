@@ -131,6 +131,13 @@ extern void	HandleK2PgStatus(const K2PgStatus& status);
  */
 extern void HandleK2PgStatusIgnoreNotFound(const K2PgStatus& status, bool *not_found);
 
+/*
+ * Same as HandleK2PgStatus but report a failed insert precondition as a
+ * unique violation of the primary key of the given relation, the way
+ * PostgreSQL words it.
+ */
+extern void HandleK2PgStatusForRelation(const K2PgStatus& status, Oid relationId);
+
 /*
  * Same as HandleK2PgStatus but also ask the given resource owner to forget
  * the given K2PG statement.
@@ -20,6 +20,8 @@
 #include <execinfo.h>
 #include <k2/logging/Log.h>
 
+#include "access/k2/op_metrics.h"
+
 namespace k2log {
 inline thread_local k2::logging::Logger k2pg("k2::pg");
 
@@ -130,41 +132,36 @@ static inline void initialize(const std::string& mainLevel, const std::string& t
 
 
 namespace k2pg {
+// Measures the latency of one K2 operation. On report(), the latency is recorded in the
+// per-thread histograms of the operation type (see op_metrics.h)
 class Metric {
    public:
-    Metric(const char* name, k2::Duration warnThr) : _name(name), _warnThr(warnThr), _start(k2::Clock::now()) {}
+    explicit Metric(K2Op op) : _op(op), _start(k2::Clock::now()) {}
     Metric() {}
     Metric(Metric&& o) {
-        _name = o._name;
-        _warnThr = o._warnThr;
+        _op = o._op;
         _start = o._start;
-        o._name = "";
-        o._warnThr = k2::Duration{};
+        o._op = K2Op::Count;
         o._start = k2::TimePoint{};
     }
     Metric& operator=(Metric&& o) {
-        _name = o._name;
-        _warnThr = o._warnThr;
+        _op = o._op;
         _start = o._start;
-        o._name = "";
-        o._warnThr = k2::Duration{};
+        o._op = K2Op::Count;
         o._start = k2::TimePoint{};
         return *this;
     }
-    void report() const {
-        // if (_warnThr > 0ns) {
-        //     auto elapsed = k2::Clock::now() - _start;
-        //     if (elapsed >= _warnThr) {
-        //         K2LOG_WCT(k2log::k2pg, "Metric {} exceeded threshold {}: {}", _name, _warnThr, elapsed);
-        //     } else {
-        //         K2LOG_DCT(k2log::k2pg, "Metric {} with threshold {}: {}", _name, _warnThr, elapsed);
-        //     }
-        // }
+    void report(bool ok=true, uint64_t bytes=0, uint64_t records=0) const {
+        if (_op == K2Op::Count) {
+            // moved-from or never started
+            return;
+        }
+        auto elapsed = k2::Clock::now() - _start;
+        RecordK2Op(_op, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed), ok, bytes, records);
     }
 
    private:
-    const char* _name{""};
-    k2::Duration _warnThr;
+    K2Op _op{K2Op::Count};
     k2::TimePoint _start;
 };
 }
@@ -0,0 +1,165 @@
+/*
+MIT License
+
+Copyright(c) 2022 Futurewei Cloud
+
+    Permission is hereby granted,
+    free of charge, to any person obtaining a copy of this software and associated documentation files(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and / or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions :
+
+    The above copyright notice and this permission notice shall be included in all copies
+    or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS",
+    WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER
+    LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+// Per-operation latency instrumentation for the K2 layer.
+//
+// Every thread records into its own set of log-linear histograms (HDR style, ~12.5% relative error)
+// with relaxed atomic increments, so recording never takes a lock. The histograms of all threads are
+// registered in a process-wide registry and are summed up only when a reader asks for a snapshot,
+// e.g., the pg_stat_k2_ops view.
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace k2pg {
+
+enum class K2Op : uint8_t {
+    Read = 0,
+    Write,
+    PartialUpdate,
+    Query,
+    CreateQuery,
+    DestroyQuery,
+    BeginTxn,
+    EndTxn,
+    TxnTotal,
+    GetSchema,
+    CreateSchema,
+    CreateCollection,
+    ReserveOids,
+    CachedRead,
+    FKCheckBatch,
+    FKLookupSaved,
+    Count
+};
+
+const char* K2OpName(K2Op op);
+
+class LatencyHistogram {
+public:
+    // values are recorded in microseconds. Each power-of-two range is split into 2^SUB_BUCKET_BITS linear buckets
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    // largest tracked magnitude is 2^MAX_VALUE_BITS usecs (~12 days), larger values go to the last bucket
+    static constexpr int MAX_VALUE_BITS = 40;
+    static constexpr int BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static int bucketFor(uint64_t usecs);
+    // the value reported for a bucket: the middle of the range of values it covers
+    static uint64_t bucketValue(int bucket);
+
+    void record(uint64_t usecs) {
+        _counts[bucketFor(usecs)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t count(int bucket) const {
+        return _counts[bucket].load(std::memory_order_relaxed);
+    }
+
+    void add(const LatencyHistogram& o);
+
+    void clear();
+
+private:
+    std::atomic<uint64_t> _counts[BUCKETS]{};
+};
+
+// Aggregated (across threads) statistics for one operation type
+struct OpStatsSnapshot {
+    K2Op op;
+    uint64_t calls = 0;
+    uint64_t errors = 0;
+    uint64_t totalUsecs = 0;
+    uint64_t maxUsecs = 0;
+    uint64_t bytes = 0;
+    uint64_t records = 0;
+    std::vector<uint64_t> buckets;
+
+    // latency in usecs at the given quantile, e.g. 0.99
+    uint64_t percentile(double quantile) const;
+};
+
+// The stats recorded by a single thread for all operation types
+struct ThreadOpStats {
+    struct OpCounters {
+        LatencyHistogram latency;
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> errors{0};
+        std::atomic<uint64_t> totalUsecs{0};
+        std::atomic<uint64_t> maxUsecs{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> records{0};
+    };
+    OpCounters ops[static_cast<int>(K2Op::Count)];
+};
+
+// Record one completed operation in the histograms of the calling thread
+void RecordK2Op(K2Op op, std::chrono::nanoseconds elapsed, bool ok, uint64_t bytes = 0, uint64_t records = 0);
+
+// Sum up the stats of all threads, one entry per operation type
+std::vector<OpStatsSnapshot> GetK2OpStats();
+
+// Clear the op and schema stats of all threads, see pg_stat_reset_k2_ops()
+void ResetK2OpStats();
+
+// Requests issued by this process to one SKV schema, i.e. to the key range of one table or index in
+// the collection of its database. Unlike the per-op stats the counters are shared by all threads, but
+// each thread caches the lookup so that recording is still only relaxed atomic increments.
+struct SchemaOpCounters {
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> writes{0};
+    std::atomic<uint64_t> queryPages{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> recordsRead{0};
+    std::atomic<uint64_t> recordsWritten{0};
+    std::atomic<uint64_t> bytesRead{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    // microseconds since the epoch when counting started, for computing rates
+    std::atomic<int64_t> sinceUsecs{0};
+};
+
+struct SchemaOpStatsSnapshot {
+    std::string collection;
+    std::string schema;
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t queryPages = 0;
+    uint64_t errors = 0;
+    uint64_t recordsRead = 0;
+    uint64_t recordsWritten = 0;
+    uint64_t bytesRead = 0;
+    uint64_t bytesWritten = 0;
+    int64_t sinceUsecs = 0;
+};
+
+// The counters of a schema, created on first use and never freed
+SchemaOpCounters* GetSchemaOpCounters(const std::string& collection, const std::string& schema);
+
+// One entry per schema that was accessed by this process
+std::vector<SchemaOpStatsSnapshot> GetSchemaOpStats();
+
+} // ns
@@ -75,11 +75,21 @@ K2PgStatus PgGate_InitPrimaryCluster();
 
 K2PgStatus PgGate_FinishInitDB();
 
-// Create database.
+// Partitioning of the K2 collection of a new database, from the CREATE DATABASE options.
+// Unset fields use the pggate create_collections config of the database.
+struct K2PgCollectionOptions {
+  const char *partitioning{nullptr}; // "hash" or "range"
+  const char *range_ends{nullptr};   // comma separated end keys of the range partitions, the last one
+                                     // empty for the open end
+  int min_nodes{0};                  // nodes to spread the partitions over, 0 if unset
+};
+
+// Create database. options may be NULL.
 K2PgStatus PgGate_ExecCreateDatabase(const char *database_name,
                                  K2PgOid database_oid,
                                  K2PgOid source_database_oid,
-                                 K2PgOid next_oid);
+                                 K2PgOid next_oid,
+                                 const K2PgCollectionOptions *options);
 
 // Drop database.
 K2PgStatus PgGate_ExecDropDatabase(const char *database_name,
@@ -101,6 +111,10 @@ K2PgStatus PgGate_ReserveOids(K2PgOid database_oid,
 
 K2PgStatus PgGate_GetCatalogMasterVersion(uint64_t *version);
 
+// Whether new sessions load the essential catalog caches from a local snapshot
+// keyed by the catalog version instead of scanning the catalogs in SKV.
+bool PgGate_UseCatalogCacheSnapshot();
+
 void PgGate_InvalidateTableCache(
     const K2PgOid database_oid,
     const K2PgOid table_oid);
@@ -153,6 +167,11 @@ K2PgStatus PgGate_ExecDropTable(K2PgOid database_oid,
                             K2PgOid table_oid,
                             bool if_exist);
 
+// Deletes all rows of the table and of its secondary indexes in the current transaction, the table
+// and index definitions are kept
+K2PgStatus PgGate_ExecTruncateTable(K2PgOid database_oid,
+                            K2PgOid table_oid);
+
 K2PgStatus PgGate_GetTableDesc(K2PgOid database_oid,
                             K2PgOid table_oid,
                             K2PgTableDesc *handle);
@@ -243,6 +262,54 @@ K2PgStatus PgGate_ExecInsert(K2PgOid database_oid,
                              std::vector<K2PgAttributeDef>& columns,
                              Datum* k2pgtupleid);
 
+// Insert a row only if no row with the same key exists. A conflict is not an error, *exists is set
+// instead and the tuple id of the existing row is returned, so that the caller can update or skip it.
+K2PgStatus PgGate_ExecInsertIfNotExists(K2PgOid database_oid,
+                                        K2PgOid table_oid,
+                                        std::vector<K2PgAttributeDef>& columns,
+                                        Datum* k2pgtupleid,
+                                        bool* exists);
+
+// Row id generation for tables without primary key, see the rowid_strategy reloption. Inserts that
+// do not provide the k2pgrowid column get a random one.
+enum K2PgRowIdStrategy {
+    K2PG_ROWID_RANDOM,
+    K2PG_ROWID_TIME_ORDERED,
+    K2PG_ROWID_SHARDED
+};
+
+// Sets *rowid to a new k2pgrowid bytea datum. Only meaningful for tables without primary key, the
+// caller checks that as it has the relation at hand, so this does not load the table.
+K2PgStatus PgGate_GenerateRowId(K2PgRowIdStrategy strategy, Datum* rowid);
+
+// Pipelined insert of many rows into one table, e.g. for COPY FROM. The handle resolves the SKV
+// schema and the attribute to field layout once, and keeps up to pggate.bulk_insert_max_in_flight
+// writes outstanding while the caller encodes the following rows. Because of that a write error
+// (e.g. a duplicate key) may be returned by a later Add call or by Flush rather than by the Add
+// of the failing row.
+struct K2PgBulkInsert;
+
+// The handle is owned by the current memory context
+K2PgStatus PgGate_NewBulkInsert(K2PgOid database_oid,
+                                K2PgOid table_oid,
+                                bool upsert,
+                                K2PgBulkInsert **handle);
+
+// Encodes and sends one row. The k2pgrowid is added if the table has one and columns do not provide
+// it. tag identifies the row to the caller (e.g. the COPY line number), see PgGate_BulkInsertFailedTag.
+// k2pgtupleid may be NULL if the caller does not need the tuple id
+K2PgStatus PgGate_BulkInsertAdd(K2PgBulkInsert *handle,
+                                const std::vector<K2PgAttributeDef>& columns,
+                                uint64_t tag,
+                                Datum* k2pgtupleid);
+
+// Waits for all outstanding writes and returns the first error, if any
+K2PgStatus PgGate_BulkInsertFlush(K2PgBulkInsert *handle);
+
+// The tag of the row an error returned by PgGate_BulkInsertAdd or PgGate_BulkInsertFlush belongs to,
+// which is not the row of that Add call when the error comes from an earlier write
+uint64_t PgGate_BulkInsertFailedTag(K2PgBulkInsert *handle);
+
 // UPDATE ------------------------------------------------------------------------------------------
 K2PgStatus PgGate_ExecUpdate(K2PgOid database_oid,
                              K2PgOid table_oid,
@@ -257,6 +324,61 @@ K2PgStatus PgGate_ExecDelete(K2PgOid database_oid,
                              int* rows_affected,
                              const std::vector<K2PgAttributeDef>& columns);
 
+// BULK UPDATE AND DELETE --------------------------------------------------------------------------
+// Pipelined update or delete of rows that the caller has just scanned, addressed by their tuple id.
+// Like K2PgBulkInsert the handle resolves the SKV schema once and keeps up to
+// pggate.bulk_modify_max_in_flight writes outstanding, so a write error may be returned by a later
+// Add call or by Flush. Rows that no longer exist are not an error and are not counted as affected.
+struct K2PgBulkModify;
+
+// The handle is owned by the current memory context
+K2PgStatus PgGate_NewBulkModify(K2PgOid database_oid,
+                                K2PgOid table_oid,
+                                K2PgBulkModify **handle);
+
+// columns must contain the tuple id and, for an update, the new values of the updated columns
+K2PgStatus PgGate_BulkUpdateAdd(K2PgBulkModify *handle,
+                                const std::vector<K2PgAttributeDef>& columns);
+
+K2PgStatus PgGate_BulkDeleteAdd(K2PgBulkModify *handle,
+                                const std::vector<K2PgAttributeDef>& columns);
+
+// Waits for all outstanding writes and returns the first error, if any
+K2PgStatus PgGate_BulkModifyFlush(K2PgBulkModify *handle, uint64_t *rows_affected);
+
+// POINT OPERATIONS --------------------------------------------------------------------------------
+// Single row operations addressed by the full primary key of a table. The handle resolves the SKV
+// schema and the attribute to field layout once, so that it can be executed many times (e.g. by a
+// prepared statement) with only the bound values being serialized on each call.
+enum K2PgPointOpType {
+    K2PG_POINT_READ,
+    K2PG_POINT_INSERT,
+    K2PG_POINT_UPDATE,
+    K2PG_POINT_DELETE
+};
+
+struct K2PgPointOp;
+
+// The handle is owned by the current memory context
+K2PgStatus PgGate_NewPointOp(K2PgOid database_oid,
+                             K2PgOid table_oid,
+                             K2PgPointOpType type,
+                             K2PgPointOp **handle);
+
+// Reads the row with the given key columns. has_data is false if the row does not exist
+K2PgStatus PgGate_ExecPointRead(K2PgPointOp *handle,
+                                const std::vector<K2PgAttributeDef>& keys,
+                                int32_t natts,
+                                uint64_t *values,
+                                bool *isnulls,
+                                bool *has_data);
+
+// Inserts, updates or deletes the row addressed by the key columns. For update, the non-key
+// columns given are the ones assigned. rows_affected is 0 if the row to update or delete is missing
+K2PgStatus PgGate_ExecPointWrite(K2PgPointOp *handle,
+                                 const std::vector<K2PgAttributeDef>& columns,
+                                 int *rows_affected);
+
 // Structure to hold parameters for preparing query plan.
 //
 // Index-related parameters are used to describe different types of scan.
@@ -316,6 +438,25 @@ K2PgStatus PgGate_ExecSelect(
     bool forward_scan,
     const K2PgSelectLimitParams& limit_params);
 
+// Planner estimate of the rows a scan returns, used to bound its readahead. Must be called before
+// PgGate_ExecSelect; scans without an estimate read ahead up to pggate.scan_readahead_pages pages.
+void PgGate_SetScanEstimate(K2PgScanHandle *handle, double estimated_rows);
+
+// Remote work done on behalf of a scan, reported by EXPLAIN ANALYZE.
+struct K2PgScanStats {
+  uint64_t create_queries{0};   // createQuery calls issued
+  uint64_t query_pages{0};      // query result pages received
+  uint64_t records_received{0}; // records shipped back by K2 (query pages and point reads)
+  uint64_t records_returned{0}; // rows handed to the PG layer
+  uint64_t records_passed{0};   // rows which also passed the quals evaluated in PG, filled in by the caller
+  uint64_t point_reads{0};      // primary key reads issued for secondary index lookups
+  uint64_t bytes_received{0};   // record payload bytes received
+  uint64_t wait_usecs{0};       // time spent blocked on K2 responses
+};
+
+// Add the counters collected so far by the given scan to stats
+void PgGate_AddScanStats(const K2PgScanHandle* handle, K2PgScanStats* stats);
+
 // Transaction control -----------------------------------------------------------------------------
 K2PgStatus PgGate_BeginTransaction();
 K2PgStatus PgGate_RestartTransaction();
@@ -333,6 +474,19 @@ K2PgStatus PgGate_ExitSeparateDdlTxnMode(bool success);
 // Check if foreign key reference exists in cache.
 bool PgGate_ForeignKeyReferenceExists(K2PgOid table_oid, const char* k2pgctid, int64_t k2pgctid_size);
 
+// Batched foreign key checks. Up to pggate.fk_check_batch_size child rows (0 disables batching) are
+// collected per statement and their references are verified together.
+int PgGate_GetForeignKeyCheckBatchSize();
+
+// Checks whether the rows referenced by k2pgctids, which must be primary keys of table_oid as built by
+// PgGate_DmlBuildPgTupleId, exist. Each distinct key is read once, with up to
+// pggate.fk_check_max_in_flight reads outstanding, and the existing ones are added to the foreign key
+// reference cache. exists is parallel to k2pgctids.
+K2PgStatus PgGate_CheckForeignKeyReferences(K2PgOid database_oid,
+                                            K2PgOid table_oid,
+                                            const std::vector<std::string>& k2pgctids,
+                                            std::vector<bool>& exists);
+
 // Add an entry to foreign key reference cache.
 K2PgStatus PgGate_CacheForeignKeyReference(K2PgOid table_oid, const char* k2pgctid, int64_t k2pgctid_size);
 
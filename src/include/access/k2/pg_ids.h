@@ -51,6 +51,37 @@ class ObjectIdGenerator {
     boost::uuids::random_generator oid_generator_;
 };
 
+// How the k2pgrowid key of a table without primary key is generated (rowid_strategy reloption).
+// Row ids are binary strings, so SKV orders them bytewise.
+enum class RowIdStrategy {
+    // v4 UUID, rows are spread over the whole key space
+    kRandom,
+    // UUIDv7 layout: 48 bit unix time in milliseconds, a 12 bit sequence and random bits. Ids of a
+    // session are increasing, and ids of all sessions are ordered by their millisecond
+    kTimeOrdered,
+    // 4 byte node hash, 8 random bytes chosen per session and a 8 byte session counter, so that
+    // each session appends to its own key range
+    kSharded
+};
+
+class RowIdGenerator {
+    public:
+    RowIdGenerator() {}
+    ~RowIdGenerator() {}
+
+    std::string Next(RowIdStrategy strategy);
+
+    private:
+    std::string NextTimeOrdered();
+    std::string NextSharded();
+
+    boost::uuids::random_generator random_generator_;
+    uint64_t last_millis_ = 0;
+    uint16_t millis_seq_ = 0;
+    std::string shard_prefix_;
+    uint64_t shard_seq_ = 0;
+};
+
 // A class to identify a Postgres object by oid and the database oid it belongs to.
 class PgObjectId {
     public:
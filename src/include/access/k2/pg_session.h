@@ -94,9 +94,9 @@ public:
         fk_reference_cache_.clear();
     }
 
-    // Generate a new random and unique rowid. It is a v4 UUID.
-    std::string GenerateNewRowid() {
-        return rowid_generator_.Next(true /* binary_id */);
+    // Generate a new unique rowid, by default a random v4 UUID.
+    std::string GenerateNewRowid(RowIdStrategy strategy = RowIdStrategy::kRandom) {
+        return rowid_generator_.Next(strategy);
     }
 
 private:
@@ -115,7 +115,7 @@ private:
     std::atomic<int64_t> stmt_id_;
 
     // Rowid generator.
-    ObjectIdGenerator rowid_generator_;
+    RowIdGenerator rowid_generator_;
 };
 
 }  // namespace k2pg
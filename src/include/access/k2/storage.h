@@ -48,6 +48,51 @@ struct K2PgScanHandle {
     K2PgSelectIndexParams indexParams;
     uint32_t maxParallelReads = 5;
     bool queryInFlight = false;
+    bool queryDone = false;
+    // Query pages requested ahead of the one being returned, 0 to request them on demand
+    uint32_t readaheadPages = 1;
+    uint64_t readaheadMaxBytes = 0;
+    uint64_t lastPageRecords = 0;
+    uint64_t lastPageBytes = 0;
+    double estimatedRows = 0;
+    K2PgScanStats stats;
+};
+
+struct K2PgPointOp {
+    K2PgPointOpType type;
+    std::string collectionName;
+    std::shared_ptr<skv::http::dto::Schema> schema;
+    std::shared_ptr<k2pg::PgTableDesc> table;
+    uint32_t tableId = 0;
+    uint32_t indexId = 0;
+    // SKV field offset indexed by attr_num, -1 for attributes without a field
+    std::vector<int> attrToField;
+};
+
+struct K2PgBulkInsert {
+    std::string collectionName;
+    std::shared_ptr<skv::http::dto::Schema> schema;
+    std::shared_ptr<k2pg::PgTableDesc> table;
+    uint32_t tableId = 0;
+    uint32_t indexId = 0;
+    std::unordered_map<int, uint32_t> attrToField;
+    bool upsert = false;
+    bool hasRowId = false;
+    uint32_t maxInFlight = 64;
+    // outstanding writes with the tag of their row, oldest first
+    std::deque<std::pair<boost::future<skv::http::Response<>>, uint64_t>> inFlight;
+    K2PgStatus firstError = K2PgStatus::OK;
+    uint64_t failedTag = 0;
+};
+
+struct K2PgBulkModify {
+    std::string collectionName;
+    std::shared_ptr<skv::http::dto::Schema> schema;
+    std::shared_ptr<k2pg::PgTableDesc> table;
+    uint32_t maxInFlight = 64;
+    std::deque<boost::future<skv::http::Response<>>> inFlight;
+    K2PgStatus firstError = K2PgStatus::OK;
+    uint64_t rowsAffected = 0;
 };
 
 namespace k2pg {
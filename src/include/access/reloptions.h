@@ -273,6 +273,7 @@ extern void ForbidUserToSetUnsupportedOptions(
     List* options, const char* optnames[], int numoptnames, const char* detail);
 extern void ForbidToSetOptionsForColTbl(List* options);
 extern void ForbidToSetTdeOptionsForNonTdeTbl(List* options);
+extern void ForbidToSetRowIdStrategyOption(List* options, const char* detail);
 extern void ForbidToAlterOptionsForTdeTbl(List* options);
 extern void ForbidToSetOptionsForUstoreTbl(List *options);
 extern void ForbidToSetOptionsForRowTbl(List* options);
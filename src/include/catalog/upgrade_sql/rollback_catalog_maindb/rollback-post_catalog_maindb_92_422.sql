@@ -0,0 +1,2 @@
+DROP VIEW IF EXISTS dbe_perf.global_k2_ops CASCADE;
+DROP VIEW IF EXISTS pg_catalog.pg_stat_k2_ops CASCADE;
@@ -0,0 +1,5 @@
+-- ----------------------------------------------------------------
+-- rollback pg_stat_get_k2_ops and pg_stat_reset_k2_ops
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_reset_k2_ops() CASCADE;
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_get_k2_ops(OUT op text, OUT calls int8, OUT errors int8, OUT total_us int8, OUT p50_us int8, OUT p99_us int8, OUT p999_us int8, OUT max_us int8, OUT bytes int8, OUT records int8) CASCADE;
@@ -0,0 +1,4 @@
+-- ----------------------------------------------------------------
+-- rollback mot_session_jit_detail
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.mot_session_jit_detail(OUT exec_count int8, OUT exec_spi_count int8) CASCADE;
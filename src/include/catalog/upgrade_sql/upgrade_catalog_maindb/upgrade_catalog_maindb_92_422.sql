@@ -0,0 +1,10 @@
+-- ----------------------------------------------------------------
+-- upgrade pg_stat_get_k2_ops and pg_stat_reset_k2_ops
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_get_k2_ops(OUT op text, OUT calls int8, OUT errors int8, OUT total_us int8, OUT p50_us int8, OUT p99_us int8, OUT p999_us int8, OUT max_us int8, OUT bytes int8, OUT records int8) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 10045;
+CREATE FUNCTION pg_catalog.pg_stat_get_k2_ops(OUT op text, OUT calls int8, OUT errors int8, OUT total_us int8, OUT p50_us int8, OUT p99_us int8, OUT p999_us int8, OUT max_us int8, OUT bytes int8, OUT records int8) RETURNS SETOF record LANGUAGE INTERNAL VOLATILE ROWS 100 as 'pg_stat_get_k2_ops';
+
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_reset_k2_ops() CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 10047;
+CREATE FUNCTION pg_catalog.pg_stat_reset_k2_ops() RETURNS void LANGUAGE INTERNAL VOLATILE as 'pg_stat_reset_k2_ops';
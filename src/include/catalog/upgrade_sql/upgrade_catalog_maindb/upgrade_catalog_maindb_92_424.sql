@@ -0,0 +1,6 @@
+-- ----------------------------------------------------------------
+-- upgrade pg_stat_get_k2_schemas
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_get_k2_schemas(OUT collection text, OUT schema text, OUT datid oid, OUT relid oid, OUT reads int8, OUT writes int8, OUT query_pages int8, OUT errors int8, OUT records_read int8, OUT records_written int8, OUT bytes_read int8, OUT bytes_written int8, OUT since timestamptz) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 10046;
+CREATE FUNCTION pg_catalog.pg_stat_get_k2_schemas(OUT collection text, OUT schema text, OUT datid oid, OUT relid oid, OUT reads int8, OUT writes int8, OUT query_pages int8, OUT errors int8, OUT records_read int8, OUT records_written int8, OUT bytes_read int8, OUT bytes_written int8, OUT since timestamptz) RETURNS SETOF record LANGUAGE INTERNAL VOLATILE ROWS 100 as 'pg_stat_get_k2_schemas';
@@ -0,0 +1,8 @@
+DROP VIEW IF EXISTS pg_catalog.pg_stat_k2_ops CASCADE;
+CREATE OR REPLACE VIEW pg_catalog.pg_stat_k2_ops AS
+    SELECT * FROM pg_catalog.pg_stat_get_k2_ops();
+
+DROP VIEW IF EXISTS dbe_perf.global_k2_ops CASCADE;
+CREATE OR REPLACE VIEW dbe_perf.global_k2_ops AS
+        SELECT pg_catalog.pgxc_node_str()::text AS node_name,op,calls,errors,total_us,p50_us,p99_us,p999_us,max_us,bytes,records
+        FROM pg_catalog.pg_stat_get_k2_ops();
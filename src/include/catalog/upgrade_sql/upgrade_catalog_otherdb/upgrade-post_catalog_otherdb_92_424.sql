@@ -0,0 +1,9 @@
+DROP VIEW IF EXISTS pg_catalog.pg_stat_k2_schemas CASCADE;
+CREATE OR REPLACE VIEW pg_catalog.pg_stat_k2_schemas AS
+    SELECT * FROM pg_catalog.pg_stat_get_k2_schemas();
+
+DROP VIEW IF EXISTS dbe_perf.global_k2_schemas CASCADE;
+CREATE OR REPLACE VIEW dbe_perf.global_k2_schemas AS
+        SELECT pg_catalog.pgxc_node_str()::text AS node_name,collection,schema,datid,relid,reads,writes,query_pages,errors,
+               records_read,records_written,bytes_read,bytes_written,since
+        FROM pg_catalog.pg_stat_get_k2_schemas();
@@ -0,0 +1,6 @@
+-- ----------------------------------------------------------------
+-- upgrade mot_session_jit_detail
+-- ----------------------------------------------------------------
+DROP FUNCTION IF EXISTS pg_catalog.mot_session_jit_detail(OUT exec_count int8, OUT exec_spi_count int8) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 6205;
+CREATE FUNCTION pg_catalog.mot_session_jit_detail(OUT exec_count int8, OUT exec_spi_count int8) RETURNS record LANGUAGE INTERNAL VOLATILE as 'mot_session_jit_detail';
@@ -268,6 +268,7 @@ typedef struct CopyStateData {
      */
     StringInfoData line_buf;
     bool line_buf_converted; /* converted to server encoding? */
+    bool line_buf_stale;     /* line_buf is not line cur_lineno, e.g. for a deferred K2 write error */
 
     /*
      * Finally, raw_buf holds raw data read from the data source (file or
@@ -501,6 +501,9 @@ extern void ExplainPropertyInteger(const char* qlabel, int value, ExplainState*
 extern void ExplainPropertyLong(const char* qlabel, long value, ExplainState* es);
 extern void ExplainPropertyFloat(const char* qlabel, double value, int ndigits, ExplainState* es);
 
+struct K2PgScanStats;
+extern void ExplainK2ScanStats(const K2PgScanStats* stats, ExplainState* es);
+
 extern int get_track_time(ExplainState* es, PlanState* planstate, bool show_track, bool show_buffer,
     bool show_dummygroup, bool show_indexinfo, bool show_storage_info = false);
 
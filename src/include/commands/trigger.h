@@ -177,6 +177,10 @@ extern bool RI_FKey_keyequal_upd_pk(Trigger* trigger, Relation pk_rel, HeapTuple
 extern bool RI_FKey_keyequal_upd_fk(Trigger* trigger, Relation fk_rel, HeapTuple old_row, HeapTuple new_row);
 extern bool RI_Initial_Check(Trigger* trigger, Relation fk_rel, Relation pk_rel);
 
+/* batched checks of references to K2PG tables, see ri_triggers.cpp */
+extern void K2PgFlushForeignKeyChecks(void);
+extern void K2PgResetForeignKeyChecks(bool isTopLevel);
+
 /* result values for RI_FKey_trigger_type: */
 #define RI_TRIGGER_PK 1   /* is a trigger on the PK relation */
 #define RI_TRIGGER_FK 2   /* is a trigger on the FK relation */
@@ -2419,6 +2419,8 @@ typedef struct knl_u_mot_context {
     tvm::JitDoWhile* jit_tvm_do_while_stack;
     JitExec::JitContext* jit_context;
     MOT::TxnManager* jit_txn;
+    uint64_t jit_exec_count;     /* jitted queries executed by this session */
+    uint64_t jit_exec_spi_count; /* ... of which issued by stored procedures */
 } knl_u_mot_context;
 
 // forward-declaration for k2 types
@@ -1399,6 +1399,8 @@ typedef struct ModifyTableState {
 
  	/* K2PG specific attributes. */
 	bool k2pg_mt_is_single_row_update_or_delete;
+	struct K2PgBulkModifyState* k2pg_bulk_modify; /* pipelined UPDATE/DELETE, NULL if rows are modified one at a time */
+	struct K2PgUpsertState* k2pg_upsert; /* conditional write upsert, NULL if conflicts are checked first */
 } ModifyTableState;
 
 typedef struct CopyFromManagerData* CopyFromManager;
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2022 Futurewei Cloud
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * opfusion_k2.h
+ *        Declaration of K2 primary key point select and modify operators for bypass executor.
+ *
+ * IDENTIFICATION
+ *        src/include/opfusion/opfusion_k2.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef SRC_INCLUDE_OPFUSION_OPFUSION_K2_H_
+#define SRC_INCLUDE_OPFUSION_OPFUSION_K2_H_
+
+#include "opfusion/opfusion.h"
+#include "access/k2/pg_gate_api.h"
+
+/*
+ * Returns K2_POINT_SELECT_FUSION or K2_POINT_MODIFY_FUSION for statements on K2 tables that
+ * address a single row by its full primary key, NONE_FUSION otherwise.
+ */
+extern FusionType getK2FusionType(PlannedStmt* plannedStmt, ParamListInfo params);
+
+class K2PointFusion : public OpFusion {
+public:
+    K2PointFusion(MemoryContext context, CachedPlanSource* psrc, List* plantree_list);
+
+    ~K2PointFusion() {};
+
+protected:
+    /* a column bound on each execution, from the primary key qual or from the target list */
+    struct K2BoundColumn {
+        AttrNumber attnum;
+        Oid atttypid;
+        int16 attlen;
+        bool attbyval;
+        bool attnotnull;
+        NameData attname;
+        Expr* expr;
+    };
+
+    struct K2PointFusionGlobalVariable {
+        K2PgPointOpType m_opType;
+        Oid m_dboid;
+        int m_keyNum;
+        K2BoundColumn* m_keys; /* primary key columns, a null key matches no row */
+        int m_valueNum;
+        K2BoundColumn* m_values; /* assigned columns of insert and update */
+    };
+
+    struct K2PointFusionLocaleVariable {
+        K2PgPointOp* m_op; /* created on first execution, owned by m_localContext */
+    };
+
+    static void InitBoundColumn(K2BoundColumn* column, TupleDesc desc, AttrNumber attnum, Expr* expr);
+
+    void InitK2Globals(Relation rel, K2PgPointOpType opType);
+
+    void InitK2Keys(Plan* plan, Relation rel);
+
+    bool BindColumns(const K2BoundColumn* columns, int num, bool isKey, std::vector<K2PgAttributeDef>& attrs);
+
+    K2PgPointOp* GetPointOp();
+
+    K2PointFusionGlobalVariable* m_c_global;
+
+    K2PointFusionLocaleVariable m_c_local;
+};
+
+class K2PointSelectFusion : public K2PointFusion {
+public:
+    K2PointSelectFusion(MemoryContext context, CachedPlanSource* psrc, List* plantree_list, ParamListInfo params);
+
+    ~K2PointSelectFusion() {};
+
+    bool execute(long max_rows, char* completionTag);
+
+    void InitLocals(ParamListInfo params);
+
+    void InitGlobals();
+};
+
+class K2PointModifyFusion : public K2PointFusion {
+public:
+    K2PointModifyFusion(MemoryContext context, CachedPlanSource* psrc, List* plantree_list, ParamListInfo params);
+
+    ~K2PointModifyFusion() {};
+
+    bool execute(long max_rows, char* completionTag);
+
+    void InitLocals(ParamListInfo params);
+
+    void InitGlobals();
+};
+
+#endif /* SRC_INCLUDE_OPFUSION_OPFUSION_K2_H_ */
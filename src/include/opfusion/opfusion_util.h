@@ -56,6 +56,9 @@ enum FusionType {
     MOT_JIT_SELECT_FUSION,
     MOT_JIT_MODIFY_FUSION,
 
+    K2_POINT_SELECT_FUSION,
+    K2_POINT_MODIFY_FUSION,
+
     BYPASS_OK,
 
     NOBYPASS_NO_CPLAN,
@@ -256,6 +259,7 @@ FusionType getSelectFusionType(List *stmt_list, ParamListInfo params);
 FusionType getInsertFusionType(List *stmt_list, ParamListInfo params);
 FusionType getUpdateFusionType(List *stmt_list, ParamListInfo params);
 FusionType getDeleteFusionType(List *stmt_list, ParamListInfo params);
+void checkTargetlist(List *targetList, FusionType* ftype);
 void tpslot_free_heaptuple(TupleTableSlot *reslot);
 void InitPartitionByScanFusion(Relation rel, Relation *fakRel, Partition *part, EState *estate, const ScanFusion *scan);
 Relation InitBucketRelation(int2 bucketid, Relation rel, Partition part);
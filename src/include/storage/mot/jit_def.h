@@ -42,6 +42,9 @@
 /** @define The maximum number of arguments in a function call expression. */
 #define MOT_JIT_MAX_FUNC_EXPR_ARGS 3
 
+/** @define The maximum number of columns in a jitted GROUP BY clause. */
+#define MOT_JIT_MAX_GROUP_BY_COLUMNS 4
+
 namespace JitExec {
 
 // To debug JIT execution, #define MOT_JIT_DEBUG
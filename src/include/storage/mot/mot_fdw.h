@@ -82,4 +82,19 @@ extern void MOTCheckpointFetchUnlock();
 extern bool MOTCheckpointExists(
     char* ctrlFilePath, size_t ctrlLen, char* checkpointDir, size_t checkpointLen, size_t& basePathLen);
 
+/**
+ * @brief Returns the path of a checkpoint the current (delta) checkpoint depends on.
+ * @param index the index of the checkpoint in the delta chain, starting with the full checkpoint.
+ * @param checkpointDir a buffer to hold the checkpoint path.
+ * @param checkpointLen the length of the given checkpoint path buffer.
+ * @return True if such a checkpoint exists, False indicates the end of the chain.
+ */
+extern bool MOTCheckpointChainDir(uint32_t index, char* checkpointDir, size_t checkpointLen);
+
+/**
+ * @brief Checks whether the current transaction can run MOT scans split among SMP workers.
+ * @return False if the transaction has uncommitted MOT changes or runs above READ COMMITTED isolation.
+ */
+extern bool MOTIsParallelScanAllowed();
+
 #endif  // MOT_FDW_H
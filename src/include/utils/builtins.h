@@ -1596,6 +1596,7 @@ extern Datum hypopg_reset_index(PG_FUNCTION_ARGS);
 extern Datum mot_global_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_local_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_session_memory_detail(PG_FUNCTION_ARGS);
+extern Datum mot_session_jit_detail(PG_FUNCTION_ARGS);
 
 /* undo meta */
 extern Datum gs_undo_meta(PG_FUNCTION_ARGS);
@@ -76,6 +76,7 @@ typedef enum {
     UPSERT_UPDATE_QUERY,
 #ifdef ENABLE_MOT
     PBE_OPT_AND_MOT_ENGINE,
+    MOT_PARALLEL_SCAN_RESTRICTED,
 #endif
     PARAM_EXPR,
     ONE_SHOT_PLAN,
@@ -329,6 +330,7 @@ typedef struct CachedPlanSource {
 #ifdef ENABLE_MOT
     StorageEngineType storageEngineType;    /* which storage engine is used*/
     JitExec::JitContext* mot_jit_context;   /* MOT JIT context required for executing LLVM jitted code */
+    bool mot_jit_tried;                     /* SPI already tried to JIT the current query_list */
 #endif
     int generation;   /* increments each time we create a plan */
     /* If CachedPlanSource has been saved, it is a member of a global list */
@@ -380,6 +382,7 @@ typedef struct CachedPlan {
 #ifdef ENABLE_MOT
     StorageEngineType storageEngineType;    /* which storage engine is used*/
     JitExec::JitContext* mot_jit_context;   /* MOT JIT context required for executing LLVM jitted code */
+    bool mot_parallel_scan;                 /* may scan MOT tables in SMP workers? */
 #endif
 
     bool dependsOnRole;       /* is plan specific to that role? */
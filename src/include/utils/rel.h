@@ -368,6 +368,7 @@ typedef struct StdRdOptions {
     char* dek_cipher;
     char* cmk_id;
     char* encrypt_algo;
+    char* rowid_strategy; /* k2pgrowid generation of K2PG tables without primary key */
     bool enable_tde;     /* switch flag for table-level TDE encryption */
     bool on_commit_delete_rows; /* global temp table */
 } StdRdOptions;
@@ -151,6 +151,10 @@ typedef struct RelationMetaData {
 #define ORIENTATION_ORC "orc"
 #define ORIENTATION_TIMESERIES "timeseries"
 
+#define ROWID_STRATEGY_RANDOM "random"
+#define ROWID_STRATEGY_TIME_ORDERED "time_ordered"
+#define ROWID_STRATEGY_SHARDED "sharded"
+
 
 #define TIME_ONE_HOUR "1 HOUR"
 
@@ -283,6 +287,12 @@ static inline int8 get_indexsplit_from_reloptions(bytea *reloptions, Oid amoid)
  */
 #define RelationGetOrientation(relation) StdRdOptionsGetStringData((relation)->rd_options, orientation, ORIENTATION_ROW)
 
+/* RelationGetRowIdStrategy
+ *    Return how the k2pgrowid of the rows of a K2PG table without primary key is generated
+ */
+#define RelationGetRowIdStrategy(relation) \
+    StdRdOptionsGetStringData((relation)->rd_options, rowid_strategy, ROWID_STRATEGY_RANDOM)
+
 #define RaletionGetStoreVersion(relation) StdRdOptionsGetStringData((relation)->rd_options, version, ORC_VERSION_012)
 
 #define RelationGetFileSystem(relation) \
@@ -159,6 +159,7 @@ extern Bitmapset *K2PgSysTablePrimaryKey(Oid relid);
 extern void K2PgSetSysCacheTuple(Relation rel, HeapTuple tup);
 extern void K2PgPreloadCatalogCaches(void);
 extern void K2PgPreloadCatalogCache(int cache_id, int idx_cache_id);
+extern void K2PgLoadCatalogCacheSnapshot(bool build);
 
 extern void InitCatalogCache(void);
 extern void InitCatalogCachePhase2(void);
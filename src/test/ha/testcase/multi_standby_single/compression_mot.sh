@@ -0,0 +1,87 @@
+#!/bin/sh
+# with LZ4 compressed checkpoint files and redo records, the standby must replay the
+# compressed redo and the primary must recover the same rows after it is killed
+
+source ./util.sh
+
+function test_1()
+{
+  set_default
+  kill_cluster
+  # compression is off by default
+  for dir in $primary_data_dir $standby_data_dir; do
+    echo "enable_checkpoint_compression = true" >> $dir/mot.conf
+    echo "enable_redo_log_compression = true" >> $dir/mot.conf
+  done
+  start_cluster
+  check_instance_multi_standby
+
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists lz4_t1; create FOREIGN table lz4_t1(id int primary key, v int, s varchar(2000)) SERVER mot_server;"
+  # wide, compressible rows in one large transaction and in single row transactions
+  gsql -d $db -p $dn1_primary_port -c "insert into lz4_t1 select g, g, repeat('mot' || (g % 10), 300) from generate_series(1, 20000) g;"
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+  seq 20001 21000 | awk '{print "insert into lz4_t1 values(" $1 ", " $1 ", repeat(\x27row\x27, 100));"}' | gsql -d $db -p $dn1_primary_port > /dev/null 2>&1
+  # small records stay uncompressed
+  gsql -d $db -p $dn1_primary_port -c "update lz4_t1 set v = v + 1 where id % 10 = 0;"
+  gsql -d $db -p $dn1_primary_port -c "delete from lz4_t1 where id % 7 = 0;"
+
+  expected=$(gsql -d $db -p $dn1_primary_port -t -A -c "select count(1), sum(v), sum(length(s)) from lz4_t1;")
+  echo "primary: $expected"
+
+  for((i = 1; i <= 60; i++))
+  do
+    actual=$(gsql -d $db -p $dn1_standby_port -t -A -c "select count(1), sum(v), sum(length(s)) from lz4_t1;" 2>/dev/null)
+    if [ "$expected" = "$actual" ]; then
+      break
+    fi
+    sleep 1
+  done
+  echo "standby: $actual"
+  if [ "$expected" = "$actual" ]; then
+    echo "compressed redo replay success on dn1_standby"
+  else
+    echo "compressed redo replay $failed_keyword on dn1_standby"
+    exit 1
+  fi
+
+  kill_cluster
+  start_cluster
+  check_instance_multi_standby
+
+  actual=$(gsql -d $db -p $dn1_primary_port -t -A -c "select count(1), sum(v), sum(length(s)) from lz4_t1;")
+  echo "after recovery: $actual"
+  if [ "$expected" = "$actual" ]; then
+    echo "compressed checkpoint recovery success on dn1_primary"
+  else
+    echo "compressed checkpoint recovery $failed_keyword on dn1_primary"
+    exit 1
+  fi
+
+  # a checkpoint taken after the recovery is readable as well
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+  kill_cluster
+  start_cluster
+  check_instance_multi_standby
+  actual=$(gsql -d $db -p $dn1_primary_port -t -A -c "select count(1), sum(v), sum(length(s)) from lz4_t1;")
+  if [ "$expected" = "$actual" ]; then
+    echo "second compressed checkpoint recovery success on dn1_primary"
+  else
+    echo "second compressed checkpoint recovery $failed_keyword on dn1_primary"
+    exit 1
+  fi
+}
+
+function tear_down()
+{
+  set_default
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists lz4_t1;"
+  kill_cluster
+  for dir in $primary_data_dir $standby_data_dir; do
+    sed -i '/^enable_checkpoint_compression = true$/d; /^enable_redo_log_compression = true$/d' $dir/mot.conf
+  done
+  start_cluster
+}
+
+test_1
+tear_down
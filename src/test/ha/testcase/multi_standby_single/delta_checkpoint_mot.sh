@@ -0,0 +1,71 @@
+#!/bin/sh
+# rows committed before and while delta checkpoints are taken must all be recovered
+# after the primary is killed, from the full checkpoint, the delta chain and the redo log
+
+source ./util.sh
+
+function test_1()
+{
+  set_default
+  kill_cluster
+  # delta checkpoints are off by default
+  echo "enable_delta_checkpoint = true" >> $primary_data_dir/mot.conf
+  echo "delta_checkpoint_chain_length = 4" >> $primary_data_dir/mot.conf
+  start_cluster
+  check_instance_multi_standby
+
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists delta_cp_t1; create FOREIGN table delta_cp_t1(id int primary key, v int) SERVER mot_server;"
+  gsql -d $db -p $dn1_primary_port -c "insert into delta_cp_t1 select g, g from generate_series(1, 10000) g;"
+  # full checkpoint, the base of the chain
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+  gsql -d $db -p $dn1_primary_port -c "update delta_cp_t1 set v = v + 1 where id % 10 = 0;"
+  gsql -d $db -p $dn1_primary_port -c "delete from delta_cp_t1 where id % 7 = 0;"
+  gsql -d $db -p $dn1_primary_port -c "insert into delta_cp_t1 select g, g from generate_series(10001, 12000) g;"
+  gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+  # single row commits racing with the delta checkpoints
+  seq 12001 14000 | awk '{print "insert into delta_cp_t1 values(" $1 ", " $1 ");"}' | gsql -d $db -p $dn1_primary_port > /dev/null 2>&1 &
+  insert_pid=$!
+  for((i = 1; i <= 3; i++))
+  do
+    gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+  done
+  wait $insert_pid
+
+  if [ $(find $primary_data_dir -name "*.delta" | wc -l) -ge 1 ]; then
+    echo "delta checkpoint taken on dn1_primary"
+  else
+    echo "delta checkpoint $failed_keyword on dn1_primary"
+    exit 1
+  fi
+
+  expected=$(gsql -d $db -p $dn1_primary_port -t -A -c "select count(1), sum(v) from delta_cp_t1;")
+  echo "before kill: $expected"
+
+  kill_cluster
+  start_cluster
+  check_instance_multi_standby
+
+  actual=$(gsql -d $db -p $dn1_primary_port -t -A -c "select count(1), sum(v) from delta_cp_t1;")
+  echo "after recovery: $actual"
+  if [ "$expected" = "$actual" ]; then
+    echo "delta checkpoint recovery success on dn1_primary"
+  else
+    echo "delta checkpoint recovery $failed_keyword on dn1_primary"
+    exit 1
+  fi
+}
+
+function tear_down()
+{
+  set_default
+  sleep 1
+  gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists delta_cp_t1;"
+  kill_cluster
+  sed -i '/^enable_delta_checkpoint = true$/d; /^delta_checkpoint_chain_length = 4$/d' $primary_data_dir/mot.conf
+  start_cluster
+}
+
+test_1
+tear_down
@@ -0,0 +1,65 @@
+--
+-- Set-based UPDATE/DELETE, TRUNCATE and DROP TABLE on K2 tables.
+--
+CREATE TABLE k2_bm (a int PRIMARY KEY, b int, c text);
+INSERT INTO k2_bm SELECT g, g % 10, 'row ' || g FROM generate_series(1, 1000) g;
+
+-- reports how many rows a statement touched
+CREATE FUNCTION k2_bm_rows(text) RETURNS bigint AS $$
+DECLARE
+    n bigint;
+BEGIN
+    EXECUTE $1;
+    GET DIAGNOSTICS n = ROW_COUNT;
+    RETURN n;
+END;
+$$ LANGUAGE plpgsql;
+
+SELECT k2_bm_rows('DELETE FROM k2_bm WHERE b = 3');
+SELECT count(*), sum(a) FROM k2_bm;
+SELECT count(*) FROM k2_bm WHERE b = 3;
+
+SELECT k2_bm_rows('UPDATE k2_bm SET b = b + 100, c = ''upd'' WHERE b = 5');
+SELECT b, count(*) FROM k2_bm WHERE b >= 100 GROUP BY b;
+SELECT count(*) FROM k2_bm WHERE c = 'upd';
+SELECT * FROM k2_bm WHERE a IN (4, 5, 6) ORDER BY a;
+
+-- nothing qualifies
+SELECT k2_bm_rows('DELETE FROM k2_bm WHERE b = 3');
+
+-- whole table
+SELECT k2_bm_rows('UPDATE k2_bm SET b = b * 2');
+SELECT count(*), sum(b) FROM k2_bm;
+
+-- a rolled back set-based delete leaves every row behind
+BEGIN;
+SELECT k2_bm_rows('DELETE FROM k2_bm WHERE a <= 500');
+SELECT count(*) FROM k2_bm;
+ROLLBACK;
+SELECT count(*), sum(a) FROM k2_bm;
+
+-- a rolled back TRUNCATE restores the data
+BEGIN;
+TRUNCATE k2_bm;
+SELECT count(*) FROM k2_bm;
+ROLLBACK;
+SELECT count(*), sum(a) FROM k2_bm;
+
+-- TRUNCATE empties the table and its indexes
+CREATE INDEX k2_bm_c ON k2_bm (c);
+TRUNCATE k2_bm;
+SELECT count(*) FROM k2_bm;
+SET enable_seqscan = off;
+SELECT count(*) FROM k2_bm WHERE c = 'upd';
+RESET enable_seqscan;
+INSERT INTO k2_bm VALUES (1, 1, 'again');
+SELECT * FROM k2_bm;
+
+-- DROP TABLE takes the data with it
+INSERT INTO k2_bm SELECT g, g, 'row ' || g FROM generate_series(2, 10) g;
+DROP TABLE k2_bm;
+CREATE TABLE k2_bm (a int PRIMARY KEY, b int, c text);
+SELECT count(*) FROM k2_bm;
+
+DROP TABLE k2_bm;
+DROP FUNCTION k2_bm_rows(text);
@@ -0,0 +1,29 @@
+--
+-- New backends load their catalog caches from a snapshot taken at the
+-- current K2 catalog version. Catalog changes must invalidate it.
+--
+CREATE TABLE k2_cs (a int PRIMARY KEY, b text);
+CREATE FUNCTION k2_cs_twice(int) RETURNS int AS 'SELECT $1 * 2' LANGUAGE sql IMMUTABLE;
+INSERT INTO k2_cs VALUES (1, 'one');
+
+-- a new backend builds or loads the snapshot
+\c
+SELECT a, b, k2_cs_twice(a) FROM k2_cs;
+\c
+SELECT a, b, k2_cs_twice(a) FROM k2_cs;
+
+-- changes made after the snapshot are seen by the next backends
+ALTER TABLE k2_cs ADD COLUMN c int DEFAULT 7;
+CREATE OR REPLACE FUNCTION k2_cs_twice(int) RETURNS int AS 'SELECT $1 * 20' LANGUAGE sql IMMUTABLE;
+\c
+SELECT a, b, c, k2_cs_twice(a) FROM k2_cs;
+SELECT attname FROM pg_attribute WHERE attrelid = 'k2_cs'::regclass AND attnum > 0 ORDER BY attnum;
+
+DROP FUNCTION k2_cs_twice(int);
+\c
+SELECT count(*) FROM pg_proc WHERE proname = 'k2_cs_twice';
+SELECT k2_cs_twice(1);
+
+DROP TABLE k2_cs;
+\c
+SELECT count(*) FROM pg_class WHERE relname = 'k2_cs';
@@ -0,0 +1,70 @@
+--
+-- COPY FROM into K2 tables through the pipelined bulk insert, with
+-- secondary indexes, without a primary key and through the per-row path
+-- taken for BEFORE ROW triggers.
+--
+CREATE TABLE k2_copy (a int PRIMARY KEY, b int, c text);
+CREATE INDEX k2_copy_b ON k2_copy (b);
+COPY k2_copy FROM stdin;
+1	10	one
+2	20	two
+3	30	three
+4	20	four
+\.
+INSERT INTO k2_copy SELECT g, g % 7, 'gen ' || g FROM generate_series(100, 1099) g;
+COPY (SELECT a, b, c FROM k2_copy WHERE a >= 100) TO '/tmp/k2_copy_bulk.data';
+DELETE FROM k2_copy WHERE a >= 100;
+COPY k2_copy FROM '/tmp/k2_copy_bulk.data';
+SELECT count(*), sum(a), sum(b) FROM k2_copy;
+SELECT a, c FROM k2_copy WHERE b = 20 ORDER BY a;
+SELECT count(*) FROM k2_copy WHERE b = 3;
+
+-- no primary key, the row id is generated per row
+CREATE TABLE k2_copy_nopk (a int, b text);
+COPY k2_copy_nopk FROM stdin;
+1	x
+1	x
+2	y
+\.
+SELECT a, b, count(*) FROM k2_copy_nopk GROUP BY a, b ORDER BY a;
+
+-- a duplicate key fails the whole COPY, the error names the line of the
+-- duplicate although later lines were read while its write was in flight
+COPY k2_copy FROM stdin;
+7	7	seven
+2	7	dup
+8	7	eight
+9	7	nine
+\.
+SELECT count(*) FROM k2_copy WHERE b = 7;
+SELECT c FROM k2_copy WHERE a = 2;
+
+-- BEFORE ROW triggers use the per-row path, AFTER ROW triggers still fire
+CREATE TABLE k2_copy_log (a int PRIMARY KEY, b int);
+CREATE FUNCTION k2_copy_before() RETURNS trigger AS $$
+BEGIN
+    NEW.b := NEW.b * 100;
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+CREATE FUNCTION k2_copy_after() RETURNS trigger AS $$
+BEGIN
+    INSERT INTO k2_copy_log VALUES (NEW.a, NEW.b);
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+CREATE TRIGGER k2_copy_before BEFORE INSERT ON k2_copy FOR EACH ROW EXECUTE PROCEDURE k2_copy_before();
+CREATE TRIGGER k2_copy_after AFTER INSERT ON k2_copy FOR EACH ROW EXECUTE PROCEDURE k2_copy_after();
+COPY k2_copy FROM stdin;
+5	5	five
+6	6	six
+\.
+SELECT a, b, c FROM k2_copy WHERE a IN (5, 6) ORDER BY a;
+SELECT a, c FROM k2_copy WHERE b = 600;
+SELECT * FROM k2_copy_log ORDER BY a;
+
+DROP TABLE k2_copy;
+DROP TABLE k2_copy_nopk;
+DROP TABLE k2_copy_log;
+DROP FUNCTION k2_copy_before();
+DROP FUNCTION k2_copy_after();
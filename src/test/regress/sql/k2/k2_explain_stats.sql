@@ -0,0 +1,30 @@
+--
+-- EXPLAIN ANALYZE of K2 scans reports the remote work of the scan.
+--
+CREATE TABLE k2_ex (a int PRIMARY KEY, b int);
+INSERT INTO k2_ex SELECT g, g % 10 FROM generate_series(1, 100) g;
+
+CREATE FUNCTION k2_explain_stats(query text) RETURNS SETOF text AS $$
+DECLARE
+    ln text;
+BEGIN
+    FOR ln IN EXECUTE 'EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF) ' || query LOOP
+        IF ln ~ 'K2 (Queries Created|Point Reads|Records Returned)' THEN
+            RETURN NEXT btrim(ln);
+        END IF;
+    END LOOP;
+END;
+$$ LANGUAGE plpgsql;
+
+SET enable_indexscan = off;
+SET enable_bitmapscan = off;
+SELECT k2_explain_stats('SELECT * FROM k2_ex');
+SELECT k2_explain_stats('SELECT * FROM k2_ex WHERE b = 3');
+RESET enable_indexscan;
+RESET enable_bitmapscan;
+
+-- the counters are not shown without ANALYZE
+EXPLAIN (COSTS OFF) SELECT * FROM k2_ex;
+
+DROP FUNCTION k2_explain_stats(text);
+DROP TABLE k2_ex;
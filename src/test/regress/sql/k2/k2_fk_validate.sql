@@ -0,0 +1,23 @@
+--
+-- ALTER TABLE ... ADD FOREIGN KEY on K2 tables must reject existing rows
+-- that reference a missing key, also when the references are batched.
+--
+CREATE TABLE k2_fk_pk (a int PRIMARY KEY);
+CREATE TABLE k2_fk_ref (id int PRIMARY KEY, a int);
+INSERT INTO k2_fk_pk VALUES (1), (2);
+INSERT INTO k2_fk_ref VALUES (1, 1), (2, 2), (3, 3), (4, NULL);
+
+-- fails, key 3 is missing
+ALTER TABLE k2_fk_ref ADD CONSTRAINT k2_fk_ref_a_fkey FOREIGN KEY (a) REFERENCES k2_fk_pk (a);
+SELECT conname FROM pg_constraint WHERE conrelid = 'k2_fk_ref'::regclass AND contype = 'f';
+
+-- succeeds once the missing key is added
+INSERT INTO k2_fk_pk VALUES (3);
+ALTER TABLE k2_fk_ref ADD CONSTRAINT k2_fk_ref_a_fkey FOREIGN KEY (a) REFERENCES k2_fk_pk (a);
+SELECT conname FROM pg_constraint WHERE conrelid = 'k2_fk_ref'::regclass AND contype = 'f';
+
+-- the constraint is enforced for new rows
+INSERT INTO k2_fk_ref VALUES (5, 5);
+
+DROP TABLE k2_fk_ref;
+DROP TABLE k2_fk_pk;
@@ -0,0 +1,110 @@
+--
+-- Key ordering, range bounds, reverse scans, pushed down filters and
+-- write-write conflicts of the K2 storage. Run against the in-process
+-- backend by fastcheck_single_k2_inproc.
+--
+-- integer keys: scans return them in numeric order, negatives first
+CREATE TABLE k2_in_int (a bigint PRIMARY KEY, b int);
+INSERT INTO k2_in_int VALUES (5, 1), (-5, 2), (0, 3), (-9223372036854775808, 4), (9223372036854775807, 5), (-1, 6), (1, 7);
+SELECT a FROM k2_in_int;
+
+-- float keys
+CREATE TABLE k2_in_float (a float8 PRIMARY KEY, b int);
+INSERT INTO k2_in_float VALUES (1.5, 1), ('-Infinity', 2), (-2.5, 3), (100, 4), (0, 5), ('Infinity', 6), (-100, 7), (-1, 8);
+SELECT a FROM k2_in_float;
+SELECT a FROM k2_in_float WHERE a > -3 AND a < 2;
+
+-- binary string keys: a string sorts before its extensions, also those
+-- starting with a zero byte
+SET bytea_output = 'hex';
+CREATE TABLE k2_in_str (a bytea PRIMARY KEY, b int);
+INSERT INTO k2_in_str VALUES ('\x6162', 1), ('\x61', 2), ('\xff', 3), ('\x610000', 4), ('\x6101', 5),
+    ('\x6100', 6), ('\x62', 7), ('\x610062', 8), ('\x00', 9), ('\x61ff', 10);
+SELECT a FROM k2_in_str;
+SELECT b FROM k2_in_str WHERE a = '\x6100';
+
+-- an equality on the leading key column scans up to the prefix successor,
+-- including keys whose encoding ends in 0xff bytes
+CREATE TABLE k2_in_pair (a int, b int, c bytea, PRIMARY KEY (a, b));
+INSERT INTO k2_in_pair SELECT a, b, '\x61' FROM generate_series(-2, 1) a, generate_series(1, 3) b;
+CREATE TABLE k2_in_spair (a bytea, b int, PRIMARY KEY (a, b));
+INSERT INTO k2_in_spair VALUES ('\x61', 1), ('\x61', 2), ('\x6100', 1), ('\x61ff', 1), ('\x60ff', 1), ('\x62', 1);
+SET enable_seqscan = off;
+SELECT a, b FROM k2_in_pair WHERE a = -1;
+SELECT a, b FROM k2_in_pair WHERE a = 0 AND b >= 2;
+SELECT a, b FROM k2_in_spair WHERE a = '\x61';
+
+-- reverse scans
+SELECT a FROM k2_in_int ORDER BY a DESC;
+SELECT a FROM k2_in_int WHERE a < 5 ORDER BY a DESC LIMIT 2;
+SELECT a FROM k2_in_float WHERE a >= -2.5 ORDER BY a DESC;
+SELECT a FROM k2_in_str ORDER BY a DESC;
+SELECT b FROM k2_in_pair WHERE a = -1 ORDER BY b DESC;
+
+-- scans over several result pages
+CREATE TABLE k2_in_big (a int PRIMARY KEY, b int);
+INSERT INTO k2_in_big SELECT g, g % 7 FROM generate_series(1, 1200) g;
+SELECT count(*), min(a), max(a) FROM (SELECT a FROM k2_in_big ORDER BY a DESC) s;
+SELECT a FROM k2_in_big ORDER BY a DESC LIMIT 3 OFFSET 600;
+SELECT a FROM k2_in_big WHERE a > 498 ORDER BY a LIMIT 4;
+RESET enable_seqscan;
+
+-- filters evaluated by the storage
+CREATE TABLE k2_in_f (a int PRIMARY KEY, b float8, c text, d int);
+INSERT INTO k2_in_f VALUES (1, 1.5, 'x', 10), (2, NULL, 'y', NULL), (3, 2.5, 'x', 30), (4, -1, NULL, 40), (5, 4, 'z', 50);
+SELECT a FROM k2_in_f WHERE b > 1;
+SELECT a FROM k2_in_f WHERE b >= 1.5 AND b < 4;
+SELECT a FROM k2_in_f WHERE c = 'x';
+SELECT a FROM k2_in_f WHERE d IN (10, 40, 60);
+SELECT a FROM k2_in_f WHERE d <= 30;
+SELECT a FROM k2_in_f WHERE d > 20::bigint;
+SELECT a FROM k2_in_f WHERE b = 2.5 AND c = 'x';
+SELECT count(*) FROM k2_in_big WHERE b = 3;
+
+-- write-write conflicts with a transaction committed in between
+CREATE TABLE k2_in_t (a int PRIMARY KEY, b int);
+INSERT INTO k2_in_t VALUES (1, 10), (2, 20);
+CREATE FUNCTION k2_in_bump(int) RETURNS void AS $$
+DECLARE
+    PRAGMA AUTONOMOUS_TRANSACTION;
+BEGIN
+    UPDATE k2_in_t SET b = b + 100 WHERE a = $1;
+END;
+$$ LANGUAGE plpgsql;
+-- a write to a key committed after the transaction started
+BEGIN;
+SELECT b FROM k2_in_t WHERE a = 1;
+SELECT k2_in_bump(1);
+UPDATE k2_in_t SET b = 0 WHERE a = 1;
+ROLLBACK;
+SELECT * FROM k2_in_t ORDER BY a;
+-- a pending write to a key committed by someone else fails the commit
+BEGIN;
+UPDATE k2_in_t SET b = b + 1 WHERE a = 2;
+SELECT k2_in_bump(2);
+COMMIT;
+SELECT * FROM k2_in_t ORDER BY a;
+-- different keys do not conflict
+BEGIN;
+UPDATE k2_in_t SET b = b + 1 WHERE a = 1;
+SELECT k2_in_bump(2);
+COMMIT;
+SELECT * FROM k2_in_t ORDER BY a;
+-- reads see the snapshot the transaction started with
+BEGIN;
+SELECT sum(b) FROM k2_in_t;
+SELECT k2_in_bump(1);
+SELECT sum(b) FROM k2_in_t;
+COMMIT;
+SELECT sum(b) FROM k2_in_t;
+
+RESET bytea_output;
+DROP FUNCTION k2_in_bump(int);
+DROP TABLE k2_in_int;
+DROP TABLE k2_in_float;
+DROP TABLE k2_in_str;
+DROP TABLE k2_in_pair;
+DROP TABLE k2_in_spair;
+DROP TABLE k2_in_big;
+DROP TABLE k2_in_f;
+DROP TABLE k2_in_t;
@@ -0,0 +1,34 @@
+--
+-- Bulk DDL on K2 consumes several OID ranges in quick succession, so the
+-- reserved range grows. Every object must still get a distinct OID.
+--
+DO $$
+BEGIN
+    FOR i IN 1..400 LOOP
+        EXECUTE 'CREATE TABLE k2_oid_t' || i || ' (a int, b text)';
+    END LOOP;
+END $$;
+
+SELECT count(*), count(DISTINCT oid), count(DISTINCT reltype) FROM pg_class
+    WHERE relname LIKE 'k2_oid_t%' AND relkind = 'r';
+SELECT count(*) FROM pg_class c WHERE c.relname LIKE 'k2_oid_t%'
+    AND EXISTS (SELECT 1 FROM pg_class c2 WHERE c2.oid = c.reltype);
+
+INSERT INTO k2_oid_t1 VALUES (1, 'first');
+INSERT INTO k2_oid_t400 VALUES (400, 'last');
+SELECT * FROM k2_oid_t1;
+SELECT * FROM k2_oid_t400;
+
+-- new objects after the burst still get fresh OIDs
+CREATE TABLE k2_oid_after (a int PRIMARY KEY);
+SELECT count(*) FROM pg_class WHERE relname LIKE 'k2_oid_t%'
+    AND oid = (SELECT oid FROM pg_class WHERE relname = 'k2_oid_after');
+
+DROP TABLE k2_oid_after;
+DO $$
+BEGIN
+    FOR i IN 1..400 LOOP
+        EXECUTE 'DROP TABLE k2_oid_t' || i;
+    END LOOP;
+END $$;
+SELECT count(*) FROM pg_class WHERE relname LIKE 'k2_oid_t%';
@@ -0,0 +1,18 @@
+--
+-- Per-operation K2 latency counters of pg_stat_k2_ops and their reset.
+--
+SELECT op FROM pg_stat_k2_ops ORDER BY op;
+
+CREATE TABLE k2_ops (a int PRIMARY KEY, b int);
+SELECT pg_stat_reset_k2_ops();
+SELECT count(*) FROM pg_stat_k2_ops WHERE op = 'write' AND calls >= 10;
+INSERT INTO k2_ops SELECT g, g FROM generate_series(1, 10) g;
+SELECT count(*) FROM k2_ops;
+SELECT op, calls >= 10 AS calls, errors = 0 AS no_errors FROM pg_stat_k2_ops WHERE op = 'write';
+SELECT op, calls >= 1 AS calls, records >= 10 AS records FROM pg_stat_k2_ops WHERE op = 'query';
+SELECT count(*) FROM pg_stat_k2_ops
+    WHERE calls > 0 AND NOT (p50_us <= p99_us AND p99_us <= p999_us AND p999_us <= max_us AND max_us <= total_us);
+SELECT count(*) FROM pg_stat_k2_ops WHERE errors > calls;
+SELECT count(*) FROM dbe_perf.global_k2_ops g JOIN pg_stat_k2_ops l USING (op) WHERE g.node_name IS NOT NULL;
+
+DROP TABLE k2_ops;
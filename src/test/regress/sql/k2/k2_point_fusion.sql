@@ -0,0 +1,63 @@
+--
+-- Prepared primary key point operations on K2 tables, which run through
+-- the K2 opfusion path, and statements that must fall back to the executor.
+--
+CREATE TABLE k2_pt (a int, b int, c text, PRIMARY KEY (a, b));
+INSERT INTO k2_pt SELECT g, g * 10, 'row ' || g FROM generate_series(1, 20) g;
+
+PREPARE pt_sel AS SELECT c FROM k2_pt WHERE a = $1 AND b = $2;
+PREPARE pt_ins AS INSERT INTO k2_pt VALUES ($1, $2, $3);
+PREPARE pt_upd AS UPDATE k2_pt SET c = $3 WHERE a = $1 AND b = $2;
+PREPARE pt_del AS DELETE FROM k2_pt WHERE a = $1 AND b = $2;
+
+EXECUTE pt_sel(3, 30);
+EXECUTE pt_sel(3, 31);
+EXECUTE pt_sel(NULL, 30);
+EXECUTE pt_ins(21, 210, 'row 21');
+EXECUTE pt_sel(21, 210);
+EXECUTE pt_upd(21, 210, 'updated');
+EXECUTE pt_upd(22, 220, 'missing');
+EXECUTE pt_sel(21, 210);
+EXECUTE pt_del(21, 210);
+EXECUTE pt_sel(21, 210);
+SELECT count(*) FROM k2_pt;
+
+-- a duplicate key through the fused insert
+EXECUTE pt_ins(3, 30, 'dup');
+EXECUTE pt_sel(3, 30);
+
+-- a point select is a single read, no query is created
+SELECT pg_stat_reset_k2_ops();
+EXECUTE pt_sel(1, 10);
+EXECUTE pt_sel(2, 20);
+EXECUTE pt_sel(3, 30);
+EXECUTE pt_sel(4, 40);
+EXECUTE pt_sel(5, 50);
+SELECT (SELECT calls FROM pg_stat_k2_ops WHERE op = 'read') >= 5 AS reads,
+       (SELECT calls FROM pg_stat_k2_ops WHERE op = 'createQuery') < 5 AS few_queries;
+
+-- not point operations, run by the executor
+PREPARE pt_part AS SELECT c FROM k2_pt WHERE a = $1;
+EXECUTE pt_part(4);
+PREPARE pt_upd_self AS UPDATE k2_pt SET c = c || '!' WHERE a = $1 AND b = $2;
+EXECUTE pt_upd_self(4, 40);
+EXECUTE pt_sel(4, 40);
+
+-- DDL invalidates the fused statements without a new PREPARE
+ALTER TABLE k2_pt ADD COLUMN d int;
+ALTER TABLE k2_pt ALTER COLUMN d SET DEFAULT 7;
+EXECUTE pt_ins(30, 300, 'row 30');
+SELECT a, c, d FROM k2_pt WHERE a = 30;
+
+-- secondary indexes disqualify the table, and are kept up to date
+CREATE INDEX k2_pt_c ON k2_pt (c);
+EXECUTE pt_upd(5, 50, 'indexed');
+EXECUTE pt_ins(31, 310, 'inserted');
+EXECUTE pt_del(6, 60);
+SET enable_seqscan = off;
+SELECT a, b FROM k2_pt WHERE c IN ('indexed', 'inserted') ORDER BY a;
+SELECT count(*) FROM k2_pt WHERE c = 'row 6';
+RESET enable_seqscan;
+
+DEALLOCATE ALL;
+DROP TABLE k2_pt;
@@ -0,0 +1,41 @@
+--
+-- Transaction-local cache of K2 point reads: repeated reads hit the cache,
+-- and writes, deletes and rollbacks are reflected by later reads.
+--
+CREATE TABLE k2_rc (a int PRIMARY KEY, b int);
+INSERT INTO k2_rc SELECT g, g * 10 FROM generate_series(1, 5) g;
+PREPARE rc_sel AS SELECT b FROM k2_rc WHERE a = $1;
+
+SELECT pg_stat_reset_k2_ops();
+BEGIN;
+EXECUTE rc_sel(1);
+EXECUTE rc_sel(1);
+EXECUTE rc_sel(1);
+UPDATE k2_rc SET b = 100 WHERE a = 1;
+EXECUTE rc_sel(1);
+DELETE FROM k2_rc WHERE a = 2;
+EXECUTE rc_sel(2);
+EXECUTE rc_sel(2);
+INSERT INTO k2_rc VALUES (6, 60);
+EXECUTE rc_sel(6);
+EXECUTE rc_sel(7);
+COMMIT;
+SELECT calls > 0 AS cache_hits FROM pg_stat_k2_ops WHERE op = 'cachedRead';
+
+-- the cache does not outlive the transaction
+BEGIN;
+UPDATE k2_rc SET b = 999 WHERE a = 3;
+EXECUTE rc_sel(3);
+ROLLBACK;
+EXECUTE rc_sel(3);
+SELECT * FROM k2_rc ORDER BY a;
+
+-- repeated foreign key checks against the same parent row
+CREATE TABLE k2_rc_child (id int PRIMARY KEY, a int REFERENCES k2_rc (a));
+INSERT INTO k2_rc_child SELECT g, 1 FROM generate_series(1, 20) g;
+INSERT INTO k2_rc_child VALUES (21, 2);
+SELECT count(*) FROM k2_rc_child;
+
+DEALLOCATE rc_sel;
+DROP TABLE k2_rc_child;
+DROP TABLE k2_rc;
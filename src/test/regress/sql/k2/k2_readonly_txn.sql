@@ -0,0 +1,67 @@
+--
+-- K2 transactions begin on first use and end without waiting when they did
+-- not write. Read-only transactions reject writes.
+--
+CREATE TABLE k2_ro (a int PRIMARY KEY, b int);
+
+-- transactions that never reach K2
+BEGIN;
+COMMIT;
+BEGIN;
+ROLLBACK;
+BEGIN;
+SELECT 1 AS one;
+COMMIT;
+
+INSERT INTO k2_ro SELECT g, g FROM generate_series(1, 10) g;
+
+-- back to back read-only transactions
+SELECT count(*) FROM k2_ro;
+SELECT sum(b) FROM k2_ro;
+SELECT b FROM k2_ro WHERE a = 5;
+BEGIN;
+SELECT count(*) FROM k2_ro;
+SELECT b FROM k2_ro WHERE a = 7;
+COMMIT;
+
+-- writes are rejected in read-only transactions
+BEGIN READ ONLY;
+SELECT count(*) FROM k2_ro;
+INSERT INTO k2_ro VALUES (100, 100);
+ROLLBACK;
+START TRANSACTION ISOLATION LEVEL REPEATABLE READ READ ONLY;
+SELECT sum(b) FROM k2_ro;
+UPDATE k2_ro SET b = 0;
+ROLLBACK;
+SELECT count(*), sum(b) FROM k2_ro;
+
+-- a SELECT that writes through a function commits its write
+CREATE FUNCTION k2_ro_put(int) RETURNS int AS 'INSERT INTO k2_ro VALUES ($1, $1); SELECT $1;' LANGUAGE sql;
+SELECT k2_ro_put(11);
+SELECT count(*), sum(b) FROM k2_ro;
+
+-- a rolled back write is not visible
+BEGIN;
+INSERT INTO k2_ro VALUES (12, 12);
+SELECT count(*) FROM k2_ro;
+ROLLBACK;
+SELECT count(*) FROM k2_ro;
+
+-- K2 rejects the writes of a read-only transaction itself: these statements
+-- passed the read-only check before their function made the transaction
+-- read-only, the K2 rejection is reported as a read-only error
+CREATE FUNCTION k2_ro_flip(int) RETURNS int AS $$
+SELECT set_config('transaction_read_only', 'on', true);
+SELECT $1;
+$$ LANGUAGE sql;
+BEGIN;
+INSERT INTO k2_ro SELECT g, k2_ro_flip(g) FROM generate_series(20, 22) g;
+ROLLBACK;
+BEGIN;
+UPDATE k2_ro SET b = k2_ro_flip(b) WHERE a = 1;
+ROLLBACK;
+SELECT count(*), sum(b) FROM k2_ro;
+
+DROP FUNCTION k2_ro_put(int);
+DROP FUNCTION k2_ro_flip(int);
+DROP TABLE k2_ro;
@@ -0,0 +1,47 @@
+--
+-- rowid_strategy of K2 tables without a primary key.
+--
+CREATE TABLE k2_rid_bad (a int) WITH (rowid_strategy = 'sequential');
+-- only tables with a k2pgrowid column take it
+CREATE TABLE k2_rid_pk (a int PRIMARY KEY) WITH (rowid_strategy = 'time_ordered');
+CREATE TEMP TABLE k2_rid_tmp (a int) WITH (rowid_strategy = 'time_ordered');
+CREATE TABLE k2_rid_pk (a int PRIMARY KEY);
+ALTER TABLE k2_rid_pk SET (rowid_strategy = 'sharded');
+DROP TABLE k2_rid_pk;
+
+CREATE TABLE k2_rid_rnd (a int, b text);
+CREATE TABLE k2_rid_time (a int, b text) WITH (rowid_strategy = 'time_ordered');
+CREATE TABLE k2_rid_shard (a int, b text) WITH (rowid_strategy = 'sharded');
+SELECT relname, opt FROM pg_class, unnest(reloptions) opt
+    WHERE relname LIKE 'k2_rid_%' AND opt LIKE 'rowid_strategy=%' ORDER BY relname;
+
+INSERT INTO k2_rid_rnd SELECT g % 10, 'r' FROM generate_series(1, 1000) g;
+INSERT INTO k2_rid_time SELECT g % 10, 't' FROM generate_series(1, 1000) g;
+INSERT INTO k2_rid_shard SELECT g % 10, 's' FROM generate_series(1, 1000) g;
+INSERT INTO k2_rid_time VALUES (1, 't'), (1, 't');
+INSERT INTO k2_rid_shard VALUES (1, 's'), (1, 's');
+COPY k2_rid_time FROM stdin;
+2	t
+2	t
+\.
+SELECT count(*), sum(a) FROM k2_rid_rnd;
+SELECT count(*), sum(a) FROM k2_rid_time;
+SELECT count(*), sum(a) FROM k2_rid_shard;
+
+-- duplicate rows stay distinct rows
+UPDATE k2_rid_time SET b = 'u' WHERE a = 1;
+DELETE FROM k2_rid_shard WHERE a = 1;
+SELECT b, count(*) FROM k2_rid_time WHERE a = 1 GROUP BY b;
+SELECT count(*) FROM k2_rid_shard WHERE a = 1;
+
+-- switching the strategy only affects new rows
+ALTER TABLE k2_rid_rnd SET (rowid_strategy = 'time_ordered');
+SELECT opt FROM pg_class, unnest(reloptions) opt
+    WHERE relname = 'k2_rid_rnd' AND opt LIKE 'rowid_strategy=%';
+INSERT INTO k2_rid_rnd SELECT 100, 'new' FROM generate_series(1, 10);
+SELECT b, count(*) FROM k2_rid_rnd GROUP BY b ORDER BY b;
+ALTER TABLE k2_rid_rnd SET (rowid_strategy = 'bad');
+
+DROP TABLE k2_rid_rnd;
+DROP TABLE k2_rid_time;
+DROP TABLE k2_rid_shard;
@@ -0,0 +1,36 @@
+--
+-- K2 query scans that read ahead several pages, stop early or fetch on
+-- demand must return the same rows as a full scan.
+--
+CREATE TABLE k2_ra (a int PRIMARY KEY, b int, c text);
+INSERT INTO k2_ra SELECT g, g % 100, repeat('x', g % 50) FROM generate_series(1, 20000) g;
+
+SELECT count(*), sum(a), sum(b), sum(length(c)) FROM k2_ra;
+SELECT count(*) FROM k2_ra WHERE b = 42;
+SELECT a FROM k2_ra WHERE a > 19995 ORDER BY a;
+
+-- pushed-down and executor limits
+SELECT count(*) FROM (SELECT * FROM k2_ra LIMIT 10) s;
+SELECT count(*) FROM (SELECT * FROM k2_ra LIMIT 5000) s;
+SELECT a FROM k2_ra WHERE a BETWEEN 100 AND 200 ORDER BY a LIMIT 3;
+
+-- a cursor that stops part way and one that reads to the end
+BEGIN;
+DECLARE k2_ra_cur CURSOR FOR SELECT a FROM k2_ra WHERE b = 7;
+MOVE FORWARD 3 IN k2_ra_cur;
+CLOSE k2_ra_cur;
+SELECT count(*) FROM k2_ra WHERE b = 7;
+DECLARE k2_ra_all CURSOR FOR SELECT a FROM k2_ra;
+MOVE FORWARD ALL IN k2_ra_all;
+FETCH 1 FROM k2_ra_all;
+CLOSE k2_ra_all;
+COMMIT;
+
+-- repeated rescans of the inner side of a nested loop
+SET enable_hashjoin = off;
+SET enable_mergejoin = off;
+SELECT count(*) FROM (SELECT generate_series(1, 5) AS n) o, k2_ra r WHERE r.b = o.n;
+RESET enable_hashjoin;
+RESET enable_mergejoin;
+
+DROP TABLE k2_ra;
@@ -0,0 +1,24 @@
+--
+-- K2 collection partitioning options of CREATE DATABASE and the per schema
+-- counters of pg_stat_k2_schemas.
+--
+CREATE DATABASE k2_part_bad WITH k2_partitioning = 'list';
+CREATE DATABASE k2_part_bad WITH k2_partitioning = 'hash' k2_range_ends = 'm,';
+CREATE DATABASE k2_part_bad WITH k2_min_nodes = 0;
+CREATE DATABASE k2_part_bad WITH k2_partitioning = 'hash' k2_partitioning = 'range';
+SELECT count(*) FROM pg_database WHERE datname = 'k2_part_bad';
+
+CREATE DATABASE k2_part_range WITH k2_partitioning = 'range' k2_range_ends = 'm,' k2_min_nodes = 1;
+SELECT count(*) FROM pg_database WHERE datname = 'k2_part_range';
+DROP DATABASE k2_part_range;
+
+CREATE TABLE k2_ss (id int PRIMARY KEY, v text);
+INSERT INTO k2_ss SELECT g, 'v' || g FROM generate_series(1, 100) g;
+SELECT count(*) FROM k2_ss;
+SELECT datid = (SELECT oid FROM pg_database WHERE datname = current_database()) AS same_db,
+       writes > 0 AS written, reads + query_pages > 0 AS read, records_written >= 100 AS records,
+       bytes_written > 0 AS bytes, since <= now() AS since
+    FROM pg_stat_k2_schemas WHERE relid = 'k2_ss'::regclass;
+SELECT count(*) > 0 FROM dbe_perf.global_k2_schemas WHERE relid = 'k2_ss'::regclass;
+
+DROP TABLE k2_ss;
@@ -0,0 +1,23 @@
+--
+-- UPDATE of K2 tables with stored generated columns. The set-based update
+-- must not be shipped as a bulk modify, and both paths must refresh the
+-- generated column.
+--
+CREATE TABLE k2_gen (a int PRIMARY KEY, b int, c int GENERATED ALWAYS AS (b * 2) STORED);
+INSERT INTO k2_gen (a, b) VALUES (1, 10), (2, 20), (3, 30);
+SELECT * FROM k2_gen ORDER BY a;
+
+-- set-based update
+UPDATE k2_gen SET b = b + 1;
+SELECT * FROM k2_gen ORDER BY a;
+
+-- single-row update by primary key
+UPDATE k2_gen SET b = 100 WHERE a = 2;
+SELECT * FROM k2_gen ORDER BY a;
+
+-- update of a column the generated one does not depend on
+ALTER TABLE k2_gen ADD COLUMN d int;
+UPDATE k2_gen SET d = a;
+SELECT * FROM k2_gen ORDER BY a;
+
+DROP TABLE k2_gen;
@@ -0,0 +1,45 @@
+--
+-- INSERT ... ON DUPLICATE KEY UPDATE on K2 tables, through the native
+-- conditional write and through the generic path.
+--
+CREATE TABLE k2_up (a int PRIMARY KEY, b int, c text);
+INSERT INTO k2_up VALUES (1, 10, 'one'), (2, 20, 'two'), (3, 30, 'three');
+
+INSERT INTO k2_up VALUES (1, 100, 'x'), (4, 40, 'four') ON DUPLICATE KEY UPDATE NOTHING;
+SELECT * FROM k2_up ORDER BY a;
+
+INSERT INTO k2_up VALUES (2, 200, 'y'), (5, 50, 'five') ON DUPLICATE KEY UPDATE b = EXCLUDED.b, c = 'updated';
+SELECT * FROM k2_up ORDER BY a;
+
+-- reads the existing row, generic path
+INSERT INTO k2_up VALUES (3, 1, 'z') ON DUPLICATE KEY UPDATE b = k2_up.b + EXCLUDED.b;
+SELECT * FROM k2_up WHERE a = 3;
+
+-- prepared upserts
+PREPARE up_put AS INSERT INTO k2_up VALUES ($1, $2, $3) ON DUPLICATE KEY UPDATE b = EXCLUDED.b;
+EXECUTE up_put(6, 60, 'six');
+EXECUTE up_put(6, 61, 'ignored');
+EXECUTE up_put(6, 62, 'ignored');
+SELECT * FROM k2_up WHERE a = 6;
+DEALLOCATE up_put;
+
+-- a rolled back upsert leaves nothing behind
+BEGIN;
+INSERT INTO k2_up VALUES (1, 0, 'gone'), (7, 70, 'gone') ON DUPLICATE KEY UPDATE b = EXCLUDED.b;
+ROLLBACK;
+SELECT * FROM k2_up WHERE a IN (1, 7) ORDER BY a;
+
+-- unique secondary index: a conflict on it removes the row and entries written
+CREATE TABLE k2_up_u (a int PRIMARY KEY, u int, v text);
+CREATE UNIQUE INDEX k2_up_u_u ON k2_up_u (u);
+INSERT INTO k2_up_u VALUES (1, 10, 'one');
+INSERT INTO k2_up_u VALUES (2, 10, 'dup u'), (3, 30, 'three') ON DUPLICATE KEY UPDATE NOTHING;
+INSERT INTO k2_up_u VALUES (1, 11, 'dup a') ON DUPLICATE KEY UPDATE NOTHING;
+SELECT * FROM k2_up_u ORDER BY a;
+SELECT a FROM k2_up_u WHERE u = 10;
+SELECT a FROM k2_up_u WHERE u = 11;
+INSERT INTO k2_up_u VALUES (4, 30, 'four') ON DUPLICATE KEY UPDATE v = EXCLUDED.v;
+SELECT * FROM k2_up_u ORDER BY a;
+
+DROP TABLE k2_up;
+DROP TABLE k2_up_u;
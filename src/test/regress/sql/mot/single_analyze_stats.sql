@@ -0,0 +1,39 @@
+--
+-- ANALYZE of MOT tables stores column statistics and the row count, and the planner uses them
+--
+CREATE FOREIGN TABLE mot_an (id int primary key, v int, w int) SERVER mot_server;
+INSERT INTO mot_an SELECT g, g % 10, CASE WHEN g % 2 = 0 THEN g END FROM generate_series(1, 1000) g;
+ANALYZE mot_an;
+SELECT reltuples FROM pg_class WHERE relname = 'mot_an';
+SELECT attname, null_frac, n_distinct FROM pg_stats WHERE tablename = 'mot_an' ORDER BY attname;
+
+CREATE FUNCTION mot_an_rows(query text) RETURNS int AS $$
+DECLARE
+    ln text;
+BEGIN
+    FOR ln IN EXECUTE 'EXPLAIN ' || query LOOP
+        RETURN substring(ln from 'rows=([0-9]+)')::int;
+    END LOOP;
+END;
+$$ LANGUAGE plpgsql;
+
+SELECT mot_an_rows('SELECT * FROM mot_an');
+SELECT mot_an_rows('SELECT * FROM mot_an WHERE v = 3');
+SELECT mot_an_rows('SELECT * FROM mot_an WHERE w IS NULL');
+
+-- more columns than the old fixed attribute bitmap could hold
+DO $$
+BEGIN
+    EXECUTE 'CREATE FOREIGN TABLE mot_an_wide (id int, ' ||
+        (SELECT string_agg('c' || g || ' int', ', ') FROM generate_series(1, 80) g) || ') SERVER mot_server';
+    EXECUTE 'INSERT INTO mot_an_wide SELECT g, ' ||
+        (SELECT string_agg('g % ' || (g + 1), ', ') FROM generate_series(1, 80) g) ||
+        ' FROM generate_series(1, 200) g';
+END $$;
+ANALYZE mot_an_wide;
+SELECT count(*) FROM pg_stats WHERE tablename = 'mot_an_wide';
+SELECT attname, n_distinct FROM pg_stats WHERE tablename = 'mot_an_wide' AND attname IN ('c1', 'c5', 'c19', 'c80') ORDER BY attname;
+
+DROP FUNCTION mot_an_rows(text);
+DROP FOREIGN TABLE mot_an;
+DROP FOREIGN TABLE mot_an_wide;
@@ -0,0 +1,23 @@
+--
+-- MOT hash index growing through several resizes, then shared by the concurrent single_hash_resize_w* tests
+--
+CREATE FOREIGN TABLE mot_hash_rs (id int primary key, k int, v int) SERVER mot_server;
+CREATE INDEX mot_hash_rs_k ON mot_hash_rs USING hash (k);
+CREATE UNIQUE INDEX mot_hash_rs_v ON mot_hash_rs USING hash (v);
+
+-- 1024 initial buckets, doubled above two entries per bucket
+INSERT INTO mot_hash_rs SELECT g, g, g FROM generate_series(1, 20000) g;
+SELECT count(*) FROM mot_hash_rs;
+SELECT count(*) FROM generate_series(1, 20000) g WHERE EXISTS (SELECT 1 FROM mot_hash_rs WHERE k = g);
+SELECT count(*) FROM generate_series(1, 20000) g WHERE EXISTS (SELECT 1 FROM mot_hash_rs WHERE v = g);
+SELECT k, v FROM mot_hash_rs WHERE k = 4097;
+SELECT k, v FROM mot_hash_rs WHERE v = 16385;
+
+DELETE FROM mot_hash_rs WHERE id % 2 = 0;
+SELECT count(*) FROM generate_series(1, 20000) g WHERE EXISTS (SELECT 1 FROM mot_hash_rs WHERE k = g);
+SELECT count(*) FROM mot_hash_rs WHERE k = 4096;
+SELECT count(*) FROM mot_hash_rs WHERE v = 4097;
+
+-- keys 1..1000 stay in place while the concurrent tests resize the index
+DELETE FROM mot_hash_rs WHERE id > 1000;
+SELECT count(*) FROM mot_hash_rs;
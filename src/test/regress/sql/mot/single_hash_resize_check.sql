@@ -0,0 +1,9 @@
+--
+-- state of mot_hash_rs after the concurrent single_hash_resize_w* tests
+--
+SELECT count(*) FROM mot_hash_rs;
+SELECT count(*) FROM mot_hash_rs a WHERE EXISTS (SELECT 1 FROM mot_hash_rs b WHERE b.k = a.id);
+SELECT count(*) FROM mot_hash_rs a WHERE EXISTS (SELECT 1 FROM mot_hash_rs b WHERE b.v = a.id);
+DELETE FROM mot_hash_rs WHERE id % 2 = 1;
+SELECT count(*) FROM mot_hash_rs a WHERE EXISTS (SELECT 1 FROM mot_hash_rs b WHERE b.k = a.id);
+DROP FOREIGN TABLE mot_hash_rs;
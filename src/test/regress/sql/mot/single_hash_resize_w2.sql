@@ -0,0 +1,12 @@
+--
+-- concurrent inserts, deletes and lookups on the hash indexes of mot_hash_rs while they resize
+--
+INSERT INTO mot_hash_rs SELECT g, g, g FROM generate_series(200001, 230000) g;
+SELECT count(*) FROM generate_series(1, 1000) g WHERE EXISTS (SELECT 1 FROM mot_hash_rs WHERE k = g);
+DELETE FROM mot_hash_rs WHERE id > 200000 AND id <= 230000 AND id % 3 = 0;
+SELECT count(*) FROM generate_series(200001, 230000) g WHERE EXISTS (SELECT 1 FROM mot_hash_rs WHERE k = g);
+INSERT INTO mot_hash_rs SELECT g, g, g FROM generate_series(230001, 240000) g;
+SELECT count(*) FROM generate_series(1, 1000) g WHERE EXISTS (SELECT 1 FROM mot_hash_rs WHERE v = g);
+SELECT count(*) FROM generate_series(200001, 240000) g WHERE EXISTS (SELECT 1 FROM mot_hash_rs WHERE v = g);
+SELECT k, v FROM mot_hash_rs WHERE k = 230001;
+SELECT count(*) FROM mot_hash_rs WHERE v = 200001;
@@ -0,0 +1,93 @@
+--
+-- COUNT(*) and GROUP BY in jitted MOT queries, over the single-table and the JOIN paths
+--
+CREATE FOREIGN TABLE mot_cnt_t1 (id int primary key, v int) SERVER mot_server;
+CREATE FOREIGN TABLE mot_cnt_t2 (id int primary key, t1_id int, w int) SERVER mot_server;
+CREATE INDEX mot_cnt_t2_t1 ON mot_cnt_t2 (t1_id);
+INSERT INTO mot_cnt_t1 SELECT g, g % 10 FROM generate_series(1, 100) g;
+INSERT INTO mot_cnt_t2 SELECT g, (g % 50) + 1, g FROM generate_series(1, 200) g;
+
+-- every jitted EXECUTE below adds exactly one to exec_count
+CREATE TABLE mot_cnt_stats AS SELECT * FROM mot_session_jit_detail();
+
+-- single-table range scan
+PREPARE cnt_range AS SELECT count(*) FROM mot_cnt_t1 WHERE id >= $1 AND id <= $2;
+EXECUTE cnt_range(1, 100);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+EXECUTE cnt_range(10, 19);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+EXECUTE cnt_range(200, 300);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+
+-- single-table range scan with a filter
+PREPARE cnt_filter AS SELECT count(*) FROM mot_cnt_t1 WHERE id >= $1 AND id <= $2 AND v = $3;
+EXECUTE cnt_filter(1, 100, 3);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+EXECUTE cnt_filter(1, 50, 0);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+
+-- join, every outer row has 4 inner rows
+PREPARE cnt_join AS SELECT count(*) FROM mot_cnt_t1 a, mot_cnt_t2 b WHERE a.id = b.t1_id AND a.id >= $1 AND a.id <= $2;
+EXECUTE cnt_join(1, 50);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+EXECUTE cnt_join(1, 10);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+EXECUTE cnt_join(51, 100);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+
+-- other aggregates still read their column
+PREPARE sum_join AS SELECT sum(b.w) FROM mot_cnt_t1 a, mot_cnt_t2 b WHERE a.id = b.t1_id AND a.id >= $1 AND a.id <= $2;
+EXECUTE sum_join(1, 1);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+
+-- GROUP BY, groups are reported in the order the index scan first meets them
+PREPARE cnt_group AS SELECT v, count(*) FROM mot_cnt_t1 WHERE id >= $1 AND id <= $2 GROUP BY v;
+EXECUTE cnt_group(1, 30);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+EXECUTE cnt_group(200, 300);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+
+-- GROUP BY an index column, ordered by the index
+PREPARE sum_group AS SELECT t1_id, sum(w) FROM mot_cnt_t2 WHERE t1_id >= $1 AND t1_id <= $2 GROUP BY t1_id ORDER BY t1_id;
+EXECUTE sum_group(1, 3);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+DELETE FROM mot_cnt_stats;
+INSERT INTO mot_cnt_stats SELECT * FROM mot_session_jit_detail();
+
+-- LIMIT counts groups
+PREPARE cnt_group_limit AS SELECT t1_id, count(*) FROM mot_cnt_t2 WHERE t1_id >= $1 AND t1_id <= $2 GROUP BY t1_id ORDER BY t1_id LIMIT 2;
+EXECUTE cnt_group_limit(1, 50);
+SELECT d.exec_count - s.exec_count AS exec_delta FROM mot_session_jit_detail() d, mot_cnt_stats s;
+
+DROP TABLE mot_cnt_stats;
+DEALLOCATE cnt_range;
+DEALLOCATE cnt_filter;
+DEALLOCATE cnt_join;
+DEALLOCATE sum_join;
+DEALLOCATE cnt_group;
+DEALLOCATE sum_group;
+DEALLOCATE cnt_group_limit;
+DROP FOREIGN TABLE mot_cnt_t2;
+DROP FOREIGN TABLE mot_cnt_t1;
@@ -0,0 +1,58 @@
+--
+-- Per-statement JIT of MOT queries issued through SPI by PL/pgSQL functions
+--
+CREATE FOREIGN TABLE mot_spi_t (id int primary key, v int) SERVER mot_server;
+INSERT INTO mot_spi_t SELECT g, g FROM generate_series(1, 100) g;
+
+CREATE OR REPLACE FUNCTION mot_spi_get(k int) RETURNS int AS
+$$
+DECLARE
+    r int;
+BEGIN
+    SELECT v INTO r FROM mot_spi_t WHERE id = k;
+    RETURN r;
+END;
+$$
+LANGUAGE 'plpgsql';
+
+CREATE OR REPLACE FUNCTION mot_spi_bump(k int) RETURNS int AS
+$$
+BEGIN
+    UPDATE mot_spi_t SET v = v + 1 WHERE id = k;
+    RETURN 1;
+END;
+$$
+LANGUAGE 'plpgsql';
+
+-- not jittable: the sub-link is left to the executor, and not retried on each call
+CREATE OR REPLACE FUNCTION mot_spi_sub(k int) RETURNS int AS
+$$
+DECLARE
+    r int;
+BEGIN
+    SELECT v INTO r FROM mot_spi_t WHERE id = (SELECT max(id) FROM mot_spi_t WHERE id <= k);
+    RETURN r;
+END;
+$$
+LANGUAGE 'plpgsql';
+
+CREATE TABLE mot_spi_stats AS SELECT * FROM mot_session_jit_detail();
+SELECT sum(mot_spi_get(i)) FROM generate_series(1, 10) i;
+SELECT d.exec_spi_count - s.exec_spi_count AS spi_delta FROM mot_session_jit_detail() d, mot_spi_stats s;
+
+DELETE FROM mot_spi_stats;
+INSERT INTO mot_spi_stats SELECT * FROM mot_session_jit_detail();
+SELECT sum(mot_spi_bump(i)) FROM generate_series(1, 5) i;
+SELECT mot_spi_get(1), mot_spi_get(6);
+SELECT d.exec_spi_count - s.exec_spi_count AS spi_delta FROM mot_session_jit_detail() d, mot_spi_stats s;
+
+DELETE FROM mot_spi_stats;
+INSERT INTO mot_spi_stats SELECT * FROM mot_session_jit_detail();
+SELECT sum(mot_spi_sub(i)) FROM generate_series(1, 10) i;
+SELECT d.exec_spi_count - s.exec_spi_count AS spi_delta FROM mot_session_jit_detail() d, mot_spi_stats s;
+
+DROP TABLE mot_spi_stats;
+DROP FUNCTION mot_spi_sub(int);
+DROP FUNCTION mot_spi_bump(int);
+DROP FUNCTION mot_spi_get(int);
+DROP FOREIGN TABLE mot_spi_t;
@@ -0,0 +1,32 @@
+--
+-- Constrained NUMERIC columns as MOT index keys, with range scans across signs and magnitudes
+--
+CREATE FOREIGN TABLE mot_num_any (k numeric primary key) SERVER mot_server;
+CREATE FOREIGN TABLE mot_num (k numeric(12,3) primary key, v int) SERVER mot_server;
+INSERT INTO mot_num VALUES (-1000.5, 1), (-2, 2), (-1.5, 3), (-0.001, 4), (0, 5), (0.001, 6),
+    (1.5, 7), (2, 8), (10, 9), (99.999, 10), (1000.5, 11), (123456789.123, 12);
+SELECT k FROM mot_num WHERE k > -2 AND k < 2 ORDER BY k;
+SELECT k FROM mot_num WHERE k >= 10 ORDER BY k;
+SELECT k FROM mot_num WHERE k < -1 ORDER BY k;
+
+-- the display scale does not matter, extra digits of the search value do
+SELECT v FROM mot_num WHERE k = 1.5;
+SELECT v FROM mot_num WHERE k = 1.50000;
+SELECT v FROM mot_num WHERE k = 1.5001;
+SELECT v FROM mot_num WHERE k > 1.4999 AND k < 1.5001;
+SELECT v FROM mot_num WHERE k = -0.0010;
+INSERT INTO mot_num VALUES (1.50, 13);
+
+-- secondary index
+CREATE FOREIGN TABLE mot_num_sec (id int primary key, d numeric(8,2) not null) SERVER mot_server;
+CREATE INDEX mot_num_sec_d ON mot_num_sec (d);
+INSERT INTO mot_num_sec SELECT g, (g - 100) / 4.0 FROM generate_series(1, 200) g;
+SELECT count(*), sum(d) FROM mot_num_sec WHERE d BETWEEN -1 AND 1;
+SELECT id FROM mot_num_sec WHERE d = -24.75;
+SELECT count(*) FROM mot_num_sec WHERE d > 24.5;
+DELETE FROM mot_num_sec WHERE id = 100;
+INSERT INTO mot_num_sec VALUES (100, 1000);
+SELECT id, d FROM mot_num_sec WHERE d >= 1000;
+
+DROP FOREIGN TABLE mot_num;
+DROP FOREIGN TABLE mot_num_sec;
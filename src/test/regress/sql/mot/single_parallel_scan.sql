@@ -0,0 +1,42 @@
+--
+-- Parallel (SMP) full scans of MOT tables
+--
+CREATE FOREIGN TABLE mot_par (id int primary key, v int) SERVER mot_server;
+INSERT INTO mot_par SELECT g, g % 100 FROM generate_series(1, 120000) g;
+ANALYZE mot_par;
+
+SET query_dop = 4;
+
+-- every row is read by exactly one worker
+SELECT count(*), count(distinct id), sum(v), min(id), max(id) FROM mot_par;
+SELECT count(*) FROM mot_par WHERE v = 7;
+
+EXPLAIN (costs off) SELECT count(*), sum(v) FROM mot_par;
+
+-- the workers don't see the changes of the current transaction, so the
+-- transaction runs a serial plan and the parallel cached plan is kept
+PREPARE par_count AS SELECT count(*), sum(v) FROM mot_par;
+EXECUTE par_count;
+EXPLAIN (costs off) EXECUTE par_count;
+BEGIN;
+EXPLAIN (costs off) EXECUTE par_count;
+INSERT INTO mot_par VALUES (120001, 1000);
+EXPLAIN (costs off) EXECUTE par_count;
+EXPLAIN (costs off) SELECT count(*), sum(v) FROM mot_par;
+EXECUTE par_count;
+DELETE FROM mot_par WHERE id <= 10;
+EXECUTE par_count;
+ROLLBACK;
+EXPLAIN (costs off) EXECUTE par_count;
+EXECUTE par_count;
+
+-- the workers can't share a repeatable read snapshot
+START TRANSACTION ISOLATION LEVEL REPEATABLE READ;
+EXPLAIN (costs off) EXECUTE par_count;
+EXECUTE par_count;
+COMMIT;
+EXPLAIN (costs off) EXECUTE par_count;
+
+DEALLOCATE par_count;
+RESET query_dop;
+DROP FOREIGN TABLE mot_par;
@@ -0,0 +1,8 @@
+--
+-- PARTITION BY on a memory table is rejected instead of being silently ignored
+--
+CREATE FOREIGN TABLE mot_part_t (a int primary key, b int) SERVER mot_server PARTITION BY (a);
+CREATE FOREIGN TABLE mot_part_t (a int, b int) SERVER mot_server PARTITION BY (b);
+
+-- nothing was created
+SELECT count(*) FROM pg_class WHERE relname = 'mot_part_t';
@@ -0,0 +1,27 @@
+--
+-- MOT scans feeding the vector engine return the same rows as row scans
+--
+CREATE FOREIGN TABLE mot_vec (id int primary key, b bigint, f float8, n numeric(10,2), s varchar(20), t text) SERVER mot_server;
+INSERT INTO mot_vec SELECT g, g * 1000000000::bigint, g / 4.0, g / 3.0,
+    CASE WHEN g % 5 = 0 THEN NULL ELSE 'v' || (g % 13) END, repeat('t', g % 7 + 1) FROM generate_series(1, 5000) g;
+ANALYZE mot_vec;
+
+SET enable_vector_engine = on;
+EXPLAIN (costs off) SELECT count(*), count(s), sum(id), sum(b), sum(f), sum(n), sum(length(t)) FROM mot_vec;
+SELECT count(*), count(s), sum(id), sum(b), sum(f), sum(n), sum(length(t)) FROM mot_vec;
+SELECT s, count(*), sum(n) FROM mot_vec GROUP BY s ORDER BY s;
+EXPLAIN (costs off) SELECT count(*), max(f), min(s), max(t) FROM mot_vec WHERE id > 2000;
+SELECT count(*), max(f), min(s), max(t) FROM mot_vec WHERE id > 2000;
+SELECT count(*) FROM mot_vec WHERE s = 'v3' AND t <> 't';
+EXPLAIN (costs off) SELECT id, s, t FROM mot_vec WHERE id = 4242;
+SELECT id, s, t FROM mot_vec WHERE id = 4242;
+
+SET enable_vector_engine = off;
+SELECT count(*), count(s), sum(id), sum(b), sum(f), sum(n), sum(length(t)) FROM mot_vec;
+SELECT s, count(*), sum(n) FROM mot_vec GROUP BY s ORDER BY s;
+SELECT count(*), max(f), min(s), max(t) FROM mot_vec WHERE id > 2000;
+SELECT count(*) FROM mot_vec WHERE s = 'v3' AND t <> 't';
+SELECT id, s, t FROM mot_vec WHERE id = 4242;
+RESET enable_vector_engine;
+
+DROP FOREIGN TABLE mot_vec;